@@ -11,6 +11,7 @@
 /* gtri - evt - wbk - 5/20/91 - add event-driven and enhancements data */
 
 extern int DEVmaxnum;
+extern int DEVmaxslots;     /* room in DEVices - see SPIinit.c */
 #define MAXNUMDEVNODES 4
 
 #include "SMPdefs.h"
@@ -47,6 +48,22 @@ typedef struct sCKTnode {
 #define PARM_IC 2
 #define PARM_NODETYPE 3
 
+/* hash index from a uid to the node, model or instance it names - uids
+ * are unique pointers, so it is the pointer that is hashed.  There may be
+ * more than one entry for a uid (the same name on two types of device).
+ */
+typedef struct sCKThashEnt {
+    IFuid key;
+    GENERIC *data;
+    struct sCKThashEnt *next;
+} CKThashEnt;
+
+typedef struct {
+    CKThashEnt **CKTbuckets;
+    int CKTbucketCount;     /* a power of 2, or 0 until first used */
+    int CKTentryCount;
+} CKThash;
+
 
 
 typedef struct {
@@ -131,6 +148,9 @@ typedef struct {
 
     CKTnode *CKTnodes;
     CKTnode *CKTlastNode;
+    CKThash CKTnodeTab;     /* node by name */
+    CKThash CKTmodTab;      /* model by name */
+    CKThash CKTinstTab;     /* instance by name */
 #define NODENAME(ckt,nodenum) CKTnodName(ckt,nodenum)
     int CKTnumStates;
     long CKTmode;
@@ -203,6 +223,32 @@ typedef struct {
     unsigned int CKTnoOpIter:1; /* flag to indicate not to try the operating
                                  * point brute force, but to use gmin stepping
                                  * first */
+    unsigned int CKTluReuse:1;  /* flag to indicate that transient iterations
+                                 * may reuse the last L-U factors (modified
+                                 * Newton) rather than factor every time */
+    double CKTluAg0;            /* CKTag[0] when the saved factors were made */
+    int CKTluOrder;             /* and CKTorder */
+    GENmodel **CKTtouched;      /* models with parameters changed since the
+                                 * last temperature update (CKTtouch) */
+    int CKTnumTouched;          /* number of them, or -1 to do them all */
+    int CKTmaxTouched;
+    int CKTsetupTouched;        /* flag to indicate that one of them decides
+                                 * what the device setup routines build, so
+                                 * the circuit can't just be rerun */
+    double *CKTwarmRhs;         /* the last operating point found, to start */
+    double *CKTwarmState;       /* the next one from on a rerun */
+    int CKTwarmSize;            /* length of CKTwarmRhs, 0 if none saved */
+    int CKTwarmStates;          /* and of CKTwarmState */
+    int CKTwarmStart;           /* how CKTop should use the saved
+                                 * operating point: */
+#define WARM_NONE 0             /* not at all */
+#define WARM_GUESS 1            /* iterate from it first */
+#define WARM_ACCEPT 2           /* take it if it still fits (CKTsnapLoad) */
+    char *CKTsnapFile;          /* file for operating point snapshots */
+    int CKTsnapAccept;          /* flag to indicate that a snapshot that fits
+                                 * may be taken without iterating */
+    int CKTsnapUsed;            /* flag to indicate that the last operating
+                                 * point was taken from the snapshot */
     JOB *CKTcurJob;
 
     SENstruct *CKTsenInfo;      /* the sensitivity information */
@@ -247,6 +293,11 @@ int CKTfndMod( GENERIC *, int *, GENERIC **, IFuid );
 int CKTfndNode( GENERIC *, GENERIC **, IFuid );
 int CKTfndTask( GENERIC *, GENERIC **, IFuid  );
 int CKTground( GENERIC *, GENERIC **, IFuid );
+int CKThashAdd( CKThash *, IFuid , GENERIC *);
+void CKThashDel( CKThash *, IFuid , GENERIC *);
+CKThashEnt * CKThashFirst( CKThash *, IFuid );
+void CKThashFree( CKThash *);
+CKThashEnt * CKThashNext( CKThashEnt *);
 int CKTic( CKTcircuit *);
 int CKTinit( GENERIC **);
 int CKTinst2Node( GENERIC *, GENERIC *, int , GENERIC **, IFuid *);
@@ -285,7 +336,13 @@ int CKTsetBreak( CKTcircuit *, double );
 int CKTsetNodPm( GENERIC *, GENERIC *, int , IFvalue *, IFvalue *);
 int CKTsetOpt( GENERIC *, GENERIC *, int , IFvalue *);
 int CKTsetup( CKTcircuit *);
+int CKTsnapLoad( CKTcircuit *);
+int CKTsnapSave( CKTcircuit *);
+int CKTsnapshot( GENERIC *, char *, int );
 int CKTtemp( CKTcircuit *);
+int CKTtempTouched( CKTcircuit *);
+int CKTtouch( CKTcircuit *, GENmodel *, int, int);
+int CKTwarmAlloc( CKTcircuit *);
 void CKTterr( int , CKTcircuit *, double *);
 int CKTtrunc( CKTcircuit *, double *);
 int CKTtypelook( char *);
@@ -351,6 +408,11 @@ int CKTfndMod();
 int CKTfndNode();
 int CKTfndTask();
 int CKTground();
+int CKThashAdd();
+void CKThashDel();
+CKThashEnt * CKThashFirst();
+void CKThashFree();
+CKThashEnt * CKThashNext();
 int CKTic();
 int CKTinit();
 int CKTinst2Node();
@@ -389,8 +451,14 @@ int CKTsetBreak();
 int CKTsetNodPm();
 int CKTsetOpt();
 int CKTsetup();
+int CKTsnapLoad();
+int CKTsnapSave();
+int CKTsnapshot();
 int CKTpzSetup();
 int CKTtemp();
+int CKTtempTouched();
+int CKTtouch();
+int CKTwarmAlloc();
 void CKTterr();
 int CKTtrunc();
 int CKTtypelook();
@@ -66,6 +66,21 @@ void cm_smooth_discontinuity(double x_input, double x_lower, double y_lower,
 double cm_smooth_pwl(double x_input, double *x, double *y, int size,
                double input_domain, double *dout_din);
 
+void cm_bus_set(Bus_t *bus, int width, unsigned long *value,
+               Digital_Strength_t strength);
+void cm_bus_fill(Bus_t *bus, int width, Digital_State_t state,
+               Digital_Strength_t strength);
+void cm_bus_copy(Bus_t *to, Bus_t *from, int width,
+               Digital_Strength_t strength);
+void cm_bus_merge(Bus_t *to, Bus_t *from);
+unsigned long cm_bus_mask(int width, int word);
+Boolean_t cm_bus_known(Bus_t *bus);
+Boolean_t cm_bus_equal(Bus_t *bus1, Bus_t *bus2);
+
+void cm_table_init(Cm_Table_t *table, double *x, int stride, int size,
+               int *cell, int num_cells);
+int  cm_table_find(Cm_Table_t *table, double x_input);
+
 double cm_analog_ramp_factor(void);
 void *cm_analog_alloc(int tag, int bytes);
 void *cm_analog_get_ptr(int tag, int timepoint);
@@ -79,6 +94,11 @@ void cm_analog_auto_partial(void);
 void *cm_event_alloc(int tag, int bytes);
 void *cm_event_get_ptr(int tag, int timepoint);
 int  cm_event_queue(double time);
+int  cm_event_journal(void *ptr, int bytes);
+
+void *cm_static_alloc(int tag, int bytes);
+void *cm_static_get_ptr(int tag);
+int  cm_static_cleanup(int tag, void (*cleanup)(void *block));
 
 char *cm_message_get_errmsg(void);
 int  cm_message_send(char *msg);
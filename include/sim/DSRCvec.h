@@ -0,0 +1,80 @@
+/*============================================================================
+FILE    DSRCvec.h
+
+MEMBER OF process XSPICE
+
+Copyright 1991
+Georgia Tech Research Corporation
+Atlanta, Georgia 30332
+All Rights Reserved
+
+PROJECT A-8503
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    Layout of the compiled vector files written by srcconv from the
+    text input files of the d_source code model.  d_source recognizes
+    one by its magic number and maps it instead of reading it.
+
+    The file is a header followed by ds_depth records of ds_stride
+    bytes each.  A record is the timepoint as a double followed by one
+    4-bit code per output bit, two to a byte with the lower numbered bit
+    in the low half.  The codes are those of the text file in the order
+    0s 1s Us 0r 1r Ur 0z 1z Uz 0u 1u Uu, numbered from 0.  Timepoints
+    are strictly increasing.
+
+    Values are stored in the byte order of the machine that wrote the
+    file.
+
+INTERFACES
+
+    None.
+
+REFERENCED FILES
+
+    None.
+
+NON-STANDARD FEATURES
+
+    None.
+
+============================================================================*/
+
+#ifndef DSRC_DEFINED
+#define DSRC_DEFINED
+
+
+#define DSRC_MAGIC      0x58445352      /* "XDSR" */
+#define DSRC_VERSION    1
+
+
+typedef struct {
+    int             ds_magic;       /* DSRC_MAGIC */
+    int             ds_version;
+    int             ds_width;       /* Output bits in each record */
+    int             ds_stride;      /* Bytes in each record, a multiple of 8 */
+    int             ds_depth;       /* Number of records */
+    int             ds_pad;
+} Dsrc_Header_t;
+
+
+#define DSRC_STRIDE(width)  ((sizeof(double) + ((width) + 1) / 2 + 7) & ~7)
+
+#define DSRC_RECORD(h, n)   ((char *) (h) + sizeof(Dsrc_Header_t) + \
+        (long) (n) * (h)->ds_stride)
+
+#define DSRC_TIME(h, n)     (*(double *) DSRC_RECORD(h, n))
+
+#define DSRC_CODE(h, n, bit) ((((unsigned char *) DSRC_RECORD(h, n)) \
+        [sizeof(double) + (bit) / 2] >> (((bit) & 1) * 4)) & 0xf)
+
+
+#endif  /* DSRC_DEFINED */
@@ -37,6 +37,31 @@ struct circ {
     char *ci_defOpt;    /* the default options anal. for this circuit */
     char *ci_specOpt;   /* the special options anal. for command line jobs */
     char *ci_curOpt;    /* the most recent options anal. for the circuit */
+    struct mcvar *ci_vary;  /* parameters to vary for Monte Carlo runs */
+    struct altvar *ci_alters; /* alter commands since the deck was parsed */
+} ;
+
+/* An alter command, kept so that it can be done again on a reparsed
+ * deck.
+ */
+
+struct altvar {
+    char *av_name;      /* The device or model... */
+    char *av_parm;      /* which of its parameters... */
+    struct variable av_val; /* and what it was set to. */
+    struct altvar *av_next;
+} ;
+
+/* A parameter to be varied by the mc command. */
+
+struct mcvar {
+    char *mv_name;      /* The device or model... */
+    char *mv_parm;      /* and which of its parameters. */
+    double mv_sigma;    /* Relative deviation. */
+    bool mv_uniform;    /* Uniform instead of gaussian. */
+    double mv_nominal;  /* The value given in the deck. */
+    double mv_value;    /* The one picked for this run. */
+    struct mcvar *mv_next;
 } ;
 
 struct subcirc {
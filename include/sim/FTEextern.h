@@ -117,6 +117,8 @@ extern char *cx_and();
 extern char *cx_or();
 extern char *cx_not();
 extern char *cx_interpolate();
+extern char *cx_fft();
+extern char *cx_ifft();
 
 /* cmdtab.c */
 
@@ -144,6 +146,8 @@ extern void ft_pnode();
 
 extern void com_show();
 extern void com_alter();
+extern void ft_altredo();
+extern void ft_altfree();
 
 /* diff.c */
 
@@ -268,6 +272,12 @@ extern bool ft_polyfit();
 extern double ft_peval();
 extern void com_linearize();
 
+/* measure.c */
+
+extern struct measure *ft_measinit();
+extern void ft_measpoint();
+extern void ft_measend();
+
 /* mfbinterface.c */
 
 extern void mi_arc();
@@ -291,6 +301,15 @@ extern void com_quit();
 extern void com_version();
 extern int hcomp();
 
+/* montecarlo.c */
+
+extern void com_vary();
+extern void ft_mcstart();
+extern bool ft_mcnominal();
+extern void ft_mcperturb();
+extern void ft_mcredo();
+extern void ft_mcrestore();
+
 /* numparse.c */
 
 extern bool ft_strictnumparse;
@@ -365,6 +384,7 @@ extern void ft_ckspace();
 
 extern void com_ac();
 extern void com_dc();
+extern void com_mc();
 extern void com_op();
 extern void com_pz();
 extern void com_sens();
@@ -375,6 +395,12 @@ extern void com_tran();
 extern void com_scirc();
 extern void ft_dorun();
 
+/* spectrum.c */
+
+extern bool ft_fft();
+extern void com_fft();
+extern void com_distortion();
+
 /* spice.c & nutmeg.c */
 
 extern bool menumode;
@@ -389,6 +415,7 @@ extern void main();
 
 /* spiceif.c & nutmegif.c */
 
+extern bool if_canrerun();
 extern bool if_tranparams();
 extern char *if_errstring();
 extern char *if_inpdeck();
@@ -402,6 +402,8 @@ typedef struct sIFsimulator {
 
     int ((*doAnalyses)(GENERIC*,int,GENERIC*));          
                                     /* run a specified task */
+    int ((*snapshot)(GENERIC*,char*,int));
+                                    /* keep operating points in a file */
 #else
     int ((*newCircuit)());          /* create new circuit */
     int ((*deleteCircuit)());       /* destroy old circuit's data structures */
@@ -436,6 +438,7 @@ typedef struct sIFsimulator {
     int ((*deleteTask)());          /* delete a task */
 
     int ((*doAnalyses)());          /* run a specified task */
+    int ((*snapshot)());            /* keep operating points in a file */
 #endif /* STDC */
 
     int numDevices;                 /* number of device types supported */
@@ -526,5 +529,10 @@ typedef struct sIFfrontEnd {
 #define RESTART 1
     /* abandon the current analysis and go on the the next in the task*/
 #define SKIPTONEXT 2
+    /* start the task over, keeping the matrix, node numbering, and pivot
+     * order built by an earlier RESTART - only the temperature dependent
+     * setup of models whose parameters have been set since is redone, and
+     * the operating point is started from the last one found */
+#define RERUN 3
 
 #endif /*IFSIMULATOR*/
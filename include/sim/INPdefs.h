@@ -75,6 +75,7 @@ typedef struct sINPmodel{
     int INPmodUsed;     /* flag to indicate it has already been used */
     card *INPmodLine;   /* pointer to line describing model */
     GENERIC *INPmodfast;   /* high speed pointer to model for access */
+    struct sINPmodel *INPnextHash;  /* link to next model in hash bucket */
 } INPmodel;
 
 /* listing types - used for debug listings */
@@ -101,7 +102,11 @@ IFvalue * INPgetValue(GENERIC*,char**,int,INPtables*);
 int INPgndInsert(GENERIC*,char**,INPtables*,GENERIC**);
 int INPinsert(char**,INPtables*);
 int INPlookMod(char*);
+int INPcacheLoad(GENERIC*,card*,INPtables*,GENERIC*,GENERIC*,char*);
+void INPcacheSave(card*,char*);
+void INPcacheStart(GENERIC*,card*,GENERIC*,GENERIC*);
 int INPmakeMod(char*,int,card*);
+INPmodel *INPmodBucket(char*);
 char *INPmkTemp(char*);
 void INPpas1(GENERIC*,card*,INPtables*);
 void INPpas2(GENERIC*,card*,INPtables*,GENERIC *);
@@ -121,6 +126,7 @@ void INP2J(GENERIC*,INPtables*,card*);
 void INP2K(GENERIC*,INPtables*,card*);
 void INP2L(GENERIC*,INPtables*,card*);
 void INP2M(GENERIC*,INPtables*,card*);
+void INP2O(GENERIC*,INPtables*,card*);
 void INP2Q(GENERIC*,INPtables*,card*,GENERIC*);
 void INP2R(GENERIC*,INPtables*,card*);
 void INP2S(GENERIC*,INPtables*,card*);
@@ -151,7 +157,11 @@ int INPgetTitle();
 int INPgetTok();
 int INPgndInsert();
 int INPlookMod();
+int INPcacheLoad();
+void INPcacheSave();
+void INPcacheStart();
 int INPmakeMod();
+INPmodel *INPmodBucket();
 int INPpName();
 int INPreadAll();
 int INPtermInsert();
@@ -179,6 +189,7 @@ void INP2J();
 void INP2K();
 void INP2L();
 void INP2M();
+void INP2O();
 void INP2Q();
 void INP2R();
 void INP2S();
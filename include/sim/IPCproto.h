@@ -20,6 +20,15 @@ Ipc_Status_t ipc_send_dcop_suffix P((void ));
 Ipc_Status_t ipc_send_errchk P((void ));
 Ipc_Status_t ipc_send_end P((void ));
 static int stuff_binary_v1 P((double d1 , double d2 , int n , char *buf , int pos ));
+static int stuff_u32_v2 P((unsigned long u , char *buf , int pos ));
+static int stuff_double_v2 P((double d , char *buf , int pos ));
+static Ipc_Status_t ipc_send_record P((char *str , int len ));
+static Ipc_Status_t frame_begin P((int kind , double ref ));
+static Ipc_Status_t frame_add P((double d ));
+static Ipc_Status_t frame_send P((void ));
+Ipc_Status_t ipc_send_vecdict_prefix P((int num ));
+Ipc_Status_t ipc_send_vecdict_entry P((int index , char *tag , Ipc_Boolean_t is_complex ));
+Ipc_Status_t ipc_send_vecdict_suffix P((void ));
 Ipc_Status_t ipc_send_double P((char *tag , double value ));
 Ipc_Status_t ipc_send_complex P((char *tag , Ipc_Complex_t value ));
 Ipc_Status_t ipc_send_int P((char *tag , int value ));
@@ -8,6 +8,7 @@
 #include "complex.h"
 #include "CKTdefs.h"
 #include "GENdefs.h"
+#include "CMtypes.h"
 
     /* structures used to describe current sources */
 
@@ -26,6 +27,7 @@ typedef struct sISRCinstance {
     int ISRCfunctionType;   /* code number of function type for source */
     int ISRCfunctionOrder;  /* order of the function for the source */
     double *ISRCcoeffs; /* pointer to array of coefficients */
+    Cm_Table_t ISRCtable; /* lookup of the PWL timepoints */
 
     double ISRCdcValue; /* DC and TRANSIENT value of source */
     double ISRCacPhase; /* AC phase angle */
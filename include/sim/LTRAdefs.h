@@ -0,0 +1,194 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+#ifndef LTRA
+#define LTRA
+
+#include "IFsim.h"
+#include "CKTdefs.h"
+#include "GENdefs.h"
+#include "complex.h"
+
+        /* definitions used to describe lossy transmission lines */
+
+    /*
+     * The line is modelled by the method of characteristics, with the
+     * characteristic impedance and the propagation function each split
+     * into an impulse plus a tail.  The tails are fitted by a sum of
+     * exponentials when the transient analysis starts, so the convolution
+     * with each of them can be updated recursively at every time point.
+     */
+
+
+/* information used to describe a single instance */
+
+typedef struct sLTRAinstance {
+    struct sLTRAmodel *LTRAmodPtr;  /* backpointer to model */
+    struct sLTRAinstance *LTRAnextInstance; /* pointer to next instance of
+                                             * current model*/
+    IFuid LTRAname;     /* pointer to character string naming this instance */
+
+    int LTRAposNode1;   /* number of positive node of end 1 of t. line */
+    int LTRAnegNode1;   /* number of negative node of end 1 of t. line */
+    int LTRAposNode2;   /* number of positive node of end 2 of t. line */
+    int LTRAnegNode2;   /* number of negative node of end 2 of t. line */
+    int LTRAbrEq1;      /* number of branch equation for end 1 of t. line */
+    int LTRAbrEq2;      /* number of branch equation for end 2 of t. line */
+
+    double LTRAinput1;  /* wave arriving at port 1 at the current time */
+    double LTRAinput2;  /* wave arriving at port 2 at the current time */
+    double LTRAzHist1;  /* history part of the impedance drop at port 1 */
+    double LTRAzHist2;  /* history part of the impedance drop at port 2 */
+
+    double LTRAlastTime;    /* time of the last accepted point */
+    double LTRAcur1;    /* current into port 1 at the last accepted point */
+    double LTRAcur2;    /* current into port 2 at the last accepted point */
+    double LTRAdelayed1;    /* wave arriving at port 1, last accepted point */
+    double LTRAdelayed2;    /* wave arriving at port 2, last accepted point */
+    double *LTRAstate;  /* recursive convolution states - four blocks of
+                         * LTRAnumState: impedance tail at port 1, port 2,
+                         * then propagation tail at port 1, port 2 */
+    int LTRAnumState;   /* number of poles the states were allocated for */
+    int LTRAinit;       /* flag to indicate the states have been set up */
+
+    double *LTRAdelays; /* past (time, wave1, wave2) triples (ring buffer) */
+    int LTRAsizeDelay;      /* size of active delayed table */
+    int LTRAallocDelay;     /* allocated size of delayed table (power of 2) */
+    int LTRAfirstDelay;     /* slot holding entry 0 of the active table */
+    int LTRAcursorDelay;    /* entry last used to interpolate the delay */
+
+    double *LTRAibr1Pos1Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr1Neg1Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr1Pos2Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr1Neg2Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr1Ibr1Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr1Ibr2Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr2Pos1Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr2Neg1Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr2Pos2Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr2Neg2Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr2Ibr1Ptr;    /* pointer to sparse matrix */
+    double *LTRAibr2Ibr2Ptr;    /* pointer to sparse matrix */
+    double *LTRApos1Ibr1Ptr;    /* pointer to sparse matrix */
+    double *LTRAneg1Ibr1Ptr;    /* pointer to sparse matrix */
+    double *LTRApos2Ibr2Ptr;    /* pointer to sparse matrix */
+    double *LTRAneg2Ibr2Ptr;    /* pointer to sparse matrix */
+} LTRAinstance ;
+
+/* the delay table is a ring of (time, wave1, wave2) triples, kept the
+ * same way as the one for the lossless line - see TRAdefs.h
+ */
+#define LTRADELAY(inst,i) ((inst)->LTRAdelays + 3 * (((inst)->LTRAfirstDelay \
+        + (i)) & ((inst)->LTRAallocDelay - 1)))
+
+
+/* per model data */
+
+typedef struct sLTRAmodel {     /* model structure for lossy lines */
+    int LTRAmodType;    /* type index of this device type */
+    struct sLTRAmodel *LTRAnextModel;   /* pointer to next possible model in
+                                         * linked list */
+    LTRAinstance * LTRAinstances;   /* pointer to list of instances that have
+                                     * this model */
+    IFuid LTRAmodName;      /* pointer to character string naming this model */
+
+    double LTRAresist;      /* resistance per unit length */
+    double LTRAinduct;      /* inductance per unit length */
+    double LTRAconduct;     /* conductance per unit length */
+    double LTRAcapac;       /* capacitance per unit length */
+    double LTRAlength;      /* length of the line */
+    int LTRAorder;          /* number of poles used to fit each tail */
+    double LTRAfitTime;     /* length of time the tails are fitted over */
+    double LTRAreltol;      /* relative deriv. tol. for breakpoint setting */
+    double LTRAabstol;      /* absolute deriv. tol. for breakpoint setting */
+
+    double LTRAtd;          /* propagation delay - calculated */
+    double LTRAimped;       /* high frequency impedance - calculated */
+    double LTRAattenuate;   /* attenuation of the delayed impulse */
+    double LTRAalpha;       /* (R/L + G/C) / 2 */
+    double LTRAbeta;        /* (R/L - G/C) / 2 */
+
+    int LTRAnumPoles;       /* number of poles actually fitted */
+    double LTRAfitWindow;   /* window the current fit was made over */
+    double *LTRApoles;      /* poles shared by both tails */
+    double *LTRAzResid;     /* residues of the impedance tail */
+    double *LTRAhResid;     /* residues of the propagation tail */
+    double *LTRAcoef;       /* per pole (decay, old, new) weights for the
+                             * step LTRAcoefStep */
+    double LTRAcoefStep;    /* time step LTRAcoef was computed for */
+    double LTRAzEff;        /* impedance seen at the current time point */
+
+    unsigned LTRAresistGiven : 1;   /* flag to indicate R was specified */
+    unsigned LTRAinductGiven : 1;   /* flag to indicate L was specified */
+    unsigned LTRAconductGiven : 1;  /* flag to indicate G was specified */
+    unsigned LTRAcapacGiven : 1;    /* flag to indicate C was specified */
+    unsigned LTRAlengthGiven : 1;   /* flag to indicate length was specified */
+    unsigned LTRAorderGiven : 1;    /* flag to indicate order was specified */
+    unsigned LTRAfitTimeGiven : 1;  /* flag to indicate tfit was specified */
+    unsigned LTRAreltolGiven : 1;   /* flag to ind. relative deriv. tol. given */
+    unsigned LTRAabstolGiven : 1;   /* flag to ind. absolute deriv. tol. given */
+} LTRAmodel;
+
+/* device parameters */
+#define LTRA_POS_NODE1 1
+#define LTRA_NEG_NODE1 2
+#define LTRA_POS_NODE2 3
+#define LTRA_NEG_NODE2 4
+#define LTRA_BR_EQ1 5
+#define LTRA_BR_EQ2 6
+#define LTRA_INPUT1 7
+#define LTRA_INPUT2 8
+
+/* model parameters */
+#define LTRA_MOD_R 101
+#define LTRA_MOD_L 102
+#define LTRA_MOD_G 103
+#define LTRA_MOD_C 104
+#define LTRA_MOD_LEN 105
+#define LTRA_MOD_ORDER 106
+#define LTRA_MOD_TFIT 107
+#define LTRA_MOD_RELTOL 108
+#define LTRA_MOD_ABSTOL 109
+#define LTRA_MOD_LTRA 110
+
+/* device questions */
+
+/* model questions */
+#define LTRA_MOD_TD 111
+#define LTRA_MOD_Z0 112
+
+#ifdef __STDC__
+extern int LTRAacLoad(GENmodel*,CKTcircuit*);
+extern int LTRAaccept(CKTcircuit*,GENmodel*);
+extern int LTRAask(CKTcircuit*,GENinstance*,int,IFvalue*,IFvalue*);
+extern void LTRAcoeffs(LTRAmodel*,double);
+extern double LTRAdelayed(LTRAinstance*,double,int);
+extern int LTRAdelete(GENmodel*,IFuid,GENinstance**);
+extern void LTRAdestroy(GENmodel**);
+extern int LTRAfit(LTRAmodel*,CKTcircuit*);
+extern int LTRAload(GENmodel*,CKTcircuit*);
+extern int LTRAmAsk(CKTcircuit*,GENmodel*,int,IFvalue*);
+extern int LTRAmDelete(GENmodel**,IFuid,GENmodel*);
+extern int LTRAmParam(int,IFvalue*,GENmodel*);
+extern int LTRAsetup(SMPmatrix*,GENmodel*,CKTcircuit*,int*);
+extern int LTRAtemp(GENmodel*,CKTcircuit*);
+extern int LTRAtrunc(GENmodel*,CKTcircuit*,double*);
+#else /* stdc */
+extern int LTRAacLoad();
+extern int LTRAaccept();
+extern int LTRAask();
+extern void LTRAcoeffs();
+extern double LTRAdelayed();
+extern int LTRAdelete();
+extern void LTRAdestroy();
+extern int LTRAfit();
+extern int LTRAload();
+extern int LTRAmAsk();
+extern int LTRAmDelete();
+extern int LTRAmParam();
+extern int LTRAsetup();
+extern int LTRAtemp();
+extern int LTRAtrunc();
+#endif /* stdc */
+
+#endif /*LTRA*/
@@ -276,6 +276,31 @@ typedef struct Mif_Conv_s {   /* for cm_analog_converge() */
 } Mif_Conv_t;
 
 
+typedef struct Mif_Static_s {   /* for cm_static_alloc() */
+
+    struct Mif_Static_s *next;    /* Next static block on this instance */
+    int         tag;              /* Tag identifying this block */
+    int         bytes;            /* Number of bytes allocated */
+    void        *block;           /* The data - never copied or rotated */
+    void        (*cleanup)(void *); /* Called with block before it is freed */
+
+} Mif_Static_t;
+
+
+typedef struct Mif_Jacobian_s { /* for auto partials - see MIFauto_partial() */
+
+    int         num_in;           /* Number of analog input ports */
+    int         num_out;          /* Number of analog output ports */
+    Mif_Boolean_t valid;          /* True once partial has been computed */
+    long        mode;             /* CKTmode partial was computed in */
+    double      delta;            /* CKTdelta partial was computed at */
+    double      ag0;              /* CKTag[0] partial was computed with */
+    double      *input;           /* Input values partial was computed at */
+    double      *partial;         /* num_out x num_in divided differences */
+
+} Mif_Jacobian_t;
+
+
 
 /* ******************************************************************** */
 
@@ -73,6 +73,10 @@ typedef struct sMIFinstance {
     int                 num_conv;         /* Number of things to be converged */
     Mif_Conv_t          *conv;            /* Info for convergence things */
 
+    Mif_Static_t        *static_data;     /* Blocks from cm_static_alloc() */
+
+    Mif_Jacobian_t      *jacobian;        /* Last auto partials, or NULL */
+
     Mif_Boolean_t       initialized;      /* True if model called once already */
 
     Mif_Boolean_t       analog;           /* true if this inst is analog or hybrid type */
@@ -99,6 +103,10 @@ typedef struct sMIFmodel {
     Mif_Boolean_t    analog;          /* true if this model is analog or hybrid type */
     Mif_Boolean_t    event_driven;    /* true if this model is event-driven or hybrid type */
 
+    int              auto_loads;      /* loads of instances with auto partials */
+    int              auto_calls;      /* extra model calls made for them */
+    int              auto_reused;     /* loads that reused the last partials */
+
 } MIFmodel;
 
 
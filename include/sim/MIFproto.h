@@ -47,6 +47,7 @@ NON-STANDARD FEATURES
 #include "SMPdefs.h"
 #include "CKTdefs.h"
 #include "MIFtypes.h"
+#include "CPstd.h"
 
 
 
@@ -114,6 +115,15 @@ extern int MIFtrunc(
     double     *timeStep
 );
 
+extern int MIFauto_stats(
+    CKTcircuit *ckt,
+    FILE       *fp
+);
+
+extern void MIFauto_clear(
+    CKTcircuit *ckt
+);
+
 extern int MIFconvTest(
     GENmodel   *inModel,
     CKTcircuit *ckt
@@ -154,4 +164,17 @@ extern Mif_Cntl_Src_Type_t MIFget_cntl_src_type(
 extern char *MIFcopy(char *);
 
 
+extern void MIFcodemodel(
+    wordlist *wl
+);
+
+extern int MIFlib_find_dev(
+    char *name
+);
+
+extern int MIFlib_find_udn(
+    char *name
+);
+
+
 #endif  /* MIFPROTO */
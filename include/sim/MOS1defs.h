@@ -61,6 +61,14 @@ typedef struct sMOS1instance {
     double MOS1vdsat;
     double MOS1sourceVcrit; /* Vcrit for pos. vds */
     double MOS1drainVcrit;  /* Vcrit for pos. vds */
+    double MOS1tEffLength;   /* effective channel length */
+    double MOS1tDrainSatCur; /* drain junction saturation current */
+    double MOS1tSourceSatCur;    /* source junction saturation current */
+    double MOS1tGsOverlapCap;    /* gate-source overlap capacitance */
+    double MOS1tGdOverlapCap;    /* gate-drain overlap capacitance */
+    double MOS1tGbOverlapCap;    /* gate-bulk overlap capacitance */
+    double MOS1tBeta;        /* transconductance scaled by W/Leff */
+    double MOS1tOxideCap;    /* total gate oxide capacitance */
     double MOS1cd;
     double MOS1cbs;
     double MOS1cbd;
@@ -60,6 +60,14 @@ typedef struct sMOS3instance {
     double MOS3vdsat;
     double MOS3sourceVcrit; /* vcrit for pos. vds */
     double MOS3drainVcrit;  /* vcrit for neg. vds */
+    double MOS3tEffLength;   /* effective channel length */
+    double MOS3tDrainSatCur; /* drain junction saturation current */
+    double MOS3tSourceSatCur;    /* source junction saturation current */
+    double MOS3tGsOverlapCap;    /* gate-source overlap capacitance */
+    double MOS3tGdOverlapCap;    /* gate-drain overlap capacitance */
+    double MOS3tGbOverlapCap;    /* gate-bulk overlap capacitance */
+    double MOS3tBeta;        /* transconductance scaled by W/Leff */
+    double MOS3tOxideCap;    /* total gate oxide capacitance */
     double MOS3cd;
     double MOS3cbs;
     double MOS3cbd;
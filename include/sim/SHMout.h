@@ -0,0 +1,105 @@
+/*============================================================================
+FILE    SHMout.h
+
+MEMBER OF process XSPICE
+
+Copyright 1991
+Georgia Tech Research Corporation
+Atlanta, Georgia 30332
+All Rights Reserved
+
+PROJECT A-8503
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    Layout of the shared-memory waveform file written by OUTinterface.c
+    when the variable "shmout" is set, and read by shmview.
+
+    The file is a header, a table of vectors, and a ring of fixed-size
+    point records, all mapped shared by the simulator and any number of
+    readers on the same machine.  Record n (counting from 0) is in slot
+    n % sh_ringsize.  The simulator fills the slot and then increments
+    sh_count, so records below sh_count are complete.  It never waits for
+    readers: a reader that falls more than sh_ringsize records behind has
+    lost the oldest ones.  To be sure a record wasn't overwritten while it
+    was being copied, a reader checks sh_count again afterwards.
+
+    A reader with nothing to do sets sh_waiters and sleeps until sh_count
+    changes - with FUTEX_WAIT on sh_count under Linux, or by polling
+    elsewhere.  The simulator wakes it after the next record and when the
+    plot ends, at which point sh_done is set.  A new plot replaces the
+    file, so readers that want it must open the name again.
+
+INTERFACES
+
+    None.
+
+REFERENCED FILES
+
+    None.
+
+NON-STANDARD FEATURES
+
+    Requires mmap().
+
+============================================================================*/
+
+#ifndef SHM_DEFINED
+#define SHM_DEFINED
+
+
+#define SHM_MAGIC       0x5853484d      /* "XSHM" */
+#define SHM_VERSION     1
+#define SHM_NAMELEN     64
+#define SHM_DEFPOINTS   4096            /* Default ring size in records */
+
+
+typedef struct {
+    int             sh_magic;       /* Written last - SHM_MAGIC when valid */
+    int             sh_version;
+    int             sh_numvecs;     /* Entries in the vector table */
+    int             sh_width;       /* Doubles in each record */
+    int             sh_complex;     /* True if each value is (real, imag) */
+    int             sh_ringsize;    /* Records in the ring, a power of 2 */
+    int             sh_vecoffset;   /* Byte offset of the vector table */
+    int             sh_ringoffset;  /* Byte offset of the ring */
+    char            sh_name[SHM_NAMELEN];   /* Circuit title */
+    char            sh_type[SHM_NAMELEN];   /* Plot name */
+    volatile unsigned int sh_count; /* Records written so far */
+    volatile int    sh_waiters;     /* True if a reader is asleep */
+    volatile int    sh_done;        /* True when the plot is finished */
+    int             sh_pad;
+} Shm_Header_t;
+
+
+typedef struct {
+    char            sv_name[SHM_NAMELEN];
+    int             sv_type;        /* SV_TIME, SV_VOLTAGE, ... */
+    int             sv_index;       /* Value number within a record */
+} Shm_Vector_t;
+
+
+#define SHM_VECTORS(h)  ((Shm_Vector_t *) ((char *) (h) + (h)->sh_vecoffset))
+
+#define SHM_RECORD(h, n) ((double *) ((char *) (h) + (h)->sh_ringoffset) + \
+        ((n) & ((h)->sh_ringsize - 1)) * (h)->sh_width)
+
+/* Order the record stores before the count store, and the count load
+ * before the record loads.
+ */
+#ifdef __GNUC__
+#define SHM_BARRIER()   __sync_synchronize()
+#else
+#define SHM_BARRIER()
+#endif
+
+
+#endif  /* SHM_DEFINED */
@@ -0,0 +1,27 @@
+/*
+ * Table of the code models and node types in a code model library,
+ * compiled by the cmlib target of a simulator directory's makefile
+ * from the same CMextrn.h, CMinfo.h, UDNextrn.h and UDNinfo.h that
+ * SPIinit.c links in.  The simulator finds these two tables with
+ * dlsym when a 'codemodel' command names the library (see MIFlib.c).
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "IFsim.h"
+#include "DEVdefs.h"
+#include "EVTudn.h"
+#include "suffix.h"
+
+#include "CMextrn.h"
+#include "UDNextrn.h"
+
+SPICEdev *cm_lib_devices[] = {
+#include "CMinfo.h"
+    NULL
+};
+
+Evt_Udn_Info_t *cm_lib_udns[] = {
+#include "UDNinfo.h"
+    NULL
+};
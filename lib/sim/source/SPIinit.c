@@ -33,6 +33,7 @@ extern SPICEdev VCCSinfo;
 extern SPICEdev CCCSinfo;
 extern SPICEdev RESinfo;
 extern SPICEdev TRAinfo;
+extern SPICEdev LTRAinfo;
 extern SPICEdev CAPinfo;
 extern SPICEdev INDinfo;
 extern SPICEdev MUTinfo;
@@ -84,7 +85,12 @@ SPICEanalysis *analInfo[] = {
     &TFinfo,
 };
 
-SPICEdev *DEVices[] = {
+/* The devices linked in are copied to DEVices by SPIinit, leaving room */
+/* for code models loaded at run time (see SPIaddDevice)                */
+
+#define SPI_MAXLOAD 100    /* code models and node types that can be loaded */
+
+static SPICEdev *linkedDEVices[] = {
 
         &ASRCinfo,
         &VSRCinfo,
@@ -96,6 +102,7 @@ SPICEdev *DEVices[] = {
         &CCCSinfo,
         &RESinfo,
         &TRAinfo,
+        &LTRAinfo,
         &CAPinfo,
         &INDinfo,
         &MUTinfo,
@@ -118,6 +125,10 @@ SPICEdev *DEVices[] = {
 
 };
 
+#define NUMLINKED (sizeof(linkedDEVices)/sizeof(SPICEdev *))
+
+SPICEdev *DEVices[NUMLINKED + SPI_MAXLOAD];
+
 
 static IFsimulator SIMinfo = {
 
@@ -160,8 +171,9 @@ static IFsimulator SIMinfo = {
     CKTdelTask,     /* deleteTask function */
 
     CKTdoJob,       /* doAnalyses function */
+    CKTsnapshot,    /* snapshot function */
 
-    sizeof(DEVices)/sizeof(SPICEdev *),
+    0,              /* set by SPIinit */
     (IFdevice**)DEVices,
 
     sizeof(analInfo)/sizeof(SPICEanalysis *),
@@ -177,8 +189,9 @@ static IFsimulator SIMinfo = {
 
 
 
-/* my internal global constant for number of devices */
-int DEVmaxnum = sizeof(DEVices)/sizeof(SPICEdev *);
+/* my internal global for number of devices, and the room for them */
+int DEVmaxnum = 0;
+int DEVmaxslots = sizeof(DEVices)/sizeof(SPICEdev *);
 int ANALmaxnum = sizeof(analInfo)/sizeof(SPICEanalysis*);
 
 /* allocate space for global constants in 'CONST.h' */
@@ -194,12 +207,16 @@ IFfrontEnd *SPfrontEnd = NULL;
 extern Evt_Udn_Info_t idn_digital_info;
 #include "UDNextrn.h"
 
-Evt_Udn_Info_t  *g_evt_udn_info[] = {
+static Evt_Udn_Info_t  *linked_udn_info[] = {
     &idn_digital_info,
 #include "UDNinfo.h"
 };
 
-int g_evt_num_udn_types = sizeof(g_evt_udn_info)/sizeof(Evt_Udn_Info_t *);
+#define NUMLINKEDUDN (sizeof(linked_udn_info)/sizeof(Evt_Udn_Info_t *))
+
+Evt_Udn_Info_t  *g_evt_udn_info[NUMLINKEDUDN + SPI_MAXLOAD];
+
+int g_evt_num_udn_types = 0;
 
 /* gtri - end - wbk - 5/20/91 - Add stuff for user-defined nodes */
 
@@ -220,9 +237,52 @@ SPIinit(frtEnd,description)
 
     SPfrontEnd = frtEnd;
     *description = &SIMinfo;
+
+    /* copy in the devices and node types linked in */
+    for(DEVmaxnum = 0; DEVmaxnum < NUMLINKED; DEVmaxnum++) {
+        DEVices[DEVmaxnum] = linkedDEVices[DEVmaxnum];
+    }
+    SIMinfo.numDevices = DEVmaxnum;
+    for(g_evt_num_udn_types = 0; g_evt_num_udn_types < NUMLINKEDUDN;
+            g_evt_num_udn_types++) {
+        g_evt_udn_info[g_evt_num_udn_types] =
+                linked_udn_info[g_evt_num_udn_types];
+    }
+
     CONSTroot2 = sqrt(2.);
     CONSTvt0 = CONSTboltz * (27 /* deg c */ + CONSTCtoK ) / CHARGE;
     CONSTKoverQ = CONSTboltz / CHARGE;
     CONSTe = exp((double)1.0);
     return(OK);
 }
+
+
+/* SPIaddDevice(dev)
+ * add a device to the end of DEVices, where it is seen by new and
+ * existing circuits alike, and return its type number, or -1 if
+ * there is no more room
+ */
+
+int
+SPIaddDevice(dev)
+    SPICEdev *dev;
+{
+    if(DEVmaxnum >= DEVmaxslots) return(-1);
+    DEVices[DEVmaxnum] = dev;
+    SIMinfo.numDevices = DEVmaxnum + 1;
+    return(DEVmaxnum++);
+}
+
+/* SPIaddUdn(udn)
+ * add a user-defined node type and return its index, or -1 if there
+ * is no more room
+ */
+
+int
+SPIaddUdn(udn)
+    Evt_Udn_Info_t *udn;
+{
+    if(g_evt_num_udn_types >= NUMLINKEDUDN + SPI_MAXLOAD) return(-1);
+    g_evt_udn_info[g_evt_num_udn_types] = udn;
+    return(g_evt_num_udn_types++);
+}
@@ -0,0 +1,244 @@
+/* $Id: cfunc.tpl,v 1.1 91/03/18 19:01:04 bill Exp $ */
+/*.......1.........2.........3.........4.........5.........6.........7.........8
+================================================================================
+
+FILE bus_adder/cfunc.mod
+
+Copyright 1991
+Georgia Tech Research Corporation, Atlanta, Ga. 30332
+All Rights Reserved
+
+PROJECT A-8503-405
+
+
+AUTHORS
+
+    <date> <person name>
+
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+
+SUMMARY
+
+    This file contains the functional description of the bus_adder
+    code model, which adds two buses of up to 64 bits a machine word
+    at a time.
+
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_set()
+                         void cm_bus_fill()
+                         unsigned long cm_bus_mask()
+                         Boolean_t cm_bus_known()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+
+REFERENCED FILES
+
+    Inputs from and outputs to ARGS structure.
+
+
+NON-STANDARD FEATURES
+
+    NONE
+
+===============================================================================*/
+
+/*=== INCLUDE FILES ====================*/
+
+
+
+/*=== CONSTANTS ========================*/
+
+
+
+/*=== MACROS ===========================*/
+
+
+
+/*=== LOCAL VARIABLES & TYPEDEFS =======*/
+
+
+
+/*=== FUNCTION PROTOTYPE DEFINITIONS ===*/
+
+
+
+/*==============================================================================
+
+FUNCTION cm_bus_adder()
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    This function implements the bus_adder code model.
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_set()
+                         void cm_bus_fill()
+                         unsigned long cm_bus_mask()
+                         Boolean_t cm_bus_known()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+RETURNED VALUE
+
+    Returns inputs and outputs via ARGS structure.
+
+GLOBAL VARIABLES
+
+    NONE
+
+NON-STANDARD FEATURES
+
+    NONE
+
+==============================================================================*/
+
+/*=== CM_BUS_ADDER ROUTINE ===*/
+
+void cm_bus_adder(ARGS)
+
+{
+    int                    i;   /* generic loop counter index   */
+    int                width;   /* bits in the sum              */
+
+    unsigned long   word[BUS_WORDS],  /* the sum                */
+                           x,   /* partial sum of one word      */
+                       carry;   /* carry into the next word     */
+
+    Bus_t                 *a,   /* first addend                 */
+                          *b,   /* second addend                */
+                        *sum,   /* current sum                  */
+                    *sum_old;   /* previous sum                 */
+
+    Digital_State_t  *cout,     /* current carry out            */
+                 *cout_old,     /* previous carry out           */
+                       cin;     /* carry in                     */
+
+
+
+    width = PARAM(width);
+
+    /*** Setup required state variables ***/
+
+    if(INIT) {  /* initial pass */
+
+        /* allocate storage */
+        sum = sum_old = (Bus_t *) cm_event_alloc(0,sizeof(Bus_t));
+        cout = cout_old = (Digital_State_t *) cm_event_alloc(1,sizeof(Digital_State_t));
+
+        /* declare load values */
+        LOAD(a) = PARAM(input_load);
+        LOAD(b) = PARAM(input_load);
+        if ( !PORT_NULL(carry_in) ) {
+            LOAD(carry_in) = PARAM(carry_load);
+        }
+    }
+    else {      /* Retrieve previous values */
+
+        sum = (Bus_t *) cm_event_get_ptr(0,0);
+        sum_old = (Bus_t *) cm_event_get_ptr(0,1);
+        cout = (Digital_State_t *) cm_event_get_ptr(1,0);
+        cout_old = (Digital_State_t *) cm_event_get_ptr(1,1);
+    }
+
+
+    /*** load current input values; no carry in if not connected ***/
+
+    a = (Bus_t *) INPUT(a);
+    b = (Bus_t *) INPUT(b);
+    if ( PORT_NULL(carry_in) ) {
+        cin = ZERO;
+    }
+    else {
+        cin = INPUT_STATE(carry_in);
+    }
+
+
+    /*** add a word at a time; any unknown input bit makes the ***/
+    /*** whole sum unknown, since it may carry into the rest   ***/
+
+    if ( cm_bus_known(a) && cm_bus_known(b) && (UNKNOWN != cin) ) {
+
+        carry = (ONE == cin);
+        for (i=0; i<BUS_WORDS; i++) {
+            x = (a->value[i] & cm_bus_mask(width,i)) +
+                (b->value[i] & cm_bus_mask(width,i));
+            word[i] = x + carry;
+            carry = (x < (a->value[i] & cm_bus_mask(width,i))) ||
+                    (word[i] < x);
+        }
+
+        if ( BUS_WORD(width) < BUS_WORDS ) {
+            *cout = (word[BUS_WORD(width)] & BUS_BIT(width)) ? ONE : ZERO;
+        }
+        else {
+            *cout = carry ? ONE : ZERO;
+        }
+        cm_bus_set(sum, width, word, STRONG);
+    }
+    else {
+        cm_bus_fill(sum, width, UNKNOWN, STRONG);
+        *cout = UNKNOWN;
+    }
+
+
+
+    /******* Determine analysis type and output appropriate values *******/
+
+    if (0.0 == TIME) {   /****** Initial conditions...output w/o delays ******/
+
+        *sum_old = *sum;
+        *cout_old = *cout;
+
+        *(Bus_t *) OUTPUT(sum) = *sum;
+        if ( !PORT_NULL(carry_out) ) {
+            OUTPUT_STATE(carry_out) = *cout;
+            OUTPUT_STRENGTH(carry_out) = STRONG;
+        }
+    }
+
+    else {      /****** Transient Analysis ******/
+
+        if ( cm_bus_equal(sum, sum_old) ) {
+            OUTPUT_CHANGED(sum) = FALSE;
+        }
+        else {
+            *(Bus_t *) OUTPUT(sum) = *sum;
+            OUTPUT_DELAY(sum) = PARAM(delay);
+        }
+
+        if ( !PORT_NULL(carry_out) ) {
+            if ( *cout == *cout_old ) {
+                OUTPUT_CHANGED(carry_out) = FALSE;
+            }
+            else {
+                OUTPUT_STATE(carry_out) = *cout;
+                OUTPUT_STRENGTH(carry_out) = STRONG;
+                OUTPUT_DELAY(carry_out) = PARAM(delay);
+            }
+        }
+    }
+}
@@ -0,0 +1,858 @@
+/* $Id: cfunc.tpl,v 1.1 91/03/18 19:01:04 bill Exp $ */
+/*.......1.........2.........3.........4.........5.........6.........7.........8
+================================================================================
+
+FILE bus_mem/cfunc.mod
+
+Copyright 1991
+Georgia Tech Research Corporation, Atlanta, Ga. 30332
+All Rights Reserved
+
+PROJECT A-8503-405
+
+
+AUTHORS
+
+    <date> <person name>
+
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+
+SUMMARY
+
+    This file contains the functional description of the bus_mem
+    code model, a RAM or ROM of up to 2^32 words of up to 64 bits,
+    with its address and data on 'bus' nodes.
+
+    The memory is not part of the event state, which is copied at
+    every event.  It is kept in pages of MEM_PAGE_WORDS words in a
+    cm_static_alloc() block, and a page is only allocated when a word
+    on it is first written, so a large memory costs only as much as
+    the part of it that is used.  Pages are found through a hash
+    table, with the last page used checked first.  Each write is
+    recorded with cm_event_journal() so that EVTbackup() can undo it
+    when the analog solution backs up past it.
+
+    The memory may be loaded at the start of each analysis from an
+    image file:
+
+        hex   Text, as for the Verilog $readmemh.  Each word is given
+              in hex, with x, z or ? for four unknown bits, at the next
+              address.  @<hex address> sets the address.  Text from
+              '*', '#' or '//' to the end of the line is ignored.
+
+        bin   Binary, starting at address 0, each word in the fewest
+              bytes that hold it, least significant byte first.
+
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_fill()
+                         void cm_bus_copy()
+                         unsigned long cm_bus_mask()
+                         Boolean_t cm_bus_known()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+                         int cm_event_journal()
+
+    CM.c                 void *cm_static_alloc()
+                         void *cm_static_get_ptr()
+                         int cm_static_cleanup()
+
+
+REFERENCED FILES
+
+    Inputs from and outputs to ARGS structure.
+
+    The image file, if the image parameter is given.
+
+
+NON-STANDARD FEATURES
+
+    NONE
+
+===============================================================================*/
+
+/*=== INCLUDE FILES ====================*/
+
+#include <stdio.h>
+#include <ctype.h>
+#include <string.h>
+
+
+
+/*=== CONSTANTS ========================*/
+
+#define MEM_PAGE_BITS   8
+#define MEM_PAGE_WORDS  (1 << MEM_PAGE_BITS)
+
+#define MEM_BUCKETS     64      /* initial hash table size */
+
+#define MAX_HEX_DIGITS  ((BUS_MAX_WIDTH + 3) / 4)
+
+
+
+/*=== MACROS ===========================*/
+
+/* The value and unknown planes of a word on a page */
+
+#define MEM_VALUE(page,i)    ((page)->word[i][0])
+#define MEM_UNKNOWN(page,i)  ((page)->word[i][1])
+
+#define MEM_HASH(mem,number) ((int) ((number) & ((mem)->num_buckets - 1)))
+
+
+
+/*=== LOCAL VARIABLES & TYPEDEFS =======*/
+
+typedef struct Mem_Page_s {
+    struct Mem_Page_s *next;     /* next page in the same hash bucket     */
+    unsigned long     number;    /* address of first word / MEM_PAGE_WORDS */
+    Boolean_t         in_use;    /* FALSE if backed up past its allocation */
+    unsigned long     word[MEM_PAGE_WORDS][2][BUS_WORDS];
+} Mem_Page_t;
+
+typedef struct {
+    int             width;       /* bits in a word                        */
+    Digital_State_t fill;        /* state of bits on pages not allocated  */
+    int             num_buckets; /* size of the hash table, a power of 2  */
+    int             num_pages;   /* pages allocated                       */
+    Mem_Page_t      **bucket;    /* the hash table                        */
+    Mem_Page_t      *last;       /* the page used last                    */
+    Boolean_t       loaded;      /* set once the contents are initialized */
+    double          last_time;   /* TIME at the last call                 */
+} Mem_t;
+
+
+
+/*=== FUNCTION PROTOTYPE DEFINITIONS ===*/
+
+static Mem_Page_t *mem_find_page(Mem_t *mem, unsigned long number,
+                                 Boolean_t create);
+static Mem_Page_t *mem_use_page(Mem_t *mem, Mem_Page_t *page);
+static void mem_read(Mem_t *mem, unsigned long address, Bus_t *out);
+static void mem_write(Mem_t *mem, unsigned long address, Bus_t *data);
+static void mem_write_unknown(Mem_t *mem);
+static void mem_clear(Mem_t *mem);
+static void mem_cleanup(void *block);
+static char *mem_load_hex(Mem_t *mem, FILE *fp);
+static char *mem_load_bin(Mem_t *mem, FILE *fp);
+
+
+
+/*==============================================================================
+
+FUNCTION mem_find_page()
+
+SUMMARY
+
+    Finds the page holding a word, and if asked, allocates it if
+    there is none.  A new page is filled with the state of words that
+    have never been written.  The hash table is doubled when the
+    average chain would be longer than two pages.  Pages never move,
+    so the locations given to cm_event_journal() stay good.
+
+    The allocation is journaled through the page's in_use flag, so
+    a page allocated after the time the analog solution backs up to
+    goes back to reading as the fill state, whatever that is after
+    the backup.  Such a page is kept, and filled again if it is used.
+
+RETURNED VALUE
+
+    The page, or NULL if there is none and create is FALSE.
+
+==============================================================================*/
+
+static Mem_Page_t *mem_find_page(
+    Mem_t *mem,                 /* the memory                     */
+    unsigned long number,       /* address / MEM_PAGE_WORDS       */
+    Boolean_t create)           /* allocate the page if not found */
+{
+    int            i;           /* generic loop counter index     */
+    int            old_size;    /* hash table size before growing */
+
+    Mem_Page_t     *page,       /* the page                       */
+                   *next,       /* next page when rehashing       */
+                   **old;       /* hash table before growing      */
+
+
+    /*** the last page used is most often the one wanted ***/
+    if ( (mem->last != NULL) && (mem->last->number == number) ) {
+        page = mem->last;
+    }
+    else {
+        for (page = mem->bucket[MEM_HASH(mem,number)]; page;
+             page = page->next) {
+            if ( page->number == number ) {
+                mem->last = page;
+                break;
+            }
+        }
+    }
+
+    if ( (page != NULL) && page->in_use ) {
+        return(page);
+    }
+    if ( !create ) {
+        return(NULL);
+    }
+    if ( page != NULL ) {
+        return(mem_use_page(mem, page));
+    }
+
+
+    /*** grow the hash table if it is getting full ***/
+    if ( mem->num_pages >= 2 * mem->num_buckets ) {
+        old = mem->bucket;
+        old_size = mem->num_buckets;
+        mem->num_buckets *= 2;
+        mem->bucket = (Mem_Page_t **) calloc(mem->num_buckets,
+                                             sizeof(Mem_Page_t *));
+        for (i=0; i<old_size; i++) {
+            for (page = old[i]; page; page = next) {
+                next = page->next;
+                page->next = mem->bucket[MEM_HASH(mem,page->number)];
+                mem->bucket[MEM_HASH(mem,page->number)] = page;
+            }
+        }
+        free(old);
+    }
+
+
+    /*** add a page ***/
+    page = (Mem_Page_t *) malloc(sizeof(Mem_Page_t));
+    page->number = number;
+    page->in_use = FALSE;
+    page->next = mem->bucket[MEM_HASH(mem,number)];
+    mem->bucket[MEM_HASH(mem,number)] = page;
+    mem->num_pages++;
+    mem->last = page;
+
+    return(mem_use_page(mem, page));
+}
+
+
+
+/*==============================================================================
+
+FUNCTION mem_use_page()
+
+SUMMARY
+
+    Puts a page that is not in use into use, filled with the state of
+    words that have never been written.  The change to in_use is
+    journaled, so that a backup past it takes the page out of use.
+
+RETURNED VALUE
+
+    The page.
+
+==============================================================================*/
+
+static Mem_Page_t *mem_use_page(
+    Mem_t *mem,                 /* the memory          */
+    Mem_Page_t *page)           /* the page not in use */
+{
+    int            i;           /* generic loop counter index */
+    int            j;           /* generic loop counter index */
+
+
+    cm_event_journal(&(page->in_use), sizeof(page->in_use));
+    page->in_use = TRUE;
+
+    for (i=0; i<MEM_PAGE_WORDS; i++) {
+        for (j=0; j<BUS_WORDS; j++) {
+            MEM_VALUE(page,i)[j] = (ONE == mem->fill) ?
+                                   cm_bus_mask(mem->width,j) : 0;
+            MEM_UNKNOWN(page,i)[j] = (UNKNOWN == mem->fill) ?
+                                     cm_bus_mask(mem->width,j) : 0;
+        }
+    }
+
+    return(page);
+}
+
+
+
+/*==============================================================================
+
+FUNCTION mem_read()
+
+SUMMARY
+
+    Reads a word into a bus value with STRONG strength.
+
+RETURNED VALUE
+
+    The word is returned in *out.
+
+==============================================================================*/
+
+static void mem_read(
+    Mem_t *mem,                 /* the memory        */
+    unsigned long address,      /* the word to read  */
+    Bus_t *out)                 /* the value read    */
+{
+    int            j;           /* generic loop counter index */
+
+    Mem_Page_t     *page;       /* the page holding the word  */
+
+
+    page = mem_find_page(mem, address >> MEM_PAGE_BITS, FALSE);
+    if ( page == NULL ) {
+        cm_bus_fill(out, mem->width, mem->fill, STRONG);
+        return;
+    }
+
+    cm_bus_fill(out, mem->width, ZERO, STRONG);
+    address &= MEM_PAGE_WORDS - 1;
+    for (j=0; j<BUS_WORDS; j++) {
+        out->value[j] = MEM_VALUE(page,address)[j];
+        out->unknown[j] = MEM_UNKNOWN(page,address)[j];
+    }
+}
+
+
+
+/*==============================================================================
+
+FUNCTION mem_write()
+
+SUMMARY
+
+    Writes a bus value to a word, journaling the old contents so that
+    a backup of the analog solution undoes it.
+
+RETURNED VALUE
+
+    NONE
+
+==============================================================================*/
+
+static void mem_write(
+    Mem_t *mem,                 /* the memory         */
+    unsigned long address,      /* the word to write  */
+    Bus_t *data)                /* the value to write */
+{
+    int            j;           /* generic loop counter index */
+
+    Mem_Page_t     *page;       /* the page holding the word  */
+
+    Bus_t          word;        /* data at the word width     */
+
+
+    cm_bus_copy(&word, data, mem->width, STRONG);
+
+    page = mem_find_page(mem, address >> MEM_PAGE_BITS, TRUE);
+    address &= MEM_PAGE_WORDS - 1;
+
+    cm_event_journal(page->word[address], sizeof(page->word[address]));
+    for (j=0; j<BUS_WORDS; j++) {
+        MEM_VALUE(page,address)[j] = word.value[j];
+        MEM_UNKNOWN(page,address)[j] = word.unknown[j];
+    }
+}
+
+
+
+/*==============================================================================
+
+FUNCTION mem_write_unknown()
+
+SUMMARY
+
+    Makes every word of the memory unknown, as for a write to an
+    unknown address.  The pages in use and the state of the others
+    are both journaled.
+
+RETURNED VALUE
+
+    NONE
+
+==============================================================================*/
+
+static void mem_write_unknown(
+    Mem_t *mem)                 /* the memory */
+{
+    int            i;           /* generic loop counter index */
+    int            j;           /* generic loop counter index */
+    int            k;           /* generic loop counter index */
+
+    Mem_Page_t     *page;       /* a page of the memory       */
+
+
+    cm_event_journal(&(mem->fill), sizeof(mem->fill));
+    mem->fill = UNKNOWN;
+
+    for (i=0; i<mem->num_buckets; i++) {
+        for (page = mem->bucket[i]; page; page = page->next) {
+            if ( !page->in_use ) {
+                continue;
+            }
+            cm_event_journal(page->word, sizeof(page->word));
+            for (j=0; j<MEM_PAGE_WORDS; j++) {
+                for (k=0; k<BUS_WORDS; k++) {
+                    MEM_VALUE(page,j)[k] = 0;
+                    MEM_UNKNOWN(page,j)[k] = cm_bus_mask(mem->width,k);
+                }
+            }
+        }
+    }
+}
+
+
+
+/*==============================================================================
+
+FUNCTION mem_clear()
+
+SUMMARY
+
+    Frees all pages of the memory, leaving every word in the fill
+    state.
+
+RETURNED VALUE
+
+    NONE
+
+==============================================================================*/
+
+static void mem_clear(
+    Mem_t *mem)                 /* the memory */
+{
+    int            i;           /* generic loop counter index */
+
+    Mem_Page_t     *page,       /* a page of the memory       */
+                   *next;       /* the next page in a bucket  */
+
+
+    for (i=0; i<mem->num_buckets; i++) {
+        for (page = mem->bucket[i]; page; page = next) {
+            next = page->next;
+            free(page);
+        }
+        mem->bucket[i] = NULL;
+    }
+    mem->num_pages = 0;
+    mem->last = NULL;
+}
+
+
+
+/*==============================================================================
+
+FUNCTION mem_cleanup()
+
+SUMMARY
+
+    Called through cm_static_cleanup() when the instance is deleted,
+    to free the pages and hash table of its memory.
+
+RETURNED VALUE
+
+    NONE
+
+==============================================================================*/
+
+static void mem_cleanup(
+    void *block)                /* the Mem_t static block */
+{
+    Mem_t          *mem = (Mem_t *) block;
+
+    if ( mem->bucket != NULL ) {
+        mem_clear(mem);
+        free(mem->bucket);
+        mem->bucket = NULL;
+    }
+}
+
+
+
+/*==============================================================================
+
+FUNCTION mem_load_hex()
+
+SUMMARY
+
+    Loads the memory from a hex image file.
+
+RETURNED VALUE
+
+    NULL, or a message describing what is wrong with the file.
+
+==============================================================================*/
+
+static char *mem_load_hex(
+    Mem_t *mem,                 /* the memory        */
+    FILE *fp)                   /* the open file     */
+{
+    int            c;           /* character read              */
+    int            i;           /* generic loop counter index  */
+    int            n;           /* number of digits in a word  */
+    int            digit;       /* value of a hex digit        */
+    int            bit;         /* bit of the word             */
+
+    unsigned long  address;     /* address of the next word    */
+
+    char           digits[MAX_HEX_DIGITS];  /* digits of a word, */
+                                            /* least significant first */
+    char           text[MAX_HEX_DIGITS];    /* as read               */
+
+    Bus_t          word;        /* the word read               */
+
+    Boolean_t      is_address;  /* the token began with @      */
+
+
+    address = 0;
+    c = getc(fp);
+
+    while ( c != EOF ) {
+
+        /*** skip white space and comments ***/
+        if ( isspace(c) ) {
+            c = getc(fp);
+            continue;
+        }
+        if ( '/' == c ) {
+            if ( (c = getc(fp)) != '/' ) {
+                return("ERROR - bus_mem: bad character in hex image file");
+            }
+        }
+        if ( ('*' == c) || ('#' == c) || ('/' == c) ) {
+            while ( (c != '\n') && (c != EOF) ) {
+                c = getc(fp);
+            }
+            continue;
+        }
+
+        /*** collect a word or address, keeping its last digits ***/
+        is_address = ('@' == c);
+        if ( is_address ) {
+            c = getc(fp);
+        }
+        n = 0;
+        while ( (c != EOF) && !isspace(c) ) {
+            if ( '_' != c ) {
+                if ( !isxdigit(c) && (strchr("xXzZ?", c) == NULL) ) {
+                    return("ERROR - bus_mem: bad character in hex image file");
+                }
+                if ( n == MAX_HEX_DIGITS ) {
+                    memmove(text, text + 1, MAX_HEX_DIGITS - 1);
+                    n--;
+                }
+                text[n++] = c;
+            }
+            c = getc(fp);
+        }
+        if ( n == 0 ) {
+            return("ERROR - bus_mem: bad address in hex image file");
+        }
+        for (i=0; i<n; i++) {
+            digits[i] = text[n - 1 - i];
+        }
+
+        if ( is_address ) {
+            address = 0;
+            for (i=n-1; i>=0; i--) {
+                if ( !isxdigit(digits[i]) ) {
+                    return("ERROR - bus_mem: bad address in hex image file");
+                }
+                digit = isdigit(digits[i]) ? digits[i] - '0' :
+                                             tolower(digits[i]) - 'a' + 10;
+                address = (address << 4) | digit;
+            }
+            continue;
+        }
+
+        /*** set the bits a digit at a time ***/
+        cm_bus_fill(&word, BUS_MAX_WIDTH, ZERO, STRONG);
+        for (i=0; i<n; i++) {
+            if ( isxdigit(digits[i]) ) {
+                digit = isdigit(digits[i]) ? digits[i] - '0' :
+                                             tolower(digits[i]) - 'a' + 10;
+            }
+            else {
+                digit = -1;
+            }
+            for (bit=4*i; (bit<4*i+4) && (bit<BUS_MAX_WIDTH); bit++) {
+                if ( digit < 0 ) {
+                    word.unknown[BUS_WORD(bit)] |= BUS_BIT(bit);
+                }
+                else if ( digit & (1 << (bit - 4 * i)) ) {
+                    word.value[BUS_WORD(bit)] |= BUS_BIT(bit);
+                }
+            }
+        }
+        mem_write(mem, address, &word);
+        address++;
+    }
+
+    return(NULL);
+}
+
+
+
+/*==============================================================================
+
+FUNCTION mem_load_bin()
+
+SUMMARY
+
+    Loads the memory from a binary image file.
+
+RETURNED VALUE
+
+    NULL, or a message describing what is wrong with the file.
+
+==============================================================================*/
+
+static char *mem_load_bin(
+    Mem_t *mem,                 /* the memory        */
+    FILE *fp)                   /* the open file     */
+{
+    int            c;           /* byte read                   */
+    int            i;           /* generic loop counter index  */
+    int            bit;         /* bit of the word             */
+    int            bytes;       /* bytes in a word             */
+
+    unsigned long  address;     /* address of the next word    */
+
+    Bus_t          word;        /* the word read               */
+
+
+    bytes = (mem->width + 7) / 8;
+
+    for (address = 0; ; address++) {
+
+        cm_bus_fill(&word, BUS_MAX_WIDTH, ZERO, STRONG);
+        for (i=0; i<bytes; i++) {
+            if ( (c = getc(fp)) == EOF ) {
+                if ( i == 0 ) {
+                    return(NULL);
+                }
+                return("ERROR - bus_mem: binary image file ends in a word");
+            }
+            for (bit=8*i; bit<8*i+8; bit++) {
+                if ( c & (1 << (bit - 8 * i)) ) {
+                    word.value[BUS_WORD(bit)] |= BUS_BIT(bit);
+                }
+            }
+        }
+        mem_write(mem, address, &word);
+    }
+}
+
+
+
+/*==============================================================================
+
+FUNCTION cm_bus_mem()
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    This function implements the bus_mem code model.
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_fill()
+                         Boolean_t cm_bus_known()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+    CM.c                 void *cm_static_alloc()
+                         void *cm_static_get_ptr()
+                         int cm_static_cleanup()
+
+RETURNED VALUE
+
+    Returns inputs and outputs via ARGS structure.
+
+GLOBAL VARIABLES
+
+    NONE
+
+NON-STANDARD FEATURES
+
+    NONE
+
+==============================================================================*/
+
+/*=== CM_BUS_MEM ROUTINE ===*/
+
+void cm_bus_mem(ARGS)
+
+{
+    unsigned long   location;   /* word addressed                */
+
+    char               *msg;    /* error loading the image       */
+
+    FILE                *fp;    /* the image file                */
+
+    Mem_t              *mem;    /* the memory                    */
+
+    Bus_t          *address,    /* address input                 */
+                       *out,    /* current output                */
+                   *out_old;    /* previous output               */
+
+    Digital_State_t  select,    /* chip select                   */
+                   write_en;    /* write enable                  */
+
+
+
+    /*** Setup required state variables ***/
+
+    if(INIT) {  /* initial pass */
+
+        /* allocate storage; the memory itself is not event state */
+        out = out_old = (Bus_t *) cm_event_alloc(0,sizeof(Bus_t));
+
+        mem = (Mem_t *) cm_static_alloc(0,sizeof(Mem_t));
+        cm_static_cleanup(0,mem_cleanup);
+        mem->width = PARAM(width);
+        mem->fill = PARAM(ic);
+        mem->num_buckets = MEM_BUCKETS;
+        mem->num_pages = 0;
+        mem->bucket = (Mem_Page_t **) calloc(MEM_BUCKETS,
+                                             sizeof(Mem_Page_t *));
+        mem->last = NULL;
+        mem->loaded = FALSE;
+        mem->last_time = 0.0;
+
+        /* declare load values */
+        if ( !PORT_NULL(data_in) ) {
+            LOAD(data_in) = PARAM(data_load);
+        }
+        LOAD(address) = PARAM(address_load);
+        if ( !PORT_NULL(write_en) ) {
+            LOAD(write_en) = PARAM(enable_load);
+        }
+        if ( !PORT_NULL(select) ) {
+            LOAD(select) = PARAM(select_load);
+        }
+    }
+    else {      /* Retrieve previous values */
+
+        out = (Bus_t *) cm_event_get_ptr(0,0);
+        out_old = (Bus_t *) cm_event_get_ptr(0,1);
+        mem = (Mem_t *) cm_static_get_ptr(0);
+    }
+
+
+    /**** retrieve inputs; always selected if select is not connected, ****/
+    /**** never written if write_en or data_in is not connected or it   ****/
+    /**** is a ROM                                                      ****/
+
+    address = (Bus_t *) INPUT(address);
+    if ( PORT_NULL(write_en) || PORT_NULL(data_in) || PARAM(rom) ) {
+        write_en = ZERO;
+    }
+    else {
+        write_en = INPUT_STATE(write_en);
+    }
+    if ( PORT_NULL(select) ) {
+        select = ONE;
+    }
+    else {
+        select = INPUT_STATE(select);
+    }
+
+    location = address->value[0];
+    if ( PARAM(address_width) < BUS_WORD_BITS ) {
+        location &= (1UL << PARAM(address_width)) - 1;
+    }
+
+
+
+    /******* Determine analysis type and output appropriate values *******/
+
+    if (0.0 == TIME) {   /****** DC analysis...output w/o delays ******/
+
+        /** set the initial contents once at the start of each analysis **/
+        if ( !mem->loaded || (mem->last_time > 0.0) ) {
+
+            mem_clear(mem);
+            mem->fill = PARAM(ic);
+            mem->loaded = TRUE;
+
+            if ( !PARAM_NULL(image) && (PARAM(image)[0] != '\0') ) {
+                if ( (fp = fopen(PARAM(image), "r")) == NULL ) {
+                    cm_message_send("ERROR - bus_mem: can't open image file");
+                }
+                else {
+                    if ( strcmp(PARAM(image_format), "bin") == 0 ) {
+                        msg = mem_load_bin(mem, fp);
+                    }
+                    else if ( strcmp(PARAM(image_format), "hex") == 0 ) {
+                        msg = mem_load_hex(mem, fp);
+                    }
+                    else {
+                        msg = "ERROR - bus_mem: image_format must be hex or bin";
+                    }
+                    if ( msg != NULL ) {
+                        cm_message_send(msg);
+                    }
+                    fclose(fp);
+                }
+            }
+        }
+    }
+    else if ( (ONE == select) && (ONE == write_en) ) {
+
+        /** store the word, or if the address is unknown, **/
+        /** the entire memory goes unknown                 **/
+        if ( cm_bus_known(address) ) {
+            mem_write(mem, location, (Bus_t *) INPUT(data_in));
+        }
+        else {
+            mem_write_unknown(mem);
+        }
+    }
+    mem->last_time = TIME;
+
+
+    /** output the addressed word when selected and reading, **/
+    /** otherwise high impedance                             **/
+
+    if ( (ONE == select) && (ONE != write_en) ) {
+        if ( cm_bus_known(address) ) {
+            mem_read(mem, location, out);
+        }
+        else {
+            cm_bus_fill(out, mem->width, UNKNOWN, STRONG);
+        }
+    }
+    else {
+        cm_bus_fill(out, mem->width, UNKNOWN, HI_IMPEDANCE);
+    }
+
+    if (0.0 == TIME) {
+        *out_old = *out;
+        *(Bus_t *) OUTPUT(data_out) = *out;
+    }
+    else if ( cm_bus_equal(out, out_old) ) {
+        OUTPUT_CHANGED(data_out) = FALSE;
+    }
+    else {
+        *(Bus_t *) OUTPUT(data_out) = *out;
+        OUTPUT_DELAY(data_out) = PARAM(read_delay);
+    }
+}
@@ -0,0 +1,206 @@
+/* $Id: cfunc.tpl,v 1.1 91/03/18 19:01:04 bill Exp $ */
+/*.......1.........2.........3.........4.........5.........6.........7.........8
+================================================================================
+
+FILE bus_mux/cfunc.mod
+
+Copyright 1991
+Georgia Tech Research Corporation, Atlanta, Ga. 30332
+All Rights Reserved
+
+PROJECT A-8503-405
+
+
+AUTHORS
+
+    <date> <person name>
+
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+
+SUMMARY
+
+    This file contains the functional description of the bus_mux
+    code model, which passes one of a number of buses to its output,
+    chosen by the value on a select bus.
+
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_fill()
+                         void cm_bus_copy()
+                         void cm_bus_merge()
+                         Boolean_t cm_bus_known()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+
+REFERENCED FILES
+
+    Inputs from and outputs to ARGS structure.
+
+
+NON-STANDARD FEATURES
+
+    NONE
+
+===============================================================================*/
+
+/*=== INCLUDE FILES ====================*/
+
+
+
+/*=== CONSTANTS ========================*/
+
+
+
+/*=== MACROS ===========================*/
+
+
+
+/*=== LOCAL VARIABLES & TYPEDEFS =======*/
+
+
+
+/*=== FUNCTION PROTOTYPE DEFINITIONS ===*/
+
+
+
+/*==============================================================================
+
+FUNCTION cm_bus_mux()
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    This function implements the bus_mux code model.
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_fill()
+                         void cm_bus_copy()
+                         void cm_bus_merge()
+                         Boolean_t cm_bus_known()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+RETURNED VALUE
+
+    Returns inputs and outputs via ARGS structure.
+
+GLOBAL VARIABLES
+
+    NONE
+
+NON-STANDARD FEATURES
+
+    NONE
+
+==============================================================================*/
+
+/*=== CM_BUS_MUX ROUTINE ===*/
+
+void cm_bus_mux(ARGS)
+
+{
+    int                    i;   /* generic loop counter index */
+    int              in_size;   /* number of input buses      */
+
+    unsigned long     select;   /* value of the select bus    */
+
+    Bus_t               *sel,   /* select input               */
+                        *out,   /* current output             */
+                    *out_old;   /* previous output            */
+
+
+
+    in_size = PORT_SIZE(in);
+
+    /*** Setup required state variables ***/
+
+    if(INIT) {  /* initial pass */
+
+        /* allocate storage */
+        out = out_old = (Bus_t *) cm_event_alloc(0,sizeof(Bus_t));
+
+        /* declare load values */
+        for (i=0; i<in_size; i++) {
+            LOAD(in[i]) = PARAM(input_load);
+        }
+        LOAD(sel) = PARAM(sel_load);
+    }
+    else {      /* Retrieve previous values */
+
+        out = (Bus_t *) cm_event_get_ptr(0,0);
+        out_old = (Bus_t *) cm_event_get_ptr(0,1);
+    }
+
+
+    /*** choose the output a whole bus at a time ***/
+
+    sel = (Bus_t *) INPUT(sel);
+
+    if ( cm_bus_known(sel) ) {
+        select = sel->value[0];
+        for (i=1; i<BUS_WORDS; i++) {
+            if ( sel->value[i] ) {
+                select = in_size;
+            }
+        }
+        if ( select < in_size ) {
+            cm_bus_copy(out, (Bus_t *) INPUT(in[select]),
+                        ((Bus_t *) INPUT(in[select]))->width, STRONG);
+        }
+        else {
+            cm_bus_fill(out, ((Bus_t *) INPUT(in[0]))->width,
+                        UNKNOWN, STRONG);
+        }
+    }
+    else {
+        /* only bits that are the same on every input are known */
+        cm_bus_copy(out, (Bus_t *) INPUT(in[0]),
+                    ((Bus_t *) INPUT(in[0]))->width, STRONG);
+        for (i=1; i<in_size; i++) {
+            cm_bus_merge(out, (Bus_t *) INPUT(in[i]));
+        }
+    }
+
+
+
+    /******* Determine analysis type and output appropriate values *******/
+
+    if (0.0 == TIME) {   /****** Initial conditions...output w/o delays ******/
+
+        *out_old = *out;
+        *(Bus_t *) OUTPUT(out) = *out;
+    }
+
+    else {      /****** Transient Analysis ******/
+
+        if ( cm_bus_equal(out, out_old) ) {
+            OUTPUT_CHANGED(out) = FALSE;
+        }
+        else {
+            *(Bus_t *) OUTPUT(out) = *out;
+            OUTPUT_DELAY(out) = PARAM(delay);
+        }
+    }
+}
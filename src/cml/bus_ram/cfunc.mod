@@ -0,0 +1,261 @@
+/* $Id: cfunc.tpl,v 1.1 91/03/18 19:01:04 bill Exp $ */
+/*.......1.........2.........3.........4.........5.........6.........7.........8
+================================================================================
+
+FILE bus_ram/cfunc.mod
+
+Copyright 1991
+Georgia Tech Research Corporation, Atlanta, Ga. 30332
+All Rights Reserved
+
+PROJECT A-8503-405
+
+
+AUTHORS
+
+    <date> <person name>
+
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+
+SUMMARY
+
+    This file contains the functional description of the bus_ram
+    code model, a memory of words of up to 64 bits with its data and
+    address on 'bus' nodes.  It behaves as d_ram does, but a word is
+    read or written with a few machine word operations rather than a
+    bit at a time, and a read is a single output event.
+
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_fill()
+                         void cm_bus_copy()
+                         unsigned long cm_bus_mask()
+                         Boolean_t cm_bus_known()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+
+REFERENCED FILES
+
+    Inputs from and outputs to ARGS structure.
+
+
+NON-STANDARD FEATURES
+
+    NONE
+
+===============================================================================*/
+
+/*=== INCLUDE FILES ====================*/
+
+
+
+/*=== CONSTANTS ========================*/
+
+
+
+/*=== MACROS ===========================*/
+
+/* Each location holds the value and unknown planes of one word */
+
+#define RAM_VALUE(ram,loc)    ((ram) + (loc) * 2 * BUS_WORDS)
+#define RAM_UNKNOWN(ram,loc)  ((ram) + (loc) * 2 * BUS_WORDS + BUS_WORDS)
+
+
+/*=== LOCAL VARIABLES & TYPEDEFS =======*/
+
+
+
+/*=== FUNCTION PROTOTYPE DEFINITIONS ===*/
+
+
+
+/*==============================================================================
+
+FUNCTION cm_bus_ram()
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    This function implements the bus_ram code model.
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_fill()
+                         void cm_bus_copy()
+                         unsigned long cm_bus_mask()
+                         Boolean_t cm_bus_known()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+RETURNED VALUE
+
+    Returns inputs and outputs via ARGS structure.
+
+GLOBAL VARIABLES
+
+    NONE
+
+NON-STANDARD FEATURES
+
+    NONE
+
+==============================================================================*/
+
+/*=== CM_BUS_RAM ROUTINE ===*/
+
+void cm_bus_ram(ARGS)
+
+{
+    int                    i,   /* generic loop counter index    */
+                           j,   /* generic loop counter index    */
+                       width,   /* bits in a word                */
+                       depth,   /* number of locations           */
+                    location;   /* location addressed            */
+
+    unsigned long       *ram;   /* the memory                    */
+
+    Bus_t           *address,   /* address input                 */
+                    *data_in,   /* data input                    */
+                        data,   /* data input at the word width  */
+                        *out,   /* current output                */
+                    *out_old;   /* previous output               */
+
+    Digital_State_t   select,   /* chip select                   */
+                    write_en;   /* write enable                  */
+
+
+
+    width = PARAM(width);
+    depth = 1 << PARAM(address_width);
+
+    /*** Setup required state variables ***/
+
+    if(INIT) {  /* initial pass */
+
+        /* allocate storage */
+        out = out_old = (Bus_t *) cm_event_alloc(0,sizeof(Bus_t));
+
+        /* allocate storage for ram memory */
+        ram = (unsigned long *) cm_event_alloc(1,depth * 2 * BUS_WORDS *
+                                               sizeof(unsigned long));
+
+        /* declare load values */
+        LOAD(data_in) = PARAM(data_load);
+        LOAD(address) = PARAM(address_load);
+        LOAD(write_en) = PARAM(enable_load);
+        if ( !PORT_NULL(select) ) {
+            LOAD(select) = PARAM(select_load);
+        }
+    }
+    else {      /* Retrieve previous values */
+
+        out = (Bus_t *) cm_event_get_ptr(0,0);
+        out_old = (Bus_t *) cm_event_get_ptr(0,1);
+        ram = (unsigned long *) cm_event_get_ptr(1,0);
+    }
+
+
+    /**** retrieve inputs; always selected if select is not connected ****/
+
+    address = (Bus_t *) INPUT(address);
+    data_in = (Bus_t *) INPUT(data_in);
+    write_en = INPUT_STATE(write_en);
+    if ( PORT_NULL(select) ) {
+        select = ONE;
+    }
+    else {
+        select = INPUT_STATE(select);
+    }
+
+    location = address->value[0] & (depth - 1);
+
+
+
+    /******* Determine analysis type and output appropriate values *******/
+
+    if (0.0 == TIME) {   /****** DC analysis...output w/o delays ******/
+
+        /** initialize ram to ic value **/
+        for (i=0; i<depth; i++) {
+            for (j=0; j<BUS_WORDS; j++) {
+                RAM_VALUE(ram,i)[j] = (1 == PARAM(ic)) ?
+                                      cm_bus_mask(width,j) : 0;
+                RAM_UNKNOWN(ram,i)[j] = (2 == PARAM(ic)) ?
+                                        cm_bus_mask(width,j) : 0;
+            }
+        }
+    }
+    else if ( (ONE == select) && (ONE == write_en) ) {
+
+        /** store the word, or if the address is unknown, **/
+        /** the entire ram goes unknown                    **/
+        if ( cm_bus_known(address) ) {
+            cm_bus_copy(&data, data_in, width, STRONG);
+            for (j=0; j<BUS_WORDS; j++) {
+                RAM_VALUE(ram,location)[j] = data.value[j];
+                RAM_UNKNOWN(ram,location)[j] = data.unknown[j];
+            }
+        }
+        else {
+            for (i=0; i<depth; i++) {
+                for (j=0; j<BUS_WORDS; j++) {
+                    RAM_VALUE(ram,i)[j] = 0;
+                    RAM_UNKNOWN(ram,i)[j] = cm_bus_mask(width,j);
+                }
+            }
+        }
+    }
+
+
+    /** output the addressed word when selected and reading, **/
+    /** otherwise high impedance                             **/
+
+    if ( (ONE == select) && (ONE != write_en) ) {
+        cm_bus_fill(out, width, ZERO, STRONG);
+        if ( cm_bus_known(address) ) {
+            for (j=0; j<BUS_WORDS; j++) {
+                out->value[j] = RAM_VALUE(ram,location)[j];
+                out->unknown[j] = RAM_UNKNOWN(ram,location)[j];
+            }
+        }
+        else {
+            cm_bus_fill(out, width, UNKNOWN, STRONG);
+        }
+    }
+    else {
+        cm_bus_fill(out, width, UNKNOWN, HI_IMPEDANCE);
+    }
+
+    if (0.0 == TIME) {
+        *out_old = *out;
+        *(Bus_t *) OUTPUT(data_out) = *out;
+    }
+    else if ( cm_bus_equal(out, out_old) ) {
+        OUTPUT_CHANGED(data_out) = FALSE;
+    }
+    else {
+        *(Bus_t *) OUTPUT(data_out) = *out;
+        OUTPUT_DELAY(data_out) = PARAM(read_delay);
+    }
+}
@@ -0,0 +1,242 @@
+/* $Id: cfunc.tpl,v 1.1 91/03/18 19:01:04 bill Exp $ */
+/*.......1.........2.........3.........4.........5.........6.........7.........8
+================================================================================
+
+FILE bus_reg/cfunc.mod
+
+Copyright 1991
+Georgia Tech Research Corporation, Atlanta, Ga. 30332
+All Rights Reserved
+
+PROJECT A-8503-405
+
+
+AUTHORS
+
+    <date> <person name>
+
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+
+SUMMARY
+
+    This file contains the functional description of the bus_reg
+    code model, a register of up to 64 bits on 'bus' nodes.  The
+    whole word is latched on the rising edge of the clock and sent
+    out as a single event.
+
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_set()
+                         void cm_bus_fill()
+                         void cm_bus_copy()
+                         void cm_bus_merge()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+
+REFERENCED FILES
+
+    Inputs from and outputs to ARGS structure.
+
+
+NON-STANDARD FEATURES
+
+    NONE
+
+===============================================================================*/
+
+/*=== INCLUDE FILES ====================*/
+
+#include <string.h>
+
+
+/*=== CONSTANTS ========================*/
+
+
+
+/*=== MACROS ===========================*/
+
+
+
+/*=== LOCAL VARIABLES & TYPEDEFS =======*/
+
+
+
+/*=== FUNCTION PROTOTYPE DEFINITIONS ===*/
+
+
+
+/*==============================================================================
+
+FUNCTION cm_bus_reg()
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    This function implements the bus_reg code model.
+
+INTERFACES
+
+    FILE                 ROUTINE CALLED
+
+    CMutil.c             void cm_bus_set()
+                         void cm_bus_fill()
+                         void cm_bus_copy()
+                         void cm_bus_merge()
+                         Boolean_t cm_bus_equal()
+
+    CMevt.c              void *cm_event_alloc()
+                         void *cm_event_get_ptr()
+
+RETURNED VALUE
+
+    Returns inputs and outputs via ARGS structure.
+
+GLOBAL VARIABLES
+
+    NONE
+
+NON-STANDARD FEATURES
+
+    NONE
+
+==============================================================================*/
+
+/*=== CM_BUS_REG ROUTINE ===*/
+
+void cm_bus_reg(ARGS)
+
+{
+    int                 width;  /* bits in the register     */
+
+    unsigned long       ic[BUS_WORDS];  /* initial value    */
+
+    Digital_State_t     *clk,   /* current clk value        */
+                    *clk_old,   /* previous clk value       */
+                      *reset,   /* current reset value      */
+                  *reset_old;   /* previous reset value     */
+
+    Bus_t               *out,   /* current register value   */
+                    *out_old,   /* previous register value  */
+                       *data,   /* input data               */
+                        zero;   /* register after a reset   */
+
+
+
+    width = PARAM(width);
+
+    /*** Setup required state variables ***/
+
+    if(INIT) {  /* initial pass */
+
+        /* allocate storage */
+        clk = clk_old = (Digital_State_t *) cm_event_alloc(0,sizeof(Digital_State_t));
+        reset = reset_old = (Digital_State_t *) cm_event_alloc(1,sizeof(Digital_State_t));
+        out = out_old = (Bus_t *) cm_event_alloc(2,sizeof(Bus_t));
+
+        /* declare load values */
+        LOAD(data) = PARAM(data_load);
+        LOAD(clk) = PARAM(clk_load);
+        if ( !PORT_NULL(reset) ) {
+            LOAD(reset) = PARAM(reset_load);
+        }
+    }
+    else {      /* Retrieve previous values */
+
+        clk = (Digital_State_t *) cm_event_get_ptr(0,0);
+        clk_old = (Digital_State_t *) cm_event_get_ptr(0,1);
+        reset = (Digital_State_t *) cm_event_get_ptr(1,0);
+        reset_old = (Digital_State_t *) cm_event_get_ptr(1,1);
+        out = (Bus_t *) cm_event_get_ptr(2,0);
+        out_old = (Bus_t *) cm_event_get_ptr(2,1);
+    }
+
+
+    /*** load current input values; reset is inactive if not connected ***/
+
+    *clk = INPUT_STATE(clk);
+    if ( PORT_NULL(reset) ) {
+        *reset = *reset_old = ZERO;
+    }
+    else {
+        *reset = INPUT_STATE(reset);
+    }
+    data = (Bus_t *) INPUT(data);
+
+    cm_bus_fill(&zero, width, ZERO, STRONG);
+
+
+
+    /******* Determine analysis type and output appropriate values *******/
+
+    if (0.0 == TIME) {   /****** Initial conditions...output w/o delays ******/
+
+        memset((char *) ic, 0, sizeof(ic));
+        ic[0] = PARAM(ic);
+        cm_bus_set(out, width, ic, STRONG);
+
+        if ( ONE == *reset ) {
+            *out = zero;
+        }
+        else if ( UNKNOWN == *reset ) {
+            cm_bus_merge(out, &zero);
+        }
+        *out_old = *out;
+
+        *(Bus_t *) OUTPUT(out) = *out;
+    }
+
+    else {      /****** Transient Analysis ******/
+
+        *out = *out_old;
+
+        /*** a reset overrides the clock; an unknown reset ***/
+        /*** leaves unknown any bit that is not already 0  ***/
+        if ( ONE == *reset ) {
+            *out = zero;
+        }
+        else if ( UNKNOWN == *reset ) {
+            cm_bus_merge(out, &zero);
+        }
+        else if ( *clk != *clk_old ) {
+
+            if ( (ZERO == *clk_old) && (ONE == *clk) ) {
+                /* rising edge - latch the whole word */
+                cm_bus_copy(out, data, width, STRONG);
+            }
+            else if ( (UNKNOWN == *clk) || (UNKNOWN == *clk_old) ) {
+                /* may or may not have been an edge */
+                cm_bus_merge(out, data);
+            }
+        }
+
+        if ( cm_bus_equal(out, out_old) ) {
+            OUTPUT_CHANGED(out) = FALSE;
+        }
+        else {
+            *(Bus_t *) OUTPUT(out) = *out;
+            if ( *reset != *reset_old ) {
+                OUTPUT_DELAY(out) = PARAM(reset_delay);
+            }
+            else {
+                OUTPUT_DELAY(out) = PARAM(clk_delay);
+            }
+        }
+    }
+}
@@ -35,6 +35,11 @@ INTERFACES
     CMmacros.h           cm_message_send();                   
 
     CMutil.c             void cm_smooth_corner(); 
+                         void cm_table_init()
+                         int  cm_table_find()
+
+    CM.c                 void *cm_static_alloc()
+                         void *cm_static_get_ptr()
 
 
 REFERENCED FILES
@@ -66,6 +71,13 @@ NON-STANDARD FEATURES
   
 /*=== LOCAL VARIABLES & TYPEDEFS =======*/                         
 
+/* pwl mode breakpoints, set up on the first pass */
+typedef struct {
+    double      *H;         /* H-field breakpoints */
+    double      *B;         /* B-field values at the breakpoints */
+    Boolean_t   bad;        /* breakpoints violate the 50% rule */
+    Cm_Table_t  table;      /* lookup of the breakpoint below an H value */
+} Core_Table_t;
 
     
            
@@ -99,6 +111,11 @@ INTERFACES
     CMmacros.h           cm_message_send();                   
 
     CMutil.c             void cm_smooth_corner(); 
+                         void cm_table_init()
+                         int  cm_table_find()
+
+    CM.c                 void *cm_static_alloc()
+                         void *cm_static_get_ptr()
 
 
 RETURNED VALUE
@@ -188,6 +205,7 @@ void cm_core(ARGS)  /* structure holding parms,
 
     int i;               /* generic loop counter index */
     int size;            /* size of the x_array        */
+    int *cells;          /* grid for the breakpoint lookup */
 
     int mode;            /* mode parameter which determines whether
                             pwl or hyst will be used in analysis. */
@@ -211,6 +229,8 @@ void cm_core(ARGS)  /* structure holding parms,
     double area;            /* cross-sectional area of the core (in meters)*/
     double length;          /* length of core (in meters) */
 
+    Core_Table_t *pwl;      /* breakpoints and their lookup */
+
     Mif_Complex_t ac_gain;
                                            
     char *allocation_error="\n***ERROR***\nCORE: Allocation calloc failed!\n";
@@ -270,36 +290,53 @@ void cm_core(ARGS)  /* structure holding parms,
 
         size = PARAM_SIZE(H_array);           
 
-        /* Allocate storage for breakpoint domain & range values */
-        H = (double *) calloc(size, sizeof(double));
-        if (H == '\0') {
-            cm_message_send(allocation_error); 
-            return;
-        }
-        B = (double *) calloc(size, sizeof(double));
-        if (B == '\0') {
-            cm_message_send(allocation_error);  
-            return;
-        }
+        if (INIT==1) {  /* First pass...set up the breakpoints */
 
+            pwl = (Core_Table_t *) cm_static_alloc(0, sizeof(Core_Table_t));
 
-        /* Retrieve H and B values. */       
-        for (i=0; i<size; i++) {
-            *(H+i) = PARAM(H_array[i]);
-            *(B+i) = PARAM(B_array[i]);
-        }                       
+            /* Allocate storage for breakpoint domain & range values */
+            /* and a grid cell per breakpoint for the lookup         */
+            pwl->H = (double *) cm_static_alloc(1, 2 * size * sizeof(double));
+            if (pwl->H == '\0') {
+                cm_message_send(allocation_error); 
+                return;
+            }
+            pwl->B = pwl->H + size;
+            cells = (int *) cm_static_alloc(2, size * sizeof(int));
+
+            /* Retrieve H and B values. */       
+            for (i=0; i<size; i++) {
+                *(pwl->H+i) = PARAM(H_array[i]);
+                *(pwl->B+i) = PARAM(B_array[i]);
+            }                       
+
+            cm_table_init(&(pwl->table), pwl->H, 1, size, cells, size);
     
 
-        /* See if input_domain is absolute...if so, test against   */
-        /* breakpoint segments for violation of 50% rule...        */
-        if (PARAM(fraction) == MIF_FALSE) {
-            for (i=0; i<(size-1); i++) { 
-                if ( (*(H+i+1) - *(H+i)) < (2.0*input_domain) ) {
-                    cm_message_send(limit_error);          
-                    return; 
-                }    
+            /* See if input_domain is absolute...if so, test against   */
+            /* breakpoint segments for violation of 50% rule...        */
+            pwl->bad = FALSE;
+            if (PARAM(fraction) == MIF_FALSE) {
+                for (i=0; i<(size-1); i++) { 
+                    if ( (*(pwl->H+i+1) - *(pwl->H+i)) < (2.0*input_domain) ) {
+                        pwl->bad = TRUE;
+                        break;
+                    }    
+                }
             }
         }
+        else {
+            pwl = (Core_Table_t *) cm_static_get_ptr(0);
+        }
+
+        if ((pwl->H == '\0') || pwl->bad) {
+            if (pwl->bad)
+                cm_message_send(limit_error);          
+            return; 
+        }
+
+        H = pwl->H;
+        B = pwl->B;
 
 
         /* Retrieve mmf_input value. */       
@@ -324,56 +361,51 @@ void cm_core(ARGS)  /* structure holding parms,
                 B_out = *(B+size-1) + (H_input - *(H+size-1)) * dout_din;
             }
             else { /*** H_input within bounds of end midpoints...     ***/
-                   /*** must determine position progressively & then  ***/
+                   /*** find the nearest breakpoint & then            ***/
                    /*** calculate required output.                    ***/
 
-                for (i=1; i<size; i++) {
+                i = cm_table_find(&(pwl->table), H_input);
+                if (H_input >= (*(H+i) + *(H+i+1))/2.0)
+                    i++;
 
-                    if (H_input < (*(H+i) + *(H+i+1))/2.0) { 
-                                       /* approximate position known...          */
-             
-                        lower_seg = (*(H+i) - *(H+i-1));
-                        upper_seg = (*(H+i+1) - *(H+i));
+                lower_seg = (*(H+i) - *(H+i-1));
+                upper_seg = (*(H+i+1) - *(H+i));
 
 
-                        /* Calculate input_domain about this region's breakpoint.*/
+                /* Calculate input_domain about this region's breakpoint.*/
 
-                        if (PARAM(fraction) == MIF_TRUE) {  /* Translate input_domain */
-                                                      /* into an absolute....   */
-                            if ( lower_seg <= upper_seg )          /* Use lower  */
-                                                                   /* segment    */
-                                                                   /* for % calc.*/
-                                input_domain = input_domain * lower_seg;
-                            else                                   /* Use upper  */
-                                                                   /* segment    */
-                                                                   /* for % calc.*/
-                                input_domain = input_domain * upper_seg;
-                        } 
+                if (PARAM(fraction) == MIF_TRUE) {  /* Translate input_domain */
+                                              /* into an absolute....   */
+                    if ( lower_seg <= upper_seg )          /* Use lower  */
+                                                           /* segment    */
+                                                           /* for % calc.*/
+                        input_domain = input_domain * lower_seg;
+                    else                                   /* Use upper  */
+                                                           /* segment    */
+                                                           /* for % calc.*/
+                        input_domain = input_domain * upper_seg;
+                } 
     
-                        /* Set up threshold values about breakpoint... */
-                        threshold_lower = *(H+i) - input_domain;
-                        threshold_upper = *(H+i) + input_domain;
-
-                        /* Determine where H_input is within region & determine     */
-                        /* output and partial values....                            */
-                        if (H_input < threshold_lower) { /* Lower linear region     */
-                            dout_din = (*(B+i) - *(B+i-1))/lower_seg;
-                            B_out = *(B+i) + (H_input - *(H+i)) * dout_din;
-                        }
-                        else {        
-                            if (H_input < threshold_upper) { /* Parabolic region */
-                                lower_slope = (*(B+i) - *(B+i-1))/lower_seg;
-                                upper_slope = (*(B+i+1) - *(B+i))/upper_seg;
-                                cm_smooth_corner(H_input,*(H+i),*(B+i),input_domain,
-                                            lower_slope,upper_slope,&B_out,&dout_din);
-                            }
-                            else {        /* Upper linear region */
-                                dout_din = (*(B+i+1) - *(B+i))/upper_seg;
-                                B_out = *(B+i) + (H_input - *(H+i)) * dout_din;
-                            }
-                        }
-                        break;  /* Break search loop...H_input has been found,   */
-                                /* and B_out and dout_din have been assigned.    */
+                /* Set up threshold values about breakpoint... */
+                threshold_lower = *(H+i) - input_domain;
+                threshold_upper = *(H+i) + input_domain;
+
+                /* Determine where H_input is within region & determine     */
+                /* output and partial values....                            */
+                if (H_input < threshold_lower) { /* Lower linear region     */
+                    dout_din = (*(B+i) - *(B+i-1))/lower_seg;
+                    B_out = *(B+i) + (H_input - *(H+i)) * dout_din;
+                }
+                else {        
+                    if (H_input < threshold_upper) { /* Parabolic region */
+                        lower_slope = (*(B+i) - *(B+i-1))/lower_seg;
+                        upper_slope = (*(B+i+1) - *(B+i))/upper_seg;
+                        cm_smooth_corner(H_input,*(H+i),*(B+i),input_domain,
+                                    lower_slope,upper_slope,&B_out,&dout_din);
+                    }
+                    else {        /* Upper linear region */
+                        dout_din = (*(B+i+1) - *(B+i))/upper_seg;
+                        B_out = *(B+i) + (H_input - *(H+i)) * dout_din;
                     }
                 }
             }
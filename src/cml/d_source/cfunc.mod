@@ -36,6 +36,10 @@ INTERFACES
     CMevt.c              void *cm_event_alloc()
                          void *cm_event_get_ptr()
                          int  cm_event_queue()
+
+    CM.c                 void *cm_static_alloc()
+                         void *cm_static_get_ptr()
+                         int  cm_static_cleanup()
                          
 
 
@@ -65,6 +69,15 @@ NON-STANDARD FEATURES
 
 /*=== MACROS ===========================*/
 
+/* Timepoint and output bit values of vector n, from the mapped
+   vector file if there is one, or from the tables read from text. */
+
+#define SOURCE_TIME(n)  ((map->header) ? DSRC_TIME(map->header,(n)) \
+                                       : timepoints[(n)])
+
+#define SOURCE_VALUE(b,n,p) ((map->header) ? \
+            cm_get_mapped_value(map->header,(b),(n),(p)) : \
+            cm_get_source_value(info->width,(b),(n),bits,(p)))
 
 
   
@@ -81,6 +94,14 @@ typedef struct {
 
 
 
+typedef struct {
+    Dsrc_Header_t *header;  /* the mapped vector file, or NULL when the
+                               vectors were read from a text file    */
+    long          length;   /* number of bytes mapped                 */
+} Source_Map_t;
+
+
+
 
 
 /* Type definition for each possible token returned. */
@@ -957,6 +978,121 @@ static int cm_read_source(FILE *source,short *bits,double *timepoints,
 
 
                                         
+/*==============================================================================
+
+FUNCTION cm_map_source()
+
+AUTHORS                      
+
+    <date> <person name>
+
+MODIFICATIONS   
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    Maps a vector file compiled by srcconv (see DSRCvec.h) into
+    memory, so that vectors are paged in as the simulation reaches
+    them instead of all being read and parsed during INIT.
+
+INTERFACES       
+
+    FILE                 ROUTINE CALLED     
+ 
+    N/A                  N/A
+
+
+RETURNED VALUE
+    
+    Returns 1 if the file was mapped, 0 if it is not a compiled
+    vector file, and -1 if it is one that can't be used.
+
+GLOBAL VARIABLES
+    
+    NONE
+
+NON-STANDARD FEATURES
+
+    Uses mmap().
+
+==============================================================================*/
+
+/*=== Static CM_MAP_SOURCE ROUTINE ===*/
+
+static int cm_map_source(char *filename,int width,Source_Map_t *map)
+{
+    int              fd;    /* file descriptor of the vector file */
+
+    Dsrc_Header_t  head;    /* copy of the file header  */
+
+    struct stat      st;    /* for the file size    */
+
+    void          *addr;    /* address of the mapping   */
+
+
+    map->header = NULL;
+    map->length = 0;
+
+    if ( (fd = open(filename, O_RDONLY)) < 0 ) return 0;
+
+    /* text vector files fall through to cm_read_source() */
+    if ( (read(fd, (char *) &head, sizeof(head)) != sizeof(head)) ||
+         (DSRC_MAGIC != head.ds_magic) ) {
+        close(fd);
+        return 0;
+    }
+
+    if ( (DSRC_VERSION != head.ds_version) || (width != head.ds_width) ||
+         (DSRC_STRIDE(width) != head.ds_stride) || (head.ds_depth < 1) ||
+         (fstat(fd, &st) != 0) ||
+         (st.st_size < sizeof(head) + (long) head.ds_depth * head.ds_stride) ) {
+        close(fd);
+        return -1;
+    }
+
+    addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == addr) return -1;
+
+#ifdef MADV_SEQUENTIAL
+    /* vectors are used in order, so read ahead and drop behind */
+    madvise(addr, st.st_size, MADV_SEQUENTIAL);
+#endif
+
+    map->header = (Dsrc_Header_t *) addr;
+    map->length = st.st_size;
+    return 1;
+}
+
+
+
+/*=== Static CM_UNMAP_SOURCE ROUTINE ===*/
+
+/* Called through cm_static_cleanup() when the instance is deleted */
+
+static void cm_unmap_source(void *block)
+{
+    Source_Map_t *map = (Source_Map_t *) block;
+
+    if (NULL != map->header) munmap((void *) map->header, map->length);
+}
+
+
+
+/*=== Static CM_GET_MAPPED_VALUE ROUTINE ===*/
+
+/* The mapped counterpart of cm_get_source_value() */
+
+static void cm_get_mapped_value(Dsrc_Header_t *header,int bit_number,
+                                int index,Digital_t *out)
+{
+    cm_source_mask_and_retrieve((short) DSRC_CODE(header,index,bit_number),
+                                0,out);
+}
+
+
+
 /*==============================================================================
 
 FUNCTION cm_d_source()
@@ -984,6 +1120,10 @@ INTERFACES
                          void *cm_event_get_ptr()
                          int  cm_event_queue()
 
+    CM.c                 void *cm_static_alloc()
+                         void *cm_static_get_ptr()
+                         int  cm_static_cleanup()
+
 
 RETURNED VALUE
     
@@ -1018,19 +1158,17 @@ void cm_d_source(ARGS)
                        dummy;   /* temp holding variable  */   
 
 
-    short              *bits,   /* the storage array for the 
+    short              *bits;   /* the storage array for the 
                                    output bit representations...
                                    this will have size equal to
                                    (width * depth)/4, since one
                                    short will hold four 12-state
                                    bit descriptions.    */
-                   *bits_old;   /* the storage array for old bit values */ 
 
 
     double       *timepoints,   /* the storage array for the 
                                    timepoints...this will have size equal 
                                    to "depth"   */
-             *timepoints_old,   /* the storage array for the old timepoints */
                  test_double,   /* test variable for doubles    */
                 double_dummy;   /* fake holding double  */   
 
@@ -1044,6 +1182,9 @@ void cm_d_source(ARGS)
                                        index and depth info. */
                        *info_old;   /* storage location for old info */
 
+
+    Source_Map_t            *map;   /* the mapped vector file, if any */
+
                                                                    
     Digital_t                out;   /* storage for each output bit */
                          
@@ -1065,91 +1206,112 @@ void cm_d_source(ARGS)
     if(INIT) {  /* initial pass */ 
                                         
 
+        /*** map the file if it is a compiled one ***/
+        map = (Source_Map_t *) cm_static_alloc(0,sizeof(Source_Map_t));
+        err = cm_map_source( PARAM(input_file), PORT_SIZE(out), map);
 
-        /*** open file and count the number of vectors in it ***/
-        source = fopen( PARAM(input_file), "r");
-    
-        /* increment counter if not a comment until EOF reached... */
-        i = 0;                                                
-        s = temp;
-        while ( fgets(s,MAX_STRING_SIZE,source) != NULL) {
-            if ( '*' != s[0] ) {
-                while(isspace(*s) || (*s == '*')) 
-                      (s)++;
-                if ( *s != '\0' ) i++;
+        if (0 != err) {
+
+            info = info_old = (Source_Table_Info_t *) 
+                              cm_event_alloc(0,sizeof(Source_Table_Info_t));
+
+            info->index = 0;
+            info->width = PORT_SIZE(out);
+
+            if (err > 0) {  /* mapped...only the index is kept */
+                cm_static_cleanup(0,cm_unmap_source);
+                info->depth = map->header->ds_depth;
+            }
+            else {  /* unusable...output zeros as for a bad text file */
+                cm_message_send(loading_error);
+                info->depth = 0;
+                bits = (short *) cm_static_alloc(1,
+                                    (info->width / 4 + 1) * sizeof(short));
+                timepoints = (double *) cm_static_alloc(2,sizeof(double));
             }
-            s = temp;
         }
+        else {
+
+            /*** open file and count the number of vectors in it ***/
+            source = fopen( PARAM(input_file), "r");
+    
+            /* increment counter if not a comment until EOF reached... */
+            i = 0;                                                
+            s = temp;
+            while ( fgets(s,MAX_STRING_SIZE,source) != NULL) {
+                if ( '*' != s[0] ) {
+                    while(isspace(*s) || (*s == '*')) 
+                          (s)++;
+                    if ( *s != '\0' ) i++;
+                }
+                s = temp;
+            }
 
-        /*** allocate storage for *index, *bits & *timepoints ***/
+            /*** allocate storage for *index, *bits & *timepoints ***/
 
-        info = info_old = (Source_Table_Info_t *) 
-                          cm_event_alloc(0,sizeof(Source_Table_Info_t));
+            info = info_old = (Source_Table_Info_t *) 
+                              cm_event_alloc(0,sizeof(Source_Table_Info_t));
         
 
                                                            
-        modf( (PORT_SIZE(out) * i / 4), &double_dummy );
-        dummy = double_dummy + 1;
+            modf( (PORT_SIZE(out) * i / 4), &double_dummy );
+            dummy = double_dummy + 1;
 
-        bits = bits_old = (short *) cm_event_alloc(1,(dummy * sizeof(short)));
+            /* The tables are only read from here on, so they go */
+            /* in static storage rather than being copied along  */
+            /* with the index at every event.                    */
+            bits = (short *) cm_static_alloc(1,(dummy * sizeof(short)));
                          
-        timepoints = timepoints_old = (double *) 
-                     cm_event_alloc(2,i * sizeof(double));
-                                       
+            timepoints = (double *) cm_static_alloc(2,i * sizeof(double));
 
-        /**** Patch assignment for memory...remove in final version ****/
-        info = info_old = (Source_Table_Info_t *) cm_event_get_ptr(0,0);
-        bits = bits_old = (short *) cm_event_get_ptr(1,0);
-        timepoints = timepoints_old = (double *) cm_event_get_ptr(2,0);
 
 
 
+            /* Initialize info values... */
 
-        /* Initialize info values... */
+            info->index = 0;
+            info->depth = i;
 
-        info->index = 0;
-        info->depth = i;
+            /* Retrieve width of the source */
+            info->width = PORT_SIZE(out);
 
-        /* Retrieve width of the source */
-        info->width = PORT_SIZE(out);
 
+            /* Initialize *bits & *timepoints to zero */
 
-        /* Initialize *bits & *timepoints to zero */
+            for (i=0; i<dummy; i++) bits[i] = 0;
 
-        for (i=0; i<dummy; i++) bits[i] = 0;
-
-        for (i=0; i<info->depth; i++) timepoints[i] = 0;
+            for (i=0; i<info->depth; i++) timepoints[i] = 0;
 
 
                                         
 
 
 
-        /* Send file pointer and the two array storage pointers */
-        /* to "cm_read_source()". This will return after        */
-        /* reading the contents of source.in, and if no         */
-        /* errors have occurred, the "*bits" and "*timepoints"  */
-        /* vectors will be loaded and the width and depth       */
-        /* values supplied.                                     */
-
-        rewind(source);
-        err = cm_read_source(source,bits,timepoints,info);
+            /* Send file pointer and the two array storage pointers */
+            /* to "cm_read_source()". This will return after        */
+            /* reading the contents of source.in, and if no         */
+            /* errors have occurred, the "*bits" and "*timepoints"  */
+            /* vectors will be loaded and the width and depth       */
+            /* values supplied.                                     */
 
+            rewind(source);
+            err = cm_read_source(source,bits,timepoints,info);
 
 
 
-        if (err) { /* problem occurred in load...send error msg. */
 
-            cm_message_send(loading_error);
+            if (err) { /* problem occurred in load...send error msg. */
 
-            /* Reset *bits & *timepoints to zero */
-            for (i=0; i<(test = (info->width*info->depth)/4); i++) bits[i] = 0;
-            for (i=0; i<info->depth; i++) timepoints[i] = 0;
-        }
+                cm_message_send(loading_error);
 
-        /* close source file */
-        fclose(source);
+                /* Reset *bits & *timepoints to zero */
+                for (i=0; i<(test = (info->width*info->depth)/4); i++) bits[i] = 0;
+                for (i=0; i<info->depth; i++) timepoints[i] = 0;
+            }
 
+            /* close source file */
+            fclose(source);
+        }
     }
     else {      /*** Retrieve previous values ***/
 
@@ -1164,46 +1326,30 @@ void cm_d_source(ARGS)
 
                                                                
 
-        /** Retrieve bits... **/
-        bits = (short *) cm_event_get_ptr(1,0);
-        bits_old = (short *) cm_event_get_ptr(1,1);
-
-        /* Set old values to new... */
-        modf( (info->width * info->depth / 4), &double_dummy );
-        dummy = double_dummy + 1;
-
-
-        for (i=0; i<dummy; i++) bits[i] = bits_old[i];
-
-                                     
-
-        /** Retrieve timepoints... **/
-        timepoints = (double *) cm_event_get_ptr(2,0);
-        timepoints_old = (double *) cm_event_get_ptr(2,1);
-
-        /* Set old values to new... */
-        for (i=0; i<info->depth; i++) 
-            timepoints[i] = timepoints_old[i];
-
-                                         
+        /** Retrieve bits & timepoints... **/
+        map = (Source_Map_t *) cm_static_get_ptr(0);
+        if (NULL == map->header) {
+            bits = (short *) cm_static_get_ptr(1);
+            timepoints = (double *) cm_static_get_ptr(2);
+        }
     }
 
     /*** For the case of TIME==0.0, set special breakpoint ***/
 
     if ( 0.0 == TIME ) {
                                     
-        test_double = timepoints[info->index];
+        test_double = SOURCE_TIME(info->index);
         if ( 0.0 == test_double ) { /* Set DC value */
 
             /* reset current breakpoint */
-            test_double = timepoints[info->index];
+            test_double = SOURCE_TIME(info->index);
             cm_event_queue( test_double );
                                               
             /* Output new values... */
             for (i=0; i<info->width; i++) {
     
                 /* retrieve output value */
-                cm_get_source_value(info->width,i,info->index,bits,&out);
+                SOURCE_VALUE(i,info->index,&out);
     
                 OUTPUT_STATE(out[i]) = out.state;
                 OUTPUT_STRENGTH(out[i]) = out.strength;
@@ -1216,7 +1362,7 @@ void cm_d_source(ARGS)
             /* set next breakpoint as long as depth 
                has not been exceeded    */
             if ( info->index < info->depth ) {
-                test_double = timepoints[info->index] - 1.0e-10;
+                test_double = SOURCE_TIME(info->index) - 1.0e-10;
                 cm_event_queue( test_double );
             }
 
@@ -1226,7 +1372,7 @@ void cm_d_source(ARGS)
             /* set next breakpoint as long as depth 
                has not been exceeded    */
             if ( info->index < info->depth ) {
-                test_double = timepoints[info->index] - 1.0e-10;
+                test_double = SOURCE_TIME(info->index) - 1.0e-10;
                 cm_event_queue( test_double );
             }
         }
@@ -1237,7 +1383,12 @@ void cm_d_source(ARGS)
          *** routine based on the last breakpoint's relationship ***
          *** to the current time value.                          ***/
         
-        test_double = timepoints[info->index] - 1.0e-10;
+        /* Once past the last vector there is none to look at, which
+           matters when the vectors are mapped from a file...         */
+        if ( info->index < info->depth ) 
+            test_double = SOURCE_TIME(info->index) - 1.0e-10;
+        else
+            test_double = TIME - 1.0;
 
         if ( TIME < test_double ) { /* Breakpoint has not occurred */
     
@@ -1247,7 +1398,7 @@ void cm_d_source(ARGS)
             }                                                     
      
             if ( info->index < info->depth ) {
-                test_double = timepoints[info->index] - 1.0e-10;
+                test_double = SOURCE_TIME(info->index) - 1.0e-10;
                 cm_event_queue( test_double );
             }
                                                                 
@@ -1257,14 +1408,14 @@ void cm_d_source(ARGS)
         if ( TIME == test_double ) { /* Breakpoint reached */
                                                                             
             /* reset current breakpoint */
-            test_double = timepoints[info->index] - 1.0e-10;
+            test_double = SOURCE_TIME(info->index) - 1.0e-10;
             cm_event_queue( test_double );
                                               
             /* Output new values... */
             for (i=0; i<info->width; i++) {
     
                 /* retrieve output value */
-                cm_get_source_value(info->width,i,info->index,bits,&out);
+                SOURCE_VALUE(i,info->index,&out);
     
                 OUTPUT_STATE(out[i]) = out.state;
                 OUTPUT_DELAY(out[i]) = 1.0e-10;
@@ -1280,7 +1431,7 @@ void cm_d_source(ARGS)
             /* set next breakpoint as long as depth 
                has not been exceeded    */
             if ( info->index < info->depth ) {
-                test_double = timepoints[info->index] - 1.0e-10;
+                test_double = SOURCE_TIME(info->index) - 1.0e-10;
                 cm_event_queue( test_double );
             }
     
@@ -53,6 +53,12 @@ NON-STANDARD FEATURES
 #include <ctype.h>
 #include <math.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "DSRCvec.h"
 
                                       
 
@@ -35,6 +35,8 @@ INTERFACES
                              
     CMevt.c              void *cm_event_alloc()
                          void *cm_event_get_ptr()
+
+    CM.c                 void *cm_static_alloc()
                          
 
 
@@ -1841,6 +1843,8 @@ INTERFACES
     CMevt.c              void *cm_event_alloc()
                          void *cm_event_get_ptr()
 
+    CM.c                 void *cm_static_alloc()
+
 RETURNED VALUE
     
     Returns inputs and outputs via ARGS structure.
@@ -1941,11 +1945,14 @@ void cm_d_state(ARGS)
         states->num_outputs = PORT_SIZE(out);
         
 
-        /* assign storage for arrays to pointers in states table    */
-        states->state = (int *) calloc(states->depth,sizeof(int));
-        states->bits = (short *) calloc((states->num_outputs * states->depth / 4),sizeof(short));
-        states->inputs = (short *) calloc((states->num_inputs * states->depth / 8),sizeof(short));
-        states->next_state = (int *) calloc(states->depth,sizeof(int));
+        /* assign storage for arrays to pointers in states table.  */
+        /* The arrays are only read after this, so they go in      */
+        /* static storage and only the pointers are copied along   */
+        /* with the current state at each event.                   */
+        states->state = (int *) cm_static_alloc(0,states->depth * sizeof(int));
+        states->bits = (short *) cm_static_alloc(1,(states->num_outputs * states->depth / 4) * sizeof(short));
+        states->inputs = (short *) cm_static_alloc(2,(states->num_inputs * states->depth / 8) * sizeof(short));
+        states->next_state = (int *) cm_static_alloc(3,states->depth * sizeof(int));
         
 
         /* Initialize *state, *bits, *inputs & *next_state to zero  */
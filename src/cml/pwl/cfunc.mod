@@ -37,6 +37,11 @@ INTERFACES
     CMmacros.h           cm_message_send();                   
                              
     CM.c                 void cm_analog_not_converged()
+                         void *cm_static_alloc()
+                         void *cm_static_get_ptr()
+
+    CMutil.c             void cm_table_init()
+                         int  cm_table_find()
 
 
 REFERENCED FILES
@@ -248,6 +253,9 @@ void cm_pwl(ARGS)  /* structure holding parms,
     double *last_x_value;   /* static variable for limiting */
     double test;            /* temp storage variable for limit testing */
 
+    Cm_Table_t *table;      /* lookup of the breakpoint below an input */
+    int *cells;             /* grid for the lookup */
+
     Mif_Complex_t ac_gain;
                                            
     char *allocation_error="\n***ERROR***\nPWL: Allocation calloc failed!\n";
@@ -286,6 +294,28 @@ void cm_pwl(ARGS)  /* structure holding parms,
             y[i] = PARAM(y_array[i]);
         }                       
 
+        /* Set up the lookup of the segments, with a grid cell per */
+        /* breakpoint so that the cost doesn't grow with the size  */
+        table = (Cm_Table_t *) cm_static_alloc(0, sizeof(Cm_Table_t));
+        cells = (int *) cm_static_alloc(1, size * sizeof(int));
+        cm_table_init(table, x, 1, size, cells, size);
+
+        /* See if input_domain is absolute...if so, test against   */
+        /* breakpoint segments for violation of 50% rule...        */
+        if (PARAM(fraction) == MIF_FALSE) {
+            if ( 3 < size ) {
+                for (i=1; i<(size-2); i++) { 
+                    /* Test for overlap...0.999999999 factor is to      */
+                    /* prevent floating point problems with comparison. */
+                    if ( (test1 = x[i+1] - x[i]) < 
+                         (test2 = 0.999999999 * (2.0 * input_domain)) ) {
+                        cm_message_send(limit_error);          
+                    }    
+                }
+            }
+
+        }
+
     }  
     else {
 
@@ -295,27 +325,12 @@ void cm_pwl(ARGS)  /* structure holding parms,
 
         y = STATIC_VAR(y);
 
-    }
-
+        table = (Cm_Table_t *) cm_static_get_ptr(0);
 
+    }
 
 
 
-    /* See if input_domain is absolute...if so, test against   */
-    /* breakpoint segments for violation of 50% rule...        */
-    if (PARAM(fraction) == MIF_FALSE) {
-        if ( 3 < size ) {
-            for (i=1; i<(size-2); i++) { 
-                /* Test for overlap...0.999999999 factor is to      */
-                /* prevent floating point problems with comparison. */
-                if ( (test1 = x[i+1] - x[i]) < 
-                     (test2 = 0.999999999 * (2.0 * input_domain)) ) {
-                    cm_message_send(limit_error);          
-                }    
-            }
-        }
-
-    }
 
 
     /* Retrieve x_input value. */       
@@ -381,37 +396,30 @@ void cm_pwl(ARGS)  /* structure holding parms,
         }
     }
     else {
-        for (i=1; i<size; i++) {
-            if ( *last_x_value < x[i] ) {
-                              
-                /* Obtain the test value of the input */
-                test = limit_x_value(x[i-1],x[i],x_input,FRACTION,last_x_value);
-                
-                /* If the test value is greater than x[i], force to x[i]  */
-                if ( test > x[i] ) {
-                    x_input = *last_x_value = x[i];
-
-                    /* Alert the simulator to non-convergence */
-                    cm_analog_not_converged();
+        /* Find the segment holding the last value...x[i-1] <= it < x[i] */
+        i = cm_table_find(table, *last_x_value) + 1;
 
-                    break;
-                }                                               
-                else 
-                /* If the test value is less than x[i-1], force to x[i-1]  */
-                /* minus some epsilon value...                             */
-                if ( test < x[i-1] ) {
-                    x_input = *last_x_value = x[i-1] - EPSILON;
+        /* Obtain the test value of the input */
+        test = limit_x_value(x[i-1],x[i],x_input,FRACTION,last_x_value);
+        
+        /* If the test value is greater than x[i], force to x[i]  */
+        if ( test > x[i] ) {
+            x_input = *last_x_value = x[i];
 
-                    /* Alert the simulator to non-convergence */
-                    cm_analog_not_converged();
+            /* Alert the simulator to non-convergence */
+            cm_analog_not_converged();
+        }                                               
+        else 
+        /* If the test value is less than x[i-1], force to x[i-1]  */
+        /* minus some epsilon value...                             */
+        if ( test < x[i-1] ) {
+            x_input = *last_x_value = x[i-1] - EPSILON;
 
-                    break;
-                }
-                else { /* Use returned value for next input */
-                    x_input = *last_x_value = test; 
-                    break;
-                }
-            }
+            /* Alert the simulator to non-convergence */
+            cm_analog_not_converged();
+        }
+        else { /* Use returned value for next input */
+            x_input = *last_x_value = test; 
         }
     }
 
@@ -449,58 +457,53 @@ void cm_pwl(ARGS)  /* structure holding parms,
             out = y[size-1] + (x_input - x[size-1]) * dout_din;
         }
         else { /*** x_input within bounds of end midpoints...     ***/
-               /*** must determine position progressively & then  ***/
+               /*** find the nearest breakpoint & then            ***/
                /*** calculate required output.                    ***/
 
-            for (i=1; i<size; i++) {
-                    
-                if (x_input < (x[i] + x[i+1])/2.0) { 
-                                   /* approximate position known...          */
-             
-                    lower_seg = (x[i] - x[i-1]);
-                    upper_seg = (x[i+1] - x[i]);
-
-
-                    /* Calculate input_domain about this region's breakpoint.*/
-
-                    if (PARAM(fraction) == MIF_TRUE) {  /* Translate input_domain */
-                                                  /* into an absolute....   */
-                        if ( lower_seg <= upper_seg )          /* Use lower  */
-                                                               /* segment    */
-                                                               /* for % calc.*/
-                            input_domain = input_domain * lower_seg;
-                        else                                   /* Use upper  */
-                                                               /* segment    */
-                                                               /* for % calc.*/
-                            input_domain = input_domain * upper_seg;
-                    } 
+            i = cm_table_find(table, x_input);
+            if (x_input >= (x[i] + x[i+1])/2.0)
+                i++;
+
+            lower_seg = (x[i] - x[i-1]);
+            upper_seg = (x[i+1] - x[i]);
+
+
+            /* Calculate input_domain about this region's breakpoint.*/
+
+            if (PARAM(fraction) == MIF_TRUE) {  /* Translate input_domain */
+                                          /* into an absolute....   */
+                if ( lower_seg <= upper_seg )          /* Use lower  */
+                                                       /* segment    */
+                                                       /* for % calc.*/
+                    input_domain = input_domain * lower_seg;
+                else                                   /* Use upper  */
+                                                       /* segment    */
+                                                       /* for % calc.*/
+                    input_domain = input_domain * upper_seg;
+            } 
     
-                    /* Set up threshold values about breakpoint... */
-                    threshold_lower = x[i] - input_domain;
-                    threshold_upper = x[i] + input_domain;
-
-                    /* Determine where x_input is within region & determine */
-                    /* output and partial values....                        */
-                    if (x_input < threshold_lower) { /* Lower linear region */
-                        dout_din = (y[i] - y[i-1])/lower_seg;
-
-                        out = y[i] + (x_input - x[i]) * dout_din;
-                    }
-                    else {        
-                        if (x_input < threshold_upper) { /* Parabolic region */
-                            lower_slope = (y[i] - y[i-1])/lower_seg;
-                            upper_slope = (y[i+1] - y[i])/upper_seg;
-
-                            cm_smooth_corner(x_input,x[i],y[i],input_domain,
-                                        lower_slope,upper_slope,&out,&dout_din);
-                        }
-                        else {        /* Upper linear region */
-                            dout_din = (y[i+1] - y[i])/upper_seg;
-                            out = y[i] + (x_input - x[i]) * dout_din;
-                        }
-                    }
-                    break;  /* Break search loop...x_input has been found, */
-                            /* and out and dout_din have been assigned.    */
+            /* Set up threshold values about breakpoint... */
+            threshold_lower = x[i] - input_domain;
+            threshold_upper = x[i] + input_domain;
+
+            /* Determine where x_input is within region & determine */
+            /* output and partial values....                        */
+            if (x_input < threshold_lower) { /* Lower linear region */
+                dout_din = (y[i] - y[i-1])/lower_seg;
+
+                out = y[i] + (x_input - x[i]) * dout_din;
+            }
+            else {        
+                if (x_input < threshold_upper) { /* Parabolic region */
+                    lower_slope = (y[i] - y[i-1])/lower_seg;
+                    upper_slope = (y[i+1] - y[i])/upper_seg;
+
+                    cm_smooth_corner(x_input,x[i],y[i],input_domain,
+                                lower_slope,upper_slope,&out,&dout_din);
+                }
+                else {        /* Upper linear region */
+                    dout_din = (y[i+1] - y[i])/upper_seg;
+                    out = y[i] + (x_input - x[i]) * dout_din;
                 }
             }
         }
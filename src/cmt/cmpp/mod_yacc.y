@@ -277,6 +277,129 @@ static append (char *str)
    (void)strcat (buffer,str);
 }
 
+/*---------------------------------------------------------------------------*/
+/*
+ * Direct access.  In the body of a function declared with ARGS, the
+ * connections, ports, parameters and static variables of the model are
+ * fetched from `private' once, into constant locals declared just after
+ * the opening brace, and the macros are translated to use those.  The
+ * port counts and which ports are arrays are known here, so a scalar port
+ * is a single pointer.  Since the locals are never assigned again, the
+ * compiler can keep them in registers across stores and calls, instead
+ * of following private->conn[i]->port[j] on every access, and can see
+ * that the ports of a loop body don't change.
+ *
+ * The declarations all go on the line of the brace, so the line numbers
+ * of the .mod file are not disturbed.  Functions that take `private'
+ * without ARGS get the full expressions as before.
+ */
+
+typedef enum {FRAME_NONE, FRAME_PENDING, FRAME_BODY} Frame_State_t;
+
+static Frame_State_t frame_state = FRAME_NONE;
+static int frame_depth;
+
+static void put_frame (FILE *fp)
+{
+   int i;
+
+   for (i = 0; i < mod_ifs_table->num_conn; i++) {
+      fprintf (fp, " Mif_Conn_Data_t *const cmpp_conn_%d = private->conn[%d];",
+	       i, i);
+      if (mod_ifs_table->conn[i].is_array) {
+	 fprintf (fp, " Mif_Port_Data_t **const cmpp_ports_%d = cmpp_conn_%d->port;",
+		  i, i);
+      } else {
+	 /* the port list of a null connection is NULL */
+	 fprintf (fp, " Mif_Port_Data_t *const cmpp_port_%d = cmpp_conn_%d->port ? cmpp_conn_%d->port[0] : 0;",
+		  i, i, i);
+      }
+   }
+   for (i = 0; i < mod_ifs_table->num_param; i++) {
+      fprintf (fp, " Mif_Value_t *const cmpp_param_%d = private->param[%d]->element;",
+	       i, i);
+   }
+   for (i = 0; i < mod_ifs_table->num_inst_var; i++) {
+      /* not the element, which the model may allocate */
+      fprintf (fp, " Mif_Inst_Var_Data_t *const cmpp_var_%d = private->inst_var[%d];",
+	       i, i);
+   }
+}
+
+/*---------------------------------------------------------------------------*/
+static void put_misc_c (FILE *fp, char *text)
+{
+   fputs (text, fp);
+   switch (frame_state) {
+   case FRAME_PENDING:
+      if (text[0] == '{') {
+	 put_frame (fp);
+	 frame_state = FRAME_BODY;
+	 frame_depth = 1;
+      } else if (text[0] == ';') {
+	 /* just a prototype */
+	 frame_state = FRAME_NONE;
+      }
+      break;
+   case FRAME_BODY:
+      if (text[0] == '{') {
+	 frame_depth++;
+      } else if ((text[0] == '}') && (--frame_depth == 0)) {
+	 frame_state = FRAME_NONE;
+      }
+      break;
+   }
+}
+
+/*---------------------------------------------------------------------------*/
+static Boolean_t direct (int i)
+{
+   /* i is negative if the id was bad, and an error has been issued */
+   return (frame_state == FRAME_BODY) && (i >= 0);
+}
+
+/*---------------------------------------------------------------------------*/
+static void put_conn (FILE *fp, int i)
+{
+   if (direct (i)) {
+      fprintf (fp, "cmpp_conn_%d", i);
+   } else {
+      fprintf (fp, "private->conn[%d]", i);
+   }
+}
+
+/*---------------------------------------------------------------------------*/
+static void put_port (FILE *fp, int i, Sub_Id_t sub_id)
+{
+   if (! direct (i)) {
+      fprintf (fp, "private->conn[%d]->port[%s]", i, subscript (sub_id));
+   } else if (mod_ifs_table->conn[i].is_array) {
+      fprintf (fp, "cmpp_ports_%d[%s]", i, subscript (sub_id));
+   } else {
+      fprintf (fp, "cmpp_port_%d", i);
+   }
+}
+
+/*---------------------------------------------------------------------------*/
+static void put_param (FILE *fp, int i, Sub_Id_t sub_id)
+{
+   if (direct (i)) {
+      fprintf (fp, "cmpp_param_%d[%s]", i, subscript (sub_id));
+   } else {
+      fprintf (fp, "private->param[%d]->element[%s]", i, subscript (sub_id));
+   }
+}
+
+/*---------------------------------------------------------------------------*/
+static void put_var (FILE *fp, int i)
+{
+   if (direct (i)) {
+      fprintf (fp, "cmpp_var_%d", i);
+   } else {
+      fprintf (fp, "private->inst_var[%d]", i);
+   }
+}
+
 %}
 
 %union {
@@ -364,7 +487,7 @@ buffered_c_char		: TOK_IDENTIFIER {append (yytext);}
 			;
 
 c_char			: TOK_IDENTIFIER {fputs (yytext, yyout);}
-			| TOK_MISC_C {fputs (yytext, yyout);}
+			| TOK_MISC_C {put_misc_c (yyout, yytext);}
 			| TOK_COMMA {fputs (yytext, yyout);}
 			| TOK_LBRACKET 
 				{putc ('[', yyout);}
@@ -379,7 +502,10 @@ c_char			: TOK_IDENTIFIER {fputs (yytext, yyout);}
 macro			: TOK_INIT
 			   {fprintf (yyout, "private->circuit.init");}
 			| TOK_ARGS
-			   {fprintf (yyout, "Mif_Private_t *private");}
+			   {fprintf (yyout, "Mif_Private_t *private");
+			    if (frame_state == FRAME_NONE) {
+			       frame_state = FRAME_PENDING;
+			    }}
 			| TOK_ANALYSIS
 			   {fprintf (yyout, "private->circuit.anal_type");}
 			| TOK_NEW_TIMEPOINT
@@ -396,8 +522,7 @@ macro			: TOK_INIT
 			   {fprintf (yyout, "private->circuit.t[%s]", $3);}
 			| TOK_PARAM TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, PARAM);
-			    fprintf (yyout, "private->param[%d]->element[%s]",
-				     i, subscript ($3));
+			    put_param (yyout, i, $3);
 			    put_type (yyout, mod_ifs_table->param[i].type);
 			   }    
 			| TOK_PARAM_SIZE TOK_LPAREN id TOK_RPAREN
@@ -408,32 +533,34 @@ macro			: TOK_INIT
 			    fprintf (yyout, "private->param[%d]->is_null", i);}
 			| TOK_PORT_SIZE TOK_LPAREN id TOK_RPAREN
 			   {int i = valid_id ($3, CONN);
-			    fprintf (yyout, "private->conn[%d]->size", i);}
+			    put_conn (yyout, i);
+			    fprintf (yyout, "->size");}
 			| TOK_PORT_NULL TOK_LPAREN id TOK_RPAREN
 			   {int i = valid_id ($3, CONN);
-			    fprintf (yyout, "private->conn[%d]->is_null", i);}
+			    put_conn (yyout, i);
+			    fprintf (yyout, "->is_null");}
 			| TOK_PARTIAL TOK_LPAREN subscriptable_id TOK_COMMA
 			  subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
 			    int j = valid_subid ($5, CONN);
 			    check_dir (i, OUT, "PARTIAL");
 			    check_dir (j, IN, "PARTIAL");
-			    fprintf (yyout, "private->conn[%d]->port[%s]->partial[%d].port[%s]",
-				     i, subscript($3), j, subscript($5));}
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->partial[%d].port[%s]",
+				     j, subscript($5));}
 			| TOK_AC_GAIN TOK_LPAREN subscriptable_id TOK_COMMA
 			  subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
 			    int j = valid_subid ($5, CONN);
 			    check_dir (i, OUT, "AC_GAIN");
 			    check_dir (j, IN, "AC_GAIN");
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->ac_gain[%d].port[%s]",
-				     i, subscript($3), j, subscript($5));}
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->ac_gain[%d].port[%s]",
+				     j, subscript($5));}
 			| TOK_STATIC_VAR TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, STATIC_VAR);
-			    fprintf (yyout, 
-				    "private->inst_var[%d]->element[%s]",
-				     i, subscript($3));
+			    put_var (yyout, i);
+			    fprintf (yyout, "->element[%s]", subscript($3));
 			    if (mod_ifs_table->inst_var[i].is_array
 				&& !($3.has_subscript)) {
 			       /* null - eg. for malloc lvalue */
@@ -443,104 +570,94 @@ macro			: TOK_INIT
 			    } }
 			| TOK_STATIC_VAR_SIZE TOK_LPAREN id TOK_RPAREN
 			   {int i = valid_subid ($3, STATIC_VAR);
-			    fprintf (yyout, "private->inst_var[%d]->size",
-				    i, subscript($3));}
+			    put_var (yyout, i);
+			    fprintf (yyout, "->size");}
 			| TOK_OUTPUT_DELAY TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
 			    check_dir (i, OUT, "OUTPUT_DELAY");
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->delay", i,
-				     subscript($3));}
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->delay");}
 			| TOK_CHANGED TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
 			    check_dir (i, OUT, "CHANGED");
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->changed", i,
-				     subscript($3));}
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->changed");}
 			| TOK_INPUT TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, IN, "INPUT");
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->input",
-				     i, subscript($3));
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->input");
 			    put_conn_type (yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);}
 			| TOK_INPUT_TYPE TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, IN, "INPUT_TYPE");
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->type_str",
-				     i, subscript($3)); }
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->type_str");}
 			| TOK_OUTPUT_TYPE TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, OUT, "OUTPUT_TYPE");
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->type_str",
-				     i, subscript($3)); }
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->type_str");}
 			| TOK_INPUT_STRENGTH TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, IN, "INPUT_STRENGTH");
-			    fprintf (yyout, 
-				     "((Digital_t*)(private->conn[%d]->port[%s]->input",
-				     i, subscript($3));
+			    fprintf (yyout, "((Digital_t*)(");
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->input");
 			    put_conn_type (yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);
 			    fprintf (yyout, "))->strength");}
 			| TOK_INPUT_STATE TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, IN, "INPUT_STATE");
-			    fprintf (yyout, 
-				     "((Digital_t*)(private->conn[%d]->port[%s]->input", 
-				     i, subscript($3));
+			    fprintf (yyout, "((Digital_t*)(");
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->input");
 			    put_conn_type (yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);
 			    fprintf (yyout, "))->state");}
 			| TOK_OUTPUT TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, OUT, "OUTPUT");
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->output", 
-				     i, subscript($3));
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->output");
 			    put_conn_type (yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);}
 			| TOK_OUTPUT_STRENGTH TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, OUT, "OUTPUT_STRENGTH");
-			    fprintf (yyout, 
-				     "((Digital_t*)(private->conn[%d]->port[%s]->output",
-				     i, subscript($3));
+			    fprintf (yyout, "((Digital_t*)(");
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->output");
 			    put_conn_type (yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);
 			    fprintf (yyout, "))->strength");}
 			| TOK_OUTPUT_STATE TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, OUT, "OUTPUT_STATE");
-			    fprintf (yyout, 
-				     "((Digital_t*)(private->conn[%d]->port[%s]->output",
-				     i, subscript($3));
+			    fprintf (yyout, "((Digital_t*)(");
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->output");
 			    put_conn_type (yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);
 			    fprintf (yyout, "))->state");}
 			| TOK_OUTPUT_CHANGED TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->changed", i,
-				     subscript($3));}
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->changed");}
 			| TOK_LOAD TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->load", i,
-				     subscript($3));}
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->load");}
 			| TOK_TOTAL_LOAD TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->total_load", i,
-				     subscript($3));}
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->total_load");}
 			| TOK_MESSAGE TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
-			    fprintf (yyout, 
-				     "private->conn[%d]->port[%s]->msg", i,
-				     subscript($3));}
+			    put_port (yyout, i, $3);
+			    fprintf (yyout, "->msg");}
 			;
 
 subscriptable_id	: id
@@ -16,7 +16,9 @@ include /usr/local/xspice-1-0/include/make.include
 
 INCLUDE = -I. -I$(ROOT)/include/sim
 
-CFLAGS = -g
+# -fPIC so the objects can also go into a code model library (see the
+# cmlib target of the simulator makefile)
+CFLAGS = -g -fPIC
 
 #-----------------------------------------------------------------------------
 # Edit the following definition to specify the object files that comprise 
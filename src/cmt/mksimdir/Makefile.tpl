@@ -9,9 +9,15 @@ OBJLIB = $(ROOT)/lib/sim/object
 SRCLIB = $(ROOT)/lib/sim/source
 
 INCLUDE = -I. -I$(ROOT)/include/sim
-LIB = -L/usr/X11/lib -lXaw -lXt -lXmu -lX11 -lm -ltermlib
+LIB = -L/usr/X11/lib -lXaw -lXt -lXmu -lX11 -lm -ltermlib -ldl
 CFLAGS = -g
 
+# The simulator exports its symbols to the code model libraries it
+# loads, and the objects in a library should be compiled with PICFLAGS
+LDFLAGS = -rdynamic
+PICFLAGS = -fPIC
+SHFLAGS = -shared
+
 .c.o: $*.c
 	${CC} ${CFLAGS} ${INCLUDE} -c $*.c
 
@@ -25,7 +31,7 @@ xspice: force
 	@echo
 	@echo "Compiling list of models and node types..."
 	$(CC)  -o temp.o $(CFLAGS) $(INCLUDE) -c $(SRCLIB)/SPIinit.c
-	@echo "$(CC) -o xspice temp.o \\" > make.tmp
+	@echo "$(CC) $(LDFLAGS) -o xspice temp.o \\" > make.tmp
 	@echo "$(OBJLIB)/core.o $(LIB) \\" >> make.tmp
 	@cat objects.inc >> make.tmp
 	@echo
@@ -52,7 +58,7 @@ atesse_xspice: force
 	@echo
 	@echo "Compiling list of models and node types..."
 	$(CC) -o temp.o $(CFLAGS) $(INCLUDE) -c $(SRCLIB)/SPIinit.c
-	@echo "$(CC) -o atesse_xspice temp.o \\" > make.tmp
+	@echo "$(CC) $(LDFLAGS) -o atesse_xspice temp.o \\" > make.tmp
 	@echo "$(OBJLIB)/bcore.o $(LIB) \\" >> make.tmp
 	@cat objects.inc >> make.tmp
 	@echo
@@ -71,5 +77,33 @@ atesse_xspice: force
 	@echo
 
 
+# Code model library - the models and node types in modpath.lst and
+# udnpath.lst, loaded by the simulator's 'codemodel' command instead
+# of being linked in
+
+cmlib: force
+	@echo
+	@echo "Running preprocessor on modpath.lst and udnpath.lst ..."
+	$(BINDIR)/cmpp -lst
+	@echo
+	@echo "Compiling list of models and node types..."
+	$(CC) -o temp.o $(CFLAGS) $(PICFLAGS) $(INCLUDE) -c $(SRCLIB)/CMlib.c
+	@echo "$(CC) $(SHFLAGS) -o cmlib.so temp.o \\" > make.tmp
+	@cat objects.inc >> make.tmp
+	@echo
+	@echo "Linking code model library ..."
+	@cat make.tmp
+	@chmod 777 make.tmp
+	@make.tmp
+	@echo
+	@echo "Deleting temporary files ..."
+	@-rm make.tmp temp.o CMinfo.h CMextrn.h UDNinfo.h UDNextrn.h objects.inc
+	@echo
+	@echo
+	@echo "Code model library created."
+	@echo
+	@echo "Load it with \"codemodel `pwd`/cmlib.so\" in the simulator."
+	@echo
+
 force:
 	@true
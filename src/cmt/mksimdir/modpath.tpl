@@ -1,5 +1,10 @@
 /usr/local/xspice-1-0/lib/cml/adc_bridge
 /usr/local/xspice-1-0/lib/cml/aswitch
+/usr/local/xspice-1-0/lib/cml/bus_adder
+/usr/local/xspice-1-0/lib/cml/bus_mem
+/usr/local/xspice-1-0/lib/cml/bus_mux
+/usr/local/xspice-1-0/lib/cml/bus_ram
+/usr/local/xspice-1-0/lib/cml/bus_reg
 /usr/local/xspice-1-0/lib/cml/capacitor
 /usr/local/xspice-1-0/lib/cml/climit
 /usr/local/xspice-1-0/lib/cml/cmeter
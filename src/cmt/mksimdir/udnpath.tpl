@@ -1,2 +1,3 @@
 /usr/local/xspice-1-0/lib/udnl/real
 /usr/local/xspice-1-0/lib/udnl/int
+/usr/local/xspice-1-0/lib/udnl/bus
@@ -0,0 +1,523 @@
+/*============================================================================
+FILE  shmview.c
+
+MEMBER OF process shmview
+
+Copyright 1991
+Georgia Tech Research Corporation
+Atlanta, Georgia 30332
+All Rights Reserved
+
+PROJECT A-8503
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    This file contains a stand-in for a viewer or post-processor reading
+    the shared-memory waveform file the simulator writes when "shmout" is
+    set (see SHMout.h), and a benchmark of that transport against a byte
+    stream.
+
+        shmview [-v] <file>
+            Follow the plot in <file> until it ends, then print the
+            number of points read and lost and the rate.  With -v, print
+            each point as it arrives.
+
+        shmview -bench [<points> [<values>]]
+            Have a child process write <points> records of <values>
+            doubles through a ring in /tmp while this process reads them,
+            then do the same through a pipe as ascii rawfile-style text,
+            and print the throughput of each.
+
+INTERFACES
+
+    main()
+
+REFERENCED FILES
+
+    The file named on the command line.
+
+NON-STANDARD FEATURES
+
+    Uses mmap(), and the futex system call under Linux.
+
+============================================================================*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <unistd.h>
+#include  <fcntl.h>
+#include  <sys/types.h>
+#include  <sys/stat.h>
+#include  <sys/mman.h>
+#include  <sys/time.h>
+#include  <sys/wait.h>
+#ifdef __linux__
+#include  <sys/syscall.h>
+#include  <linux/futex.h>
+#endif
+#include  "SHMout.h"
+
+
+#define USAGE_MSG "Usage:  shmview [-v] <file>\n        shmview -bench [<points> [<values>]]"
+
+#define BENCH_POINTS  1000000
+#define BENCH_VALUES  50
+#define BENCH_FILE    "/tmp/shmview.bench"
+
+
+typedef struct {
+   unsigned long  points;     /* Records read */
+   unsigned long  lost;       /* Records overwritten before they were read */
+   double         checksum;   /* Sum of the first value of each record */
+   double         seconds;    /* Time from first record to end of plot */
+} Shm_Stats_t;
+
+
+static double now(void);
+static void shm_wait(Shm_Header_t *h, unsigned int count);
+static void shm_wake(Shm_Header_t *h);
+static Shm_Header_t *shm_attach(char *file, long *size);
+static void shm_follow(Shm_Header_t *h, int verbose, Shm_Stats_t *stats);
+static void bench(unsigned long points, int values);
+static void bench_write_shm(unsigned long points, int values);
+static void bench_write_pipe(int fd, unsigned long points, int values);
+static void bench_read_pipe(int fd, int values, Shm_Stats_t *stats);
+static void print_stats(char *what, Shm_Stats_t *stats, int values);
+
+
+/* *********************************************************************** */
+
+
+main(
+    int argc,      /* Number of command line arguments */
+    char *argv[])  /* Command line argument text */
+{
+   Shm_Header_t  *h;
+   Shm_Stats_t   stats;
+   long          size;
+   int           verbose = 0;
+   int           i = 1;
+
+   if((argc > 1) && (strcmp(argv[1], "-bench") == 0)) {
+      bench((argc > 2) ? strtoul(argv[2], NULL, 10) : BENCH_POINTS,
+            (argc > 3) ? atoi(argv[3]) : BENCH_VALUES);
+      exit(0);
+   }
+
+   if((argc > 1) && (strcmp(argv[1], "-v") == 0)) {
+      verbose = 1;
+      i++;
+   }
+   if(i != argc - 1) {
+      fprintf(stderr, "%s\n", USAGE_MSG);
+      exit(1);
+   }
+
+   h = shm_attach(argv[i], &size);
+   if(h == NULL)
+      exit(1);
+   shm_follow(h, verbose, &stats);
+   print_stats(h->sh_type, &stats, h->sh_width);
+   munmap((void *) h, size);
+   exit(0);
+}
+
+
+/* *********************************************************************** */
+
+
+/*
+now
+
+Return the wall clock time in seconds.
+*/
+
+static double now(void)
+{
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return(tv.tv_sec + tv.tv_usec * 1.0e-6);
+}
+
+
+/*
+shm_wait
+
+Sleep until the record count changes from `count', or for a while.
+The caller must already have set sh_waiters.
+*/
+
+static void shm_wait(
+    Shm_Header_t *h,       /* The mapped file */
+    unsigned int count)    /* The count we are done with */
+{
+#ifdef __linux__
+   struct timespec ts;
+
+   /* time out now and then in case the simulator died */
+   ts.tv_sec = 0;
+   ts.tv_nsec = 100000000;
+   syscall(SYS_futex, &h->sh_count, FUTEX_WAIT, count, &ts, NULL, 0);
+#else
+   usleep(1000);
+#endif
+}
+
+
+/*
+shm_wake
+
+Wake readers sleeping in shm_wait.
+*/
+
+static void shm_wake(
+    Shm_Header_t *h)       /* The mapped file */
+{
+#ifdef __linux__
+   syscall(SYS_futex, &h->sh_count, FUTEX_WAKE, 0x7fffffff, NULL, NULL, 0);
+#endif
+}
+
+
+/*
+shm_attach
+
+Map a shared-memory waveform file, waiting for the simulator to create
+it and finish the header.
+*/
+
+static Shm_Header_t *shm_attach(
+    char *file,            /* The file named by "shmout" */
+    long *size)            /* Returns the size of the mapping */
+{
+   Shm_Header_t   *h;
+   struct stat    st;
+   int            fd;
+
+   for(;;) {
+      fd = open(file, O_RDWR);
+      if((fd >= 0) && (fstat(fd, &st) == 0) &&
+            (st.st_size >= (long) sizeof(Shm_Header_t))) {
+         h = (Shm_Header_t *) mmap(NULL, st.st_size, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED, fd, 0);
+         close(fd);
+         if(h == (Shm_Header_t *) MAP_FAILED) {
+            perror(file);
+            return(NULL);
+         }
+         if(h->sh_magic == SHM_MAGIC)
+            break;
+         munmap((void *) h, st.st_size);
+      }
+      else if(fd >= 0)
+         close(fd);
+      usleep(10000);
+   }
+   SHM_BARRIER();
+
+   if(h->sh_version != SHM_VERSION) {
+      fprintf(stderr, "ERROR - %s is version %d, not %d\n", file,
+              h->sh_version, SHM_VERSION);
+      munmap((void *) h, st.st_size);
+      return(NULL);
+   }
+   *size = st.st_size;
+   return(h);
+}
+
+
+/*
+shm_follow
+
+Read records as the simulator writes them until the plot ends.
+*/
+
+static void shm_follow(
+    Shm_Header_t *h,       /* The mapped file */
+    int verbose,           /* Print each record */
+    Shm_Stats_t *stats)    /* Returns what happened */
+{
+   Shm_Vector_t   *sv = SHM_VECTORS(h);
+   double         *rec;
+   unsigned int   next = 0;
+   unsigned int   count;
+   double         start = 0.0;
+   int            i;
+
+   rec = (double *) malloc(h->sh_width * sizeof(double));
+   memset(stats, 0, sizeof(Shm_Stats_t));
+
+   if(verbose) {
+      printf("Title: %s\nPlotname: %s\nVariables:\n", h->sh_name, h->sh_type);
+      for(i = 0; i < h->sh_numvecs; i++)
+         printf("\t%d\t%s\n", sv[i].sv_index, sv[i].sv_name);
+   }
+
+   for(;;) {
+      count = h->sh_count;
+      SHM_BARRIER();
+
+      if(next == count) {
+         if(h->sh_done)
+            break;
+         /* nothing new - sleep unless something came in meanwhile */
+         h->sh_waiters = 1;
+         SHM_BARRIER();
+         if((h->sh_count == count) && ! h->sh_done)
+            shm_wait(h, count);
+         continue;
+      }
+
+      if(stats->points == 0 && stats->lost == 0)
+         start = now();
+
+      /* skip what has already been overwritten */
+      if(count - next > (unsigned int) h->sh_ringsize) {
+         stats->lost += count - h->sh_ringsize - next;
+         next = count - h->sh_ringsize;
+      }
+
+      memcpy(rec, SHM_RECORD(h, next), h->sh_width * sizeof(double));
+      SHM_BARRIER();
+
+      /* and check it wasn't overwritten while we copied it */
+      if(h->sh_count - next > (unsigned int) h->sh_ringsize) {
+         stats->lost++;
+         next++;
+         continue;
+      }
+
+      stats->points++;
+      stats->checksum += rec[0];
+      if(verbose) {
+         printf("%u", next);
+         for(i = 0; i < h->sh_width; i++)
+            printf("\t%.15e", rec[i]);
+         printf("\n");
+      }
+      next++;
+   }
+
+   if(stats->points)
+      stats->seconds = now() - start;
+   free(rec);
+}
+
+
+/*
+print_stats
+
+Print the summary of a run.
+*/
+
+static void print_stats(
+    char *what,            /* What was read */
+    Shm_Stats_t *stats,    /* What happened */
+    int values)            /* Doubles per record */
+{
+   double rate = (stats->seconds > 0.0) ? stats->points / stats->seconds : 0.0;
+
+   printf("%s: %lu points, %lu lost, %.3f s, %.0f points/s, %.1f MB/s\n",
+          what, stats->points, stats->lost, stats->seconds, rate,
+          rate * values * sizeof(double) / 1.0e6);
+}
+
+
+/* *********************************************************************** */
+
+
+/*
+bench
+
+Time the ring against a pipe carrying the same data as text.
+*/
+
+static void bench(
+    unsigned long points,  /* Records to send */
+    int values)            /* Doubles per record */
+{
+   Shm_Header_t   *h;
+   Shm_Stats_t    stats;
+   long           size;
+   int            fd[2];
+   pid_t          pid;
+
+   if((points == 0) || (values < 1)) {
+      fprintf(stderr, "%s\n", USAGE_MSG);
+      exit(1);
+   }
+
+   /* shared memory */
+   unlink(BENCH_FILE);
+   pid = fork();
+   if(pid == 0) {
+      bench_write_shm(points, values);
+      _exit(0);
+   }
+   h = shm_attach(BENCH_FILE, &size);
+   if(h == NULL)
+      exit(1);
+   shm_follow(h, 0, &stats);
+   waitpid(pid, NULL, 0);
+   print_stats("shared memory", &stats, values);
+   munmap((void *) h, size);
+   unlink(BENCH_FILE);
+
+   /* byte stream */
+   if(pipe(fd) < 0) {
+      perror("pipe");
+      exit(1);
+   }
+   pid = fork();
+   if(pid == 0) {
+      close(fd[0]);
+      bench_write_pipe(fd[1], points, values);
+      _exit(0);
+   }
+   close(fd[1]);
+   bench_read_pipe(fd[0], values, &stats);
+   close(fd[0]);
+   waitpid(pid, NULL, 0);
+   print_stats("ascii pipe", &stats, values);
+}
+
+
+/*
+bench_write_shm
+
+Write records the way OUTinterface.c does.
+*/
+
+static void bench_write_shm(
+    unsigned long points,  /* Records to send */
+    int values)            /* Doubles per record */
+{
+   Shm_Header_t   *h;
+   double         *rec;
+   long           size;
+   unsigned long  n;
+   int            fd;
+   int            i;
+
+   size = (sizeof(Shm_Header_t) + values * sizeof(Shm_Vector_t) + 63) & ~63L;
+   size += (long) SHM_DEFPOINTS * values * sizeof(double);
+
+   fd = open(BENCH_FILE ".new", O_RDWR | O_CREAT | O_TRUNC, 0644);
+   if((fd < 0) || (ftruncate(fd, size) < 0)) {
+      perror(BENCH_FILE);
+      _exit(1);
+   }
+   h = (Shm_Header_t *) mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                             fd, 0);
+   close(fd);
+   if(h == (Shm_Header_t *) MAP_FAILED) {
+      perror(BENCH_FILE);
+      _exit(1);
+   }
+
+   h->sh_version = SHM_VERSION;
+   h->sh_numvecs = values;
+   h->sh_width = values;
+   h->sh_ringsize = SHM_DEFPOINTS;
+   h->sh_vecoffset = sizeof(Shm_Header_t);
+   h->sh_ringoffset = (h->sh_vecoffset + values * sizeof(Shm_Vector_t) + 63)
+                      & ~63;
+   strcpy(h->sh_type, "shared memory");
+   for(i = 0; i < values; i++) {
+      sprintf(SHM_VECTORS(h)[i].sv_name, "v%d", i);
+      SHM_VECTORS(h)[i].sv_index = i;
+   }
+   SHM_BARRIER();
+   h->sh_magic = SHM_MAGIC;
+   rename(BENCH_FILE ".new", BENCH_FILE);
+
+   /* unlike the simulator, start only once the reader is waiting */
+   while(! h->sh_waiters)
+      usleep(1000);
+
+   for(n = 0; n < points; n++) {
+      rec = SHM_RECORD(h, (unsigned int) n);
+      for(i = 0; i < values; i++)
+         rec[i] = n + i * 1.0e-3;
+      SHM_BARRIER();
+      h->sh_count = n + 1;
+      SHM_BARRIER();
+      if(h->sh_waiters) {
+         h->sh_waiters = 0;
+         shm_wake(h);
+      }
+   }
+   h->sh_done = 1;
+   SHM_BARRIER();
+   shm_wake(h);
+   munmap((void *) h, size);
+}
+
+
+/*
+bench_write_pipe
+
+Write records the way an ascii rawfile has them.
+*/
+
+static void bench_write_pipe(
+    int fd,                /* Write end of the pipe */
+    unsigned long points,  /* Records to send */
+    int values)            /* Doubles per record */
+{
+   FILE           *fp = fdopen(fd, "w");
+   unsigned long  n;
+   int            i;
+
+   for(n = 0; n < points; n++) {
+      fprintf(fp, "%lu", n);
+      for(i = 0; i < values; i++)
+         fprintf(fp, "\t%.15e\n", n + i * 1.0e-3);
+   }
+   fclose(fp);
+}
+
+
+/*
+bench_read_pipe
+
+Parse what bench_write_pipe wrote back into doubles.
+*/
+
+static void bench_read_pipe(
+    int fd,                /* Read end of the pipe */
+    int values,            /* Doubles per record */
+    Shm_Stats_t *stats)    /* Returns what happened */
+{
+   FILE    *fp = fdopen(fd, "r");
+   double  *rec;
+   double  start;
+   char    line[128];
+   int     i = 0;
+
+   rec = (double *) malloc(values * sizeof(double));
+   memset(stats, 0, sizeof(Shm_Stats_t));
+   start = now();
+
+   while(fgets(line, sizeof(line), fp)) {
+      /* the point number shares a line with the first value */
+      rec[i] = strtod(strchr(line, '\t') + 1, NULL);
+      if(++i == values) {
+         stats->points++;
+         stats->checksum += rec[0];
+         i = 0;
+      }
+   }
+   stats->seconds = now() - start;
+   free(rec);
+}
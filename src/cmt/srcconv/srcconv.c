@@ -0,0 +1,331 @@
+/*============================================================================
+FILE  srcconv.c
+
+MEMBER OF process srcconv
+
+Copyright 1991
+Georgia Tech Research Corporation
+Atlanta, Georgia 30332
+All Rights Reserved
+
+PROJECT A-8503
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    This file contains a converter from the text vector files read by
+    the d_source code model to the compiled form it can map instead
+    (see DSRCvec.h).
+
+        srcconv <textfile> <vecfile>
+            Read <textfile> a line at a time and write <vecfile>.  The
+            width is taken from the first vector, and every later vector
+            must have the same number of values and a later timepoint.
+
+    The text is interpreted exactly as by d_source: lines beginning
+    with '*' and blank lines are skipped, and values may be separated by
+    white space, '=', '(', ')' or ','.  Timepoints take the SPICE scale
+    suffixes and are rounded to float precision as d_source does.
+
+INTERFACES
+
+    main()
+
+REFERENCED FILES
+
+    The files named on the command line.
+
+NON-STANDARD FEATURES
+
+    None.
+
+============================================================================*/
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <ctype.h>
+#include  "DSRCvec.h"
+
+
+#define USAGE_MSG "Usage:  srcconv <textfile> <vecfile>"
+
+#define NUM_CODES  12
+
+/* In code order - see DSRCvec.h */
+static char *code_names[NUM_CODES] = {
+   "0s", "1s", "Us", "0r", "1r", "Ur", "0z", "1z", "Uz", "0u", "1u", "Uu"
+};
+
+
+static char *read_line(FILE *fp);
+static int  split_line(char *line, char ***tokens, int *max_tokens);
+static int  get_time(char *str, double *value);
+static void fail(char *file, long line_num, char *msg);
+
+
+/* *********************************************************************** */
+
+
+main(
+    int argc,      /* Number of command line arguments */
+    char *argv[])  /* Command line argument text */
+{
+   FILE           *in;
+   FILE           *out;
+   Dsrc_Header_t  head;
+   char           *line;
+   char           **tokens = NULL;
+   int            max_tokens = 0;
+   int            num_tokens;
+   unsigned char  *record = NULL;
+   double         time;
+   double         last_time = 0.0;
+   long           line_num = 0;
+   char           *s;
+   int            i;
+   int            code;
+
+   if(argc != 3) {
+      fprintf(stderr, "%s\n", USAGE_MSG);
+      exit(1);
+   }
+   if((in = fopen(argv[1], "r")) == NULL) {
+      perror(argv[1]);
+      exit(1);
+   }
+   if((out = fopen(argv[2], "w")) == NULL) {
+      perror(argv[2]);
+      exit(1);
+   }
+
+   /* The depth isn't known until the end, so the header is written */
+   /* again then */
+   memset((char *) &head, 0, sizeof(head));
+   head.ds_version = DSRC_VERSION;
+
+   while((line = read_line(in)) != NULL) {
+
+      line_num++;
+
+      /* skip comments and lines with nothing but blanks and stars */
+      if(line[0] == '*')
+         continue;
+      for(s = line; isspace(*s) || (*s == '*'); s++)
+         ;
+      if(*s == '\0')
+         continue;
+
+      num_tokens = split_line(line, &tokens, &max_tokens);
+
+      if(head.ds_depth == 0) {
+         if(num_tokens < 2)
+            fail(argv[1], line_num, "no output values");
+         head.ds_width = num_tokens - 1;
+         head.ds_stride = DSRC_STRIDE(head.ds_width);
+         record = (unsigned char *) malloc(head.ds_stride);
+         if(fwrite((char *) &head, sizeof(head), 1, out) != 1)
+            fail(argv[2], 0L, "write failed");
+      }
+      else if(num_tokens != head.ds_width + 1)
+         fail(argv[1], line_num, "wrong number of values");
+
+      if(get_time(tokens[0], &time) != 0)
+         fail(argv[1], line_num, "bad timepoint");
+      if((head.ds_depth > 0) && (time <= last_time))
+         fail(argv[1], line_num, "timepoint is not later than the last one");
+      last_time = time;
+
+      memset((char *) record, 0, head.ds_stride);
+      memcpy((char *) record, (char *) &time, sizeof(double));
+      for(i = 0; i < head.ds_width; i++) {
+         for(code = 0; code < NUM_CODES; code++)
+            if(strcmp(tokens[i + 1], code_names[code]) == 0)
+               break;
+         if(code == NUM_CODES)
+            fail(argv[1], line_num, "bad output value");
+         record[sizeof(double) + i / 2] |= code << ((i & 1) * 4);
+      }
+
+      if(fwrite((char *) record, head.ds_stride, 1, out) != 1)
+         fail(argv[2], 0L, "write failed");
+      head.ds_depth++;
+   }
+
+   if(head.ds_depth == 0)
+      fail(argv[1], 0L, "no vectors");
+
+   /* Now that it is complete, mark it as a vector file */
+   head.ds_magic = DSRC_MAGIC;
+   if((fseek(out, 0L, 0) != 0) ||
+      (fwrite((char *) &head, sizeof(head), 1, out) != 1) ||
+      (fclose(out) != 0))
+      fail(argv[2], 0L, "write failed");
+
+   printf("%d vectors of %d bits\n", head.ds_depth, head.ds_width);
+   exit(0);
+}
+
+
+/* *********************************************************************** */
+
+
+/*
+read_line
+
+Read a line of any length, without the newline.  The line is kept in
+a buffer that is reused by the next call.  Returns NULL at end of file.
+*/
+
+static char *read_line(
+    FILE *fp)              /* The text file */
+{
+   static char  *buf = NULL;
+   static int   size = 0;
+   int          len = 0;
+
+   if(buf == NULL) {
+      size = 256;
+      buf = (char *) malloc(size);
+   }
+
+   while(fgets(buf + len, size - len, fp) != NULL) {
+      len += strlen(buf + len);
+      if((len > 0) && (buf[len - 1] == '\n')) {
+         buf[len - 1] = '\0';
+         return(buf);
+      }
+      size *= 2;
+      buf = (char *) realloc(buf, size);
+   }
+   return((len > 0) ? buf : NULL);
+}
+
+
+/*
+split_line
+
+Break a line into tokens in place, using the separators of d_source's
+CNVgettok.  Returns the number of tokens.
+*/
+
+#define IS_SEP(c) (isspace(c) || ((c) == '=') || ((c) == '(') || \
+                   ((c) == ')') || ((c) == ','))
+
+static int split_line(
+    char *line,            /* The line, which is modified */
+    char ***tokens,        /* The token pointer array, grown as needed */
+    int *max_tokens)       /* The size of the array */
+{
+   int   n = 0;
+
+   for(;;) {
+      while(IS_SEP(*line))
+         line++;
+      if(*line == '\0')
+         break;
+      if(n == *max_tokens) {
+         *max_tokens = (*max_tokens == 0) ? 64 : *max_tokens * 2;
+         *tokens = (char **) realloc(*tokens, *max_tokens * sizeof(char *));
+      }
+      (*tokens)[n++] = line;
+      while((*line != '\0') && ! IS_SEP(*line))
+         line++;
+      if(*line != '\0')
+         *line++ = '\0';
+   }
+   return(n);
+}
+
+
+/*
+get_time
+
+Convert a timepoint the way d_source's cnv_get_spice_value does,
+including its use of float.  Returns non-zero if there is no number.
+*/
+
+static int get_time(
+    char *str,             /* The value text e.g. 1.2n */
+    double *value)         /* The numerical value */
+{
+   char   val_str[82];
+   int    len;
+   int    i;
+   char   c = '\0';
+   char   c1;
+   float  scale_factor;
+   float  number;
+
+   len = strlen(str);
+   if(len > (sizeof(val_str) - 1))
+      len = sizeof(val_str) - 1;
+
+   for(i = 0; i < len; i++) {
+      c = str[i];
+      if(isalpha(c) && (c != 'E') && (c != 'e'))
+         break;
+      else if(isspace(c))
+         break;
+      else
+         val_str[i] = c;
+   }
+   val_str[i] = '\0';
+
+   if((i >= len) || (! isalpha(c)))
+      scale_factor = 1.0;
+   else {
+      switch(tolower(c)) {
+      case 't': scale_factor = 1.0e12;  break;
+      case 'g': scale_factor = 1.0e9;   break;
+      case 'k': scale_factor = 1.0e3;   break;
+      case 'u': scale_factor = 1.0e-6;  break;
+      case 'n': scale_factor = 1.0e-9;  break;
+      case 'p': scale_factor = 1.0e-12; break;
+      case 'f': scale_factor = 1.0e-15; break;
+      case 'm':
+         c1 = (i + 1 < len) ? toupper(str[i + 1]) : '\0';
+         if(c1 == 'E')
+            scale_factor = 1.0e6;
+         else if(c1 == 'I')
+            scale_factor = 25.4e-6;
+         else
+            scale_factor = 1.0e-3;
+         break;
+      default:  scale_factor = 1.0;     break;
+      }
+   }
+
+   if(sscanf(val_str, "%e", &number) < 1)
+      return(1);
+
+   number = number * scale_factor;
+   *value = number;
+   return(0);
+}
+
+
+/*
+fail
+
+Print an error message and exit.
+*/
+
+static void fail(
+    char *file,            /* The file the problem is in */
+    long line_num,         /* The line it is on, or 0 */
+    char *msg)             /* What is wrong */
+{
+   if(line_num > 0)
+      fprintf(stderr, "srcconv: %s, line %ld: %s\n", file, line_num, msg);
+   else
+      fprintf(stderr, "srcconv: %s: %s\n", file, msg);
+   exit(1);
+}
@@ -74,6 +74,12 @@ CKTacct(ckt,anal,which,val)
     case OPT_TRANSOLVE:
         val->rValue = ckt->CKTstat->STATtranSolveTime;
         break;
+    case OPT_LUFACTORS:
+        val->iValue = ckt->CKTstat->STATnumLUfac;
+        break;
+    case OPT_LUSAVED:
+        val->iValue = ckt->CKTstat->STATsavedLUfac;
+        break;
     case OPT_TEMP:
         val->rValue = ckt->CKTtemp - CONSTCtoK;
         break;
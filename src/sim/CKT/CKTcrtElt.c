@@ -43,6 +43,12 @@ CKTcrtElt(ckt,inModPtr,inInstPtr,name)
     if(instPtr == (GENinstance *)NULL) return(E_NOMEM);
     instPtr->GENname = name;
     instPtr->GENmodPtr = modPtr;
+    error = CKThashAdd(&(((CKTcircuit *)ckt)->CKTinstTab),name,
+            (GENERIC *)instPtr);
+    if(error) {
+        FREE(instPtr);
+        return(error);
+    }
     instPtr->GENnextInstance = modPtr->GENinstances;
     modPtr->GENinstances = instPtr;
     if(inInstPtr != NULL) *inInstPtr = (GENERIC *)instPtr;
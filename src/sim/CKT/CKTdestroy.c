@@ -47,6 +47,10 @@ CKTdestroy(inCkt)
     }
     if(ckt->CKTmatrix)      SMPdestroy(ckt->CKTmatrix);
     if(ckt->CKTbreaks)      FREE(ckt->CKTbreaks);
+    if(ckt->CKTtouched)     FREE(ckt->CKTtouched);
+    if(ckt->CKTwarmRhs)     FREE(ckt->CKTwarmRhs);
+    if(ckt->CKTwarmState)   FREE(ckt->CKTwarmState);
+    if(ckt->CKTsnapFile)    FREE(ckt->CKTsnapFile);
     for(node = ckt->CKTnodes; node; ) {
         nnode = node->next;
         FREE(node);
@@ -54,6 +58,9 @@ CKTdestroy(inCkt)
     }
     ckt->CKTnodes = (CKTnode *)NULL;
     ckt->CKTlastNode = (CKTnode *)NULL;
+    CKThashFree(&(ckt->CKTnodeTab));
+    CKThashFree(&(ckt->CKTmodTab));
+    CKThashFree(&(ckt->CKTinstTab));
     FREE(ckt);
     return(OK);
 }
@@ -3,24 +3,42 @@
  */
 
     /* CKTdltInst
-     *  delete the specified instance - not yet supported in spice 
+     *  delete the specified instance, if its device knows how
      */
 
 #include "prefix.h"
 #include <stdio.h>
 #include "CKTdefs.h"
+#include "DEVdefs.h"
 #include "IFsim.h"
 #include "SPerror.h"
 #include "util.h"
 #include "suffix.h"
 
-RCSID("CKTdltInst.c $Revision: 1.1 $ on $Date: 91/04/02 12:07:21 $")
+RCSID("CKTdltInst.c $Revision: 1.2 $ on $Date: 92/10/12 09:40:17 $")
+
+extern SPICEdev *DEVices[];
 
-/* ARGSUSED */
 int
 CKTdltInst(ckt,instance)
     GENERIC *ckt;
     GENERIC *instance;
 {
-    return(E_UNSUPP);
+    GENinstance *inst = (GENinstance *)instance;
+    GENmodel *mod;
+    IFuid name;
+    int type;
+    int error;
+
+    if(inst == (GENinstance *)NULL) return(E_NODEV);
+    mod = inst->GENmodPtr;
+    type = mod->GENmodType;
+    if((*DEVices[type]).DEVdelete == NULL) return(E_UNSUPP);
+
+    name = inst->GENname;
+    error = (*((*DEVices[type]).DEVdelete))(mod,name,(GENinstance **)&inst);
+    if(error) return(error);
+    /* only the pointer is compared, so it is all right that it's gone */
+    CKThashDel(&(((CKTcircuit *)ckt)->CKTinstTab),name,instance);
+    return(OK);
 }
@@ -3,24 +3,43 @@
  */
 
     /* CKTdltMod
-     *  delete the specified model - not yet supported in spice 
+     *  delete the specified model, along with all of its instances,
+     *  if its device knows how
      */
 
 #include "prefix.h"
 #include <stdio.h>
 #include "CKTdefs.h"
+#include "DEVdefs.h"
 #include "IFsim.h"
 #include "SPerror.h"
 #include "util.h"
 #include "suffix.h"
 
-RCSID("CKTdltMod.c $Revision: 1.1 $ on $Date: 91/04/02 12:07:22 $")
+RCSID("CKTdltMod.c $Revision: 1.2 $ on $Date: 92/10/12 09:40:17 $")
+
+extern SPICEdev *DEVices[];
 
-/* ARGSUSED */
 int
-CKTdltMod(ckt,modPtr)
-    GENERIC *ckt;
+CKTdltMod(inCkt,modPtr)
+    GENERIC *inCkt;
     GENERIC *modPtr;
 {
-    return(E_UNSUPP);
+    register CKTcircuit *ckt = (CKTcircuit *)inCkt;
+    GENmodel *mod = (GENmodel *)modPtr;
+    GENinstance *here;
+    int type;
+
+    if(mod == (GENmodel *)NULL) return(E_NOMOD);
+    type = mod->GENmodType;
+    if((*DEVices[type]).DEVmodDelete == NULL) return(E_UNSUPP);
+
+    /* the device frees the instances too, so take them out of the
+     * index while they are still there to look at */
+    for(here = mod->GENinstances; here != NULL; here = here->GENnextInstance) {
+        CKThashDel(&(ckt->CKTinstTab),here->GENname,(GENERIC *)here);
+    }
+    CKThashDel(&(ckt->CKTmodTab),mod->GENmodName,modPtr);
+    return((*((*DEVices[type]).DEVmodDelete))(&(ckt->CKThead[type]),
+            mod->GENmodName,mod));
 }
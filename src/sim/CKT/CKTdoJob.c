@@ -11,6 +11,7 @@
 
 /* gtri - add - wbk - 11/26/90 - add include for MIF and EVT global data */
 #include "MIF.h"
+#include "MIFproto.h"
 #include "EVTproto.h"
 /* gtri - end - wbk - 11/26/90 */
 
@@ -38,8 +39,18 @@ CKTdoJob(inCkt,reset,inTask)
     int i;
     double startTime;
     unsigned  senflag ;
+    int tempAll;
 
     startTime = (*(SPfrontEnd->IFseconds))();
+    /* the temperature routines use these, so a rerun with any of them
+     * changed has to redo every model
+     */
+    tempAll = ckt->CKTtemp != task->TSKtemp ||
+            ckt->CKTnomTemp != task->TSKnomTemp ||
+            ckt->CKTdefaultMosL != task->TSKdefaultMosL ||
+            ckt->CKTdefaultMosW != task->TSKdefaultMosW ||
+            ckt->CKTdefaultMosAD != task->TSKdefaultMosAD ||
+            ckt->CKTdefaultMosAS != task->TSKdefaultMosAS;
     ckt->CKTtemp  = task->TSKtemp;
     ckt->CKTnomTemp  = task->TSKnomTemp;
     ckt->CKTmaxOrder  = task->TSKmaxOrder;
@@ -70,7 +81,44 @@ CKTdoJob(inCkt,reset,inTask)
     ckt->CKTdefaultMosAS  = task->TSKdefaultMosAS;
     ckt->CKTfixLimit  = task->TSKfixLimit;
     ckt->CKTnoOpIter  = task->TSKnoOpIter;
-    if(reset) {
+    ckt->CKTluReuse  = task->TSKluReuse;
+    ckt->CKTwarmStart = WARM_NONE;
+    if(reset == RERUN && (ckt->CKTniState & NIUNINITIALIZED)) {
+        /* never got as far as being set up */
+        reset = RESTART;
+    }
+    if(reset == RERUN && ckt->evt->counts.num_insts > 0) {
+        /* code models only allocate their event state when first called,
+         * so event-driven circuits can't keep it - the front end should
+         * have reparsed the deck (if_canrerun)
+         */
+        reset = RESTART;
+    }
+    if(reset == RERUN && ckt->CKTsetupTouched) {
+        /* a parameter that decides which nodes and matrix elements the
+         * devices make has changed - the front end should have reparsed
+         * the deck (if_canrerun), the setup routines don't take away
+         * what they made before
+         */
+        reset = RESTART;
+    }
+    if(reset == RERUN) {
+        /* matrix structure, states and ordering are still valid from the
+         * previous RESTART, only parameters may have been changed, so just
+         * redo the temperature dependent precomputation for the models
+         * that were touched - or all of them if the options they use
+         * have changed - and start from the last operating point
+         */
+        if(tempAll) ckt->CKTnumTouched = -1;
+        error = CKTtempTouched(ckt);
+        if(error) {
+            ckt->CKTstat->STATtotAnalTime += 
+                    (*(SPfrontEnd->IFseconds))()-startTime;
+            return(error);
+        }
+        ckt->CKTcurrentAnalysis = 0;
+        ckt->CKTwarmStart = WARM_GUESS;
+    } else if(reset) {
         which = -1;
         senflag = 0;
         for(i=0;i<ANALmaxnum;i++) {
@@ -122,6 +170,16 @@ CKTdoJob(inCkt,reset,inTask)
         }
         ckt->CKTcurrentAnalysis = 0;
     }
+    if(reset) {
+        error = CKTsnapLoad(ckt);
+        if(error) {
+            ckt->CKTstat->STATtotAnalTime += 
+                    (*(SPfrontEnd->IFseconds))()-startTime;
+            return(error);
+        }
+        /* partials kept for code models may be for the old parameters */
+        MIFauto_clear(ckt);
+    }
 
     /* gtri - add - 12/12/90 - wbk - return if syntax errors from parsing */
     if(g_ipc.enabled) {
@@ -25,6 +25,7 @@ CKTfndDev(Ckt,type,fast,name,modfast,modname)
     register CKTcircuit *ckt=(CKTcircuit *)Ckt;
     register GENinstance *here;
     register GENmodel *mods;
+    register CKThashEnt *ent;
 
     if((GENinstance **)fast != (GENinstance **)NULL && 
             *(GENinstance **)fast != (GENinstance *)NULL) {
@@ -33,62 +34,39 @@ CKTfndDev(Ckt,type,fast,name,modfast,modname)
         if(type) *type = (*((GENinstance**)fast))->GENmodPtr->GENmodType;
         return(OK);
     } 
-    if(modfast) {
-        /* have model, just need device */
-        mods = (GENmodel*)modfast;
-        for(here = mods->GENinstances ; here != NULL; 
-                here = here->GENnextInstance) {
-            if (here->GENname == name) {
-                if(fast != NULL) *(GENinstance **)fast = here;
-                if(type) *type = mods->GENmodType;
-                return(OK);
-            }
+    if(!modfast && (*type < -1 || *type >= DEVmaxnum)) return(E_BADPARM);
+
+    /* go straight to the instances of that name through the index, and
+     * take the first one that is of the right type and model */
+    for(ent = CKThashFirst(&(ckt->CKTinstTab),name); ent != NULL;
+            ent = CKThashNext(ent)) {
+        here = (GENinstance *)ent->data;
+        mods = here->GENmodPtr;
+        if(modfast) {
+            if(mods != (GENmodel *)modfast) continue;
+        } else {
+            if(*type >= 0 && mods->GENmodType != *type) continue;
+            if(modname != (char *)NULL && mods->GENmodName != modname)
+                continue;
         }
-        return(E_NODEV);
+        if(fast != NULL) *(GENinstance **)fast = here;
+        if(type) *type = mods->GENmodType;
+        return(OK);
     }
-    if(*type >=0 && *type < DEVmaxnum) {
-        /* have device type, need to find model & device */
-        /* look through all models */
-        for(mods=(GENmodel *)ckt->CKThead[*type]; mods != NULL ; 
-                mods = mods->GENnextModel) {
-            /* and all instances */
-            if(modname == (char *)NULL || mods->GENmodName == modname) {
-                for(here = mods->GENinstances ; here != NULL; 
-                        here = here->GENnextInstance) {
-                    if (here->GENname == name) {
-                        if(fast != 0) *(GENinstance **)fast = here;
-                        return(OK);
-                    }
-                }
-                if(mods->GENmodName == modname) {
-                    return(E_NODEV);
-                }
-            }
-        }
-        return(E_NOMOD);
-    } else if(*type == -1) {
-        /* look through all types (UGH - worst case - take forever) */ 
-        for(*type = 0;*type <DEVmaxnum;(*type)++) {
-            /* need to find model & device */
-            /* look through all models */
-            for(mods=(GENmodel *)ckt->CKThead[*type];mods!=NULL;
-                    mods = mods->GENnextModel) {
-                /* and all instances */
-                if(modname == (char *)NULL || mods->GENmodName == modname) {
-                    for(here = mods->GENinstances ; here != NULL; 
-                            here = here->GENnextInstance) {
-                        if (here->GENname == name) {
-                            if(fast != 0) *(GENinstance **)fast = here;
-                            return(OK);
-                        }
-                    }
-                    if(mods->GENmodName == modname) {
-                        return(E_NODEV);
-                    }
-                }
+
+    /* not there - work out which error the caller gets */
+    if(modfast) return(E_NODEV);
+    if(modname != (char *)NULL) {
+        for(ent = CKThashFirst(&(ckt->CKTmodTab),modname); ent != NULL;
+                ent = CKThashNext(ent)) {
+            mods = (GENmodel *)ent->data;
+            if(*type == -1 || mods->GENmodType == *type) {
+                /* the model is there, just not the device */
+                *type = mods->GENmodType;
+                return(E_NODEV);
             }
         }
-        *type = -1;
-        return(E_NODEV);
-    } else return(E_BADPARM);
+    }
+    if(*type == -1) return(E_NODEV);
+    return(E_NOMOD);
 }
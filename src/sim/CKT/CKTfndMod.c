@@ -21,6 +21,7 @@ CKTfndMod(ckt,type,modfast,modname)
     IFuid modname;
 {
     register GENmodel *mods;
+    register CKThashEnt *ent;
 
     if(modfast != NULL && *(GENmodel **)modfast != NULL) {
         /* already have  modfast, so nothing to do */
@@ -29,29 +30,24 @@ CKTfndMod(ckt,type,modfast,modname)
     } 
     if(*type >=0 && *type < DEVmaxnum) {
         /* have device type, need to find model */
-        /* look through all models */
-        for(mods=((CKTcircuit *)ckt)->CKThead[*type]; mods != NULL ; 
-                mods = mods->GENnextModel) {
-            if(mods->GENmodName == modname) {
+        for(ent = CKThashFirst(&(((CKTcircuit *)ckt)->CKTmodTab),modname);
+                ent != NULL; ent = CKThashNext(ent)) {
+            mods = (GENmodel *)ent->data;
+            if(mods->GENmodType == *type) {
                 *modfast = (char *)mods;
                 return(OK);
             }
         }
         return(E_NOMOD);
     } else if(*type == -1) {
-        /* look through all types (UGH - worst case - take forever) */ 
-        for(*type = 0;*type <DEVmaxnum;(*type)++) {
-            /* need to find model & device */
-            /* look through all models */
-            for(mods=((CKTcircuit *)ckt)->CKThead[*type];mods!=NULL;
-                    mods = mods->GENnextModel) {
-                if(mods->GENmodName == modname) {
-                    *modfast = (char *)mods;
-                    return(OK);
-                }
-            }
+        /* any type will do */
+        ent = CKThashFirst(&(((CKTcircuit *)ckt)->CKTmodTab),modname);
+        if(ent != NULL) {
+            mods = (GENmodel *)ent->data;
+            *type = mods->GENmodType;
+            *modfast = (char *)mods;
+            return(OK);
         }
-        *type = -1;
         return(E_NOMOD);
     } else return(E_BADPARM);
 }
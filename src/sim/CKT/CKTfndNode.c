@@ -23,7 +23,16 @@ CKTfndNode(ckt,node,name)
     IFuid name;
 {
     register CKTnode *here;
+    CKThashEnt *ent;
 
+    if(name != (IFuid)NULL) {
+        ent = CKThashFirst(&(((CKTcircuit *)ckt)->CKTnodeTab),name);
+        if(ent == (CKThashEnt *)NULL) return(E_NOTFOUND);
+        if(node) *node = (char *)ent->data;
+        return(OK);
+    }
+    /* only the ground node might not have a name, and that isn't in
+     * the index */
     for (here = ((CKTcircuit *)ckt)->CKTnodes; here; here = here->next)  {
         if(here->name == name) {
             if(node) *node = (char *)here;
@@ -44,6 +44,8 @@ CKTground(inCkt,node,name)
         ckt->CKTlastNode = ckt->CKTnodes;
     }
     if(node)*node = (char *)ckt->CKTnodes;
+    if(name) return(CKThashAdd(&(ckt->CKTnodeTab),name,
+            (GENERIC *)ckt->CKTnodes));
     return(OK);
 
 }
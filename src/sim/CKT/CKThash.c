@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 1985 Thomas L. Quarles
+ */
+
+    /* CKThash
+     *  Hash indexes from uids to the nodes, models and instances they
+     *  name, so that finding one doesn't mean walking every list in the
+     *  circuit.  Uids are unique, so two names are the same exactly when
+     *  the pointers are, and it is the pointer that gets hashed.
+     *  Defined: CKThashAdd, CKThashDel, CKThashFirst, CKThashNext,
+     *  CKThashFree
+     */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "CKTdefs.h"
+#include "util.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+/* size of a table when it is first used */
+#define CKTHASHINIT 256
+
+#ifdef __STDC__
+static int CKThashKey(CKThash *, IFuid);
+static int CKThashGrow(CKThash *);
+#else /* stdc */
+static int CKThashKey();
+static int CKThashGrow();
+#endif /* stdc */
+
+
+/* add an entry for 'key' - it doesn't check for one already there */
+int
+CKThashAdd(tab,key,data)
+    register CKThash *tab;
+    IFuid key;
+    GENERIC *data;
+{
+    register CKThashEnt *ent;
+    int error;
+    int i;
+
+    if(tab->CKTentryCount >= 2 * tab->CKTbucketCount) {
+        error = CKThashGrow(tab);
+        if(error) return(error);
+    }
+    ent = (CKThashEnt *)MALLOC(sizeof(CKThashEnt));
+    if(ent == (CKThashEnt *)NULL) return(E_NOMEM);
+    ent->key = key;
+    ent->data = data;
+    i = CKThashKey(tab,key);
+    ent->next = tab->CKTbuckets[i];
+    tab->CKTbuckets[i] = ent;
+    tab->CKTentryCount++;
+    return(OK);
+}
+
+
+/* remove the entry for 'key' that points at 'data' */
+void
+CKThashDel(tab,key,data)
+    register CKThash *tab;
+    IFuid key;
+    GENERIC *data;
+{
+    register CKThashEnt **prev;
+    register CKThashEnt *ent;
+
+    if(tab->CKTbucketCount == 0) return;
+    for(prev = &(tab->CKTbuckets[CKThashKey(tab,key)]); (ent = *prev);
+            prev = &(ent->next)) {
+        if(ent->key == key && ent->data == data) {
+            *prev = ent->next;
+            FREE(ent);
+            tab->CKTentryCount--;
+            return;
+        }
+    }
+}
+
+
+/* first entry for 'key', or NULL if there aren't any */
+CKThashEnt *
+CKThashFirst(tab,key)
+    register CKThash *tab;
+    IFuid key;
+{
+    register CKThashEnt *ent;
+
+    if(tab->CKTbucketCount == 0) return((CKThashEnt *)NULL);
+    for(ent = tab->CKTbuckets[CKThashKey(tab,key)]; ent; ent = ent->next) {
+        if(ent->key == key) return(ent);
+    }
+    return((CKThashEnt *)NULL);
+}
+
+
+/* next entry with the same key as 'ent', or NULL */
+CKThashEnt *
+CKThashNext(ent)
+    register CKThashEnt *ent;
+{
+    register IFuid key = ent->key;
+
+    for(ent = ent->next; ent; ent = ent->next) {
+        if(ent->key == key) return(ent);
+    }
+    return((CKThashEnt *)NULL);
+}
+
+
+/* throw away the whole index (but not what it points at) */
+void
+CKThashFree(tab)
+    register CKThash *tab;
+{
+    register CKThashEnt *ent;
+    register CKThashEnt *next;
+    register int i;
+
+    for(i = 0; i < tab->CKTbucketCount; i++) {
+        for(ent = tab->CKTbuckets[i]; ent; ent = next) {
+            next = ent->next;
+            FREE(ent);
+        }
+    }
+    if(tab->CKTbuckets) FREE(tab->CKTbuckets);
+    tab->CKTbucketCount = 0;
+    tab->CKTentryCount = 0;
+}
+
+
+static int
+CKThashKey(tab,key)
+    CKThash *tab;
+    IFuid key;
+{
+    register unsigned long h = (unsigned long)key;
+
+    /* the low bits of a heap pointer are nearly always zero, and the
+     * names were mostly allocated in order, so fold a few shifts in */
+    h = (h >> 3) ^ (h >> 10) ^ (h >> 17);
+    return((int)(h & (tab->CKTbucketCount - 1)));
+}
+
+
+/* double the number of buckets (or start the table off) */
+static int
+CKThashGrow(tab)
+    register CKThash *tab;
+{
+    CKThashEnt **old = tab->CKTbuckets;
+    int oldCount = tab->CKTbucketCount;
+    register CKThashEnt *ent;
+    CKThashEnt *next;
+    int i, j;
+
+    tab->CKTbucketCount = oldCount ? 2 * oldCount : CKTHASHINIT;
+    tab->CKTbuckets = (CKThashEnt **)MALLOC(tab->CKTbucketCount *
+            sizeof(CKThashEnt *));
+    if(tab->CKTbuckets == (CKThashEnt **)NULL) {
+        tab->CKTbuckets = old;
+        tab->CKTbucketCount = oldCount;
+        return(E_NOMEM);
+    }
+    for(i = 0; i < oldCount; i++) {
+        for(ent = old[i]; ent; ent = next) {
+            next = ent->next;
+            j = CKThashKey(tab,ent->key);
+            ent->next = tab->CKTbuckets[j];
+            tab->CKTbuckets[j] = ent;
+        }
+    }
+    if(old) FREE(old);
+    return(OK);
+}
@@ -33,11 +33,14 @@ CKTinit(ckt)
 /* gtri - begin - dynamically allocate the array of model lists */
 /* CKThead used to be statically sized in CKTdefs.h, but has been changed */
 /* to a ** pointer */
-    (sckt)->CKThead = (GENmodel **)MALLOC(DEVmaxnum * sizeof(GENmodel *));
+    (sckt)->CKThead = (GENmodel **)MALLOC(DEVmaxslots * sizeof(GENmodel *));
     if((sckt)->CKThead == NULL) return(E_NOMEM);
 /* gtri - end   - dynamically allocate the array of model lists */
 
-    for (i=0;i<DEVmaxnum;i++) {
+    /* room for every device there could be, since code models may be
+     * loaded while the circuit is being read in
+     */
+    for (i=0;i<DEVmaxslots;i++) {
         (sckt)->CKThead[i] = (GENmodel *) NULL;
     }
     (sckt)->CKTmaxEqNum = 1;
@@ -107,6 +110,7 @@ CKTinit(ckt)
     g_mif_info.errmsg            = NULL;
     g_mif_info.auto_partial.global = MIF_FALSE;
     g_mif_info.auto_partial.local = MIF_FALSE;
+    g_mif_info.auto_partial.reuse = MIF_FALSE;
 /* gtri - end - wbk - 01/12/91 */
 
     return(OK);
@@ -40,5 +40,7 @@ CKTlinkEq(ckt,node)
     ckt->CKTlastNode = ckt->CKTlastNode->next;
     ckt->CKTlastNode->number = ckt->CKTmaxEqNum++;
     ckt->CKTlastNode->next = (CKTnode *)NULL;
+    if(node->name) return(CKThashAdd(&(ckt->CKTnodeTab),node->name,
+            (GENERIC *)node));
     return(OK);
 }
@@ -23,16 +23,14 @@ CKTmapNode(ckt,node,name)
     GENERIC **node;
     IFuid name;
 {
-    register CKTnode *here;
     int error;
     IFuid uid;
     CKTnode *mynode;
 
-    for (here = ((CKTcircuit *)ckt)->CKTnodes; here; here = here->next)  {
-        if(here->name == name) {
-            if(node) *node = (char *)here;
-            return(E_EXISTS);
-        }
+    error = CKTfndNode(ckt,(GENERIC **)&mynode,name);
+    if(error == OK) {
+        if(node) *node = (char *)mynode;
+        return(E_EXISTS);
     }
     /* not found, so must be a new one */
     error = CKTmkNode((CKTcircuit*)ckt,&mynode); /*allocate the node*/
@@ -34,6 +34,12 @@ CKTmodCrt(ckt,type,modfast,name)
         if(mymodfast == (GENmodel *)NULL) return(E_NOMEM);
         mymodfast->GENmodType = type;
         mymodfast->GENmodName = name;
+        error = CKThashAdd(&(((CKTcircuit *)ckt)->CKTmodTab),name,
+                (GENERIC *)mymodfast);
+        if(error) {
+            FREE(mymodfast);
+            return(error);
+        }
         mymodfast->GENnextModel =(GENmodel *)((CKTcircuit *)ckt)->CKThead[type];
         ((CKTcircuit *)ckt)->CKThead[type]=(GENmodel *)mymodfast;
         if(modfast) *modfast=(GENERIC *)mymodfast;
@@ -29,10 +29,13 @@ CKTmodParam(ckt,modfast,param,val,selector)
     IFvalue *selector;
 {
     register int type = ((GENmodel *)modfast)->GENmodType;
+    int error;
 
     if (((*DEVices[type]).DEVmodParam)) {
-        return(((*((*DEVices[type]).DEVmodParam)) (param,val,
-                (GENmodel *)modfast)));
+        error = (*((*DEVices[type]).DEVmodParam)) (param,val,
+                (GENmodel *)modfast);
+        if(error) return(error);
+        return(CKTtouch((CKTcircuit *)ckt,(GENmodel *)modfast,param,1));
     } else {
         return(E_BADPARM);
     }
@@ -51,5 +51,7 @@ CKTnewNode(inCkt,node,name)
     ckt->CKTlastNode->next = (CKTnode *)NULL;
 
     if(node) *node = (GENERIC *)ckt->CKTlastNode;
+    if(name) return(CKThashAdd(&(ckt->CKTnodeTab),name,
+            (GENERIC *)ckt->CKTlastNode));
     return(OK);
 }
@@ -62,5 +62,6 @@ CKTnewTask(ckt,taskPtr,taskName)
     tsk->TSKdefaultMosAD = 0;
     tsk->TSKdefaultMosAS = 0;
     tsk->TSKnoOpIter=0;
+    tsk->TSKluReuse=0;
     return(OK);
 }
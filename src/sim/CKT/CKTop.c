@@ -11,6 +11,10 @@
 
 RCSID("CKTop.c $Revision: 1.3 $ on $Date: 91/08/01 17:18:38 $")
 
+static int opwarm();
+static int opfits();
+static void opsave();
+
 int
 CKTop(ckt,firstmode, continuemode, iterlim) 
     CKTcircuit *ckt;
@@ -21,6 +25,13 @@ CKTop(ckt,firstmode, continuemode, iterlim)
     int converged;
     int i;
 
+    /* on a rerun after a few parameters have changed, the last operating
+     * point is usually close enough to converge from directly
+     */
+    if(ckt->CKTwarmStart && opwarm(ckt,continuemode,iterlim) == 0) {
+        return(0);
+    }
+
     ckt->CKTmode = firstmode;
     if(!ckt->CKTnoOpIter) {
 /* gtri - begin - wbk - add convergence problem reporting flags */
@@ -75,6 +86,7 @@ CKTop(ckt,firstmode, continuemode, iterlim)
 /* gtri - begin - wbk - add convergence problem reporting flags */
                 ckt->enh->conv_debug.last_NIiter_call = MIF_FALSE;
 /* gtri - end - wbk - add convergence problem reporting flags */
+                opsave(ckt);
                 return(0);
             }
             (*(SPfrontEnd->IFerror))(ERR_WARNING,
@@ -118,6 +130,7 @@ CKTop(ckt,firstmode, continuemode, iterlim)
 /* gtri - begin - wbk - add convergence problem reporting flags */
             ckt->enh->conv_debug.last_NIiter_call = MIF_FALSE;
 /* gtri - end - wbk - add convergence problem reporting flags */
+            opsave(ckt);
             return(0);
         } else {
 /* gtri - begin - wbk - add convergence problem reporting flags */
@@ -129,5 +142,127 @@ CKTop(ckt,firstmode, continuemode, iterlim)
 /* gtri - begin - wbk - add convergence problem reporting flags */
     ckt->enh->conv_debug.last_NIiter_call = MIF_FALSE;
 /* gtri - end - wbk - add convergence problem reporting flags */
+    opsave(ckt);
+    return(0);
+}
+
+/* Try to converge from the operating point saved by opsave, returning 0
+ * if that worked.  If it didn't, or there isn't a usable one, the caller
+ * starts over the usual way.  A point read from a snapshot may be taken
+ * as it is (WARM_ACCEPT) if it still satisfies the equations.
+ */
+
+static int
+opwarm(ckt,continuemode,iterlim)
+    CKTcircuit *ckt;
+    long continuemode;    
+    int iterlim;
+{
+    int converged;
+    int size;
+    int i;
+
+    size = SMPmatSize(ckt->CKTmatrix) + 1;
+    if(ckt->CKTwarmSize != size || ckt->CKTwarmStates != ckt->CKTnumStates ||
+            (continuemode & MODEUIC)) {
+        return(1);
+    }
+    for(i=0;i<size;i++) {
+        ckt->CKTrhsOld[i] = ckt->CKTwarmRhs[i];
+    }
+    for(i=0;i<ckt->CKTnumStates;i++) {
+        ckt->CKTstate0[i] = ckt->CKTwarmState[i];
+    }
+    ckt->CKTmode = continuemode;
+
+    if(ckt->CKTwarmStart == WARM_ACCEPT) {
+        ckt->CKTnoncon = 0;
+        if(CKTload(ckt) == 0 && ckt->CKTnoncon == 0 && opfits(ckt)) {
+            ckt->CKTsnapUsed = 1;
+            return(0);
+        }
+        (*(SPfrontEnd->IFerror))(ERR_INFO,
+                "snapshot operating point no longer fits, iterating from it",
+                (IFuid *)NULL);
+        ckt->CKTwarmStart = WARM_GUESS;
+        for(i=0;i<ckt->CKTnumStates;i++) {
+            ckt->CKTstate0[i] = ckt->CKTwarmState[i];
+        }
+    }
+
+    ckt->enh->conv_debug.last_NIiter_call = MIF_FALSE;
+    converged = NIiter(ckt,iterlim);
+    if(converged != 0) {
+        (*(SPfrontEnd->IFerror))(ERR_INFO,
+                "no convergence from the last operating point",(IFuid *)NULL);
+        return(converged);
+    }
+    opsave(ckt);
     return(0);
 }
+
+/* Check that the point in CKTrhsOld, with the matrix and rhs just loaded
+ * from it, is a solution - that the residual of each equation is no
+ * more than the change a Newton step within the convergence tolerances
+ * could make to it.
+ */
+
+static int
+opfits(ckt)
+    CKTcircuit *ckt;
+{
+    register SMPmatrix *matrix = ckt->CKTmatrix;
+    register SMPelement *here;
+    register double *tol = ckt->CKTrhsSpare;
+    register double *x = ckt->CKTrhsOld;
+    CKTnode *node;
+    double sum;
+    double bound;
+    int row;
+    int col;
+
+    /* the tolerance on each unknown, as NIconvTest has it */
+    for(row=1;row<=matrix->SMPsize;row++) {
+        tol[row] = ckt->CKTvoltTol;
+    }
+    for(node = ckt->CKTnodes; node; node = node->next) {
+        if(node->number == 0) continue;
+        tol[node->number] = ckt->CKTreltol * FABS(x[node->number]) +
+                ((node->type == NODE_VOLTAGE) ? ckt->CKTvoltTol :
+                ckt->CKTabstol);
+    }
+
+    for(row=1;row<=matrix->SMPsize;row++) {
+        sum = 0;
+        bound = ckt->CKTabstol;
+        for(here = *(matrix->SMProwHead + row); here != NULL;
+                here = here->SMProwNext) {
+            col = here->SMPcolNumber;
+            if(col == 0) continue;
+            col = SMPintToExtMapCol(col,matrix);
+            sum += here->SMPvalue * x[col];
+            bound += FABS(here->SMPvalue) * tol[col];
+        }
+        if(FABS(ckt->CKTrhs[SMPintToExtMapRow(row,matrix)] - sum) > bound) {
+            return(0);
+        }
+    }
+    return(1);
+}
+
+/* Keep a converged operating point for opwarm. */
+
+static void
+opsave(ckt)
+    CKTcircuit *ckt;
+{
+    int i;
+
+    if(CKTwarmAlloc(ckt) != 0) return;
+    for(i=0;i<ckt->CKTwarmSize;i++) {
+        ckt->CKTwarmRhs[i] = ckt->CKTrhsOld[i];
+    }
+    for(i=0;i<ckt->CKTnumStates;i++) {
+        ckt->CKTwarmState[i] = ckt->CKTstate0[i];
+    }
+}
@@ -29,10 +29,13 @@ CKTparam(ckt,fast,param,val,selector)
     IFvalue *selector;
 {
     register int type;
+    int error;
     GENinstance *myfast = (GENinstance *)fast;
     type = myfast->GENmodPtr->GENmodType;
     if(((*DEVices[type]).DEVparam)) {
-        return(((*((*DEVices[type]).DEVparam)) (param,val,myfast,selector)));
+        error = (*((*DEVices[type]).DEVparam)) (param,val,myfast,selector);
+        if(error) return(error);
+        return(CKTtouch((CKTcircuit *)ckt,myfast->GENmodPtr,param,0));
     } else {
         return(E_BADPARM);
     }
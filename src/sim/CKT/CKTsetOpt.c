@@ -41,6 +41,12 @@ CKTsetOpt(ckt,anal,opt,val)
     case OPT_NOOPITER:
         task->TSKnoOpIter = val->iValue;
         break;
+    case OPT_LUREUSE:
+        task->TSKluReuse = val->iValue;
+        break;
+    case OPT_MIF_AUTO_REUSE:
+        g_mif_info.auto_partial.reuse = MIF_TRUE;
+        break;
     case OPT_GMIN:
         task->TSKgmin = val->rValue;
         break;
@@ -230,6 +236,13 @@ static IFparm OPTtbl[] = {
  { "trancuriters", OPT_TRANCURITER, IF_ASK|IF_INTEGER,
         "Transient iters per point" },
  { "loadtime", OPT_LOADTIME, IF_ASK|IF_REAL,"Load time" },
+ { "lureuse", OPT_LUREUSE, IF_SET|IF_FLAG,
+        "Reuse L-U factors in transient (modified Newton)" },
+ { "lufactors", OPT_LUFACTORS, IF_ASK|IF_INTEGER,"L-U factorizations" },
+ { "lusaved", OPT_LUSAVED, IF_ASK|IF_INTEGER,
+        "L-U factorizations saved by reuse" },
+ { "autopartialreuse", OPT_MIF_AUTO_REUSE, IF_SET|IF_FLAG,
+        "Reuse auto partials while code model inputs are within tolerance" },
 
 /* gtri - begin - wbk - add new options */
  { "maxopalter", OPT_EVT_MAX_OP_ALTER, IF_SET|IF_INTEGER, "Maximum analog/event alternations in DCOP" },
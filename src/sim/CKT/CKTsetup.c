@@ -42,6 +42,13 @@ CKTsetup(ckt)
     register SMPmatrix *matrix;
     ckt->CKTnumStates=0;
 
+    /* everything gets its temperature update after this, and the
+     * equations may have changed under a saved operating point
+     */
+    ckt->CKTnumTouched=0;
+    ckt->CKTsetupTouched=0;
+    ckt->CKTwarmSize=0;
+
 
     if(ckt->CKTsenInfo){
         if (error = CKTsenSetup(ckt)) return(error);
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 1985 Thomas L. Quarles
+ */
+
+    /* Operating point snapshots.
+     *
+     * CKTsnapshot(ckt,file,accept) names a file to keep the operating
+     * point of the circuit in.  Each job then starts by reading it
+     * (CKTsnapLoad), and if it was written for a circuit with the same
+     * nodes, devices and models it becomes the starting point for CKTop
+     * in place of the usual junction voltages.  With accept set, CKTop
+     * takes it as the answer without iterating as long as it still
+     * satisfies the circuit equations.  After a DC or transient
+     * operating point has been found CKTsnapSave writes it back.
+     *
+     * The file holds CKTrhsOld and CKTstate0 in the machine's own
+     * format, so it is only good on the machine that wrote it.  For
+     * circuits with event-driven instances only the analog solution is
+     * kept - the event-driven nodes are found again by EVTop, which
+     * then starts its analog solutions from the snapshot.
+     */
+
+#include "prefix.h"
+#include <stdio.h>
+#include <string.h>
+#include "SMPdefs.h"
+#include "CKTdefs.h"
+#include "util.h"
+#include "DEVdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+extern SPICEdev *DEVices[];
+
+#define SNAPMAGIC 0x584f5053    /* "XOPS" */
+#define SNAPVERSION 1
+
+typedef struct {
+    int SNAPmagic;
+    int SNAPversion;
+    unsigned long SNAPhash;     /* from snaphash, to check the topology */
+    int SNAPsize;               /* length of the solution vector */
+    int SNAPnumStates;          /* and of the state vector */
+} SNAPheader;
+
+static unsigned long snaphash();
+static unsigned long hashstr();
+
+int
+CKTsnapshot(inCkt,file,accept)
+    GENERIC *inCkt;
+    char *file;
+    int accept;
+{
+    register CKTcircuit *ckt = (CKTcircuit *)inCkt;
+
+    if(ckt->CKTsnapFile) FREE(ckt->CKTsnapFile);
+    ckt->CKTsnapAccept = 0;
+    if(file == NULL) return(OK);
+    ckt->CKTsnapFile = MALLOC(strlen(file) + 1);
+    if(ckt->CKTsnapFile == NULL) return(E_NOMEM);
+    (void) strcpy(ckt->CKTsnapFile,file);
+    ckt->CKTsnapAccept = accept;
+    return(OK);
+}
+
+    /* CKTwarmAlloc(ckt)
+     * make sure the space for a saved operating point is the right size
+     * for the circuit as it is set up now
+     */
+
+int
+CKTwarmAlloc(ckt)
+    register CKTcircuit *ckt;
+{
+    int size;
+
+    size = SMPmatSize(ckt->CKTmatrix) + 1;
+    if(ckt->CKTwarmSize != size || ckt->CKTwarmRhs == NULL) {
+        if(ckt->CKTwarmRhs) FREE(ckt->CKTwarmRhs);
+        ckt->CKTwarmSize = 0;
+        ckt->CKTwarmRhs = (double *)MALLOC(size * sizeof(double));
+        if(ckt->CKTwarmRhs == NULL) return(E_NOMEM);
+    }
+    if(ckt->CKTwarmStates != ckt->CKTnumStates) {
+        if(ckt->CKTwarmState) FREE(ckt->CKTwarmState);
+        ckt->CKTwarmStates = 0;
+        ckt->CKTwarmSize = 0;
+        if(ckt->CKTnumStates) {
+            ckt->CKTwarmState = (double *)MALLOC(ckt->CKTnumStates *
+                    sizeof(double));
+            if(ckt->CKTwarmState == NULL) return(E_NOMEM);
+        }
+    }
+    ckt->CKTwarmSize = size;
+    ckt->CKTwarmStates = ckt->CKTnumStates;
+    return(OK);
+}
+
+    /* CKTsnapLoad(ckt)
+     * read the snapshot file, if there is one for this circuit, into
+     * the saved operating point and have CKTop start from it
+     */
+
+int
+CKTsnapLoad(ckt)
+    register CKTcircuit *ckt;
+{
+    SNAPheader head;
+    FILE *fp;
+    int error;
+    int ok;
+
+    ckt->CKTsnapUsed = 0;
+    if(ckt->CKTsnapFile == NULL) return(OK);
+    if((fp = fopen(ckt->CKTsnapFile,"r")) == NULL) return(OK);
+
+    ok = fread((char *)&head,sizeof(head),1,fp) == 1 &&
+            head.SNAPmagic == SNAPMAGIC &&
+            head.SNAPversion == SNAPVERSION &&
+            head.SNAPsize == SMPmatSize(ckt->CKTmatrix) + 1 &&
+            head.SNAPnumStates == ckt->CKTnumStates &&
+            head.SNAPhash == snaphash(ckt);
+    if(!ok) {
+        (void) fclose(fp);
+        (*(SPfrontEnd->IFerror))(ERR_INFO,
+                "operating point snapshot is for a different circuit",
+                (IFuid *)NULL);
+        return(OK);
+    }
+    error = CKTwarmAlloc(ckt);
+    if(error) {
+        (void) fclose(fp);
+        return(error);
+    }
+    ok = fread((char *)ckt->CKTwarmRhs,sizeof(double),head.SNAPsize,fp) ==
+            head.SNAPsize &&
+            fread((char *)ckt->CKTwarmState,sizeof(double),
+            head.SNAPnumStates,fp) == head.SNAPnumStates;
+    (void) fclose(fp);
+    if(!ok) {
+        ckt->CKTwarmSize = 0;
+        return(OK);
+    }
+
+    /* the event-driven nodes aren't in it, so it can only be a guess */
+    if(ckt->CKTsnapAccept && ckt->evt->counts.num_insts == 0) {
+        ckt->CKTwarmStart = WARM_ACCEPT;
+    } else {
+        ckt->CKTwarmStart = WARM_GUESS;
+    }
+    return(OK);
+}
+
+    /* CKTsnapSave(ckt)
+     * write the operating point just found to the snapshot file
+     */
+
+int
+CKTsnapSave(ckt)
+    register CKTcircuit *ckt;
+{
+    SNAPheader head;
+    FILE *fp;
+    int ok;
+
+    /* nothing new if it came straight from the file, and nothing at
+     * all if the initial conditions were used instead
+     */
+    if(ckt->CKTsnapFile == NULL || ckt->CKTsnapUsed ||
+            (ckt->CKTmode & MODEUIC)) return(OK);
+
+    head.SNAPmagic = SNAPMAGIC;
+    head.SNAPversion = SNAPVERSION;
+    head.SNAPhash = snaphash(ckt);
+    head.SNAPsize = SMPmatSize(ckt->CKTmatrix) + 1;
+    head.SNAPnumStates = ckt->CKTnumStates;
+
+    if((fp = fopen(ckt->CKTsnapFile,"w")) == NULL) {
+        (*(SPfrontEnd->IFerror))(ERR_WARNING,
+                "can't write operating point snapshot",(IFuid *)NULL);
+        return(OK);
+    }
+    ok = fwrite((char *)&head,sizeof(head),1,fp) == 1 &&
+            fwrite((char *)ckt->CKTrhsOld,sizeof(double),head.SNAPsize,fp) ==
+            head.SNAPsize &&
+            fwrite((char *)ckt->CKTstate0,sizeof(double),
+            head.SNAPnumStates,fp) == head.SNAPnumStates;
+    if(fclose(fp) != 0) ok = 0;
+    if(!ok) {
+        (*(SPfrontEnd->IFerror))(ERR_WARNING,
+                "can't write operating point snapshot",(IFuid *)NULL);
+        (void) unlink(ckt->CKTsnapFile);
+    }
+    return(OK);
+}
+
+    /* snaphash(ckt)
+     * hash together what decides the meaning of each entry in the
+     * solution and state vectors: the nodes and equations, and the
+     * devices with their models and the nodes they connect to, in the
+     * order setup numbered their states
+     */
+
+static unsigned long
+snaphash(ckt)
+    register CKTcircuit *ckt;
+{
+    register unsigned long hash = 0;
+    register CKTnode *node;
+    register GENmodel *model;
+    register GENinstance *here;
+    IFdevice *dev;
+    int terms;
+    int i;
+    int j;
+
+    hash = hash * 31 + SMPmatSize(ckt->CKTmatrix);
+    hash = hash * 31 + ckt->CKTnumStates;
+    hash = hash * 31 + ckt->evt->counts.num_nodes;
+    hash = hash * 31 + ckt->evt->counts.num_insts;
+
+    for(node = ckt->CKTnodes; node; node = node->next) {
+        hash = hash * 31 + hashstr((char *)node->name);
+        hash = hash * 31 + node->number;
+        hash = hash * 31 + node->type;
+    }
+
+    for(i=0;i<DEVmaxnum;i++) {
+        if(ckt->CKThead[i] == NULL) continue;
+        dev = &(DEVices[i]->DEVpublic);
+        hash = hash * 31 + hashstr(dev->name);
+
+        /* only the spice devices keep their nodes in the generic part */
+        terms = (dev->cm_func == NULL) ? dev->terms : 0;
+        if(terms > 5) terms = 5;
+
+        for(model = ckt->CKThead[i]; model; model = model->GENnextModel) {
+            hash = hash * 31 + hashstr((char *)model->GENmodName);
+            for(here = model->GENinstances; here;
+                    here = here->GENnextInstance) {
+                hash = hash * 31 + hashstr((char *)here->GENname);
+                for(j=0;j<terms;j++) {
+                    hash = hash * 31 + (&(here->GENnode1))[j];
+                }
+            }
+        }
+    }
+    return(hash);
+}
+
+static unsigned long
+hashstr(s)
+    register char *s;
+{
+    register unsigned long hash = 0;
+
+    if(s == NULL) return(0);
+    while(*s) {
+        hash = hash * 31 + (unsigned char) *s++;
+    }
+    return(hash);
+}
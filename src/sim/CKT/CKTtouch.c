@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 1985 Thomas L. Quarles
+ */
+
+    /* CKTtouch(ckt,model,param,modParam)
+     * note that parameter param of the given model (modParam nonzero),
+     * or of one of its instances, has been changed since the circuit
+     * was set up, so that a rerun only has to redo the temperature
+     * dependent precomputation for the models that were touched
+     * (CKTtempTouched) rather than for the whole circuit - unless the
+     * parameter is one that decides what the setup routine builds,
+     * in which case the circuit has to be set up again (CKTsetupTouched)
+     */
+
+#include "prefix.h"
+#include <stdio.h>
+#include <string.h>
+#include "SMPdefs.h"
+#include "CKTdefs.h"
+#include "CONST.h"
+#include "util.h"
+#include "DEVdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+extern SPICEdev *DEVices[];
+
+/* more than this many and it's quicker to just do them all */
+#define MAXTOUCHED 64
+
+/* devices whose temperature routine uses the parameters of instances of
+ * another type, so must be redone when one of those is touched
+ */
+static char *coupled[][2] = {
+    { "Inductor", "mutual" },   /* MUTtemp reads the inductances */
+};
+
+/* parameters that decide which internal nodes and matrix elements the
+ * setup routine of a device makes - "*" for all of them
+ */
+static char *setupParms[][2] = {
+    { "Diode",  "rs" },
+    { "BJT",    "rb" },
+    { "BJT",    "rc" },
+    { "BJT",    "re" },
+    { "JFET",   "rd" },
+    { "JFET",   "rs" },
+    { "MES",    "rd" },
+    { "MES",    "rs" },
+    { "Mos1",   "rd" },
+    { "Mos1",   "rs" },
+    { "Mos1",   "rsh" },
+    { "Mos1",   "nrd" },
+    { "Mos1",   "nrs" },
+    { "Mos2",   "rd" },
+    { "Mos2",   "rs" },
+    { "Mos2",   "rsh" },
+    { "Mos2",   "nrd" },
+    { "Mos2",   "nrs" },
+    { "Mos3",   "rd" },
+    { "Mos3",   "rs" },
+    { "Mos3",   "rsh" },
+    { "Mos3",   "nrd" },
+    { "Mos3",   "nrs" },
+    { "BSIM",   "rsh" },
+    { "BSIM",   "nrd" },
+    { "BSIM",   "nrs" },
+    { "URC",    "*" },      /* the lumps are made from all of them */
+};
+
+static void touchone();
+static int setupParm();
+
+int
+CKTtouch(ckt,model,param,modParam)
+    register CKTcircuit *ckt;
+    GENmodel *model;
+    int param;
+    int modParam;
+{
+    register int i;
+    int type;
+
+    /* before the first setup everything gets done anyway */
+    if(ckt->CKTniState & NIUNINITIALIZED) return(OK);
+
+    if(setupParm(model->GENmodType,param,modParam)) {
+        ckt->CKTsetupTouched = 1;
+    }
+    touchone(ckt,model);
+    for(i=0;i<sizeof(coupled)/sizeof(coupled[0]);i++) {
+        if(strcmp(DEVices[model->GENmodType]->DEVpublic.name,
+                coupled[i][0]) != 0) continue;
+        type = CKTtypelook(coupled[i][1]);
+        if(type < 0) continue;
+        for(model = ckt->CKThead[type]; model; model = model->GENnextModel) {
+            touchone(ckt,model);
+        }
+    }
+    return(OK);
+}
+
+static int
+setupParm(type,param,modParam)
+    int type;
+    int param;
+    int modParam;
+{
+    IFdevice *dev = &(DEVices[type]->DEVpublic);
+    IFparm *parms;
+    char *keyword;
+    register int i;
+    int n;
+
+    if(modParam) {
+        parms = dev->modelParms;
+        n = dev->numModelParms;
+    } else {
+        parms = dev->instanceParms;
+        n = dev->numInstanceParms;
+    }
+    keyword = NULL;
+    for(i=0;i<n;i++) {
+        if(parms[i].id == param) {
+            keyword = parms[i].keyword;
+            break;
+        }
+    }
+    for(i=0;i<sizeof(setupParms)/sizeof(setupParms[0]);i++) {
+        if(strcmp(dev->name,setupParms[i][0]) != 0) continue;
+        if(strcmp(setupParms[i][1],"*") == 0) return(1);
+        if(keyword && strcmp(keyword,setupParms[i][1]) == 0) return(1);
+    }
+    return(0);
+}
+
+static void
+touchone(ckt,model)
+    register CKTcircuit *ckt;
+    GENmodel *model;
+{
+    register int i;
+
+    if(ckt->CKTnumTouched < 0) return;
+    for(i=0;i<ckt->CKTnumTouched;i++) {
+        if(ckt->CKTtouched[i] == model) return;
+    }
+    if(ckt->CKTnumTouched >= MAXTOUCHED) {
+        ckt->CKTnumTouched = -1;
+        return;
+    }
+    if(ckt->CKTnumTouched >= ckt->CKTmaxTouched) {
+        ckt->CKTmaxTouched = ckt->CKTmaxTouched ? 2*ckt->CKTmaxTouched : 8;
+        ckt->CKTtouched = (GENmodel **)REALLOC(ckt->CKTtouched,
+                ckt->CKTmaxTouched * sizeof(GENmodel *));
+        if(ckt->CKTtouched == NULL) {
+            ckt->CKTmaxTouched = 0;
+            ckt->CKTnumTouched = -1;
+            return;
+        }
+    }
+    ckt->CKTtouched[ckt->CKTnumTouched++] = model;
+}
+
+    /* CKTtempTouched(ckt)
+     * redo the temperature dependent precomputation for the models
+     * noted by CKTtouch, or for all of them if there were too many or
+     * the circuit temperature has changed, and start a new list
+     */
+
+int
+CKTtempTouched(ckt)
+    register CKTcircuit *ckt;
+{
+    register int i;
+    GENmodel *model;
+    GENmodel *next;
+    int type;
+    int error;
+
+    if(ckt->CKTnumTouched < 0) {
+        ckt->CKTnumTouched = 0;
+        return(CKTtemp(ckt));
+    }
+
+    ckt->CKTvt = CONSTKoverQ * ckt->CKTtemp;
+
+    for(i=0;i<ckt->CKTnumTouched;i++) {
+        model = ckt->CKTtouched[i];
+        type = model->GENmodType;
+        if((*DEVices[type]).DEVtemperature == NULL) continue;
+
+        /* the temperature routines do a whole list of models, so cut
+         * this one off from the rest for the call
+         */
+        next = model->GENnextModel;
+        model->GENnextModel = NULL;
+        error = (*((*DEVices[type]).DEVtemperature))(model,ckt);
+        model->GENnextModel = next;
+        if(error) return(error);
+    }
+    ckt->CKTnumTouched = 0;
+    return(OK);
+}
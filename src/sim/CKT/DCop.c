@@ -78,6 +78,9 @@ DCop(ckt)
     }
 /* gtri - end - wbk - 6/10/91 - Call EVTop if event-driven instances exist */
 
+    /* keep it for the next run (see CKTsnapshot) */
+    CKTsnapSave(ckt);
+
     ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEDCOP | MODEINITSMSIG;
 
 
@@ -143,6 +143,9 @@ DCtran(ckt,restart)
     }
 /* gtri - end - wbk - Call EVTop if event-driven instances exist */
 
+    /* keep it for the next run (see CKTsnapshot) */
+    CKTsnapSave(ckt);
+
 /* gtri - add - wbk - 12/19/90 - Add IPC stuff */
 
         /* Send the operating point results for Mspice compatibility */
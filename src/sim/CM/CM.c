@@ -34,6 +34,10 @@ INTERFACES
     cm_analog_not_converged()
     cm_analog_auto_partial()
 
+    cm_static_alloc()
+    cm_static_get_ptr()
+    cm_static_cleanup()
+
     cm_message_get_errmsg()
     cm_message_send()
 
@@ -383,6 +387,121 @@ int  cm_analog_converge(
 
 
 
+/*
+cm_static_alloc()
+
+This function is called from code model C functions to allocate
+storage for data that an instance sets up once and afterwards only
+reads, such as a table loaded from a file.  Unlike the storage from
+cm_analog_alloc() and cm_event_alloc(), it is not part of the state
+history - it is never copied to a new timepoint or backed up, so a
+large table costs nothing per call.  The block is zeroed, lives as
+long as the instance, and is found again with cm_static_get_ptr().
+It may only be allocated on the initialization pass.
+*/
+
+void *cm_static_alloc(
+    int tag,            /* The user-specified tag for this block of memory */
+    int bytes)          /* The number of bytes to allocate */
+{
+    MIFinstance  *here;
+
+    Mif_Static_t *static_data;
+
+
+    /* Get the address of the instance struct from g_mif_info */
+    here = g_mif_info.instance;
+
+    /* If not initialization pass, return error */
+    if(here->initialized) {
+        g_mif_info.errmsg =
+        "ERROR - cm_static_alloc() - Cannot alloc when not initialization pass\n";
+        return(NULL);
+    }
+
+    /* Scan blocks on the instance and see if tag has already been used */
+    for(static_data = here->static_data; static_data;
+                                         static_data = static_data->next) {
+        if(tag == static_data->tag) {
+            g_mif_info.errmsg =
+            "ERROR - cm_static_alloc() - Tag already used in previous call\n";
+            return(NULL);
+        }
+    }
+
+    /* Add a new block to the head of the list */
+    static_data = (void *) MALLOC(sizeof(Mif_Static_t));
+    static_data->tag = tag;
+    static_data->bytes = bytes;
+    static_data->block = (void *) MALLOC(bytes > 0 ? bytes : 1);
+    static_data->cleanup = NULL;
+    static_data->next = here->static_data;
+    here->static_data = static_data;
+
+    return(static_data->block);
+}
+
+
+
+/*
+cm_static_get_ptr()
+
+This function is called from code model C functions to return a
+pointer to storage allocated with cm_static_alloc().  There is only
+one copy, so unlike cm_analog_get_ptr() and cm_event_get_ptr() there
+is no timepoint argument.
+*/
+
+void *cm_static_get_ptr(
+    int tag)            /* The user-specified tag for this block of memory */
+{
+    Mif_Static_t *static_data;
+
+
+    /* Scan blocks on the instance struct and see if tag exists */
+    for(static_data = g_mif_info.instance->static_data; static_data;
+                                         static_data = static_data->next) {
+        if(tag == static_data->tag)
+            return(static_data->block);
+    }
+
+    g_mif_info.errmsg = "ERROR - cm_static_get_ptr() - Bad tag\n";
+    return(NULL);
+}
+
+
+
+/*
+cm_static_cleanup()
+
+This function is called from code model C functions to name a
+function to be called with a block allocated by cm_static_alloc()
+when the instance is deleted, just before the block is freed.  It is
+for blocks that hold resources of their own, such as a mapped file.
+*/
+
+int cm_static_cleanup(
+    int tag,                    /* The user-specified tag for the block */
+    void (*cleanup)(void *))    /* The function to call with the block */
+{
+    Mif_Static_t *static_data;
+
+
+    /* Scan blocks on the instance struct and see if tag exists */
+    for(static_data = g_mif_info.instance->static_data; static_data;
+                                         static_data = static_data->next) {
+        if(tag == static_data->tag) {
+            static_data->cleanup = cleanup;
+            return(MIF_OK);
+        }
+    }
+
+    g_mif_info.errmsg = "ERROR - cm_static_cleanup() - Bad tag\n";
+    return(MIF_ERROR);
+}
+
+
+
 /*
 cm_message_get_errmsg()
 
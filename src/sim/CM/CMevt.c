@@ -28,6 +28,7 @@ INTERFACES
     cm_event_alloc()
     cm_event_get_ptr()
     cm_event_queue()
+    cm_event_journal()
 
 REFERENCED FILES
 
@@ -265,3 +266,65 @@ int  cm_event_queue(
 
     return(MIF_OK);
 }
+
+
+
+/*
+cm_event_journal()
+
+This function is called from code model C functions just before they
+change storage that is not part of their event state, such as a block
+from cm_static_alloc().  Such storage is not copied at each event, so
+EVTbackup() cannot reset it by discarding states.  Instead the old
+contents are saved here, and EVTbackup() puts them back if the change
+is later than the time backed up to.  The entries are discarded when
+the analog timepoint is accepted.  Outside transient analysis there is
+nothing to back up, and nothing is saved.
+*/
+
+
+int  cm_event_journal(
+    void *ptr,         /* The storage about to be changed */
+    int bytes)         /* The number of bytes */
+{
+    Evt_State_Data_t    *state_data;
+    Evt_Journal_t       *entry;
+    char                *from;
+    int                 i;
+
+
+    if(g_mif_info.circuit.anal_type != MIF_TRAN)
+        return(MIF_OK);
+
+    state_data = g_mif_info.ckt->evt->data.state;
+
+    /* Take an entry from the free list if there is one */
+    entry = state_data->journal_free;
+    if(entry)
+        state_data->journal_free = entry->next;
+    else {
+        entry = (void *) MALLOC(sizeof(Evt_Journal_t));
+        entry->size = 0;
+        entry->old = NULL;
+    }
+
+    if(entry->size < bytes) {
+        if(entry->old)
+            FREE(entry->old);
+        entry->old = MALLOC(bytes);
+        entry->size = bytes;
+    }
+
+    /* Save the old contents and add the entry to the head of the list */
+    entry->step = g_mif_info.circuit.evt_step;
+    entry->addr = ptr;
+    entry->bytes = bytes;
+    from = ptr;
+    for(i = 0; i < bytes; i++)
+        entry->old[i] = from[i];
+
+    entry->next = state_data->journal;
+    state_data->journal = entry;
+
+    return(MIF_OK);
+}
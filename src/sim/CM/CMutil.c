@@ -30,6 +30,17 @@ INTERFACES
     cm_smooth_discontinuity()
     cm_smooth_pwl()
 
+    cm_table_init()
+    cm_table_find()
+
+    cm_bus_set()
+    cm_bus_fill()
+    cm_bus_copy()
+    cm_bus_merge()
+    cm_bus_mask()
+    cm_bus_known()
+    cm_bus_equal()
+
     cm_climit_fcn()
 
     cm_complex_set()
@@ -362,7 +373,7 @@ double cm_smooth_pwl(double x_input, double *x, double *y, int size,
                double input_domain, double *dout_din)  
 {
 
-    int i;               /* generic loop counter index */
+    int i;               /* index of the breakpoint nearest x_input */
 
     double lower_seg;      /* x segment below which input resides */
     double upper_seg;      /* x segment above which the input resides */
@@ -372,6 +383,8 @@ double cm_smooth_pwl(double x_input, double *x, double *y, int size,
     double threshold_lower; /* value below which the output begins smoothing */
     double threshold_upper; /* value above which the output begins smoothing */
 
+    Cm_Table_t table;      /* for finding the breakpoint */
+
                                            
     char *limit_error="\n***ERROR***\nViolation of 50% rule in breakpoints!\n";
 
@@ -393,55 +406,51 @@ double cm_smooth_pwl(double x_input, double *x, double *y, int size,
             out = *(y+size-1) + (x_input - *(x+size-1)) * *dout_din;
         }
         else { /*** x_input within bounds of end midpoints...     ***/
-               /*** must determine position progressively & then  ***/
+               /*** find the nearest breakpoint & then            ***/
                /*** calculate required output.                    ***/
 
-            for (i=1; i<size; i++) {
-
-                if (x_input < (*(x+i) + *(x+i+1))/2.0) { 
-                                   /* approximate position known...          */
-             
-                    lower_seg = (*(x+i) - *(x+i-1));
-                    upper_seg = (*(x+i+1) - *(x+i));
-
-
-                    /* Calculate input_domain about this region's breakpoint.*/
-
-                    /* Translate input_domain into an absolute....   */
-                    if ( lower_seg <= upper_seg )          /* Use lower  */
-                                                           /* segment    */
-                                                           /* for % calc.*/
-                        input_domain = input_domain * lower_seg;
-                    else                                   /* Use upper  */
-                                                           /* segment    */
-                                                           /* for % calc.*/
-                        input_domain = input_domain * upper_seg;
-                    
-
-                    /* Set up threshold values about breakpoint... */
-                    threshold_lower = *(x+i) - input_domain;
-                    threshold_upper = *(x+i) + input_domain;
-
-                    /* Determine where x_input is within region & determine */
-                    /* output and partial values....                        */
-                    if (x_input < threshold_lower) { /* Lower linear region */
-                        *dout_din = (*(y+i) - *(y+i-1))/lower_seg;
-                        out = *(y+i) + (x_input - *(x+i)) * *dout_din;
-                    }
-                    else {        
-                        if (x_input < threshold_upper) { /* Parabolic region */
-                            lower_slope = (*(y+i) - *(y+i-1))/lower_seg;
-                            upper_slope = (*(y+i+1) - *(y+i))/upper_seg;
-                            cm_smooth_corner(x_input,*(x+i),*(y+i),input_domain,
-                                        lower_slope,upper_slope,&out,dout_din);
-                        }
-                        else {        /* Upper linear region */
-                            *dout_din = (*(y+i+1) - *(y+i))/upper_seg;
-                            out = *(y+i) + (x_input - *(x+i)) * *dout_din;
-                        }
-                    }
-                    break;  /* Break search loop...x_input has been found, */
-                            /* and out and *dout_din have been assigned.   */
+            cm_table_init(&table, x, 1, size, (int *) 0, 0);
+            i = cm_table_find(&table, x_input);
+            if (x_input >= (*(x+i) + *(x+i+1))/2.0)
+                i++;
+
+            lower_seg = (*(x+i) - *(x+i-1));
+            upper_seg = (*(x+i+1) - *(x+i));
+
+
+            /* Calculate input_domain about this region's breakpoint.*/
+
+            /* Translate input_domain into an absolute....   */
+            if ( lower_seg <= upper_seg )          /* Use lower  */
+                                                   /* segment    */
+                                                   /* for % calc.*/
+                input_domain = input_domain * lower_seg;
+            else                                   /* Use upper  */
+                                                   /* segment    */
+                                                   /* for % calc.*/
+                input_domain = input_domain * upper_seg;
+            
+
+            /* Set up threshold values about breakpoint... */
+            threshold_lower = *(x+i) - input_domain;
+            threshold_upper = *(x+i) + input_domain;
+
+            /* Determine where x_input is within region & determine */
+            /* output and partial values....                        */
+            if (x_input < threshold_lower) { /* Lower linear region */
+                *dout_din = (*(y+i) - *(y+i-1))/lower_seg;
+                out = *(y+i) + (x_input - *(x+i)) * *dout_din;
+            }
+            else {        
+                if (x_input < threshold_upper) { /* Parabolic region */
+                    lower_slope = (*(y+i) - *(y+i-1))/lower_seg;
+                    upper_slope = (*(y+i+1) - *(y+i))/upper_seg;
+                    cm_smooth_corner(x_input,*(x+i),*(y+i),input_domain,
+                                lower_slope,upper_slope,&out,dout_din);
+                }
+                else {        /* Upper linear region */
+                    *dout_din = (*(y+i+1) - *(y+i))/upper_seg;
+                    out = *(y+i) + (x_input - *(x+i)) * *dout_din;
                 }
             }
         }
@@ -450,6 +459,132 @@ double cm_smooth_pwl(double x_input, double *x, double *y, int size,
 } 
 
 
+
+/* Breakpoint Table Functions ***********************************
+*                                                               *
+* These functions find the segment of a table of breakpoints    *
+* that an input value falls in, for piecewise linear models     *
+* and sources with many breakpoints.  The breakpoints must be   *
+* in non-decreasing order.  They may be spaced out in a larger  *
+* array (stride > 1), such as the time-value pairs of a PWL     *
+* source.                                                       *
+*                                                               *
+* cm_table_find() first tries the segment it found last time    *
+* and the one after it, which is where successive iterations    *
+* and timepoints nearly always land.  Otherwise, if the caller  *
+* gave cm_table_init() space for a grid of num_cells equal      *
+* cells over the table, it starts from the segment the input's  *
+* cell begins in, and failing that it does a binary search.     *
+* The last segment found is only a hint, so it does not matter  *
+* if it is not backed up along with the state of an instance.   *
+*                                                               *
+*****************************************************************/
+
+#define TABLE_X(t,i)  ((t)->x[(i) * (t)->stride])
+
+void cm_table_init(
+    Cm_Table_t *table,     /* The table to set up */
+    double *x,             /* The first breakpoint */
+    int stride,            /* Doubles from one breakpoint to the next */
+    int size,              /* The number of breakpoints */
+    int *cell,             /* Space for the grid, or NULL */
+    int num_cells)         /* The number of cells in the grid, or 0 */
+{
+    int i;                 /* breakpoint index */
+    int k;                 /* cell index */
+
+    table->x = x;
+    table->stride = stride;
+    table->size = size;
+    table->cursor = 0;
+    table->cell = cell;
+    table->num_cells = 0;
+
+    /* No grid if not asked for, or if it would all be one cell */
+    if ((cell == (int *) 0) || (num_cells <= 0) || (size < 2) ||
+        (TABLE_X(table, size - 1) <= TABLE_X(table, 0)))
+        return;
+
+    table->num_cells = num_cells;
+    table->cell_scale = num_cells /
+                        (TABLE_X(table, size - 1) - TABLE_X(table, 0));
+
+    /* Record the last breakpoint at or below the start of each cell */
+    for (k = 0, i = 0; k < num_cells; k++) {
+        while ((i < size - 1) && (TABLE_X(table, i + 1) <=
+                                  TABLE_X(table, 0) + k / table->cell_scale))
+            i++;
+        cell[k] = i;
+    }
+}
+
+
+/* Return the index of the last breakpoint at or below x_input, */
+/* or -1 if x_input is below the first breakpoint.              */
+
+int cm_table_find(
+    Cm_Table_t *table,     /* The table */
+    double x_input)        /* The value to look for */
+{
+    int i;                 /* breakpoint index */
+    int lo;                /* bounds of the binary search */
+    int hi;
+    int k;                 /* cell index */
+    int last;              /* the last breakpoint */
+
+    last = table->size - 1;
+
+    if ((last < 0) || (x_input < TABLE_X(table, 0)))
+        return -1;
+    if (x_input >= TABLE_X(table, last)) {
+        i = last;
+    }
+    else {
+
+        /* Try the last segment found and the next one */
+        i = table->cursor;
+        if ((TABLE_X(table, i) > x_input) || (x_input >= TABLE_X(table, i + 1))) {
+            if ((TABLE_X(table, i) <= x_input) && (i + 2 <= last) &&
+                (x_input < TABLE_X(table, i + 2))) {
+                i++;
+            }
+            else if (table->num_cells > 0) {
+
+                /* Start from the segment the cell begins in, moving */
+                /* down in case rounding put the cell too high       */
+                k = (x_input - TABLE_X(table, 0)) * table->cell_scale;
+                if (k >= table->num_cells)
+                    k = table->num_cells - 1;
+                i = table->cell[k];
+                while ((i > 0) && (TABLE_X(table, i) > x_input))
+                    i--;
+                while (TABLE_X(table, i + 1) <= x_input)
+                    i++;
+            }
+            else {
+                /* Binary search, keeping x[lo] <= x_input < x[hi] */
+                lo = 0;
+                hi = last;
+                while (hi - lo > 1) {
+                    i = (lo + hi) / 2;
+                    if (TABLE_X(table, i) <= x_input)
+                        lo = i;
+                    else
+                        hi = i;
+                }
+                i = lo;
+            }
+        }
+    }
+
+    if (i < last)
+        table->cursor = i;
+    else if (last > 0)
+        table->cursor = last - 1;
+    return i;
+}
+
+
 Complex_t cm_complex_set(double real, double imag)
 {
     /* Create a complex number with the real and imaginary */
@@ -520,3 +655,164 @@ Complex_t cm_complex_divide(Complex_t x, Complex_t y)
 }
 
 
+
+
+
+/* Bus Functions ************************************************
+*                                                               *
+* The following functions help code models build and examine    *
+* the Bus_t values of 'bus' ports a word at a time.  They keep  *
+* the bits above the bus width zero in every plane, which the   *
+* node type relies on when it compares two values.              *
+*                                                               *
+*****************************************************************/
+
+unsigned long cm_bus_mask(
+    int width,             /* The number of bits in the bus */
+    int word)              /* The word of the planes */
+{
+    /* Return the bits of the word that are within the bus */
+
+    int bits;
+
+    bits = width - word * BUS_WORD_BITS;
+    if(bits <= 0)
+        return(0);
+    else if(bits >= BUS_WORD_BITS)
+        return(~0UL);
+    else
+        return(BUS_BIT(bits) - 1);
+}
+
+
+void cm_bus_set(
+    Bus_t *bus,                   /* The bus to set */
+    int width,                    /* Its width */
+    unsigned long *value,         /* BUS_WORDS words of values */
+    Digital_Strength_t strength)  /* The strength of every bit */
+{
+    /* Set the bus to a known value with a single strength */
+
+    int             i;
+    unsigned long   mask;
+
+    if(width > BUS_MAX_WIDTH)
+        width = BUS_MAX_WIDTH;
+    bus->width = width;
+    for(i = 0; i < BUS_WORDS; i++) {
+        mask = cm_bus_mask(width, i);
+        bus->value[i] = value[i] & mask;
+        bus->unknown[i] = 0;
+        bus->strength[0][i] = (strength & 1) ? mask : 0;
+        bus->strength[1][i] = (strength & 2) ? mask : 0;
+    }
+}
+
+
+void cm_bus_fill(
+    Bus_t *bus,                   /* The bus to set */
+    int width,                    /* Its width */
+    Digital_State_t state,        /* The state of every bit */
+    Digital_Strength_t strength)  /* The strength of every bit */
+{
+    /* Set every bit of the bus to the same state and strength */
+
+    int             i;
+    unsigned long   mask;
+
+    if(width > BUS_MAX_WIDTH)
+        width = BUS_MAX_WIDTH;
+    bus->width = width;
+    for(i = 0; i < BUS_WORDS; i++) {
+        mask = cm_bus_mask(width, i);
+        bus->value[i] = (state == ONE) ? mask : 0;
+        bus->unknown[i] = (state == UNKNOWN) ? mask : 0;
+        bus->strength[0][i] = (strength & 1) ? mask : 0;
+        bus->strength[1][i] = (strength & 2) ? mask : 0;
+    }
+}
+
+
+void cm_bus_copy(
+    Bus_t *to,                    /* The bus to set */
+    Bus_t *from,                  /* The bus to take the states from */
+    int width,                    /* The width of the result */
+    Digital_Strength_t strength)  /* The strength of every bit */
+{
+    /* Copy the states of a bus, which may have a different width, */
+    /* and drive them with the given strength.  Bits that are not  */
+    /* in the source bus are UNKNOWN.                               */
+
+    int             i;
+    unsigned long   mask;
+
+    if(width > BUS_MAX_WIDTH)
+        width = BUS_MAX_WIDTH;
+    to->width = width;
+    for(i = 0; i < BUS_WORDS; i++) {
+        mask = cm_bus_mask(width, i);
+        to->value[i] = from->value[i] & mask;
+        to->unknown[i] = (from->unknown[i] | ~cm_bus_mask(from->width, i)) &
+                         mask;
+        to->value[i] &= ~to->unknown[i];
+        to->strength[0][i] = (strength & 1) ? mask : 0;
+        to->strength[1][i] = (strength & 2) ? mask : 0;
+    }
+}
+
+
+void cm_bus_merge(
+    Bus_t *to,             /* The bus to change */
+    Bus_t *from)           /* The bus it might have become */
+{
+    /* Make UNKNOWN the bits of a bus whose states differ from those */
+    /* of another, for when it is not known which of the two it now */
+    /* holds.  Bits that are not in the other bus become UNKNOWN.   */
+
+    int             i;
+    unsigned long   x;
+
+    for(i = 0; i < BUS_WORDS; i++) {
+        x = (to->value[i] ^ from->value[i]) | from->unknown[i] |
+            ~cm_bus_mask(from->width, i);
+        x &= cm_bus_mask(to->width, i);
+        to->unknown[i] |= x;
+        to->value[i] &= ~to->unknown[i];
+    }
+}
+
+
+Boolean_t cm_bus_known(
+    Bus_t *bus)            /* The bus to examine */
+{
+    /* Return TRUE if no bit of the bus is UNKNOWN */
+
+    int i;
+
+    for(i = 0; i < BUS_WORDS; i++)
+        if(bus->unknown[i])
+            return(FALSE);
+    return(TRUE);
+}
+
+
+Boolean_t cm_bus_equal(
+    Bus_t *bus1,           /* The first bus */
+    Bus_t *bus2)           /* The second bus */
+{
+    /* Return TRUE if the buses have the same width and the same */
+    /* state and strength in every bit */
+
+    int i;
+
+    if(bus1->width != bus2->width)
+        return(FALSE);
+    for(i = 0; i < BUS_WORDS; i++) {
+        if((bus1->value[i] != bus2->value[i]) ||
+           (bus1->unknown[i] != bus2->unknown[i]) ||
+           (bus1->strength[0][i] != bus2->strength[0][i]) ||
+           (bus1->strength[1][i] != bus2->strength[1][i]))
+            return(FALSE);
+    }
+    return(TRUE);
+}
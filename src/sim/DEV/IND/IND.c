@@ -173,7 +173,7 @@ SPICEdev MUTinfo = {
     NULL,/* load handled by INDload */
     MUTsetup,
     MUTsetup,
-    NULL,
+    MUTtemp,
     NULL,
     NULL,
     MUTacLoad,
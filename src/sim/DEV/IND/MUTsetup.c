@@ -30,9 +30,19 @@ MUTsetup(matrix,inModel,ckt,states)
 {
     register MUTmodel *model = (MUTmodel*)inModel;
     register MUTinstance *here;
+    int indtype;
     int ktype;
     int error;
 
+    if(model == NULL) return(OK);
+    indtype = CKTtypelook("Inductor");
+    if(indtype <= 0) {
+        (*(SPfrontEnd->IFerror))(ERR_PANIC,
+                "mutual inductor, but inductors not available!",
+                (IFuid *)NULL);
+        return(E_INTERN);
+    }
+
     /*  loop through all the inductor models */
     for( ; model != NULL; model = model->MUTnextModel ) {
 
@@ -40,13 +50,12 @@ MUTsetup(matrix,inModel,ckt,states)
         for (here = model->MUTinstances; here != NULL ;
                 here=here->MUTnextInstance) {
             
-            ktype = CKTtypelook("Inductor");
-            if(ktype <= 0) {
-                (*(SPfrontEnd->IFerror))(ERR_PANIC,
-                        "mutual inductor, but inductors not available!",
-                        (IFuid *)NULL);
-                return(E_INTERN);
-            }
+            /* look the inductors up by name every time through the
+             * circuit's instance index, rather than trusting pointers
+             * left from an earlier setup to inductors since deleted */
+            here->MUTind1 = NULL;
+            here->MUTind2 = NULL;
+            ktype = indtype;
 
             error = CKTfndDev((GENERIC*)ckt,&ktype,(GENERIC**)&(here->MUTind1),
                     here->MUTindName1, (GENERIC *)NULL,(char *)NULL);
@@ -59,6 +68,7 @@ MUTsetup(matrix,inModel,ckt,states)
                     "%s: coupling to non-existant inductor %s.",
                     namarray);
             }
+            ktype = indtype;
             error = CKTfndDev((GENERIC*)ckt,&ktype,(GENERIC**)&(here->MUTind2),
                     here->MUTindName2,(GENERIC *)NULL,(char *)NULL);
             if(error && error!= E_NODEV && error != E_NOMOD) return(error);
@@ -71,8 +81,7 @@ MUTsetup(matrix,inModel,ckt,states)
                     namarray);
             }
 
-            here->MUTfactor = here->MUTcoupling *sqrt(here->MUTind1->INDinduct *
-                    here->MUTind2->INDinduct);
+            /* MUTfactor is computed in MUTtemp */
 
 
 /* macro to make elements with built in test for out of memory */
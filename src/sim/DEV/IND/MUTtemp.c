@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 1985 Thomas L. Quarles
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include <math.h>
+#include "util.h"
+#include "CKTdefs.h"
+#include "INDdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+#ifdef MUTUAL
+/*ARGSUSED*/
+int
+MUTtemp(inModel,ckt)
+    GENmodel *inModel;
+    CKTcircuit *ckt;
+        /* compute the mutual inductance from the coupling coefficient
+         * and the two inductances - done here rather than in setup so
+         * that a rerun after the inductors are altered picks it up
+         */
+{
+    register MUTmodel *model = (MUTmodel*)inModel;
+    register MUTinstance *here;
+
+    /*  loop through all the inductor models */
+    for( ; model != NULL; model = model->MUTnextModel ) {
+
+        /* loop through all the instances of the model */
+        for (here = model->MUTinstances; here != NULL ;
+                here=here->MUTnextInstance) {
+            
+            if(here->MUTind1 == NULL || here->MUTind2 == NULL) continue;
+            here->MUTfactor = here->MUTcoupling *sqrt(here->MUTind1->INDinduct *
+                    here->MUTind2->INDinduct);
+        }
+    }
+    return(OK);
+}
+#endif /* MUTUAL */
@@ -10,6 +10,7 @@
 #include "TRANdefs.h"
 #include "util.h"
 #include "SPerror.h"
+#include "CMproto.h"
 #include "suffix.h"
 
 RCSID("ISRCaccept.c $Revision: 1.2 $ on $Date: 91/07/11 13:45:51 $")
@@ -151,27 +152,32 @@ ISRCaccept(ckt,inModel)
                 break;
                 case PWL: {
                     register int i;
-                    if(ckt->CKTtime < *(here->ISRCcoeffs)) {
+                    register double *coeffs = here->ISRCcoeffs;
+                    int size = here->ISRCfunctionOrder/2;
+
+                    if(ckt->CKTtime < *coeffs) {
                         if(ckt->CKTbreak) {
-                            error = CKTsetBreak(ckt,*(here->ISRCcoeffs));
-                            break;
+                            error = CKTsetBreak(ckt,*coeffs);
                         }
+                        break;
+                    }
+                    if(here->ISRCtable.x != coeffs ||
+                            here->ISRCtable.size != size) {
+                        cm_table_init(&(here->ISRCtable),coeffs,2,size,
+                                (int *)NULL,0);
                     }
-                    for(i=0;i<(here->ISRCfunctionOrder/2)-1;i++) {
-                        if((*(here->ISRCcoeffs+2*i)==ckt->CKTtime)) {
-                            if(ckt->CKTbreak) {
-                                error = CKTsetBreak(ckt,
-                                        *(here->ISRCcoeffs+2*i+2));
-                                if(error) return(error);
-                            }
-                            goto bkptset;
-                        } 
+                    i = cm_table_find(&(here->ISRCtable),ckt->CKTtime);
+                    if((*(coeffs+2*i)==ckt->CKTtime)) {
+                        while(i > 0 && *(coeffs+2*(i-1))==ckt->CKTtime) i--;
+                        if(i < size-1 && ckt->CKTbreak) {
+                            error = CKTsetBreak(ckt,*(coeffs+2*i+2));
+                            if(error) return(error);
+                        }
                     }
                     break;
                 }
                 }
             }
-bkptset: ;
         }
     }
     return(OK);
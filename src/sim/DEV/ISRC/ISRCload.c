@@ -226,32 +226,38 @@ ISRCload(inModel,ckt)
                     break;
                 case PWL: {
                     register int i;
-                    if(time< *(here->ISRCcoeffs)) {
-                        value = *(here->ISRCcoeffs + 1) ;
-                        break;
+                    register double *coeffs = here->ISRCcoeffs;
+                    int size = here->ISRCfunctionOrder/2;
+
+                    /* the timepoints may have been changed since the
+                     * table was set up
+                     */
+                    if(here->ISRCtable.x != coeffs ||
+                            here->ISRCtable.size != size) {
+                        cm_table_init(&(here->ISRCtable),coeffs,2,size,
+                                (int *)NULL,0);
                     }
-                    for(i=0;i<=(here->ISRCfunctionOrder/2)-1;i++) {
-                        if((*(here->ISRCcoeffs+2*i)==time)) {
-                            value = *(here->ISRCcoeffs+2*i+1);
-                            goto loadDone;
-                        }
-                        if((*(here->ISRCcoeffs+2*i)<time) &&
-                                (*(here->ISRCcoeffs+2*(i+1)) >time)) {
-                            value = *(here->ISRCcoeffs+2*i+1) +
-                                (((time-*(here->ISRCcoeffs+2*i))/
-                                (*(here->ISRCcoeffs+2*(i+1)) - 
-                                 *(here->ISRCcoeffs+2*i))) *
-                                (*(here->ISRCcoeffs+2*i+3) - 
-                                 *(here->ISRCcoeffs+2*i+1)));
-                            goto loadDone;
-                        }
+                    i = cm_table_find(&(here->ISRCtable),time);
+                    if(i < 0) {
+                        value = *(coeffs + 1) ;
+                    } else if(*(coeffs+2*i)==time) {
+                        /* the first of any points at the same time */
+                        while(i > 0 && *(coeffs+2*(i-1))==time) i--;
+                        value = *(coeffs+2*i+1);
+                    } else if(i == size-1) {
+                        value = *(coeffs+ here->ISRCfunctionOrder-1) ;
+                    } else {
+                        value = *(coeffs+2*i+1) +
+                            (((time-*(coeffs+2*i))/
+                            (*(coeffs+2*(i+1)) - 
+                             *(coeffs+2*i))) *
+                            (*(coeffs+2*i+3) - 
+                             *(coeffs+2*i+1)));
                     }
-                    value = *(here->ISRCcoeffs+ here->ISRCfunctionOrder-1) ;
                     break;
                 }
                 }
             }
-loadDone:
             value *= ckt->CKTsrcFact;
 
 /* gtri - begin - wbk - modify for supply ramping option */
@@ -0,0 +1,111 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "DEVdefs.h"
+#include "IFsim.h"
+#include "LTRAdefs.h"
+#include "suffix.h"
+
+static IFparm LTRApTable[] = { /* parameters */ 
+ OP( "pos_node1", LTRA_POS_NODE1,IF_INTEGER,"Positive node of end 1 of t. line"),
+ OP( "neg_node1", LTRA_NEG_NODE1,IF_INTEGER,"Negative node of end 1 of t. line"),
+ OP( "pos_node2", LTRA_POS_NODE2,IF_INTEGER,"Positive node of end 2 of t. line"),
+ OP( "neg_node2", LTRA_NEG_NODE2,IF_INTEGER,"Negative node of end 2 of t. line"),
+ OP( "br_eq1",    LTRA_BR_EQ1,   IF_INTEGER,"Branch equation for end 1"),
+ OP( "br_eq2",    LTRA_BR_EQ2,   IF_INTEGER,"Branch equation for end 2"),
+ OP( "input1",    LTRA_INPUT1,   IF_REAL,   "Wave arriving at end 1"),
+ OP( "input2",    LTRA_INPUT2,   IF_REAL,   "Wave arriving at end 2")
+};
+
+static IFparm LTRAmPTable[] = { /* model parameters */
+ IOP( "r",      LTRA_MOD_R,      IF_REAL,   "Resistance per unit length"),
+ IOP( "l",      LTRA_MOD_L,      IF_REAL,   "Inductance per unit length"),
+ IOP( "g",      LTRA_MOD_G,      IF_REAL,   "Conductance per unit length"),
+ IOP( "c",      LTRA_MOD_C,      IF_REAL,   "Capacitance per unit length"),
+ IOP( "len",    LTRA_MOD_LEN,    IF_REAL,   "Length of line"),
+ IOP( "order",  LTRA_MOD_ORDER,  IF_INTEGER,"Number of poles fitted to the tails"),
+ IOP( "tfit",   LTRA_MOD_TFIT,   IF_REAL,   "Time span the tails are fitted over"),
+ IOP( "rel",    LTRA_MOD_RELTOL, IF_REAL,   "Rel. rate of change of deriv. for bkpt"),
+ IOP( "abs",    LTRA_MOD_ABSTOL, IF_REAL,   "Abs. rate of change of deriv. for bkpt"),
+ IP( "ltra",    LTRA_MOD_LTRA,   IF_FLAG,   "Lossy transmission line model"),
+ OP( "td",      LTRA_MOD_TD,     IF_REAL,   "Propagation delay"),
+ OP( "z0",      LTRA_MOD_Z0,     IF_REAL,   "High frequency impedance")
+};
+
+static char *LTRAnames[] = {
+    "P1+",
+    "P1-",
+    "P2+",
+    "P2-"
+};
+
+SPICEdev LTRAinfo = {
+
+/* gtri - modify - wbk - 10/11/90 - add 0,NULL entries into IFdevice */
+/*                                  structure for MIF element data   */
+
+    {
+        "LTRA",
+        "Lossy transmission line",
+
+        sizeof(LTRAnames)/sizeof(char *),
+        sizeof(LTRAnames)/sizeof(char *),
+        LTRAnames,
+
+        sizeof(LTRApTable)/sizeof(IFparm),
+        LTRApTable,
+
+        sizeof(LTRAmPTable)/sizeof(IFparm),
+        LTRAmPTable,
+
+        NULL,  /* This is a SPICE device, it has no MIF info data */
+
+        0,     /* This is a SPICE device, it has no MIF info data */
+        NULL,  /* This is a SPICE device, it has no MIF info data */
+
+        0,     /* This is a SPICE device, it has no MIF info data */
+        NULL,  /* This is a SPICE device, it has no MIF info data */
+
+        0,     /* This is a SPICE device, it has no MIF info data */
+        NULL,  /* This is a SPICE device, it has no MIF info data */
+    },
+
+/* gtri - end - wbk - 10/11/90 */
+
+    NULL,
+    LTRAmParam,
+    LTRAload,
+    LTRAsetup,
+    LTRAsetup,
+    LTRAtemp,
+    LTRAtrunc,
+    NULL,
+    LTRAacLoad,
+    LTRAaccept,
+    LTRAdestroy,
+#ifdef DELETES
+    LTRAmDelete,
+    LTRAdelete,
+#else /* DELETES */
+    NULL,
+    NULL,
+#endif /* DELETES */
+    NULL,
+    LTRAask,
+    LTRAmAsk,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+
+    sizeof(LTRAinstance),
+    sizeof(LTRAmodel),
+
+};
@@ -0,0 +1,124 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include <math.h>
+#include "CKTdefs.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+#ifdef __STDC__
+static void LTRAsqrt(double,double,double*,double*);
+#else /* stdc */
+static void LTRAsqrt();
+#endif /* stdc */
+
+int
+LTRAacLoad(inModel,ckt)
+    GENmodel *inModel;
+    CKTcircuit *ckt;
+        /* actually load the current values into the
+         * sparse matrix previously provided
+         */
+{
+    register LTRAmodel *model = (LTRAmodel *)inModel;
+    register LTRAinstance *here;
+    double a, b, w, den;
+    double gr, gi;      /* propagation constant times length */
+    double zr, zi;      /* characteristic impedance */
+    double hr, hi;      /* propagation function */
+    double hzr, hzi;    /* the product of the two */
+    double mag;
+
+    /*  loop through all the transmission line models */
+    for( ; model != NULL; model = model->LTRAnextModel ) {
+
+        /* the line is exact in the frequency domain:
+         *  v1 - Z i1 = H (v2 + Z i2)
+         * with Z = z0 sqrt((s+a)/(s+b)) and H = exp(-td sqrt((s+a)(s+b)))
+         */
+        a = model->LTRAresist / model->LTRAinduct;
+        b = model->LTRAconduct / model->LTRAcapac;
+        w = ckt->CKTomega;
+        den = b*b + w*w;
+
+        if(den != 0) {
+            LTRAsqrt(a*b - w*w, w*(a+b), &gr, &gi);
+            gr *= model->LTRAtd;
+            gi *= model->LTRAtd;
+            LTRAsqrt((a*b + w*w)/den, w*(b-a)/den, &zr, &zi);
+            zr *= model->LTRAimped;
+            zi *= model->LTRAimped;
+            mag = exp(-gr);
+            hr = mag * cos(-gi);
+            hi = mag * sin(-gi);
+            hzr = hr*zr - hi*zi;
+            hzi = hr*zi + hi*zr;
+        }
+
+        /* loop through all the instances of the model */
+        for (here = model->LTRAinstances; here != NULL ;
+                here=here->LTRAnextInstance) {
+
+            *(here->LTRApos1Ibr1Ptr) += 1;
+            *(here->LTRAneg1Ibr1Ptr) -= 1;
+            *(here->LTRApos2Ibr2Ptr) += 1;
+            *(here->LTRAneg2Ibr2Ptr) -= 1;
+
+            if(den == 0) {
+                /* no shunt loss at dc - same as LTRAload */
+                *(here->LTRAibr1Pos1Ptr) += 1;
+                *(here->LTRAibr1Neg1Ptr) -= 1;
+                *(here->LTRAibr1Pos2Ptr) -= 1;
+                *(here->LTRAibr1Neg2Ptr) += 1;
+                *(here->LTRAibr1Ibr1Ptr) -= model->LTRAresist *
+                        model->LTRAlength;
+                *(here->LTRAibr2Ibr1Ptr) += 1;
+                *(here->LTRAibr2Ibr2Ptr) += 1;
+                continue;
+            }
+
+            *(here->LTRAibr1Pos1Ptr) += 1;
+            *(here->LTRAibr1Neg1Ptr) -= 1;
+            *(here->LTRAibr1Ibr1Ptr+0) -= zr;
+            *(here->LTRAibr1Ibr1Ptr+1) -= zi;
+            *(here->LTRAibr1Pos2Ptr+0) -= hr;
+            *(here->LTRAibr1Pos2Ptr+1) -= hi;
+            *(here->LTRAibr1Neg2Ptr+0) += hr;
+            *(here->LTRAibr1Neg2Ptr+1) += hi;
+            *(here->LTRAibr1Ibr2Ptr+0) -= hzr;
+            *(here->LTRAibr1Ibr2Ptr+1) -= hzi;
+
+            *(here->LTRAibr2Pos2Ptr) += 1;
+            *(here->LTRAibr2Neg2Ptr) -= 1;
+            *(here->LTRAibr2Ibr2Ptr+0) -= zr;
+            *(here->LTRAibr2Ibr2Ptr+1) -= zi;
+            *(here->LTRAibr2Pos1Ptr+0) -= hr;
+            *(here->LTRAibr2Pos1Ptr+1) -= hi;
+            *(here->LTRAibr2Neg1Ptr+0) += hr;
+            *(here->LTRAibr2Neg1Ptr+1) += hi;
+            *(here->LTRAibr2Ibr1Ptr+0) -= hzr;
+            *(here->LTRAibr2Ibr1Ptr+1) -= hzi;
+        }
+    }
+    return(OK);
+}
+
+
+/* principal square root of (re + j im) - the real part is never negative */
+static void
+LTRAsqrt(re,im,sre,sim)
+    double re;
+    double im;
+    double *sre;
+    double *sim;
+{
+    double mag = sqrt(re*re + im*im);
+
+    *sre = sqrt((mag + re) / 2);
+    *sim = sqrt((mag - re) / 2);
+    if(im < 0) *sim = -*sim;
+}
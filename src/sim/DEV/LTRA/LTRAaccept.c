@@ -0,0 +1,189 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "util.h"
+#include "CKTdefs.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+int
+LTRAaccept(ckt,inModel)
+    register CKTcircuit *ckt;
+    GENmodel *inModel;
+{
+    register LTRAmodel *model = (LTRAmodel *)inModel;
+    register LTRAinstance *here;
+    register int i,j;
+    double *coef;
+    double *zs1, *zs2, *hs1, *hs2;
+    double v1,v2,i1,i2;
+    double w1,w2;
+    double arrive1,arrive2;
+    double d1,d2,d3,d4;
+    double *from,*to;
+    int n;
+    int error;
+
+    /*  loop through all the transmission line models */
+    for( ; model != NULL; model = model->LTRAnextModel ) {
+
+        if(ckt->CKTmode & MODEINITTRAN) {
+            /* called once with the initial solution before the first
+             * time step - make sure the tails are fitted for this run */
+            error = LTRAfit(model,ckt);
+            if(error) return(error);
+        }
+        n = model->LTRAnumPoles;
+        coef = model->LTRAcoef;
+
+        /* loop through all the instances of the model */
+        for (here = model->LTRAinstances; here != NULL ;
+                here=here->LTRAnextInstance) {
+
+            v1 = *(ckt->CKTrhsOld + here->LTRAposNode1) -
+                    *(ckt->CKTrhsOld + here->LTRAnegNode1);
+            v2 = *(ckt->CKTrhsOld + here->LTRAposNode2) -
+                    *(ckt->CKTrhsOld + here->LTRAnegNode2);
+            i1 = *(ckt->CKTrhsOld + here->LTRAbrEq1);
+            i2 = *(ckt->CKTrhsOld + here->LTRAbrEq2);
+
+            if(ckt->CKTmode & MODEINITTRAN) {
+                if(here->LTRAnumState < n) {
+                    if(here->LTRAstate) FREE(here->LTRAstate);
+                    here->LTRAstate = (double *)MALLOC(4*n*sizeof(double));
+                    if(here->LTRAstate == NULL) return(E_NOMEM);
+                    here->LTRAnumState = n;
+                }
+                zs1 = here->LTRAstate;
+                zs2 = zs1 + here->LTRAnumState;
+                hs1 = zs2 + here->LTRAnumState;
+                hs2 = hs1 + here->LTRAnumState;
+
+                /* everything has been steady forever, so each state is
+                 * just its residue over its pole times its input */
+                w1 = v1 + model->LTRAimped * i1;
+                w2 = v2 + model->LTRAimped * i2;
+                for(i = 0; i < n; i++) {
+                    zs1[i] = model->LTRAzResid[i] / model->LTRApoles[i] * i1;
+                    zs2[i] = model->LTRAzResid[i] / model->LTRApoles[i] * i2;
+                    w1 += zs1[i];
+                    w2 += zs2[i];
+                }
+                for(i = 0; i < n; i++) {
+                    hs1[i] = model->LTRAhResid[i] / model->LTRApoles[i] * w2;
+                    hs2[i] = model->LTRAhResid[i] / model->LTRApoles[i] * w1;
+                }
+                here->LTRAcur1 = i1;
+                here->LTRAcur2 = i2;
+                here->LTRAdelayed1 = w2;
+                here->LTRAdelayed2 = w1;
+                here->LTRAlastTime = ckt->CKTtime;
+
+                here->LTRAfirstDelay = 0;
+                here->LTRAsizeDelay = 1;
+                here->LTRAcursorDelay = 1;
+                to = LTRADELAY(here,0);
+                *to = ckt->CKTtime - model->LTRAtd;
+                *(to+1) = w1;
+                *(to+2) = w2;
+                to = LTRADELAY(here,1);
+                *to = ckt->CKTtime;
+                *(to+1) = w1;
+                *(to+2) = w2;
+                here->LTRAinit = 1;
+                continue;
+            }
+            if(!here->LTRAinit) continue;
+            if(ckt->CKTtime <= here->LTRAlastTime) continue;
+
+            /* step the convolutions to the accepted point */
+            LTRAcoeffs(model, ckt->CKTtime - here->LTRAlastTime);
+            zs1 = here->LTRAstate;
+            zs2 = zs1 + here->LTRAnumState;
+            hs1 = zs2 + here->LTRAnumState;
+            hs2 = hs1 + here->LTRAnumState;
+            arrive1 = LTRAdelayed(here, ckt->CKTtime - model->LTRAtd, 2);
+            arrive2 = LTRAdelayed(here, ckt->CKTtime - model->LTRAtd, 1);
+            w1 = v1 + model->LTRAimped * i1;
+            w2 = v2 + model->LTRAimped * i2;
+            for(i = 0; i < n; i++) {
+                zs1[i] = coef[3*i] * zs1[i] + model->LTRAzResid[i] *
+                        (coef[3*i+1] * here->LTRAcur1 + coef[3*i+2] * i1);
+                zs2[i] = coef[3*i] * zs2[i] + model->LTRAzResid[i] *
+                        (coef[3*i+1] * here->LTRAcur2 + coef[3*i+2] * i2);
+                hs1[i] = coef[3*i] * hs1[i] + model->LTRAhResid[i] *
+                        (coef[3*i+1] * here->LTRAdelayed1 +
+                        coef[3*i+2] * arrive1);
+                hs2[i] = coef[3*i] * hs2[i] + model->LTRAhResid[i] *
+                        (coef[3*i+1] * here->LTRAdelayed2 +
+                        coef[3*i+2] * arrive2);
+                w1 += zs1[i];
+                w2 += zs2[i];
+            }
+            here->LTRAcur1 = i1;
+            here->LTRAcur2 = i2;
+            here->LTRAdelayed1 = arrive1;
+            here->LTRAdelayed2 = arrive2;
+            here->LTRAlastTime = ckt->CKTtime;
+
+            /* drop the history nobody will look at again - the next
+             * lookup is for a time after CKTtime - td */
+            i = 0;
+            while(i < here->LTRAsizeDelay - 1 && *LTRADELAY(here,i+1) <=
+                    ckt->CKTtime - model->LTRAtd) i++;
+            here->LTRAfirstDelay = (here->LTRAfirstDelay + i) &
+                    (here->LTRAallocDelay - 1);
+            here->LTRAsizeDelay -= i;
+            here->LTRAcursorDelay -= i;
+
+            /* and add the new point */
+            if(here->LTRAallocDelay <= here->LTRAsizeDelay+1) {
+                /* need to grab some more space - double it, and
+                 * unwrap the ring into the new table as we go */
+                from = here->LTRAdelays;
+                to = (double *)MALLOC(2*3*here->LTRAallocDelay*
+                        sizeof(double));
+                if(to == NULL) return(E_NOMEM);
+                for(j=0;j<=here->LTRAsizeDelay;j++) {
+                    *(to+3*j) = *LTRADELAY(here,j);
+                    *(to+3*j+1) = *(LTRADELAY(here,j)+1);
+                    *(to+3*j+2) = *(LTRADELAY(here,j)+2);
+                }
+                FREE(from);
+                here->LTRAdelays = to;
+                here->LTRAfirstDelay = 0;
+                here->LTRAallocDelay *= 2;
+            }
+            here->LTRAsizeDelay ++;
+            to = LTRADELAY(here,here->LTRAsizeDelay);
+            *to = ckt->CKTtime;
+            *(to+1) = w1;
+            *(to+2) = w2;
+
+            /* if the slope of either wave just changed, the corner will
+             * arrive at the other end one delay from now */
+            if(here->LTRAsizeDelay >= 2) {
+                from = LTRADELAY(here,here->LTRAsizeDelay-1);
+                to = LTRADELAY(here,here->LTRAsizeDelay-2);
+                if(*from - *to <= 0) continue;
+                d1 = (w1 - *(from+1)) / (ckt->CKTtime - *from);
+                d2 = (*(from+1) - *(to+1)) / (*from - *to);
+                d3 = (w2 - *(from+2)) / (ckt->CKTtime - *from);
+                d4 = (*(from+2) - *(to+2)) / (*from - *to);
+                if( (*from + model->LTRAtd > ckt->CKTtime) && (
+                        (FABS(d1-d2) >= model->LTRAreltol*
+                        MAX(FABS(d1),FABS(d2))+ model->LTRAabstol) ||
+                        (FABS(d3-d4) >= model->LTRAreltol*
+                        MAX(FABS(d3),FABS(d4))+ model->LTRAabstol) ) ) {
+                    error = CKTsetBreak(ckt, *from + model->LTRAtd);
+                    if(error) return(error);
+                }
+            }
+        }
+    }
+    return(OK);
+}
@@ -0,0 +1,59 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+/*
+ * This routine gives access to the internal device parameters
+ * of lossy transmission lines
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "CKTdefs.h"
+#include "DEVdefs.h"
+#include "IFsim.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+/* ARGSUSED */
+int
+LTRAask(ckt,inst,which,value,select)
+    CKTcircuit *ckt;
+    GENinstance *inst;
+    int which;
+    IFvalue *value;
+    IFvalue *select;
+{
+    LTRAinstance *here = (LTRAinstance *)inst;
+
+    switch(which) {
+        case LTRA_POS_NODE1:
+            value->iValue = here->LTRAposNode1;
+            return (OK);
+        case LTRA_NEG_NODE1:
+            value->iValue = here->LTRAnegNode1;
+            return (OK);
+        case LTRA_POS_NODE2:
+            value->iValue = here->LTRAposNode2;
+            return (OK);
+        case LTRA_NEG_NODE2:
+            value->iValue = here->LTRAnegNode2;
+            return (OK);
+        case LTRA_BR_EQ1:
+            value->iValue = here->LTRAbrEq1;
+            return (OK);
+        case LTRA_BR_EQ2:
+            value->iValue = here->LTRAbrEq2;
+            return (OK);
+        case LTRA_INPUT1:
+            value->rValue = here->LTRAinput1;
+            return (OK);
+        case LTRA_INPUT2:
+            value->rValue = here->LTRAinput2;
+            return (OK);
+        default:
+            return (E_BADPARM);
+    }
+    /* NOTREACHED */
+}
@@ -0,0 +1,37 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "util.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+int
+LTRAdelete(inModel,name,kill)
+    GENmodel *inModel;
+    IFuid name;
+    GENinstance **kill;
+{
+    LTRAinstance **fast = (LTRAinstance **)kill;
+    LTRAmodel *model = (LTRAmodel *)inModel;
+    LTRAinstance **prev = NULL;
+    LTRAinstance *here;
+
+    for( ; model ; model = model->LTRAnextModel) {
+        prev = &(model->LTRAinstances);
+        for(here = *prev; here ; here = *prev) {
+            if(here->LTRAname == name || (fast && here==*fast) ) {
+                *prev= here->LTRAnextInstance;
+                FREE(here->LTRAdelays);
+                FREE(here->LTRAstate);
+                FREE(here);
+                return(OK);
+            }
+            prev = &(here->LTRAnextInstance);
+        }
+    }
+    return(E_NODEV);
+}
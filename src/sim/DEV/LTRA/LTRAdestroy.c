@@ -0,0 +1,53 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "util.h"
+#include "LTRAdefs.h"
+#include "suffix.h"
+
+void
+LTRAdestroy(inModel)
+    GENmodel **inModel;
+{
+    LTRAmodel **model = (LTRAmodel **)inModel;
+    LTRAinstance *here;
+    LTRAinstance *prev = NULL;
+    LTRAmodel *mod = *model;
+    LTRAmodel *oldmod = NULL;
+
+    for( ; mod ; mod = mod->LTRAnextModel) {
+        if(oldmod) {
+            FREE(oldmod->LTRApoles);
+            FREE(oldmod->LTRAzResid);
+            FREE(oldmod->LTRAhResid);
+            FREE(oldmod->LTRAcoef);
+            FREE(oldmod);
+        }
+        oldmod = mod;
+        prev = (LTRAinstance *)NULL;
+        for(here = mod->LTRAinstances ; here ; here = here->LTRAnextInstance) {
+            if(prev) {
+                FREE(prev->LTRAdelays);
+                FREE(prev->LTRAstate);
+                FREE(prev);
+            }
+            prev = here;
+        }
+        if(prev) {
+            FREE(prev->LTRAdelays);
+            FREE(prev->LTRAstate);
+            FREE(prev);
+        }
+    }
+    if(oldmod) {
+        FREE(oldmod->LTRApoles);
+        FREE(oldmod->LTRAzResid);
+        FREE(oldmod->LTRAhResid);
+        FREE(oldmod->LTRAcoef);
+        FREE(oldmod);
+    }
+    *model = NULL;
+}
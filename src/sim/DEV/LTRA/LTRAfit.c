@@ -0,0 +1,277 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+/*
+ * Fit the tails of the impedance and propagation impulse responses with
+ * a sum of exponentials.  The poles are spread geometrically over the
+ * time scales of the line and of the run, and the residues are found by
+ * a least squares fit to the exact responses, which are known in closed
+ * form in terms of modified Bessel functions.
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include <math.h>
+#include "util.h"
+#include "CKTdefs.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+#ifdef __STDC__
+static double LTRAi0s(double);
+static double LTRAi1s(double);
+static double LTRAzTail(LTRAmodel*,double);
+static double LTRAhTail(LTRAmodel*,double);
+static int LTRAlsq(LTRAmodel*,double(*)(LTRAmodel*,double),double*,double*,
+        int);
+#else /* stdc */
+static double LTRAi0s();
+static double LTRAi1s();
+static double LTRAzTail();
+static double LTRAhTail();
+static int LTRAlsq();
+#endif /* stdc */
+
+/* number of samples per pole in the least squares fit */
+#define LTRASAMPLES 16
+
+int
+LTRAfit(model,ckt)
+    LTRAmodel *model;
+    CKTcircuit *ckt;
+{
+    double window;
+    double fast;
+    double ratio;
+    double *times;
+    int n;
+    int m;
+    int i;
+    int error;
+
+    window = model->LTRAfitTime;
+    if(!model->LTRAfitTimeGiven || window <= 0) {
+        window = ckt->CKTfinalTime;
+        if(window <= 0) window = 100 * model->LTRAtd;
+    }
+    if(window == model->LTRAfitWindow) return(OK);  /* still good */
+    model->LTRAfitWindow = window;
+    model->LTRAcoefStep = 0;
+
+    if(model->LTRApoles) FREE(model->LTRApoles);
+    if(model->LTRAzResid) FREE(model->LTRAzResid);
+    if(model->LTRAhResid) FREE(model->LTRAhResid);
+    if(model->LTRAcoef) FREE(model->LTRAcoef);
+
+    /* a distortionless line (R/L == G/C) has no tails at all */
+    if(model->LTRAbeta == 0) {
+        model->LTRAnumPoles = 0;
+        return(OK);
+    }
+
+    n = model->LTRAnumPoles = model->LTRAorder;
+    model->LTRApoles = (double *)MALLOC(n * sizeof(double));
+    model->LTRAzResid = (double *)MALLOC(n * sizeof(double));
+    model->LTRAhResid = (double *)MALLOC(n * sizeof(double));
+    model->LTRAcoef = (double *)MALLOC(3 * n * sizeof(double));
+    if(!model->LTRApoles || !model->LTRAzResid || !model->LTRAhResid ||
+            !model->LTRAcoef) return(E_NOMEM);
+
+    /* the fastest detail in either tail is set by the delay and by the
+     * loss time constant 1/alpha */
+    fast = MIN(model->LTRAtd, 1/model->LTRAalpha) / 10;
+    if(fast * 100 > window) window = fast * 100;
+
+    ratio = (n > 1) ? pow(window/fast, 1.0/(n-1)) : 1;
+    for(i = 0; i < n; i++) {
+        model->LTRApoles[i] = 1 / (fast * pow(ratio, (double)i));
+    }
+
+    m = LTRASAMPLES * n;
+    times = (double *)MALLOC(m * sizeof(double));
+    if(!times) return(E_NOMEM);
+    times[0] = 0;
+    ratio = pow(window*10/fast, 1.0/(m-2));
+    for(i = 1; i < m; i++) {
+        times[i] = fast / 10 * pow(ratio, (double)(i-1));
+    }
+
+    error = LTRAlsq(model, LTRAzTail, times, model->LTRAzResid, m);
+    if(!error) error = LTRAlsq(model, LTRAhTail, times, model->LTRAhResid, m);
+    FREE(times);
+    return(error);
+}
+
+
+/* least squares fit of the residues of f over the given sample times,
+ * by the normal equations - the poles are far enough apart for them to
+ * be well enough conditioned
+ */
+static int
+LTRAlsq(model,f,times,resid,m)
+    LTRAmodel *model;
+    double (*f)();
+    double *times;
+    double *resid;
+    int m;
+{
+    int n = model->LTRAnumPoles;
+    double *a;      /* n by n+1 augmented normal equations */
+    double *e;      /* exponentials at one sample time */
+    double fval;
+    double big;
+    double tmp;
+    int i, j, k, piv;
+
+    a = (double *)MALLOC(n * (n+1) * sizeof(double));
+    e = (double *)MALLOC(n * sizeof(double));
+    if(!a || !e) {
+        if(a) FREE(a);
+        if(e) FREE(e);
+        return(E_NOMEM);
+    }
+#define A(r,c) a[(r)*(n+1)+(c)]
+
+    for(k = 0; k < m; k++) {
+        fval = (*f)(model, times[k]);
+        for(i = 0; i < n; i++) {
+            e[i] = exp(-model->LTRApoles[i] * times[k]);
+        }
+        for(i = 0; i < n; i++) {
+            for(j = 0; j < n; j++) {
+                A(i,j) += e[i] * e[j];
+            }
+            A(i,n) += e[i] * fval;
+        }
+    }
+
+    /* a touch of damping keeps the solution sane if two columns are
+     * nearly the same over the window */
+    big = 0;
+    for(i = 0; i < n; i++) big = MAX(big, A(i,i));
+    for(i = 0; i < n; i++) A(i,i) += 1e-12 * big;
+
+    /* gaussian elimination with partial pivoting */
+    for(k = 0; k < n; k++) {
+        piv = k;
+        for(i = k+1; i < n; i++) {
+            if(FABS(A(i,k)) > FABS(A(piv,k))) piv = i;
+        }
+        if(A(piv,k) == 0) {
+            FREE(a);
+            FREE(e);
+            return(E_SINGULAR);
+        }
+        if(piv != k) {
+            for(j = k; j <= n; j++) {
+                tmp = A(k,j);
+                A(k,j) = A(piv,j);
+                A(piv,j) = tmp;
+            }
+        }
+        for(i = k+1; i < n; i++) {
+            tmp = A(i,k) / A(k,k);
+            for(j = k; j <= n; j++) {
+                A(i,j) -= tmp * A(k,j);
+            }
+        }
+    }
+    for(i = n-1; i >= 0; i--) {
+        tmp = A(i,n);
+        for(j = i+1; j < n; j++) {
+            tmp -= A(i,j) * resid[j];
+        }
+        resid[i] = tmp / A(i,i);
+    }
+#undef A
+    FREE(a);
+    FREE(e);
+    return(OK);
+}
+
+
+/* tail of the impulse response of the characteristic impedance:
+ *  z0 * beta * exp(-alpha t) * (I0(beta t) + I1(beta t))
+ */
+static double
+LTRAzTail(model,t)
+    LTRAmodel *model;
+    double t;
+{
+    double b = FABS(model->LTRAbeta);
+    double x = b * t;
+    double i1 = LTRAi1s(x);
+
+    if(model->LTRAbeta < 0) i1 = -i1;
+    return(model->LTRAimped * model->LTRAbeta *
+            exp(-(model->LTRAalpha - b) * t) * (LTRAi0s(x) + i1));
+}
+
+
+/* tail of the impulse response of the propagation function, tau after
+ * the delayed impulse:
+ *  exp(-alpha t) * beta * td * I1(beta u) / u,  u = sqrt(t*t - td*td)
+ */
+static double
+LTRAhTail(model,tau)
+    LTRAmodel *model;
+    double tau;
+{
+    double td = model->LTRAtd;
+    double b = FABS(model->LTRAbeta);
+    double t = tau + td;
+    double u = sqrt(tau * (tau + 2 * td));
+    double x = b * u;
+
+    if(x < 1e-8) {
+        /* I1(x)/x goes to 1/2 */
+        return(exp(-model->LTRAalpha * t) * b * b * td / 2);
+    }
+    return(exp(-(model->LTRAalpha * t - x)) * b * td * LTRAi1s(x) / u);
+}
+
+
+/* exp(-x) * I0(x) for x >= 0 (Abramowitz and Stegun 9.8.1, 9.8.2) */
+static double
+LTRAi0s(x)
+    double x;
+{
+    double t;
+
+    if(x < 3.75) {
+        t = x / 3.75;
+        t *= t;
+        return(exp(-x) * (1.0 + t * (3.5156229 + t * (3.0899424 +
+                t * (1.2067492 + t * (0.2659732 + t * (0.0360768 +
+                t * 0.0045813)))))));
+    }
+    t = 3.75 / x;
+    return((0.39894228 + t * (0.01328592 + t * (0.00225319 +
+            t * (-0.00157565 + t * (0.00916281 + t * (-0.02057706 +
+            t * (0.02635537 + t * (-0.01647633 + t * 0.00392377))))))))
+            / sqrt(x));
+}
+
+
+/* exp(-x) * I1(x) for x >= 0 (Abramowitz and Stegun 9.8.3, 9.8.4) */
+static double
+LTRAi1s(x)
+    double x;
+{
+    double t;
+
+    if(x < 3.75) {
+        t = x / 3.75;
+        t *= t;
+        return(exp(-x) * x * (0.5 + t * (0.87890594 + t * (0.51498869 +
+                t * (0.15084934 + t * (0.02658733 + t * (0.00301532 +
+                t * 0.00032411)))))));
+    }
+    t = 3.75 / x;
+    return((0.39894228 + t * (-0.03988024 + t * (-0.00362018 +
+            t * (0.00163801 + t * (-0.01031555 + t * (0.02282967 +
+            t * (-0.02895312 + t * (0.01787654 - t * 0.00420059))))))))
+            / sqrt(x));
+}
@@ -0,0 +1,89 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+/*
+ * Helpers for stepping the recursive convolutions and for looking
+ * back along the line into the history of the waves leaving each end.
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include <math.h>
+#include "util.h"
+#include "CKTdefs.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+/* Work out, for a step of h, the weights used to update the convolution
+ * of each exponential with an input that is linear over the step:
+ *  x(t+h) = E x(t) + res * (c0 u(t) + c1 u(t+h))
+ * They are the same for every instance of the model, so they are kept
+ * in the model and only recomputed when the step changes.
+ */
+void
+LTRAcoeffs(model,h)
+    LTRAmodel *model;
+    double h;
+{
+    double p, x, e, c0, c1;
+    int i;
+
+    if(h == model->LTRAcoefStep) return;
+    model->LTRAcoefStep = h;
+    model->LTRAzEff = model->LTRAimped;
+    for(i = 0; i < model->LTRAnumPoles; i++) {
+        p = model->LTRApoles[i];
+        x = p * h;
+        e = exp(-x);
+        if(x < 1e-3) {
+            /* series, to dodge the cancellation in x - (1 - e) */
+            c1 = h * (0.5 - x * (1.0/6 - x/24));
+            c0 = h * (1 - x * (0.5 - x/6)) - c1;
+        } else {
+            c1 = (x - (1 - e)) / (p * x);
+            c0 = (1 - e) / p - c1;
+        }
+        model->LTRAcoef[3*i] = e;
+        model->LTRAcoef[3*i+1] = c0;
+        model->LTRAcoef[3*i+2] = c1;
+        model->LTRAzEff += model->LTRAzResid[i] * c1;
+    }
+}
+
+
+/* Value at time t of the wave that left end 'which' (1 or 2), found by
+ * linear interpolation in the history.  The search starts from where the
+ * last one ended, so it is usually only a step or two.  Before the start
+ * of the history the first value is held, and past the end the last two
+ * points are extrapolated.
+ */
+double
+LTRAdelayed(here,t,which)
+    LTRAinstance *here;
+    double t;
+    int which;
+{
+    double *d0, *d1;
+    int i;
+
+    if(here->LTRAsizeDelay == 0)
+        return(*(LTRADELAY(here,0)+which));
+
+    i = here->LTRAcursorDelay;
+    if(i > here->LTRAsizeDelay) i = here->LTRAsizeDelay;
+    if(i < 1) i = 1;
+    while((i>1) && (*LTRADELAY(here,i-1) > t)) i--;
+    while((i<here->LTRAsizeDelay) && (*LTRADELAY(here,i) <= t)) i++;
+    here->LTRAcursorDelay = i;
+
+    d0 = LTRADELAY(here,i-1);
+    d1 = LTRADELAY(here,i);
+    if(t <= *d0)
+        return(*(d0+which));
+    if(*d1 == *d0)
+        return(*(d1+which));
+    return(*(d0+which) + (*(d1+which) - *(d0+which)) * (t - *d0) /
+            (*d1 - *d0));
+}
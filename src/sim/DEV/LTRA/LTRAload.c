@@ -0,0 +1,107 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "util.h"
+#include "CKTdefs.h"
+#include "LTRAdefs.h"
+#include "TRANdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+/*ARGSUSED*/
+int
+LTRAload(inModel,ckt)
+    GENmodel *inModel;
+    CKTcircuit *ckt;
+        /* actually load the current values into the
+         * sparse matrix previously provided
+         */
+{
+    register LTRAmodel *model = (LTRAmodel *)inModel;
+    register LTRAinstance *here;
+    double *coef;
+    double *zs1, *zs2, *hs1, *hs2;
+    double arrive1, arrive2;
+    int n;
+    register int i;
+
+    /*  loop through all the transmission line models */
+    for( ; model != NULL; model = model->LTRAnextModel ) {
+
+        n = model->LTRAnumPoles;
+        coef = model->LTRAcoef;
+
+        /* loop through all the instances of the model */
+        for (here = model->LTRAinstances; here != NULL ;
+                here=here->LTRAnextInstance) {
+
+            *(here->LTRApos1Ibr1Ptr) += 1;
+            *(here->LTRAneg1Ibr1Ptr) -= 1;
+            *(here->LTRApos2Ibr2Ptr) += 1;
+            *(here->LTRAneg2Ibr2Ptr) -= 1;
+
+            if(ckt->CKTmode & MODEDC) {
+                /* at dc the line is just its series resistance - the
+                 * shunt conductance is ignored */
+                *(here->LTRAibr1Pos1Ptr) += 1;
+                *(here->LTRAibr1Neg1Ptr) -= 1;
+                *(here->LTRAibr1Pos2Ptr) -= 1;
+                *(here->LTRAibr1Neg2Ptr) += 1;
+                *(here->LTRAibr1Ibr1Ptr) -= model->LTRAresist *
+                        model->LTRAlength;
+                *(here->LTRAibr2Ibr1Ptr) += 1;
+                *(here->LTRAibr2Ibr2Ptr) += 1;
+                continue;
+            }
+
+            if(ckt->CKTmode & (MODEINITTRAN | MODEINITPRED)) {
+                /* first pass at a new time point:  step the convolutions
+                 * from the last accepted point to here, leaving out the
+                 * part proportional to the present currents, which goes
+                 * into the matrix as LTRAzEff
+                 */
+                LTRAcoeffs(model, ckt->CKTtime - here->LTRAlastTime);
+                zs1 = here->LTRAstate;
+                zs2 = zs1 + here->LTRAnumState;
+                hs1 = zs2 + here->LTRAnumState;
+                hs2 = hs1 + here->LTRAnumState;
+
+                arrive1 = LTRAdelayed(here, ckt->CKTtime - model->LTRAtd, 2);
+                arrive2 = LTRAdelayed(here, ckt->CKTtime - model->LTRAtd, 1);
+                here->LTRAinput1 = model->LTRAattenuate * arrive1;
+                here->LTRAinput2 = model->LTRAattenuate * arrive2;
+                here->LTRAzHist1 = here->LTRAzHist2 = 0;
+                for(i = 0; i < n; i++) {
+                    here->LTRAzHist1 += coef[3*i] * zs1[i] +
+                            model->LTRAzResid[i] * coef[3*i+1] *
+                            here->LTRAcur1;
+                    here->LTRAzHist2 += coef[3*i] * zs2[i] +
+                            model->LTRAzResid[i] * coef[3*i+1] *
+                            here->LTRAcur2;
+                    here->LTRAinput1 += coef[3*i] * hs1[i] +
+                            model->LTRAhResid[i] * (coef[3*i+1] *
+                            here->LTRAdelayed1 + coef[3*i+2] * arrive1);
+                    here->LTRAinput2 += coef[3*i] * hs2[i] +
+                            model->LTRAhResid[i] * (coef[3*i+1] *
+                            here->LTRAdelayed2 + coef[3*i+2] * arrive2);
+                }
+            }
+
+            /* v1 - zEff * i1 = input1 + zHist1, and the same at end 2 */
+            *(here->LTRAibr1Pos1Ptr) += 1;
+            *(here->LTRAibr1Neg1Ptr) -= 1;
+            *(here->LTRAibr1Ibr1Ptr) -= model->LTRAzEff;
+            *(here->LTRAibr2Pos2Ptr) += 1;
+            *(here->LTRAibr2Neg2Ptr) -= 1;
+            *(here->LTRAibr2Ibr2Ptr) -= model->LTRAzEff;
+            *(ckt->CKTrhs + here->LTRAbrEq1) += here->LTRAinput1 +
+                    here->LTRAzHist1;
+            *(ckt->CKTrhs + here->LTRAbrEq2) += here->LTRAinput2 +
+                    here->LTRAzHist2;
+        }
+    }
+    return(OK);
+}
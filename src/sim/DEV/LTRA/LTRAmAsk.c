@@ -0,0 +1,66 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+/*
+ * This routine gives access to the internal model parameters
+ * of lossy transmission lines
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "CKTdefs.h"
+#include "DEVdefs.h"
+#include "IFsim.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+/* ARGSUSED */
+int
+LTRAmAsk(ckt,inst,which,value)
+    CKTcircuit *ckt;
+    GENmodel *inst;
+    int which;
+    IFvalue *value;
+{
+    LTRAmodel *here = (LTRAmodel *)inst;
+    switch(which) {
+        case LTRA_MOD_R:
+            value->rValue = here->LTRAresist;
+            return (OK);
+        case LTRA_MOD_L:
+            value->rValue = here->LTRAinduct;
+            return (OK);
+        case LTRA_MOD_G:
+            value->rValue = here->LTRAconduct;
+            return (OK);
+        case LTRA_MOD_C:
+            value->rValue = here->LTRAcapac;
+            return (OK);
+        case LTRA_MOD_LEN:
+            value->rValue = here->LTRAlength;
+            return (OK);
+        case LTRA_MOD_ORDER:
+            value->iValue = here->LTRAorder;
+            return (OK);
+        case LTRA_MOD_TFIT:
+            value->rValue = here->LTRAfitTime;
+            return (OK);
+        case LTRA_MOD_RELTOL:
+            value->rValue = here->LTRAreltol;
+            return (OK);
+        case LTRA_MOD_ABSTOL:
+            value->rValue = here->LTRAabstol;
+            return (OK);
+        case LTRA_MOD_TD:
+            value->rValue = here->LTRAtd;
+            return (OK);
+        case LTRA_MOD_Z0:
+            value->rValue = here->LTRAimped;
+            return (OK);
+        default:
+            return (E_BADPARM);
+    }
+    /* NOTREACHED */
+}
@@ -0,0 +1,53 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "util.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+int
+LTRAmDelete(inModel,modname,kill)
+    GENmodel **inModel;
+    IFuid modname;
+    GENmodel *kill;
+{
+    LTRAmodel **model = (LTRAmodel **)inModel;
+    LTRAmodel *modfast = (LTRAmodel *)kill;
+    LTRAinstance *here;
+    LTRAinstance *prev = NULL;
+    LTRAmodel **oldmod;
+    oldmod = model;
+    for( ; *model ; model = &((*model)->LTRAnextModel)) {
+        if( (*model)->LTRAmodName == modname || 
+                (modfast && *model == modfast) ) goto delgot;
+        oldmod = model;
+    }
+    return(E_NOMOD);
+
+delgot:
+    *oldmod = (*model)->LTRAnextModel; /* cut deleted device out of list */
+    for(here = (*model)->LTRAinstances ; here ; here = here->LTRAnextInstance) {
+        if(prev) {
+            FREE(prev->LTRAdelays);
+            FREE(prev->LTRAstate);
+            FREE(prev);
+        }
+        prev = here;
+    }
+    if(prev) {
+        FREE(prev->LTRAdelays);
+        FREE(prev->LTRAstate);
+        FREE(prev);
+    }
+    FREE((*model)->LTRApoles);
+    FREE((*model)->LTRAzResid);
+    FREE((*model)->LTRAhResid);
+    FREE((*model)->LTRAcoef);
+    FREE(*model);
+    return(OK);
+
+}
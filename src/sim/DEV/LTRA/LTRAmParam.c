@@ -0,0 +1,65 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "LTRAdefs.h"
+#include "util.h"
+#include "IFsim.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+int
+LTRAmParam(param,value,inModel)
+    int param;
+    IFvalue *value;
+    GENmodel *inModel;
+{
+    register LTRAmodel *model = (LTRAmodel *)inModel;
+    switch(param) {
+        case LTRA_MOD_R:
+            model->LTRAresist = value->rValue;
+            model->LTRAresistGiven = TRUE;
+            break;
+        case LTRA_MOD_L:
+            model->LTRAinduct = value->rValue;
+            model->LTRAinductGiven = TRUE;
+            break;
+        case LTRA_MOD_G:
+            model->LTRAconduct = value->rValue;
+            model->LTRAconductGiven = TRUE;
+            break;
+        case LTRA_MOD_C:
+            model->LTRAcapac = value->rValue;
+            model->LTRAcapacGiven = TRUE;
+            break;
+        case LTRA_MOD_LEN:
+            model->LTRAlength = value->rValue;
+            model->LTRAlengthGiven = TRUE;
+            break;
+        case LTRA_MOD_ORDER:
+            model->LTRAorder = value->iValue;
+            model->LTRAorderGiven = TRUE;
+            break;
+        case LTRA_MOD_TFIT:
+            model->LTRAfitTime = value->rValue;
+            model->LTRAfitTimeGiven = TRUE;
+            break;
+        case LTRA_MOD_RELTOL:
+            model->LTRAreltol = value->rValue;
+            model->LTRAreltolGiven = TRUE;
+            break;
+        case LTRA_MOD_ABSTOL:
+            model->LTRAabstol = value->rValue;
+            model->LTRAabstolGiven = TRUE;
+            break;
+        case LTRA_MOD_LTRA:
+            /* no operation - already know we are a lossy line, but this
+             * makes the .model line read naturally */
+            break;
+        default:
+            return(E_BADPARM);
+    }
+    return(OK);
+}
@@ -0,0 +1,118 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "util.h"
+#include "SMPdefs.h"
+#include "CKTdefs.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+/* ARGSUSED */
+int
+LTRAsetup(matrix,inModel,ckt,state)
+    register SMPmatrix *matrix;
+    GENmodel *inModel;
+    register CKTcircuit *ckt;
+    int *state;
+        /* load the transmission line structure with those pointers needed later
+         * for fast matrix loading 
+         */
+{
+    register LTRAmodel *model = (LTRAmodel *)inModel;
+    register LTRAinstance *here;
+    int error;
+    CKTnode *tmp;
+
+    /*  loop through all the transmission line models */
+    for( ; model != NULL; model = model->LTRAnextModel ) {
+
+        if(!model->LTRAresistGiven) {
+            model->LTRAresist = 0;
+        }
+        if(!model->LTRAconductGiven) {
+            model->LTRAconduct = 0;
+        }
+        if(!model->LTRAlengthGiven) {
+            model->LTRAlength = 1;
+        }
+        if(!model->LTRAorderGiven) {
+            model->LTRAorder = 8;
+        }
+        if(!model->LTRAreltolGiven) {
+            model->LTRAreltol = 1;
+        }
+        if(!model->LTRAabstolGiven) {
+            model->LTRAabstol = 1;
+        }
+        if(!model->LTRAinductGiven || !model->LTRAcapacGiven ||
+                model->LTRAinduct <= 0 || model->LTRAcapac <= 0) {
+            (*(SPfrontEnd->IFerror))(ERR_FATAL,
+                    "%s: lossy line needs l and c greater than zero",
+                    &(model->LTRAmodName));
+            return(E_BADPARM);
+        }
+        if(model->LTRAorder < 1 || model->LTRAorder > 32) {
+            (*(SPfrontEnd->IFerror))(ERR_FATAL,
+                    "%s: lossy line order must be between 1 and 32",
+                    &(model->LTRAmodName));
+            return(E_BADPARM);
+        }
+
+        /* loop through all the instances of the model */
+        for (here = model->LTRAinstances; here != NULL ;
+                here=here->LTRAnextInstance) {
+            
+            if(here->LTRAbrEq1==0) {
+                error = CKTmkCur(ckt,&tmp,here->LTRAname,"i1");
+                if(error) return(error);
+                here->LTRAbrEq1 = tmp->number;
+            }
+
+            if(here->LTRAbrEq2==0) {
+                error = CKTmkCur(ckt,&tmp,here->LTRAname,"i2");
+                if(error) return(error);
+                here->LTRAbrEq2 = tmp->number;
+            }
+
+            /* allocate the delay table - it grows by doubling in LTRAaccept */
+            if(here->LTRAdelays == NULL) {
+                here->LTRAallocDelay = 8;
+                here->LTRAdelays = (double *)MALLOC(3*here->LTRAallocDelay*
+                        sizeof(double));
+                if(here->LTRAdelays == NULL) return(E_NOMEM);
+            }
+            here->LTRAfirstDelay = 0;
+            here->LTRAsizeDelay = 0;
+            here->LTRAcursorDelay = 1;
+            here->LTRAinit = 0;
+
+/* macro to make elements with built in test for out of memory */
+#define TSTALLOC(ptr,first,second) \
+if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NULL){\
+    return(E_NOMEM);\
+}
+
+            TSTALLOC(LTRAibr1Pos1Ptr, LTRAbrEq1, LTRAposNode1)
+            TSTALLOC(LTRAibr1Neg1Ptr, LTRAbrEq1, LTRAnegNode1)
+            TSTALLOC(LTRAibr1Pos2Ptr, LTRAbrEq1, LTRAposNode2)
+            TSTALLOC(LTRAibr1Neg2Ptr, LTRAbrEq1, LTRAnegNode2)
+            TSTALLOC(LTRAibr1Ibr1Ptr, LTRAbrEq1, LTRAbrEq1)
+            TSTALLOC(LTRAibr1Ibr2Ptr, LTRAbrEq1, LTRAbrEq2)
+            TSTALLOC(LTRAibr2Pos1Ptr, LTRAbrEq2, LTRAposNode1)
+            TSTALLOC(LTRAibr2Neg1Ptr, LTRAbrEq2, LTRAnegNode1)
+            TSTALLOC(LTRAibr2Pos2Ptr, LTRAbrEq2, LTRAposNode2)
+            TSTALLOC(LTRAibr2Neg2Ptr, LTRAbrEq2, LTRAnegNode2)
+            TSTALLOC(LTRAibr2Ibr1Ptr, LTRAbrEq2, LTRAbrEq1)
+            TSTALLOC(LTRAibr2Ibr2Ptr, LTRAbrEq2, LTRAbrEq2)
+            TSTALLOC(LTRApos1Ibr1Ptr, LTRAposNode1, LTRAbrEq1)
+            TSTALLOC(LTRAneg1Ibr1Ptr, LTRAnegNode1, LTRAbrEq1)
+            TSTALLOC(LTRApos2Ibr2Ptr, LTRAposNode2, LTRAbrEq2)
+            TSTALLOC(LTRAneg2Ibr2Ptr, LTRAnegNode2, LTRAbrEq2)
+        }
+    }
+    return(OK);
+}
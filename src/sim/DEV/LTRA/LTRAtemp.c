@@ -0,0 +1,46 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include <math.h>
+#include "util.h"
+#include "SMPdefs.h"
+#include "CKTdefs.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+/* ARGSUSED */
+int
+LTRAtemp(inModel,ckt)
+    GENmodel *inModel;
+    CKTcircuit *ckt;
+        /*
+         * pre-process parameters for later use
+         */
+{
+    register LTRAmodel *model = (LTRAmodel *)inModel;
+
+    /*  loop through all the transmission line models */
+    for( ; model != NULL; model = model->LTRAnextModel ) {
+
+        /* with a = R/L and b = G/C the propagation constant times the
+         * length is td * sqrt((s+a)(s+b)), and the impedance is
+         * z0 * sqrt((s+a)/(s+b))
+         */
+        model->LTRAtd = model->LTRAlength *
+                sqrt(model->LTRAinduct * model->LTRAcapac);
+        model->LTRAimped = sqrt(model->LTRAinduct / model->LTRAcapac);
+        model->LTRAalpha = (model->LTRAresist/model->LTRAinduct +
+                model->LTRAconduct/model->LTRAcapac) / 2;
+        model->LTRAbeta = (model->LTRAresist/model->LTRAinduct -
+                model->LTRAconduct/model->LTRAcapac) / 2;
+        model->LTRAattenuate = exp(-model->LTRAalpha * model->LTRAtd);
+
+        /* the tails depend on the parameters, so make LTRAfit start over */
+        model->LTRAfitWindow = 0;
+    }
+    return(OK);
+}
@@ -0,0 +1,64 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "util.h"
+#include "CKTdefs.h"
+#include "LTRAdefs.h"
+#include "SPerror.h"
+#include "suffix.h"
+
+int
+LTRAtrunc(inModel,ckt,timeStep)
+    GENmodel *inModel;
+    register CKTcircuit *ckt;
+    double *timeStep;
+
+{
+    register LTRAmodel *model = (LTRAmodel *)inModel;
+    register LTRAinstance *here;
+    double *last, *prev;
+    double w1,w2;
+    double d1,d2,d3,d4;
+    double tmp;
+
+    /*  loop through all the transmission line models */
+    for( ; model != NULL; model = model->LTRAnextModel ) {
+
+        /* loop through all the instances of the model */
+        for (here = model->LTRAinstances; here != NULL ;
+                here=here->LTRAnextInstance) {
+            if(!here->LTRAinit || here->LTRAsizeDelay < 1) continue;
+            last = LTRADELAY(here,here->LTRAsizeDelay);
+            prev = LTRADELAY(here,here->LTRAsizeDelay-1);
+            if((ckt->CKTtime - *last <= 0) || (*last - *prev <= 0)) continue;
+
+            /* the waves leaving each end at the new point - LTRAzEff and
+             * the history terms are still those for this step */
+            w1 = ( *(ckt->CKTrhsOld + here->LTRAposNode1)
+                - *(ckt->CKTrhsOld + here->LTRAnegNode1))
+                + *(ckt->CKTrhsOld + here->LTRAbrEq1) * model->LTRAzEff
+                + here->LTRAzHist1;
+            w2 = ( *(ckt->CKTrhsOld + here->LTRAposNode2)
+                - *(ckt->CKTrhsOld + here->LTRAnegNode2))
+                + *(ckt->CKTrhsOld + here->LTRAbrEq2) * model->LTRAzEff
+                + here->LTRAzHist2;
+            d1 = (w1 - *(last+1)) / (ckt->CKTtime - *last);
+            d2 = (*(last+1) - *(prev+1)) / (*last - *prev);
+            d3 = (w2 - *(last+2)) / (ckt->CKTtime - *last);
+            d4 = (*(last+2) - *(prev+2)) / (*last - *prev);
+            if( (FABS(d1-d2) >= model->LTRAreltol*MAX(FABS(d1),FABS(d2))+
+                    model->LTRAabstol) ||
+                    (FABS(d3-d4) >= model->LTRAreltol*MAX(FABS(d3),FABS(d4))+
+                    model->LTRAabstol) ) {
+                /* derivative changing at the last point - don't step
+                 * past the time it reaches the other end */
+                tmp = *last + model->LTRAtd - ckt->CKTtime;
+                if(tmp > 0) *timeStep = MIN(*timeStep,tmp);
+            }
+        }
+    }
+    return(OK);
+}
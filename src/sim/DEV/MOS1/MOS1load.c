@@ -16,6 +16,19 @@
 
 RCSID("MOS1load.c $Revision: 1.1 $ on $Date: 90/10/11 12:44:25 $")
 
+/*
+ * the instances of a model are loaded MOS1BATCH at a time in three
+ * passes:  gather the terminal voltages (with prediction, bypass and
+ * limiting) into the b... arrays below, evaluate the diode and drain
+ * current equations straight down those arrays, then scatter the
+ * results through the state vector and the SMP pointers of each
+ * instance.  Building with MOS1BATCH as 1 gives back the old one
+ * instance at a time order.
+ */
+#ifndef MOS1BATCH
+#define MOS1BATCH 32
+#endif /* MOS1BATCH */
+
 int
 MOS1load(inModel,ckt)
     GENmodel *inModel;
@@ -26,6 +39,7 @@ MOS1load(inModel,ckt)
 {
     register MOS1model *model = (MOS1model *) inModel;
     register MOS1instance *here;
+    MOS1instance *rest;     /* instances not yet gathered */
     double Beta;
     double DrainSatCur;
     double EffectiveLength;
@@ -87,6 +101,45 @@ MOS1load(inModel,ckt)
     int senflag;
 #endif /* CAPBYPASS */ 
     int SenCond;
+    int ib;
+    int nbat;       /* number of instances in the current batch */
+
+    /* the batch - one entry per instance, gathered in list order */
+    MOS1instance *binst[MOS1BATCH];
+    int bsen[MOS1BATCH];        /* SenCond */
+    int bbyp[MOS1BATCH];        /* bypassed - last values still good */
+    int bcheck[MOS1BATCH];      /* limiting changed a voltage */
+    int bmode[MOS1BATCH];
+    double bvt[MOS1BATCH];
+    double bvbs[MOS1BATCH];
+    double bvbd[MOS1BATCH];
+    double bvgs[MOS1BATCH];
+    double bvds[MOS1BATCH];
+    double bvgd[MOS1BATCH];
+    double bvgb[MOS1BATCH];
+    double bdelvbs[MOS1BATCH];
+    double bdelvbd[MOS1BATCH];
+    double bcdhat[MOS1BATCH];
+    double bcbhat[MOS1BATCH];
+    double bphi[MOS1BATCH];
+    double bvbi[MOS1BATCH];
+    double bbeta[MOS1BATCH];
+    double bdsat[MOS1BATCH];     /* drain junction saturation current */
+    double bssat[MOS1BATCH];     /* source junction saturation current */
+    double bgscap[MOS1BATCH];    /* gate-source overlap capacitance */
+    double bgdcap[MOS1BATCH];    /* gate-drain overlap capacitance */
+    double bgbcap[MOS1BATCH];    /* gate-bulk overlap capacitance */
+    double boxcap[MOS1BATCH];    /* oxide capacitance */
+    double bgbs[MOS1BATCH];
+    double bcbs[MOS1BATCH];
+    double bgbd[MOS1BATCH];
+    double bcbd[MOS1BATCH];
+    double bgm[MOS1BATCH];
+    double bgds[MOS1BATCH];
+    double bgmbs[MOS1BATCH];
+    double bcdrain[MOS1BATCH];
+    double bvon[MOS1BATCH];
+    double bvdsat[MOS1BATCH];
 
 
 #ifdef CAPBYPASS
@@ -100,8 +153,15 @@ MOS1load(inModel,ckt)
     /*  loop through all the MOS1 device models */
     for( ; model != NULL; model = model->MOS1nextModel ) {
 
-        /* loop through all the instances of the model */
-        for (here = model->MOS1instances; here != NULL ;
+      /* loop through all the instances of the model, a batch at a time */
+      rest = model->MOS1instances;
+      while(rest != NULL) {
+
+        /*
+         * gather - pick up the voltages of the next batch of instances
+         */
+        nbat = 0;
+        for (here = rest; here != NULL && nbat < MOS1BATCH;
                 here=here->MOS1nextInstance) {
 
             vt = CONSTKoverQ * here->MOS1temp;
@@ -116,6 +176,7 @@ MOS1load(inModel,ckt)
 
             }
             SenCond = ckt->CKTsenInfo && here->MOS1senPertFlag;
+            bbyp[nbat] = 0;
 
 /*
 
@@ -126,32 +187,45 @@ asm("   .globl mospta");
 asm("mospta:");
 #endif /*DETAILPROF*/
 
-            /* first, we compute a few useful values - these could be
-             * pre-computed, but for historical reasons are still done
-             * here.  They may be moved at the expense of instance size
+            /* first, we get a few useful values - these are computed
+             * in MOS1temp since they depend only on the geometry, but
+             * sensitivity analysis perturbs w and l directly, so in that
+             * case they are still done here
              */
 
-            EffectiveLength=here->MOS1l - 2*model->MOS1latDiff;
-            if( (here->MOS1tSatCurDens == 0) || 
-                    (here->MOS1drainArea == 0) ||
-                    (here->MOS1sourceArea == 0)) {
-                DrainSatCur = here->MOS1tSatCur;
-                SourceSatCur = here->MOS1tSatCur;
+            if(SenCond) {
+                /* w and l may be perturbed, so redo the geometry */
+                EffectiveLength=here->MOS1l - 2*model->MOS1latDiff;
+                if( (here->MOS1tSatCurDens == 0) || 
+                        (here->MOS1drainArea == 0) ||
+                        (here->MOS1sourceArea == 0)) {
+                    DrainSatCur = here->MOS1tSatCur;
+                    SourceSatCur = here->MOS1tSatCur;
+                } else {
+                    DrainSatCur = here->MOS1tSatCurDens * 
+                            here->MOS1drainArea;
+                    SourceSatCur = here->MOS1tSatCurDens * 
+                            here->MOS1sourceArea;
+                }
+                GateSourceOverlapCap = model->MOS1gateSourceOverlapCapFactor * 
+                        here->MOS1w;
+                GateDrainOverlapCap = model->MOS1gateDrainOverlapCapFactor * 
+                        here->MOS1w;
+                GateBulkOverlapCap = model->MOS1gateBulkOverlapCapFactor * 
+                        EffectiveLength;
+                Beta = here->MOS1tTransconductance * here->MOS1w/EffectiveLength;
+                OxideCap = model->MOS1oxideCapFactor * EffectiveLength * 
+                        here->MOS1w;
             } else {
-                DrainSatCur = here->MOS1tSatCurDens * 
-                        here->MOS1drainArea;
-                SourceSatCur = here->MOS1tSatCurDens * 
-                        here->MOS1sourceArea;
+                EffectiveLength = here->MOS1tEffLength;
+                DrainSatCur = here->MOS1tDrainSatCur;
+                SourceSatCur = here->MOS1tSourceSatCur;
+                GateSourceOverlapCap = here->MOS1tGsOverlapCap;
+                GateDrainOverlapCap = here->MOS1tGdOverlapCap;
+                GateBulkOverlapCap = here->MOS1tGbOverlapCap;
+                Beta = here->MOS1tBeta;
+                OxideCap = here->MOS1tOxideCap;
             }
-            GateSourceOverlapCap = model->MOS1gateSourceOverlapCapFactor * 
-                    here->MOS1w;
-            GateDrainOverlapCap = model->MOS1gateDrainOverlapCapFactor * 
-                    here->MOS1w;
-            GateBulkOverlapCap = model->MOS1gateBulkOverlapCapFactor * 
-                    EffectiveLength;
-            Beta = here->MOS1tTransconductance * here->MOS1w/EffectiveLength;
-            OxideCap = model->MOS1oxideCapFactor * EffectiveLength * 
-                    here->MOS1w;
             /* 
              * ok - now to do the start-up operations
              *
@@ -317,7 +391,8 @@ asm("mosptb:");
                     /* nothing interesting has changed since last
                      * iteration on this device, so we just
                      * copy all the values computed last iteration out
-                     * and keep going
+                     * and keep going - the rest is done in the
+                     * scatter pass
                      */
                     vbs = *(ckt->CKTstate0 + here->MOS1vbs);
                     vbd = *(ckt->CKTstate0 + here->MOS1vbd);
@@ -325,25 +400,8 @@ asm("mosptb:");
                     vds = *(ckt->CKTstate0 + here->MOS1vds);
                     vgd = vgs - vds;
                     vgb = vgs - vbs;
-                    cdrain = here->MOS1mode * (here->MOS1cd + here->MOS1cbd);
-                    if(ckt->CKTmode & (MODETRAN | MODETRANOP)) {
-                        capgs = ( *(ckt->CKTstate0+here->MOS1capgs)+ 
-                                  *(ckt->CKTstate1+here->MOS1capgs) +
-                                  GateSourceOverlapCap );
-                        capgd = ( *(ckt->CKTstate0+here->MOS1capgd)+ 
-                                  *(ckt->CKTstate1+here->MOS1capgd) +
-                                  GateDrainOverlapCap );
-                        capgb = ( *(ckt->CKTstate0+here->MOS1capgb)+ 
-                                  *(ckt->CKTstate1+here->MOS1capgb) +
-                                  GateBulkOverlapCap );
-
-                        if(ckt->CKTsenInfo){
-                            here->MOS1cgs = capgs;
-                            here->MOS1cgd = capgd;
-                            here->MOS1cgb = capgb;
-                        }
-                    }
-                    goto bypass;
+                    bbyp[nbat] = 1;
+                    goto next1;
                 }
 #endif /*NOBYPASS*/
 /*
@@ -439,29 +497,71 @@ asm("mospte:");
             vgd = vgs - vds;
             vgb = vgs - vbs;
 
+            /* put this instance into the batch */
+next1:      binst[nbat] = here;
+            bsen[nbat] = SenCond;
+            bcheck[nbat] = Check;
+            bvt[nbat] = vt;
+            bvbs[nbat] = vbs;
+            bvbd[nbat] = vbd;
+            bvgs[nbat] = vgs;
+            bvds[nbat] = vds;
+            bvgd[nbat] = vgd;
+            bvgb[nbat] = vgb;
+            bdelvbs[nbat] = delvbs;
+            bdelvbd[nbat] = delvbd;
+            bcdhat[nbat] = cdhat;
+            bcbhat[nbat] = cbhat;
+            bphi[nbat] = here->MOS1tPhi;
+            bvbi[nbat] = here->MOS1tVbi;
+            bbeta[nbat] = Beta;
+            bdsat[nbat] = DrainSatCur;
+            bssat[nbat] = SourceSatCur;
+            bgscap[nbat] = GateSourceOverlapCap;
+            bgdcap[nbat] = GateDrainOverlapCap;
+            bgbcap[nbat] = GateBulkOverlapCap;
+            boxcap[nbat] = OxideCap;
+            nbat++;
+        }
+        rest = here;
+
+        /*
+         * evaluate - the junction diodes and the drain current of every
+         * instance in the batch that was not bypassed.  This only works
+         * on the batch arrays, so it runs straight down contiguous
+         * storage with no pointer chasing.
+         */
+        for (ib = 0; ib < nbat; ib++) {
+            if(bbyp[ib]) continue;
+            vt = bvt[ib];
+            vbs = bvbs[ib];
+            vbd = bvbd[ib];
+            vgs = bvgs[ib];
+            vgd = bvgd[ib];
+            vds = bvds[ib];
 
             /*
              * bulk-source and bulk-drain diodes
              *   here we just evaluate the ideal diode current and the
              *   corresponding derivative (conductance).
              */
-next1:      if(vbs <= 0) {
-                here->MOS1gbs = SourceSatCur/vt;
-                here->MOS1cbs = here->MOS1gbs*vbs;
-                here->MOS1gbs += ckt->CKTgmin;
+            if(vbs <= 0) {
+                bgbs[ib] = bssat[ib]/vt;
+                bcbs[ib] = bgbs[ib]*vbs;
+                bgbs[ib] += ckt->CKTgmin;
             } else {
                 evbs = exp(MIN(MAX_EXP_ARG,vbs/vt));
-                here->MOS1gbs = SourceSatCur*evbs/vt + ckt->CKTgmin;
-                here->MOS1cbs = SourceSatCur * (evbs-1);
+                bgbs[ib] = bssat[ib]*evbs/vt + ckt->CKTgmin;
+                bcbs[ib] = bssat[ib] * (evbs-1);
             }
             if(vbd <= 0) {
-                here->MOS1gbd = DrainSatCur/vt;
-                here->MOS1cbd = here->MOS1gbd *vbd;
-                here->MOS1gbd += ckt->CKTgmin;
+                bgbd[ib] = bdsat[ib]/vt;
+                bcbd[ib] = bgbd[ib] *vbd;
+                bgbd[ib] += ckt->CKTgmin;
             } else {
                 evbd = exp(MIN(MAX_EXP_ARG,vbd/vt));
-                here->MOS1gbd = DrainSatCur*evbd/vt +ckt->CKTgmin;
-                here->MOS1cbd = DrainSatCur *(evbd-1);
+                bgbd[ib] = bdsat[ib]*evbd/vt +ckt->CKTgmin;
+                bcbd[ib] = bdsat[ib] *(evbd-1);
             }
 
             /* now to determine whether the user was able to correctly
@@ -469,10 +569,10 @@ next1:      if(vbs <= 0) {
              */
             if(vds >= 0) {
                 /* normal mode */
-                here->MOS1mode = 1;
+                bmode[ib] = 1;
             } else {
                 /* inverse mode */
-                here->MOS1mode = -1;
+                bmode[ib] = -1;
             }
 /*
 
@@ -499,15 +599,15 @@ asm("mosptf:");
             double sarg;
             double vgst;
 
-                if ((here->MOS1mode==1?vbs:vbd) <= 0 ) {
-                    sarg=sqrt(here->MOS1tPhi-(here->MOS1mode==1?vbs:vbd));
+                if ((bmode[ib]==1?vbs:vbd) <= 0 ) {
+                    sarg=sqrt(bphi[ib]-(bmode[ib]==1?vbs:vbd));
                 } else {
-                    sarg=sqrt(here->MOS1tPhi);
-                    sarg=sarg-(here->MOS1mode==1?vbs:vbd)/(sarg+sarg);
+                    sarg=sqrt(bphi[ib]);
+                    sarg=sarg-(bmode[ib]==1?vbs:vbd)/(sarg+sarg);
                     sarg=MAX(0,sarg);
                 }
-                von=(here->MOS1tVbi*model->MOS1type)+model->MOS1gamma*sarg;
-                vgst=(here->MOS1mode==1?vgs:vgd)-von;
+                von=(bvbi[ib]*model->MOS1type)+model->MOS1gamma*sarg;
+                vgst=(bmode[ib]==1?vgs:vgd)-von;
                 vdsat=MAX(vgst,0);
                 if (sarg <= 0) {
                     arg=0;
@@ -519,37 +619,99 @@ asm("mosptf:");
                      *     cutoff region
                      */
                     cdrain=0;
-                    here->MOS1gm=0;
-                    here->MOS1gds=0;
-                    here->MOS1gmbs=0;
+                    bgm[ib]=0;
+                    bgds[ib]=0;
+                    bgmbs[ib]=0;
                 } else{
                     /*
                      *     saturation region
                      */
-                    betap=Beta*(1+model->MOS1lambda*(vds*here->MOS1mode));
-                    if (vgst <= (vds*here->MOS1mode)){
+                    betap=bbeta[ib]*(1+model->MOS1lambda*(vds*bmode[ib]));
+                    if (vgst <= (vds*bmode[ib])){
                         cdrain=betap*vgst*vgst*.5;
-                        here->MOS1gm=betap*vgst;
-                        here->MOS1gds=model->MOS1lambda*Beta*vgst*vgst*.5;
-                        here->MOS1gmbs=here->MOS1gm*arg;
+                        bgm[ib]=betap*vgst;
+                        bgds[ib]=model->MOS1lambda*bbeta[ib]*vgst*vgst*.5;
+                        bgmbs[ib]=bgm[ib]*arg;
                     } else {
                     /*
                      *     linear region
                      */
-                        cdrain=betap*(vds*here->MOS1mode)*
-                            (vgst-.5*(vds*here->MOS1mode));
-                        here->MOS1gm=betap*(vds*here->MOS1mode);
-                        here->MOS1gds=betap*(vgst-(vds*here->MOS1mode))+
-                                model->MOS1lambda*Beta*
-                                (vds*here->MOS1mode)*
-                                (vgst-.5*(vds*here->MOS1mode));
-                        here->MOS1gmbs=here->MOS1gm*arg;
+                        cdrain=betap*(vds*bmode[ib])*
+                            (vgst-.5*(vds*bmode[ib]));
+                        bgm[ib]=betap*(vds*bmode[ib]);
+                        bgds[ib]=betap*(vgst-(vds*bmode[ib]))+
+                                model->MOS1lambda*bbeta[ib]*
+                                (vds*bmode[ib])*
+                                (vgst-.5*(vds*bmode[ib]));
+                        bgmbs[ib]=bgm[ib]*arg;
                     }
                 }
                 /*
                  *     finished
                  */
             }
+            bcdrain[ib] = cdrain;
+            bvon[ib] = von;
+            bvdsat[ib] = vdsat;
+        }
+
+        /*
+         * scatter - charges, convergence test and the matrix and rhs
+         * stamps for each instance in the batch
+         */
+        for (ib = 0; ib < nbat; ib++) {
+            here = binst[ib];
+            SenCond = bsen[ib];
+            Check = bcheck[ib];
+            vbs = bvbs[ib];
+            vbd = bvbd[ib];
+            vgs = bvgs[ib];
+            vds = bvds[ib];
+            vgd = bvgd[ib];
+            vgb = bvgb[ib];
+            delvbs = bdelvbs[ib];
+            delvbd = bdelvbd[ib];
+            cdhat = bcdhat[ib];
+            cbhat = bcbhat[ib];
+            GateSourceOverlapCap = bgscap[ib];
+            GateDrainOverlapCap = bgdcap[ib];
+            GateBulkOverlapCap = bgbcap[ib];
+            OxideCap = boxcap[ib];
+
+            if(bbyp[ib]) {
+                /* bypassed in the gather pass */
+                cdrain = here->MOS1mode * (here->MOS1cd + here->MOS1cbd);
+                if(ckt->CKTmode & (MODETRAN | MODETRANOP)) {
+                    capgs = ( *(ckt->CKTstate0+here->MOS1capgs)+
+                              *(ckt->CKTstate1+here->MOS1capgs) +
+                              GateSourceOverlapCap );
+                    capgd = ( *(ckt->CKTstate0+here->MOS1capgd)+
+                              *(ckt->CKTstate1+here->MOS1capgd) +
+                              GateDrainOverlapCap );
+                    capgb = ( *(ckt->CKTstate0+here->MOS1capgb)+
+                              *(ckt->CKTstate1+here->MOS1capgb) +
+                              GateBulkOverlapCap );
+
+                    if(ckt->CKTsenInfo){
+                        here->MOS1cgs = capgs;
+                        here->MOS1cgd = capgd;
+                        here->MOS1cgb = capgb;
+                    }
+                }
+                goto bypass;
+            }
+
+            here->MOS1gbs = bgbs[ib];
+            here->MOS1cbs = bcbs[ib];
+            here->MOS1gbd = bgbd[ib];
+            here->MOS1cbd = bcbd[ib];
+            here->MOS1mode = bmode[ib];
+            here->MOS1gm = bgm[ib];
+            here->MOS1gds = bgds[ib];
+            here->MOS1gmbs = bgmbs[ib];
+            cdrain = bcdrain[ib];
+            von = bvon[ib];
+            vdsat = bvdsat[ib];
 /*
 
 */
@@ -1015,6 +1177,7 @@ bypass:
             *(here->MOS1SPdpPtr) += (-here->MOS1gds-xrev*
                     (here->MOS1gm+here->MOS1gmbs));
         }
+      }
     }
     return(OK);
 }
@@ -207,6 +207,32 @@ MOS1temp(inModel,ckt)
                         here->MOS1tSatCurDens * here->MOS1sourceArea));
             }
 
+            /* geometry dependent values used on every load, these
+             * only change with the instance parameters, so do them here
+             */
+            here->MOS1tEffLength = here->MOS1l - 2*model->MOS1latDiff;
+            if( (here->MOS1tSatCurDens == 0) || 
+                    (here->MOS1drainArea == 0) ||
+                    (here->MOS1sourceArea == 0)) {
+                here->MOS1tDrainSatCur = here->MOS1tSatCur;
+                here->MOS1tSourceSatCur = here->MOS1tSatCur;
+            } else {
+                here->MOS1tDrainSatCur = here->MOS1tSatCurDens * 
+                        here->MOS1drainArea;
+                here->MOS1tSourceSatCur = here->MOS1tSatCurDens * 
+                        here->MOS1sourceArea;
+            }
+            here->MOS1tGsOverlapCap = model->MOS1gateSourceOverlapCapFactor * 
+                    here->MOS1w;
+            here->MOS1tGdOverlapCap = model->MOS1gateDrainOverlapCapFactor * 
+                    here->MOS1w;
+            here->MOS1tGbOverlapCap = model->MOS1gateBulkOverlapCapFactor * 
+                    here->MOS1tEffLength;
+            here->MOS1tBeta = here->MOS1tTransconductance * here->MOS1w /
+                    here->MOS1tEffLength;
+            here->MOS1tOxideCap = model->MOS1oxideCapFactor * 
+                    here->MOS1tEffLength * here->MOS1w;
+
             if(model->MOS1capBDGiven) {
                 czbd = here->MOS1tCbd;
             } else {
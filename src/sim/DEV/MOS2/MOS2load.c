@@ -22,6 +22,19 @@ RCSID("MOS2load.c $Revision: 1.1 $ on $Date: 90/10/11 12:44:54 $")
 static double sig1[4] = {1.0, -1.0, 1.0, -1.0};
 static double sig2[4] = {1.0,  1.0,-1.0, -1.0};
 
+/*
+ * the instances of a model are loaded MOS2BATCH at a time in three
+ * passes:  gather the terminal voltages (with prediction, bypass and
+ * limiting) into the b... arrays below, evaluate the diode and drain
+ * current equations for the whole batch, then scatter the results
+ * through the state vector and the SMP pointers of each instance.
+ * Building with MOS2BATCH as 1 gives back the old one instance at a
+ * time order.
+ */
+#ifndef MOS2BATCH
+#define MOS2BATCH 32
+#endif /* MOS2BATCH */
+
 int
 MOS2load(inModel,ckt)
     GENmodel *inModel;
@@ -32,6 +45,7 @@ MOS2load(inModel,ckt)
 {
     register MOS2model *model = (MOS2model *)inModel;
     register MOS2instance *here;
+    MOS2instance *rest;     /* instances not yet gathered */
     int error;
     double Beta;
     double DrainSatCur;
@@ -93,6 +107,36 @@ MOS2load(inModel,ckt)
     int senflag;
 #endif /* CAPBYPASS */
     int SenCond=0;
+    int ib;
+    int nbat;       /* number of instances in the current batch */
+
+    /* the batch - one entry per instance, gathered in list order */
+    MOS2instance *binst[MOS2BATCH];
+    int bsen[MOS2BATCH];        /* SenCond */
+    int bbyp[MOS2BATCH];        /* bypassed - last values still good */
+    int bcheck[MOS2BATCH];      /* limiting changed a voltage */
+    double bvt[MOS2BATCH];
+    double bvbs[MOS2BATCH];
+    double bvbd[MOS2BATCH];
+    double bvgs[MOS2BATCH];
+    double bvds[MOS2BATCH];
+    double bvgd[MOS2BATCH];
+    double bvgb[MOS2BATCH];
+    double bdelvbs[MOS2BATCH];
+    double bdelvbd[MOS2BATCH];
+    double bcdhat[MOS2BATCH];
+    double bcbhat[MOS2BATCH];
+    double bleff[MOS2BATCH];     /* effective channel length */
+    double bbeta[MOS2BATCH];
+    double bdsat[MOS2BATCH];     /* drain junction saturation current */
+    double bssat[MOS2BATCH];     /* source junction saturation current */
+    double bgscap[MOS2BATCH];    /* gate-source overlap capacitance */
+    double bgdcap[MOS2BATCH];    /* gate-drain overlap capacitance */
+    double bgbcap[MOS2BATCH];    /* gate-bulk overlap capacitance */
+    double boxcap[MOS2BATCH];    /* oxide capacitance */
+    double bcdrain[MOS2BATCH];
+    double bvon[MOS2BATCH];
+    double bvdsat[MOS2BATCH];
 
 #ifdef CAPBYPASS
     senflag = 0;
@@ -110,8 +154,15 @@ MOS2load(inModel,ckt)
     /*  loop through all the MOS2 device models */
     for( ; model != NULL; model = model->MOS2nextModel ) {
 
-        /* loop through all the instances of the model */
-        for (here = model->MOS2instances; here != NULL ;
+      /* loop through all the instances of the model, a batch at a time */
+      rest = model->MOS2instances;
+      while(rest != NULL) {
+
+        /*
+         * gather - pick up the voltages of the next batch of instances
+         */
+        nbat = 0;
+        for (here = rest; here != NULL && nbat < MOS2BATCH;
                 here=here->MOS2nextInstance) {
 
             vt = CONSTKoverQ * here->MOS2temp;
@@ -127,28 +178,41 @@ MOS2load(inModel,ckt)
                 SenCond = here->MOS2senPertFlag;
 
             }
-
-            EffectiveLength=here->MOS2l - 2*model->MOS2latDiff;
-            if( (here->MOS2tSatCurDens == 0) || 
-                    (here->MOS2drainArea == 0) ||
-                    (here->MOS2sourceArea == 0)) {
-                DrainSatCur = here->MOS2tSatCur;
-                SourceSatCur = here->MOS2tSatCur;
+            bbyp[nbat] = 0;
+
+            if(SenCond) {
+                /* w and l may be perturbed, so redo the geometry */
+                EffectiveLength=here->MOS2l - 2*model->MOS2latDiff;
+                if( (here->MOS2tSatCurDens == 0) || 
+                        (here->MOS2drainArea == 0) ||
+                        (here->MOS2sourceArea == 0)) {
+                    DrainSatCur = here->MOS2tSatCur;
+                    SourceSatCur = here->MOS2tSatCur;
+                } else {
+                    DrainSatCur = here->MOS2tSatCurDens * 
+                            here->MOS2drainArea;
+                    SourceSatCur = here->MOS2tSatCurDens * 
+                            here->MOS2sourceArea;
+                }
+                GateSourceOverlapCap = model->MOS2gateSourceOverlapCapFactor * 
+                        here->MOS2w;
+                GateDrainOverlapCap = model->MOS2gateDrainOverlapCapFactor * 
+                        here->MOS2w;
+                GateBulkOverlapCap = model->MOS2gateBulkOverlapCapFactor * 
+                        EffectiveLength;
+                Beta = here->MOS2tTransconductance * here->MOS2w/EffectiveLength;
+                OxideCap = model->MOS2oxideCapFactor * EffectiveLength * 
+                        here->MOS2w;
             } else {
-                DrainSatCur = here->MOS2tSatCurDens * 
-                        here->MOS2drainArea;
-                SourceSatCur = here->MOS2tSatCurDens * 
-                        here->MOS2sourceArea;
+                EffectiveLength = here->MOS2tEffLength;
+                DrainSatCur = here->MOS2tDrainSatCur;
+                SourceSatCur = here->MOS2tSourceSatCur;
+                GateSourceOverlapCap = here->MOS2tGsOverlapCap;
+                GateDrainOverlapCap = here->MOS2tGdOverlapCap;
+                GateBulkOverlapCap = here->MOS2tGbOverlapCap;
+                Beta = here->MOS2tBeta;
+                OxideCap = here->MOS2tOxideCap;
             }
-            GateSourceOverlapCap = model->MOS2gateSourceOverlapCapFactor * 
-                    here->MOS2w;
-            GateDrainOverlapCap = model->MOS2gateDrainOverlapCapFactor * 
-                    here->MOS2w;
-            GateBulkOverlapCap = model->MOS2gateBulkOverlapCapFactor * 
-                    EffectiveLength;
-            Beta = here->MOS2tTransconductance * here->MOS2w/EffectiveLength;
-            OxideCap = model->MOS2oxideCapFactor * EffectiveLength * 
-                    here->MOS2w;
 
 
             if(SenCond){
@@ -301,7 +365,8 @@ MOS2load(inModel,ckt)
                     /* nothing interesting has changed since last 
                      * iteration on this device, so we just
                      * copy all the values computed last iteration 
-                     * out and keep going
+                     * out and keep going - the rest is done in the
+                     * scatter pass
                      */
                     vbs = *(ckt->CKTstate0 + here->MOS2vbs);
                     vbd = *(ckt->CKTstate0 + here->MOS2vbd);
@@ -309,24 +374,8 @@ MOS2load(inModel,ckt)
                     vds = *(ckt->CKTstate0 + here->MOS2vds);
                     vgd = vgs - vds;
                     vgb = vgs - vbs;
-                    cdrain = here->MOS2mode * (here->MOS2cd + here->MOS2cbd);
-                    if(ckt->CKTmode & (MODETRAN | MODETRANOP)) {
-                        capgs = ( *(ckt->CKTstate0 + here->MOS2capgs)+
-                                  *(ckt->CKTstate1 + here->MOS2capgs)+
-                                  GateSourceOverlapCap );
-                        capgd = ( *(ckt->CKTstate0 + here->MOS2capgd)+
-                                  *(ckt->CKTstate1 + here->MOS2capgd)+
-                                  GateDrainOverlapCap );
-                        capgb = ( *(ckt->CKTstate0 + here->MOS2capgb)+
-                                  *(ckt->CKTstate1 + here->MOS2capgb)+
-                                  GateBulkOverlapCap );
-                        if(ckt->CKTsenInfo){
-                            here->MOS2cgs = capgs;
-                            here->MOS2cgd = capgd;
-                            here->MOS2cgb = capgb;
-                        }
-                    }
-                    goto bypass;
+                    bbyp[nbat] = 1;
+                    goto next1;
                 }
 #endif /*NOBYPASS*/
                 /* ok - bypass is out, do it the hard way */
@@ -392,12 +441,59 @@ MOS2load(inModel,ckt)
             vgd = vgs - vds;
             vgb = vgs - vbs;
 
+            /* put this instance into the batch */
+next1:      binst[nbat] = here;
+            bsen[nbat] = SenCond;
+            bcheck[nbat] = Check;
+            bvt[nbat] = vt;
+            bvbs[nbat] = vbs;
+            bvbd[nbat] = vbd;
+            bvgs[nbat] = vgs;
+            bvds[nbat] = vds;
+            bvgd[nbat] = vgd;
+            bvgb[nbat] = vgb;
+            bdelvbs[nbat] = delvbs;
+            bdelvbd[nbat] = delvbd;
+            bcdhat[nbat] = cdhat;
+            bcbhat[nbat] = cbhat;
+            bleff[nbat] = EffectiveLength;
+            bbeta[nbat] = Beta;
+            bdsat[nbat] = DrainSatCur;
+            bssat[nbat] = SourceSatCur;
+            bgscap[nbat] = GateSourceOverlapCap;
+            bgdcap[nbat] = GateDrainOverlapCap;
+            bgbcap[nbat] = GateBulkOverlapCap;
+            boxcap[nbat] = OxideCap;
+            nbat++;
+        }
+        rest = here;
+
+        /*
+         * evaluate - the junction diodes and the drain current of every
+         * instance in the batch that was not bypassed, working from the
+         * voltages and geometry gathered above
+         */
+        for (ib = 0; ib < nbat; ib++) {
+            if(bbyp[ib]) continue;
+            here = binst[ib];
+            vt = bvt[ib];
+            vbs = bvbs[ib];
+            vbd = bvbd[ib];
+            vgs = bvgs[ib];
+            vds = bvds[ib];
+            vgd = bvgd[ib];
+            EffectiveLength = bleff[ib];
+            Beta = bbeta[ib];
+            DrainSatCur = bdsat[ib];
+            SourceSatCur = bssat[ib];
+            OxideCap = boxcap[ib];
+
             /* bulk-source and bulk-drain doides
              * here we just evaluate the ideal diode current and the
              * correspoinding derivative (conductance).
              */
 
-next1:      if(vbs <= 0) {
+            if(vbs <= 0) {
                 here->MOS2gbs = SourceSatCur/vt;
                 here->MOS2cbs = here->MOS2gbs*vbs;
                 here->MOS2gbs += ckt->CKTgmin;
@@ -998,7 +1094,62 @@ line1050:
              */
 
             }
-doneval:    
+doneval:
+            bcdrain[ib] = cdrain;
+            bvon[ib] = von;
+            bvdsat[ib] = vdsat;
+        }
+
+        /*
+         * scatter - charges, convergence test and the matrix and rhs
+         * stamps for each instance in the batch
+         */
+        for (ib = 0; ib < nbat; ib++) {
+            here = binst[ib];
+            SenCond = bsen[ib];
+            Check = bcheck[ib];
+            vbs = bvbs[ib];
+            vbd = bvbd[ib];
+            vgs = bvgs[ib];
+            vds = bvds[ib];
+            vgd = bvgd[ib];
+            vgb = bvgb[ib];
+            delvbs = bdelvbs[ib];
+            delvbd = bdelvbd[ib];
+            cdhat = bcdhat[ib];
+            cbhat = bcbhat[ib];
+            GateSourceOverlapCap = bgscap[ib];
+            GateDrainOverlapCap = bgdcap[ib];
+            GateBulkOverlapCap = bgbcap[ib];
+            OxideCap = boxcap[ib];
+
+#ifndef NOBYPASS
+            if(bbyp[ib]) {
+                /* bypassed in the gather pass */
+                cdrain = here->MOS2mode * (here->MOS2cd + here->MOS2cbd);
+                if(ckt->CKTmode & (MODETRAN | MODETRANOP)) {
+                    capgs = ( *(ckt->CKTstate0 + here->MOS2capgs)+
+                              *(ckt->CKTstate1 + here->MOS2capgs)+
+                              GateSourceOverlapCap );
+                    capgd = ( *(ckt->CKTstate0 + here->MOS2capgd)+
+                              *(ckt->CKTstate1 + here->MOS2capgd)+
+                              GateDrainOverlapCap );
+                    capgb = ( *(ckt->CKTstate0 + here->MOS2capgb)+
+                              *(ckt->CKTstate1 + here->MOS2capgb)+
+                              GateBulkOverlapCap );
+                    if(ckt->CKTsenInfo){
+                        here->MOS2cgs = capgs;
+                        here->MOS2cgd = capgd;
+                        here->MOS2cgb = capgb;
+                    }
+                }
+                goto bypass;
+            }
+#endif /* NOBYPASS */
+            cdrain = bcdrain[ib];
+            von = bvon[ib];
+            vdsat = bvdsat[ib];
+
             here->MOS2von = model->MOS2type * von;
             here->MOS2vdsat = model->MOS2type * vdsat;
             /*
@@ -1416,6 +1567,7 @@ bypass:
             *(here->MOS2SPdpPtr) -= here->MOS2gds+xrev*(here->MOS2gm+
                     here->MOS2gmbs);
         }
+      }
     }
     return(OK);
 }
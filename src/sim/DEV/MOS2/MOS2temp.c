@@ -258,6 +258,32 @@ MOS2temp(inModel,ckt)
                         vt * log( vt / (CONSTroot2 *
                         here->MOS2tSatCurDens * here->MOS2sourceArea));
             }
+            /* geometry dependent values used on every load, these
+             * only change with the instance parameters, so do them here
+             */
+            here->MOS2tEffLength = here->MOS2l - 2*model->MOS2latDiff;
+            if( (here->MOS2tSatCurDens == 0) || 
+                    (here->MOS2drainArea == 0) ||
+                    (here->MOS2sourceArea == 0)) {
+                here->MOS2tDrainSatCur = here->MOS2tSatCur;
+                here->MOS2tSourceSatCur = here->MOS2tSatCur;
+            } else {
+                here->MOS2tDrainSatCur = here->MOS2tSatCurDens * 
+                        here->MOS2drainArea;
+                here->MOS2tSourceSatCur = here->MOS2tSatCurDens * 
+                        here->MOS2sourceArea;
+            }
+            here->MOS2tGsOverlapCap = model->MOS2gateSourceOverlapCapFactor * 
+                    here->MOS2w;
+            here->MOS2tGdOverlapCap = model->MOS2gateDrainOverlapCapFactor * 
+                    here->MOS2w;
+            here->MOS2tGbOverlapCap = model->MOS2gateBulkOverlapCapFactor * 
+                    here->MOS2tEffLength;
+            here->MOS2tBeta = here->MOS2tTransconductance * here->MOS2w /
+                    here->MOS2tEffLength;
+            here->MOS2tOxideCap = model->MOS2oxideCapFactor * 
+                    here->MOS2tEffLength * here->MOS2w;
+
             if(model->MOS2capBDGiven) {
                 czbd = here->MOS2tCbd;
             } else {
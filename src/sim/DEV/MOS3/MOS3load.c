@@ -16,6 +16,19 @@
 
 RCSID("MOS3load.c $Revision: 1.1 $ on $Date: 90/10/11 12:45:27 $")
 
+/*
+ * the instances of a model are loaded MOS3BATCH at a time in three
+ * passes:  gather the terminal voltages (with prediction, bypass and
+ * limiting) into the b... arrays below, evaluate the diode and drain
+ * current equations for the whole batch, then scatter the results
+ * through the state vector and the SMP pointers of each instance.
+ * Building with MOS3BATCH as 1 gives back the old one instance at a
+ * time order.
+ */
+#ifndef MOS3BATCH
+#define MOS3BATCH 32
+#endif /* MOS3BATCH */
+
 int
 MOS3load(inModel,ckt)
     GENmodel *inModel;
@@ -26,6 +39,7 @@ MOS3load(inModel,ckt)
 {
     register MOS3model *model = (MOS3model *)inModel;
     register MOS3instance *here;
+    MOS3instance *rest;     /* instances not yet gathered */
     double Beta;
     double DrainSatCur;
     double EffectiveLength;
@@ -87,6 +101,36 @@ MOS3load(inModel,ckt)
 #endif /* CAPBYPASS */
     int SenCond;
     double vt;  /* vt at instance temperature */
+    int ib;
+    int nbat;       /* number of instances in the current batch */
+
+    /* the batch - one entry per instance, gathered in list order */
+    MOS3instance *binst[MOS3BATCH];
+    int bsen[MOS3BATCH];        /* SenCond */
+    int bbyp[MOS3BATCH];        /* bypassed - last values still good */
+    int bcheck[MOS3BATCH];      /* limiting changed a voltage */
+    double bvt[MOS3BATCH];
+    double bvbs[MOS3BATCH];
+    double bvbd[MOS3BATCH];
+    double bvgs[MOS3BATCH];
+    double bvds[MOS3BATCH];
+    double bvgd[MOS3BATCH];
+    double bvgb[MOS3BATCH];
+    double bdelvbs[MOS3BATCH];
+    double bdelvbd[MOS3BATCH];
+    double bcdhat[MOS3BATCH];
+    double bcbhat[MOS3BATCH];
+    double bleff[MOS3BATCH];     /* effective channel length */
+    double bbeta[MOS3BATCH];
+    double bdsat[MOS3BATCH];     /* drain junction saturation current */
+    double bssat[MOS3BATCH];     /* source junction saturation current */
+    double bgscap[MOS3BATCH];    /* gate-source overlap capacitance */
+    double bgdcap[MOS3BATCH];    /* gate-drain overlap capacitance */
+    double bgbcap[MOS3BATCH];    /* gate-bulk overlap capacitance */
+    double boxcap[MOS3BATCH];    /* oxide capacitance */
+    double bcdrain[MOS3BATCH];
+    double bvon[MOS3BATCH];
+    double bvdsat[MOS3BATCH];
 
 
 #ifdef CAPBYPASS
@@ -109,8 +153,15 @@ MOS3load(inModel,ckt)
 next: 
     for( ; model != NULL; model = model->MOS3nextModel ) {
 
-        /* loop through all the instances of the model */
-        for (here = model->MOS3instances; here != NULL ;
+      /* loop through all the instances of the model, a batch at a time */
+      rest = model->MOS3instances;
+      while(rest != NULL) {
+
+        /*
+         * gather - pick up the voltages of the next batch of instances
+         */
+        nbat = 0;
+        for (here = rest; here != NULL && nbat < MOS3BATCH;
                 here=here->MOS3nextInstance) {
 
             vt = CONSTKoverQ * here->MOS3temp;
@@ -126,37 +177,51 @@ next:
 
             }
             SenCond = ckt->CKTsenInfo && here->MOS3senPertFlag;
+            bbyp[nbat] = 0;
 #ifdef DETAILPROF
 asm("   .globl mos3pta");
 asm("mos3pta:");
 #endif /* DETAILPROF */
 
-            /* first, we compute a few useful values - these could be
-             * pre-computed, but for historical reasons are still done
-             * here.  They may be moved at the expense of instance size
+            /* first, we get a few useful values - these are computed
+             * in MOS3temp since they depend only on the geometry, but
+             * sensitivity analysis perturbs w and l directly, so in that
+             * case they are still done here
              */
 
-            EffectiveLength=here->MOS3l - 2*model->MOS3latDiff;
-            if( (here->MOS3tSatCurDens == 0) || 
-                    (here->MOS3drainArea == 0) ||
-                    (here->MOS3sourceArea == 0)) {
-                DrainSatCur = here->MOS3tSatCur;
-                SourceSatCur = here->MOS3tSatCur;
+            if(SenCond) {
+                /* w and l may be perturbed, so redo the geometry */
+                EffectiveLength=here->MOS3l - 2*model->MOS3latDiff;
+                if( (here->MOS3tSatCurDens == 0) || 
+                        (here->MOS3drainArea == 0) ||
+                        (here->MOS3sourceArea == 0)) {
+                    DrainSatCur = here->MOS3tSatCur;
+                    SourceSatCur = here->MOS3tSatCur;
+                } else {
+                    DrainSatCur = here->MOS3tSatCurDens * 
+                            here->MOS3drainArea;
+                    SourceSatCur = here->MOS3tSatCurDens * 
+                            here->MOS3sourceArea;
+                }
+                GateSourceOverlapCap = model->MOS3gateSourceOverlapCapFactor * 
+                        here->MOS3w;
+                GateDrainOverlapCap = model->MOS3gateDrainOverlapCapFactor * 
+                        here->MOS3w;
+                GateBulkOverlapCap = model->MOS3gateBulkOverlapCapFactor * 
+                        EffectiveLength;
+                Beta = here->MOS3tTransconductance * here->MOS3w/EffectiveLength;
+                OxideCap = model->MOS3oxideCapFactor * EffectiveLength * 
+                        here->MOS3w;
             } else {
-                DrainSatCur = here->MOS3tSatCurDens * 
-                        here->MOS3drainArea;
-                SourceSatCur = here->MOS3tSatCurDens * 
-                        here->MOS3sourceArea;
+                EffectiveLength = here->MOS3tEffLength;
+                DrainSatCur = here->MOS3tDrainSatCur;
+                SourceSatCur = here->MOS3tSourceSatCur;
+                GateSourceOverlapCap = here->MOS3tGsOverlapCap;
+                GateDrainOverlapCap = here->MOS3tGdOverlapCap;
+                GateBulkOverlapCap = here->MOS3tGbOverlapCap;
+                Beta = here->MOS3tBeta;
+                OxideCap = here->MOS3tOxideCap;
             }
-            GateSourceOverlapCap = model->MOS3gateSourceOverlapCapFactor * 
-                    here->MOS3w;
-            GateDrainOverlapCap = model->MOS3gateDrainOverlapCapFactor * 
-                    here->MOS3w;
-            GateBulkOverlapCap = model->MOS3gateBulkOverlapCapFactor * 
-                    EffectiveLength;
-            Beta = here->MOS3tTransconductance * here->MOS3w/EffectiveLength;
-            OxideCap = model->MOS3oxideCapFactor * EffectiveLength * 
-                    here->MOS3w;
 
             if(SenCond){
 #ifdef SENSDEBUG
@@ -328,7 +393,8 @@ asm("mos3ptb:");
                     /* nothing interesting has changed since last
                      * iteration on this device, so we just
                      * copy all the values computed last iteration out
-                     * and keep going
+                     * and keep going - the rest is done in the
+                     * scatter pass
                      */
                     vbs = *(ckt->CKTstate0 + here->MOS3vbs);
                     vbd = *(ckt->CKTstate0 + here->MOS3vbd);
@@ -336,19 +402,8 @@ asm("mos3ptb:");
                     vds = *(ckt->CKTstate0 + here->MOS3vds);
                     vgd = vgs - vds;
                     vgb = vgs - vbs;
-                    cdrain = here->MOS3mode * (here->MOS3cd + here->MOS3cbd);
-                    if(ckt->CKTmode & (MODETRAN | MODETRANOP)) {
-                        capgs = ( *(ckt->CKTstate0+here->MOS3capgs)+ 
-                                  *(ckt->CKTstate1+here->MOS3capgs) +
-                                  GateSourceOverlapCap );
-                        capgd = ( *(ckt->CKTstate0+here->MOS3capgd)+ 
-                                  *(ckt->CKTstate1+here->MOS3capgd) +
-                                  GateDrainOverlapCap );
-                        capgb = ( *(ckt->CKTstate0+here->MOS3capgb)+ 
-                                  *(ckt->CKTstate1+here->MOS3capgb) +
-                                  GateBulkOverlapCap );
-                    }
-                    goto bypass;
+                    bbyp[nbat] = 1;
+                    goto next1;
                 }
 #endif /*NOBYPASS*/
 
@@ -434,13 +489,60 @@ asm("mos3pte:");
             vgd = vgs - vds;
             vgb = vgs - vbs;
 
+            /* put this instance into the batch */
+next1:      binst[nbat] = here;
+            bsen[nbat] = SenCond;
+            bcheck[nbat] = Check;
+            bvt[nbat] = vt;
+            bvbs[nbat] = vbs;
+            bvbd[nbat] = vbd;
+            bvgs[nbat] = vgs;
+            bvds[nbat] = vds;
+            bvgd[nbat] = vgd;
+            bvgb[nbat] = vgb;
+            bdelvbs[nbat] = delvbs;
+            bdelvbd[nbat] = delvbd;
+            bcdhat[nbat] = cdhat;
+            bcbhat[nbat] = cbhat;
+            bleff[nbat] = EffectiveLength;
+            bbeta[nbat] = Beta;
+            bdsat[nbat] = DrainSatCur;
+            bssat[nbat] = SourceSatCur;
+            bgscap[nbat] = GateSourceOverlapCap;
+            bgdcap[nbat] = GateDrainOverlapCap;
+            bgbcap[nbat] = GateBulkOverlapCap;
+            boxcap[nbat] = OxideCap;
+            nbat++;
+        }
+        rest = here;
+
+        /*
+         * evaluate - the junction diodes and the drain current of every
+         * instance in the batch that was not bypassed, working from the
+         * voltages and geometry gathered above
+         */
+        for (ib = 0; ib < nbat; ib++) {
+            if(bbyp[ib]) continue;
+            here = binst[ib];
+            vt = bvt[ib];
+            vbs = bvbs[ib];
+            vbd = bvbd[ib];
+            vgs = bvgs[ib];
+            vds = bvds[ib];
+            vgd = bvgd[ib];
+            EffectiveLength = bleff[ib];
+            Beta = bbeta[ib];
+            DrainSatCur = bdsat[ib];
+            SourceSatCur = bssat[ib];
+            OxideCap = boxcap[ib];
+
 
             /*
              * bulk-source and bulk-drain diodes
              *   here we just evaluate the ideal diode current and the
              *   corresponding derivative (conductance).
              */
-next1:      if(vbs <= 0) {
+            if(vbs <= 0) {
                 here->MOS3gbs = SourceSatCur/vt;
                 here->MOS3cbs = here->MOS3gbs*vbs;
                 here->MOS3gbs += ckt->CKTgmin;
@@ -875,6 +977,53 @@ innerline1000:;
              *.....done
              */
             }
+            bcdrain[ib] = cdrain;
+            bvon[ib] = von;
+            bvdsat[ib] = vdsat;
+        }
+
+        /*
+         * scatter - charges, convergence test and the matrix and rhs
+         * stamps for each instance in the batch
+         */
+        for (ib = 0; ib < nbat; ib++) {
+            here = binst[ib];
+            SenCond = bsen[ib];
+            Check = bcheck[ib];
+            vbs = bvbs[ib];
+            vbd = bvbd[ib];
+            vgs = bvgs[ib];
+            vds = bvds[ib];
+            vgd = bvgd[ib];
+            vgb = bvgb[ib];
+            delvbs = bdelvbs[ib];
+            delvbd = bdelvbd[ib];
+            cdhat = bcdhat[ib];
+            cbhat = bcbhat[ib];
+            GateSourceOverlapCap = bgscap[ib];
+            GateDrainOverlapCap = bgdcap[ib];
+            GateBulkOverlapCap = bgbcap[ib];
+            OxideCap = boxcap[ib];
+
+            if(bbyp[ib]) {
+                /* bypassed in the gather pass */
+                cdrain = here->MOS3mode * (here->MOS3cd + here->MOS3cbd);
+                if(ckt->CKTmode & (MODETRAN | MODETRANOP)) {
+                    capgs = ( *(ckt->CKTstate0+here->MOS3capgs)+ 
+                              *(ckt->CKTstate1+here->MOS3capgs) +
+                              GateSourceOverlapCap );
+                    capgd = ( *(ckt->CKTstate0+here->MOS3capgd)+ 
+                              *(ckt->CKTstate1+here->MOS3capgd) +
+                              GateDrainOverlapCap );
+                    capgb = ( *(ckt->CKTstate0+here->MOS3capgb)+ 
+                              *(ckt->CKTstate1+here->MOS3capgb) +
+                              GateBulkOverlapCap );
+                }
+                goto bypass;
+            }
+            cdrain = bcdrain[ib];
+            von = bvon[ib];
+            vdsat = bvdsat[ib];
 
 #ifdef DETAILPROF
 asm("   .globl mos3ptg");
@@ -1330,6 +1479,7 @@ asm("mos3ptn:");
             *(here->MOS3SPdpPtr) += (-here->MOS3gds-
                     xrev*(here->MOS3gm+here->MOS3gmbs));
         }
+      }
     }
     return(OK);
 }
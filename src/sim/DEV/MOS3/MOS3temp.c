@@ -236,6 +236,32 @@ MOS3temp(inModel,ckt)
                         vt * log( vt / (CONSTroot2 *
                         model->MOS3jctSatCurDensity * here->MOS3sourceArea));
             }
+            /* geometry dependent values used on every load, these
+             * only change with the instance parameters, so do them here
+             */
+            here->MOS3tEffLength = here->MOS3l - 2*model->MOS3latDiff;
+            if( (here->MOS3tSatCurDens == 0) || 
+                    (here->MOS3drainArea == 0) ||
+                    (here->MOS3sourceArea == 0)) {
+                here->MOS3tDrainSatCur = here->MOS3tSatCur;
+                here->MOS3tSourceSatCur = here->MOS3tSatCur;
+            } else {
+                here->MOS3tDrainSatCur = here->MOS3tSatCurDens * 
+                        here->MOS3drainArea;
+                here->MOS3tSourceSatCur = here->MOS3tSatCurDens * 
+                        here->MOS3sourceArea;
+            }
+            here->MOS3tGsOverlapCap = model->MOS3gateSourceOverlapCapFactor * 
+                    here->MOS3w;
+            here->MOS3tGdOverlapCap = model->MOS3gateDrainOverlapCapFactor * 
+                    here->MOS3w;
+            here->MOS3tGbOverlapCap = model->MOS3gateBulkOverlapCapFactor * 
+                    here->MOS3tEffLength;
+            here->MOS3tBeta = here->MOS3tTransconductance * here->MOS3w /
+                    here->MOS3tEffLength;
+            here->MOS3tOxideCap = model->MOS3oxideCapFactor * 
+                    here->MOS3tEffLength * here->MOS3w;
+
             if(model->MOS3capBDGiven) {
                 czbd = here->MOS3tCbd;
             } else {
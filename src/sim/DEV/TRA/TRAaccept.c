@@ -32,47 +32,60 @@ TRAaccept(ckt,inModel)
         /* loop through all the instances of the model */
         for (here = model->TRAinstances; here != NULL ;
                 here=here->TRAnextInstance) {
-            if( (ckt->CKTtime - here->TRAtd) > *(here->TRAdelays+6)) {
-                /* shift! */
-                for(i=2;i<here->TRAsizeDelay && 
-                    (ckt->CKTtime - here->TRAtd > *(here->TRAdelays+3*i));i++)
-                        { /* loop does it all */ ; }
+            if( (ckt->CKTtime - here->TRAtd) > *TRADELAY(here,2)) {
+                /* drop the entries we no longer need - the search starts
+                 * from the cursor TRAload left, and the ring means nothing
+                 * has to be moved
+                 */
+                i = here->TRAcursorDelay;
+                if(i > here->TRAsizeDelay) i = here->TRAsizeDelay;
+                if(i < 2) i = 2;
+                while(i>2 && (ckt->CKTtime - here->TRAtd <= 
+                        *TRADELAY(here,i-1))) i--;
+                while(i<here->TRAsizeDelay && 
+                    (ckt->CKTtime - here->TRAtd > *TRADELAY(here,i))) i++;
                 i -= 2;
-                for(j=i;j<=here->TRAsizeDelay;j++) {
-                    from = here->TRAdelays + 3*j;
-                    to = here->TRAdelays + 3*(j-i);
-                    *(to) = *(from);
-                    *(to+1) = *(from+1);
-                    *(to+2) = *(from+2);
-                }
+                here->TRAfirstDelay = (here->TRAfirstDelay + i) &
+                        (here->TRAallocDelay - 1);
                 here->TRAsizeDelay -= i;
+                here->TRAcursorDelay -= i;
             }
-            if(ckt->CKTtime - *(here->TRAdelays+3*here->TRAsizeDelay) >
+            if(ckt->CKTtime - *TRADELAY(here,here->TRAsizeDelay) >
                     ckt->CKTminBreak) {
-                if(here->TRAallocDelay <= here->TRAsizeDelay) {
-                    /* need to grab some more space */
-                    here->TRAallocDelay += 5;
-                    here->TRAdelays = (double *)REALLOC((char *)here->TRAdelays,
-                        (here->TRAallocDelay+1)*3*sizeof(double));
+                if(here->TRAallocDelay <= here->TRAsizeDelay+1) {
+                    /* need to grab some more space - double it, and
+                     * unwrap the ring into the new table as we go */
+                    from = here->TRAdelays;
+                    to = (double *)MALLOC(2*3*here->TRAallocDelay*
+                            sizeof(double));
+                    if(to == NULL) return(E_NOMEM);
+                    for(j=0;j<=here->TRAsizeDelay;j++) {
+                        *(to+3*j) = *TRADELAY(here,j);
+                        *(to+3*j+1) = *(TRADELAY(here,j)+1);
+                        *(to+3*j+2) = *(TRADELAY(here,j)+2);
+                    }
+                    FREE(from);
+                    here->TRAdelays = to;
+                    here->TRAfirstDelay = 0;
+                    here->TRAallocDelay *= 2;
                 }
                 here->TRAsizeDelay ++;
-                to = (here->TRAdelays  +3*here->TRAsizeDelay);
+                to = TRADELAY(here,here->TRAsizeDelay);
                 *to = ckt->CKTtime;
-                to = (here->TRAdelays+1+3*here->TRAsizeDelay);
-                *to = ( *(ckt->CKTrhsOld + here->TRAposNode2)
+                *(to+1) = ( *(ckt->CKTrhsOld + here->TRAposNode2)
                      -*(ckt->CKTrhsOld + here->TRAnegNode2))
                     + *(ckt->CKTrhsOld + here->TRAbrEq2)*
                         here->TRAimped;
-                *(here->TRAdelays+2+3*here->TRAsizeDelay) = 
+                *(to+2) = 
                     ( *(ckt->CKTrhsOld + here->TRAposNode1)
                      -*(ckt->CKTrhsOld + here->TRAnegNode1))
                     + *(ckt->CKTrhsOld + here->TRAbrEq1)*
                         here->TRAimped;
 #ifdef NOTDEF
-                v1 = *(here->TRAdelays+1+3*here->TRAsizeDelay);
-                v2 = *(here->TRAdelays+1+3*(here->TRAsizeDelay-1));
-                v3 = *(here->TRAdelays+2+3*here->TRAsizeDelay);
-                v4 = *(here->TRAdelays+2+3*(here->TRAsizeDelay-1));
+                v1 = *(TRADELAY(here,here->TRAsizeDelay)+1);
+                v2 = *(TRADELAY(here,here->TRAsizeDelay-1)+1);
+                v3 = *(TRADELAY(here,here->TRAsizeDelay)+2);
+                v4 = *(TRADELAY(here,here->TRAsizeDelay-1)+2);
                 if( (FABS(v1-v2) >= 50*ckt->CKTreltol*
                         MAX(FABS(v1),FABS(v2))+50*ckt->CKTvoltTol) ||
                     (FABS(v3-v4) >= 50*ckt->CKTreltol*
@@ -81,24 +94,24 @@ TRAaccept(ckt,inModel)
                     /*printf("%s:  at %g set for %g and %g\n",here->TRAname,
                         ckt->CKTtime,
                         ckt->CKTtime+here->TRAtd,
-                        *(here->TRAdelays+3*here->TRAsizeDelay-3)+
+                        *TRADELAY(here,here->TRAsizeDelay-1)+
                                 here->TRAtd);*/
                     error = CKTsetBreak(ckt,ckt->CKTtime+here->TRAtd);
                     if(error) return(error);
                     /* also set for break after PREVIOUS point */
                     error = CKTsetBreak(ckt,
-                            *(here->TRAdelays+3*here->TRAsizeDelay -3) +
+                            *TRADELAY(here,here->TRAsizeDelay-1) +
                             here->TRAtd);
                     CKTbreakDump(ckt);
                     if(error) return(error);
                 }
 #else
-                v1 = *(here->TRAdelays+1+3*here->TRAsizeDelay);
-                v2 = *(here->TRAdelays+1+3*(here->TRAsizeDelay-1));
-                v3 = *(here->TRAdelays+1+3*(here->TRAsizeDelay-2));
-                v4 = *(here->TRAdelays+2+3*here->TRAsizeDelay);
-                v5 = *(here->TRAdelays+2+3*(here->TRAsizeDelay-1));
-                v6 = *(here->TRAdelays+2+3*(here->TRAsizeDelay-2));
+                v1 = *(TRADELAY(here,here->TRAsizeDelay)+1);
+                v2 = *(TRADELAY(here,here->TRAsizeDelay-1)+1);
+                v3 = *(TRADELAY(here,here->TRAsizeDelay-2)+1);
+                v4 = *(TRADELAY(here,here->TRAsizeDelay)+2);
+                v5 = *(TRADELAY(here,here->TRAsizeDelay-1)+2);
+                v6 = *(TRADELAY(here,here->TRAsizeDelay-2)+2);
                 d1 = (v1-v2)/ckt->CKTdeltaOld[0];
                 d2 = (v2-v3)/ckt->CKTdeltaOld[1];
                 d3 = (v4-v5)/ckt->CKTdeltaOld[0];
@@ -112,14 +125,14 @@ TRAaccept(ckt,inModel)
                     /* derivitive changing - need to schedule after delay */
                     /*printf("%s:  at %g set for %g\n",here->TRAname,
                         ckt->CKTtime,
-                        *(here->TRAdelays+3*here->TRAsizeDelay-3)+here->TRAtd
+                        *TRADELAY(here,here->TRAsizeDelay-1)+here->TRAtd
                         );*/
                     /*printf("%g, %g, %g -> %g, %g \n",v1,v2,v3,d1,d2);*/
                     /*printf("%g, %g, %g -> %g, %g \n",v4,v5,v6,d3,d4);*/
                     /* also set for break after PREVIOUS point */
                     /*printf("setting break\n");*/
                     error = CKTsetBreak(ckt,
-                            *(here->TRAdelays+3*here->TRAsizeDelay -3) +
+                            *TRADELAY(here,here->TRAsizeDelay-1) +
                             here->TRAtd);
                     if(error) return(error);
                 }
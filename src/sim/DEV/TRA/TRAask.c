@@ -87,10 +87,16 @@ TRAask(ckt,inst,which,value,select)
             value->rValue = here->TRAbrEq2;
             return (OK);
         case TRA_DELAY:
-            value->v.vec.rVec = (double *) MALLOC(here->TRAsizeDelay);
-            value->v.numValue = temp = here->TRAsizeDelay;
-            while (temp--) {
-                *value->v.vec.rVec++ = *here->TRAdelays++;
+            /* unwrap the ring of (time, input1, input2) triples */
+            value->v.numValue = 3 * (here->TRAsizeDelay + 1);
+            value->v.vec.rVec = (double *) MALLOC(value->v.numValue *
+                    sizeof(double));
+            if (value->v.vec.rVec == NULL)
+                return (E_NOMEM);
+            for (temp = 0; temp <= here->TRAsizeDelay; temp++) {
+                value->v.vec.rVec[3*temp] = *TRADELAY(here,temp);
+                value->v.vec.rVec[3*temp+1] = *(TRADELAY(here,temp)+1);
+                value->v.vec.rVec[3*temp+2] = *(TRADELAY(here,temp)+2);
             }
             return (OK);
         default:
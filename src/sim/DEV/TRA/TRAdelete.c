@@ -27,6 +27,7 @@ TRAdelete(inModel,name,kill)
         for(here = *prev; here ; here = *prev) {
             if(here->TRAname == name || (fast && here==*fast) ) {
                 *prev= here->TRAnextInstance;
+                FREE(here->TRAdelays);
                 FREE(here);
                 return(OK);
             }
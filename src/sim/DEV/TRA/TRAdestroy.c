@@ -25,10 +25,16 @@ TRAdestroy(inModel)
         oldmod = mod;
         prev = (TRAinstance *)NULL;
         for(here = mod->TRAinstances ; here ; here = here->TRAnextInstance) {
-            if(prev) FREE(prev);
+            if(prev) {
+                FREE(prev->TRAdelays);
+                FREE(prev);
+            }
             prev = here;
         }
-        if(prev) FREE(prev);
+        if(prev) {
+            FREE(prev->TRAdelays);
+            FREE(prev);
+        }
     }
     if(oldmod) FREE(oldmod);
     *model = NULL;
@@ -26,6 +26,7 @@ TRAload(inModel,ckt)
     register TRAinstance *here;
     double t1,t2,t3;
     double f1,f2,f3;
+    double *d0,*d1,*d2;
     register int i;
 
     /*  loop through all the transmission line models */
@@ -78,22 +79,37 @@ TRAload(inModel,ckt)
                             + ( *(ckt->CKTrhsOld+here->TRAbrEq1) 
                                 *here->TRAimped);
                     }
-                    *(here->TRAdelays  ) = -2*here->TRAtd;
-                    *(here->TRAdelays +3) = -here->TRAtd;
-                    *(here->TRAdelays+6) = 0;
-                    *(here->TRAdelays+1) = *(here->TRAdelays +4) = 
-                            *(here->TRAdelays+7) = here->TRAinput1;
-                    *(here->TRAdelays+2) = *(here->TRAdelays +5) = 
-                            *(here->TRAdelays+8) = here->TRAinput2;
+                    here->TRAfirstDelay = 0;
                     here->TRAsizeDelay = 2;
+                    here->TRAcursorDelay = 2;
+                    d0 = TRADELAY(here,0);
+                    d1 = TRADELAY(here,1);
+                    d2 = TRADELAY(here,2);
+                    *d0 = -2*here->TRAtd;
+                    *d1 = -here->TRAtd;
+                    *d2 = 0;
+                    *(d0+1) = *(d1+1) = *(d2+1) = here->TRAinput1;
+                    *(d0+2) = *(d1+2) = *(d2+2) = here->TRAinput2;
                 } else {
                     if(ckt->CKTmode & MODEINITPRED) {
-                        for(i=2;(i<here->TRAsizeDelay) && 
-                            (*(here->TRAdelays +3*i) <=
-                            (ckt->CKTtime-here->TRAtd));i++) {;/*loop does it*/}
-                        t1 = *(here->TRAdelays + (3*(i-2)));
-                        t2 = *(here->TRAdelays + (3*(i-1)));
-                        t3 = *(here->TRAdelays + (3*(i  )));
+                        /* find the first entry past time-td, starting from
+                         * where we found it last time - the delayed time
+                         * moves only a little between calls
+                         */
+                        i = here->TRAcursorDelay;
+                        if(i > here->TRAsizeDelay) i = here->TRAsizeDelay;
+                        if(i < 2) i = 2;
+                        while((i>2) && (*TRADELAY(here,i-1) >
+                                (ckt->CKTtime-here->TRAtd))) i--;
+                        while((i<here->TRAsizeDelay) && (*TRADELAY(here,i) <=
+                                (ckt->CKTtime-here->TRAtd))) i++;
+                        here->TRAcursorDelay = i;
+                        d0 = TRADELAY(here,i-2);
+                        d1 = TRADELAY(here,i-1);
+                        d2 = TRADELAY(here,i);
+                        t1 = *d0;
+                        t2 = *d1;
+                        t3 = *d2;
                         if( (t2-t1)==0  || (t3-t2) == 0) continue;
                         f1 = (ckt->CKTtime - here->TRAtd - t2) * 
                              (ckt->CKTtime - here->TRAtd - t3) ;
@@ -128,19 +144,15 @@ TRAload(inModel,ckt)
                         /*printf("at time %g, using %g, %g, %g\n",ckt->CKTtime,
                                 t1,t2,t3);
                         printf("values %g, %g, %g \n",
-                            *(here->TRAdelays + (3*(i-2))+1),
-                            *(here->TRAdelays + (3*(i-1))+1),
-                            *(here->TRAdelays + (3*(i  ))+1) );
+                            *(d0+1), *(d1+1), *(d2+1) );
                         printf("and    %g, %g, %g \n",
-                            *(here->TRAdelays + (3*(i-2))+2),
-                            *(here->TRAdelays + (3*(i-1))+2),
-                            *(here->TRAdelays + (3*(i  ))+2) );*/
-                        here->TRAinput1 = f1 * *(here->TRAdelays + (3*(i-2))+1)
-                                        + f2 * *(here->TRAdelays + (3*(i-1))+1)
-                                        + f3 * *(here->TRAdelays + (3*(i  ))+1);
-                        here->TRAinput2 = f1 * *(here->TRAdelays + (3*(i-2))+2)
-                                        + f2 * *(here->TRAdelays + (3*(i-1))+2)
-                                        + f3 * *(here->TRAdelays + (3*(i  ))+2);
+                            *(d0+2), *(d1+2), *(d2+2) );*/
+                        here->TRAinput1 = f1 * *(d0+1)
+                                        + f2 * *(d1+1)
+                                        + f3 * *(d2+1);
+                        here->TRAinput2 = f1 * *(d0+2)
+                                        + f2 * *(d1+2)
+                                        + f3 * *(d2+2);
                     }
                 }
             *(ckt->CKTrhs + here->TRAbrEq1) += here->TRAinput1;
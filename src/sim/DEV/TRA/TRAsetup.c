@@ -60,9 +60,15 @@ TRAsetup(matrix,inModel,ckt,state)
                 here->TRAintNode2 = tmp->number;
             }
 
-            /* allocate the delay table */
-            here->TRAdelays = (double *)MALLOC(15*sizeof(double));
-            here->TRAallocDelay = 4;
+            /* allocate the delay table - it grows by doubling in TRAaccept */
+            if(here->TRAdelays == NULL) {
+                here->TRAallocDelay = 8;
+                here->TRAdelays = (double *)MALLOC(3*here->TRAallocDelay*
+                        sizeof(double));
+                if(here->TRAdelays == NULL) return(E_NOMEM);
+            }
+            here->TRAfirstDelay = 0;
+            here->TRAcursorDelay = 2;
 
 /* macro to make elements with built in test for out of memory */
 #define TSTALLOC(ptr,first,second) \
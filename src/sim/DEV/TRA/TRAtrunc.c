@@ -35,14 +35,14 @@ TRAtrunc(inModel,ckt,timeStep)
                 - *(ckt->CKTrhsOld + here->TRAnegNode2))
                 + *(ckt->CKTrhsOld + here->TRAbrEq2) *
                     here->TRAimped;
-            v2 = *(here->TRAdelays+1+3*(here->TRAsizeDelay));
-            v3 = *(here->TRAdelays+1+3*(here->TRAsizeDelay-1));
+            v2 = *(TRADELAY(here,here->TRAsizeDelay)+1);
+            v3 = *(TRADELAY(here,here->TRAsizeDelay-1)+1);
             v4 = ( *(ckt->CKTrhsOld + here->TRAposNode1)
                 - *(ckt->CKTrhsOld + here->TRAnegNode1))
                 + *(ckt->CKTrhsOld + here->TRAbrEq1) *
                     here->TRAimped;
-            v5 = *(here->TRAdelays+2+3*(here->TRAsizeDelay));
-            v6 = *(here->TRAdelays+2+3*(here->TRAsizeDelay-1));
+            v5 = *(TRADELAY(here,here->TRAsizeDelay)+2);
+            v6 = *(TRADELAY(here,here->TRAsizeDelay-1)+2);
             d1 = (v1-v2)/ckt->CKTdeltaOld[1];
             d2 = (v2-v3)/ckt->CKTdeltaOld[2];
             d3 = (v4-v5)/ckt->CKTdeltaOld[1];
@@ -56,18 +56,18 @@ TRAtrunc(inModel,ckt,timeStep)
                 /* derivitive changing - need to schedule after delay */
                 /*printf("%s:  at %g set for %g\n",here->TRAname,
                     ckt->CKTtime,
-                    *(here->TRAdelays+3*here->TRAsizeDelay-3)+here->TRAtd
+                    *TRADELAY(here,here->TRAsizeDelay-1)+here->TRAtd
                     );*/
                 /*printf("%g, %g, %g -> %g, %g \n",v1,v2,v3,d1,d2);*/
                 /*printf("%g, %g, %g -> %g, %g \n",v4,v5,v6,d3,d4);*/
                 /* also set for break after PREVIOUS point */
                 /*printf("setting break\n");*/
                 /* will need to set a breakpoint at 
-                    *(here->TRAdelays+3*(here->TRAsizeDelay)) + here->TRAtd
+                    *TRADELAY(here,here->TRAsizeDelay) + here->TRAtd
                     so we need to make sure we don't step past it 
                 */
                 /* the previous timepoint plus the delay */
-                tmp = *(here->TRAdelays+3*here->TRAsizeDelay) + here->TRAtd;
+                tmp = *TRADELAY(here,here->TRAsizeDelay) + here->TRAtd;
                 /* minus current time */
                 tmp -= ckt->CKTtime;
                 *timeStep = MIN(*timeStep,tmp);
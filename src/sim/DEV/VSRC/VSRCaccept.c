@@ -10,6 +10,7 @@
 #include "TRANdefs.h"
 #include "util.h"
 #include "SPerror.h"
+#include "CMproto.h"
 #include "suffix.h"
 
 RCSID("VSRCaccept.c $Revision: 1.2 $ on $Date: 91/07/11 13:45:20 $")
@@ -152,27 +153,32 @@ VSRCaccept(ckt,inModel)
                 break;
                 case PWL: {
                     register int i;
-                    if(ckt->CKTtime < *(here->VSRCcoeffs)) {
+                    register double *coeffs = here->VSRCcoeffs;
+                    int size = here->VSRCfunctionOrder/2;
+
+                    if(ckt->CKTtime < *coeffs) {
                         if(ckt->CKTbreak) {
-                            error = CKTsetBreak(ckt,*(here->VSRCcoeffs));
-                            break;
+                            error = CKTsetBreak(ckt,*coeffs);
                         }
+                        break;
+                    }
+                    if(here->VSRCtable.x != coeffs ||
+                            here->VSRCtable.size != size) {
+                        cm_table_init(&(here->VSRCtable),coeffs,2,size,
+                                (int *)NULL,0);
                     }
-                    for(i=0;i<(here->VSRCfunctionOrder/2)-1;i++) {
-                        if((*(here->VSRCcoeffs+2*i)==ckt->CKTtime)) {
-                            if(ckt->CKTbreak) {
-                                error = CKTsetBreak(ckt,
-                                        *(here->VSRCcoeffs+2*i+2));
-                                if(error) return(error);
-                            }
-                            goto bkptset;
-                        } 
+                    i = cm_table_find(&(here->VSRCtable),ckt->CKTtime);
+                    if((*(coeffs+2*i)==ckt->CKTtime)) {
+                        while(i > 0 && *(coeffs+2*(i-1))==ckt->CKTtime) i--;
+                        if(i < size-1 && ckt->CKTbreak) {
+                            error = CKTsetBreak(ckt,*(coeffs+2*i+2));
+                            if(error) return(error);
+                        }
                     }
                     break;
                 }
                 }
             }
-bkptset: ;
         }
     }
     return(OK);
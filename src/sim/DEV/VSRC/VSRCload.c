@@ -233,32 +233,38 @@ VSRCload(inModel,ckt)
                     break;
                 case PWL: {
                     register int i;
-                    if(time< *(here->VSRCcoeffs)) {
-                        value = *(here->VSRCcoeffs + 1) ;
-                        break;
+                    register double *coeffs = here->VSRCcoeffs;
+                    int size = here->VSRCfunctionOrder/2;
+
+                    /* the timepoints may have been changed since the
+                     * table was set up
+                     */
+                    if(here->VSRCtable.x != coeffs ||
+                            here->VSRCtable.size != size) {
+                        cm_table_init(&(here->VSRCtable),coeffs,2,size,
+                                (int *)NULL,0);
                     }
-                    for(i=0;i<=(here->VSRCfunctionOrder/2)-1;i++) {
-                        if((*(here->VSRCcoeffs+2*i)==time)) {
-                            value = *(here->VSRCcoeffs+2*i+1);
-                            goto loadDone;
-                        }
-                        if((*(here->VSRCcoeffs+2*i)<time) &&
-                                (*(here->VSRCcoeffs+2*(i+1)) >time)) {
-                            value = *(here->VSRCcoeffs+2*i+1) +
-                                (((time-*(here->VSRCcoeffs+2*i))/
-                                (*(here->VSRCcoeffs+2*(i+1)) - 
-                                 *(here->VSRCcoeffs+2*i))) *
-                                (*(here->VSRCcoeffs+2*i+3) - 
-                                 *(here->VSRCcoeffs+2*i+1)));
-                            goto loadDone;
-                        }
+                    i = cm_table_find(&(here->VSRCtable),time);
+                    if(i < 0) {
+                        value = *(coeffs + 1) ;
+                    } else if(*(coeffs+2*i)==time) {
+                        /* the first of any points at the same time */
+                        while(i > 0 && *(coeffs+2*(i-1))==time) i--;
+                        value = *(coeffs+2*i+1);
+                    } else if(i == size-1) {
+                        value = *(coeffs+ here->VSRCfunctionOrder-1) ;
+                    } else {
+                        value = *(coeffs+2*i+1) +
+                            (((time-*(coeffs+2*i))/
+                            (*(coeffs+2*(i+1)) - 
+                             *(coeffs+2*i))) *
+                            (*(coeffs+2*i+3) - 
+                             *(coeffs+2*i+1)));
                     }
-                    value = *(here->VSRCcoeffs+ here->VSRCfunctionOrder-1) ;
                     break;
                 }
                 }
             }
-loadDone:
             value *= ckt->CKTsrcFact;
 
 /* gtri - begin - wbk - modify for supply ramping option */
@@ -75,6 +75,8 @@ void EVTaccept(
     Evt_State_Data_t    *state_data;
     Evt_Msg_Data_t      *msg_data;
 
+    Evt_Journal_t       *entry;
+
 
     /* Exit if no event instances */
     if(ckt->evt->counts.num_insts == 0)
@@ -150,6 +152,15 @@ void EVTaccept(
     /* Reset number modified to zero */
     state_data->num_modified = 0;
 
+    /* Changes journaled before this time can no longer be backed up */
+    if(state_data->journal) {
+        for(entry = state_data->journal; entry->next; entry = entry->next)
+            ;
+        entry->next = state_data->journal_free;
+        state_data->journal_free = state_data->journal;
+        state_data->journal = NULL;
+    }
+
 
     /* Process the msg data */
     num_modified = msg_data->num_modified;
@@ -58,6 +58,7 @@ NON-STANDARD FEATURES
 
 static void EVTbackup_node_data(CKTcircuit  *ckt, double new_time);
 static void EVTbackup_state_data(CKTcircuit  *ckt, double new_time);
+static void EVTbackup_journal(CKTcircuit  *ckt, double new_time);
 static void EVTbackup_msg_data(CKTcircuit  *ckt, double new_time);
 static void EVTbackup_inst_queue(CKTcircuit  *ckt, double new_time);
 static void EVTbackup_output_queue(CKTcircuit  *ckt, double new_time);
@@ -103,6 +104,9 @@ void EVTbackup(
     /* Backup the state data */
     EVTbackup_state_data(ckt, new_time);
 
+    /* Undo journaled changes to storage outside the state data */
+    EVTbackup_journal(ckt, new_time);
+
     /* Backup the msg data */
     EVTbackup_msg_data(ckt, new_time);
 
@@ -294,6 +298,40 @@ static void EVTbackup_state_data(
 
 
 
+/*
+EVTbackup_journal()
+
+Restore the storage saved by cm_event_journal() for changes made
+after the new time.  The newest entries are first, so the oldest
+contents of anything changed more than once are restored last.
+*/
+
+
+static void EVTbackup_journal(
+    CKTcircuit  *ckt,           /* the main circuit structure */
+    double      new_time)       /* the time to backup to */
+{
+    int         i;
+
+    Evt_State_Data_t    *state_data;
+    Evt_Journal_t       *entry;
+
+    state_data = ckt->evt->data.state;
+
+    while((entry = state_data->journal) && (entry->step > new_time)) {
+
+        for(i = 0; i < entry->bytes; i++)
+            entry->addr[i] = entry->old[i];
+
+        state_data->journal = entry->next;
+        entry->next = state_data->journal_free;
+        state_data->journal_free = entry;
+    }
+
+} /* EVTbackup_journal */
+
+
+
 /*
 EVTbackup_msg_data()
 
@@ -58,6 +58,7 @@ NON-STANDARD FEATURES
 
 static int EVTsetup_queues(CKTcircuit *ckt);
 static int EVTsetup_data(CKTcircuit *ckt);
+static void EVTsetup_free_journal(Evt_Journal_t *entry);
 static int EVTsetup_jobs(CKTcircuit *ckt);
 static int EVTsetup_load_ptrs(CKTcircuit *ckt);
 
@@ -307,6 +308,16 @@ static int EVTsetup_data(
     /* jobs are kept around like SPICE does */
 
     data = &(ckt->evt->data);
+
+    /* The cm_event_journal() entries of the last analysis are only */
+    /* needed while it runs, so they are freed here */
+    if(data->state) {
+        EVTsetup_free_journal(data->state->journal);
+        EVTsetup_free_journal(data->state->journal_free);
+        data->state->journal = NULL;
+        data->state->journal_free = NULL;
+    }
+
     CKALLOC(data->node, 1, Evt_Node_Data_t)
     CKALLOC(data->state, 1, Evt_State_Data_t)
     CKALLOC(data->msg, 1, Evt_Msg_Data_t)
@@ -420,6 +431,29 @@ static int EVTsetup_data(
 
 
 
+/*
+EVTsetup_free_journal
+
+This function frees a list of entries made by cm_event_journal().
+*/
+
+
+static void EVTsetup_free_journal(
+    Evt_Journal_t *entry)  /* The head of the list */
+{
+    Evt_Journal_t  *next;
+
+    while(entry) {
+        next = entry->next;
+        if(entry->old)
+            FREE(entry->old);
+        FREE(entry);
+        entry = next;
+    }
+}
+
+
+
 /*
 EVTsetup_jobs
 
@@ -273,6 +273,13 @@ static void EVTnode_insert(
         }
     }
 
+    /* If not linked in, try the code model libraries */
+    if(! found) {
+        udn_index = MIFlib_find_udn(type_name);
+        if(udn_index >= 0)
+            found = MIF_TRUE;
+    }
+
     /* Report error if not recognized */
     if(! found) {
         *err_msg = "Unrecognized connection type";
@@ -26,6 +26,16 @@
 #include "IPCtiein.h"
 #include "MIF.h"
 /* gtri - end - wbk - 12/19/90 */
+#include "SHMout.h"
+#ifdef UNIX
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#endif
 #include "suffix.h"
 
 
@@ -90,6 +100,10 @@ typedef struct runDesc {
     int pointCount;
     int isComplex;
     int windowCount;
+    struct measure *meas;   /* The .measure cards for this run. */
+    Shm_Header_t *shm;      /* The shared-memory copy, if "shmout" is set. */
+    long shmSize;
+    Ipc_Boolean_t ipcComplex;   /* Send the ground node to IPC as complex. */
 } runDesc;
 
 static int beginPlot();
@@ -105,6 +119,10 @@ static void plotInit();
 static void plotAddRealValue();
 static void plotAddComplexValue();
 static void plotEnd();
+static void shmInit();
+static void shmAddPoint();
+static void shmEnd();
+static void shmWake();
 static bool parseSpecial();
 static bool name_eq();
 static bool getSpecial();
@@ -114,6 +132,7 @@ static void freeRun();
 static void addIspecials();
 static void addCLDQJMspecials();
 /* gtri - add - 4/15/91 - wbk - Add prototypes for new functions */
+static void ipcSendDict();
 
 
 /* The two "begin plot" routines share all their internals... */
@@ -184,6 +203,8 @@ beginPlot(analysisPtr, circuitPtr, cktName, analName, refName, refType,
     int numsaves;
     int i, j, depind;
     char namebuf[BSIZE], parambuf[BSIZE], depbuf[BSIZE];
+    char *abbrev;
+    char shmpath[BSIZE];
     bool saveall = true;
 
 /* gtri - add - wbk - 12/19/90 - Add IPC stuff */
@@ -204,6 +225,16 @@ beginPlot(analysisPtr, circuitPtr, cktName, analName, refName, refType,
     run->type = copy(analName);
     run->windowed = windowed;
 
+    /* The .measure cards look at everything the simulator gives us, not
+     * just what is saved.  The op point in front of an ac analysis has
+     * no scale and isn't what they are talking about.
+     */
+    abbrev = ft_plotabbrev(analName);
+    if (ft_curckt && (ft_curckt->ci_ckt == circuitPtr) && (refName ||
+            (abbrev && eq(abbrev, "op"))))
+        run->meas = ft_measinit(ft_curckt->ci_commands, analName,
+                refName ? refType : 0, numNames, dataNames, dataType);
+
 /* gtri - add - wbk - 12/19/90 - Add IPC stuff */
 
     /* Execute this code in lieu of original code if ipc is enabled */
@@ -234,6 +265,19 @@ beginPlot(analysisPtr, circuitPtr, cktName, analName, refName, refType,
                 addCLDQJMspecials(run);
         }
 
+        /* The ground node goes with the rest of the run.  The analysis */
+        /* type in g_mif_info isn't set yet when AC begins its plot.    */
+        run->ipcComplex = (dataType == IF_COMPLEX) ? IPC_TRUE : IPC_FALSE;
+        for(i = 0; i < run->numData; i++) {
+            if(run->data[i].type == IF_COMPLEX)
+                run->ipcComplex = IPC_TRUE;
+        }
+
+        /* Protocol V2 sends the names once here, in the order OUTpData */
+        /* will send the values */
+        if(g_ipc.protocol == IPC_PROTOCOL_V2)
+            ipcSendDict(run);
+
         /* Do the stuff that the original routine does at the end */
 
         run->writeOut = ft_getOutReq(&run->fp, &run->runPlot, &run->binary,
@@ -346,6 +390,9 @@ beginPlot(analysisPtr, circuitPtr, cktName, analName, refName, refType,
     else
         plotInit(run);
 
+    if (cp_getvar("shmout", VT_STRING, shmpath))
+        shmInit(run, shmpath);
+
     return (OK);
 }
 
@@ -462,13 +509,16 @@ OUTpData(plotPtr, refValue, valuePtr)
 
     run->pointCount++;
 
+    if (run->meas)
+        ft_measpoint(run->meas, refValue, valuePtr, run->pointCount);
+
 /* gtri - add - wbk - 12/19/90 - Add IPC stuff */
 
     if(g_ipc.enabled) {
 
         /* Send ground node data for consistancy */
 
-        if(g_mif_info.circuit.anal_type != MIF_AC) {
+        if(! run->ipcComplex) {
             ipc_send_double("0", 0.0);
         }
         else {
@@ -495,12 +545,18 @@ OUTpData(plotPtr, refValue, valuePtr)
             }
             else if(g_ipc.anal_type != IPC_ANAL_AC) {
                 /* Must be a special (ICLDQJM current) */
-                if(! getSpecial(&run->data[i], run, &val))
+                if(! getSpecial(&run->data[i], run, &val)) {
+                    /* V2 frames are positional, so hold the place */
+                    if(g_ipc.protocol == IPC_PROTOCOL_V2)
+                        ipc_send_double(run->data[i].specName, 0.0);
                     continue;
+                }
                 if(run->data[i].type == IF_REAL) {
                     ipc_send_double(run->data[i].specName,
                                     val.rValue * run->data[i].specModType);
                 }
+                else if(g_ipc.protocol == IPC_PROTOCOL_V2)
+                    ipc_send_double(run->data[i].specName, 0.0);
             }
         }
 
@@ -588,6 +644,9 @@ OUTpData(plotPtr, refValue, valuePtr)
         gr_iplot(run->runPlot);
     }
 
+    if (run->shm)
+        shmAddPoint(run, refValue, valuePtr);
+
     if (ft_bpcheck(run->runPlot, run->pointCount) == false)
         shouldstop = true;
 
@@ -639,6 +698,12 @@ OUTendPlot(plotPtr)
         gr_end_iplot();
         plotEnd(run);
     }
+    if (run->shm)
+        shmEnd(run);
+
+    ft_measend(run->meas, run->writeOut ? (struct plot *) NULL :
+            run->runPlot);
+    run->meas = NULL;
 
     freeRun(run);
 
@@ -916,6 +981,182 @@ plotEnd(run)
     return;
 }
 
+/* The shared-memory backend.  See SHMout.h for the layout and how the
+ * readers use it.  Every value takes the same slot in every record, with
+ * the same real-or-complex convention as the rawfile.
+ */
+
+static void
+shmInit(run, path)
+    runDesc *run;
+    char *path;
+{
+#ifdef UNIX
+    Shm_Header_t *h;
+    Shm_Vector_t *sv;
+    int fd, i, ringsize, npoints, type;
+    long size;
+    char buf[BSIZE], *name;
+
+    if (!cp_getvar("shmpoints", VT_NUM, (char *) &npoints) || npoints < 2)
+        npoints = SHM_DEFPOINTS;
+    for (ringsize = 2; ringsize < npoints; ringsize *= 2)
+        ;
+
+    run->isComplex = false;
+    for (i = 0; i < run->numData; i++)
+        if (run->data[i].type == IF_COMPLEX)
+            run->isComplex = true;
+
+    size = sizeof (Shm_Header_t) + run->numData * sizeof (Shm_Vector_t);
+    size = (size + 63) & ~63L;
+    size += (long) ringsize * run->numData * (run->isComplex ? 2 : 1) *
+            sizeof (double);
+
+    /* Readers still looking at the last plot keep the old file. */
+    (void) unlink(path);
+    if ((fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644)) < 0) {
+        perror(path);
+        return;
+    }
+    if (ftruncate(fd, (off_t) size) < 0) {
+        perror(path);
+        (void) close(fd);
+        return;
+    }
+    h = (Shm_Header_t *) mmap((char *) NULL, (size_t) size,
+            PROT_READ | PROT_WRITE, MAP_SHARED, fd, (off_t) 0);
+    (void) close(fd);
+    if (h == (Shm_Header_t *) MAP_FAILED) {
+        perror(path);
+        return;
+    }
+
+    h->sh_version = SHM_VERSION;
+    h->sh_numvecs = run->numData;
+    h->sh_complex = run->isComplex;
+    h->sh_width = run->numData * (run->isComplex ? 2 : 1);
+    h->sh_ringsize = ringsize;
+    h->sh_vecoffset = sizeof (Shm_Header_t);
+    h->sh_ringoffset = (h->sh_vecoffset + run->numData *
+            sizeof (Shm_Vector_t) + 63) & ~63;
+    (void) strncpy(h->sh_name, run->name, SHM_NAMELEN - 1);
+    (void) strncpy(h->sh_type, run->type, SHM_NAMELEN - 1);
+
+    /* Name and type them the way fileInit does. */
+    sv = SHM_VECTORS(h);
+    for (i = 0; i < run->numData; i++) {
+        if (isdigit(*run->data[i].name)) {
+            (void) sprintf(buf, "V(%s)", run->data[i].name);
+            name = buf;
+        } else
+            name = run->data[i].name;
+        if (substring("#branch", name))
+            type = SV_CURRENT;
+        else if (cieq(name, "time"))
+            type = SV_TIME;
+        else if (cieq(name, "frequency"))
+            type = SV_FREQUENCY;
+        else
+            type = SV_VOLTAGE;
+        (void) strncpy(sv[i].sv_name, name, SHM_NAMELEN - 1);
+        sv[i].sv_type = type;
+        sv[i].sv_index = i;
+    }
+
+    SHM_BARRIER();
+    h->sh_magic = SHM_MAGIC;
+
+    run->shm = h;
+    run->shmSize = size;
+#else
+    fprintf(cp_err, "Warning: no shared-memory output on this system\n");
+#endif
+    return;
+}
+
+static void
+shmAddPoint(run, refValue, valuePtr)
+    runDesc *run;
+    IFvalue *refValue;
+    IFvalue *valuePtr;
+{
+    Shm_Header_t *h = run->shm;
+    dataDesc *d;
+    IFvalue val;
+    double *rec, re, im;
+    unsigned int n;
+    int i;
+
+    n = h->sh_count;
+    rec = SHM_RECORD(h, n);
+    for (i = 0; i < run->numData; i++) {
+        d = &run->data[i];
+        re = im = 0.0;
+        if (d->outIndex == -1) {
+            if (d->type == IF_COMPLEX) {
+                re = refValue->cValue.real;
+                im = refValue->cValue.imag;
+            } else
+                re = refValue->rValue;
+        } else if (d->regular) {
+            if (d->type == IF_COMPLEX) {
+                re = valuePtr->v.vec.cVec[d->outIndex].real;
+                im = valuePtr->v.vec.cVec[d->outIndex].imag;
+            } else
+                re = valuePtr->v.vec.rVec[d->outIndex];
+        } else if (getSpecial(d, run, &val)) {
+            if (d->type == IF_COMPLEX) {
+                re = val.cValue.real;
+                im = val.cValue.imag;
+            } else
+                re = val.rValue;
+        }
+        if (h->sh_complex) {
+            rec[2 * i] = re;
+            rec[2 * i + 1] = im;
+        } else
+            rec[i] = re;
+    }
+
+    /* Publish it, then wake anybody who went to sleep waiting. */
+    SHM_BARRIER();
+    h->sh_count = n + 1;
+    SHM_BARRIER();
+    if (h->sh_waiters) {
+        h->sh_waiters = 0;
+        shmWake(h);
+    }
+    return;
+}
+
+static void
+shmEnd(run)
+    runDesc *run;
+{
+    Shm_Header_t *h = run->shm;
+
+    h->sh_done = 1;
+    SHM_BARRIER();
+    shmWake(h);
+#ifdef UNIX
+    (void) munmap((char *) h, (size_t) run->shmSize);
+#endif
+    run->shm = NULL;
+    return;
+}
+
+static void
+shmWake(h)
+    Shm_Header_t *h;
+{
+#if defined(UNIX) && defined(__linux__)
+    (void) syscall(SYS_futex, &h->sh_count, FUTEX_WAKE, MAXPOSINT,
+            (char *) NULL, (char *) NULL, 0);
+#endif
+    return;
+}
+
 
 
 /* ParseSpecial takes something of the form "@name[param,index]" and rips
@@ -1300,3 +1541,45 @@ runDesc *run;
 
 /* gtri - end - 4/15/91 - wbk - Add new routines for returning currents */
 
+
+/* Send the protocol V2 name dictionary for a run.  The entries must */
+/* match, one for one, the values OUTpData sends for each point.     */
+
+static void ipcSendDict(run)
+runDesc *run;
+{
+    int i, num;
+
+    /* Count them first.  The type of a special isn't known until it is */
+    /* first looked up, so each one gets a real entry. */
+    num = 1;
+    for (i = 0; i < run->numData; i++) {
+        if(run->data[i].regular) {
+            if((run->data[i].type == IF_REAL) ||
+                    (run->data[i].type == IF_COMPLEX))
+                num++;
+        }
+        else if(g_ipc.anal_type != IPC_ANAL_AC)
+            num++;
+    }
+
+    ipc_send_vecdict_prefix(num);
+
+    /* The ground node goes first */
+    num = 0;
+    ipc_send_vecdict_entry(num++, "0", run->ipcComplex);
+
+    for (i = 0; i < run->numData; i++) {
+        if(run->data[i].regular) {
+            if((run->data[i].type == IF_REAL) ||
+                    (run->data[i].type == IF_COMPLEX))
+                ipc_send_vecdict_entry(num++, run->data[i].name,
+                    (run->data[i].type == IF_COMPLEX) ? IPC_TRUE : IPC_FALSE);
+        }
+        else if(g_ipc.anal_type != IPC_ANAL_AC)
+            ipc_send_vecdict_entry(num++, run->data[i].specName, IPC_FALSE);
+    }
+
+    ipc_send_vecdict_suffix();
+}
+
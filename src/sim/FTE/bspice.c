@@ -152,7 +152,7 @@ main(ac, av)
         /* Make sure there are at least two args to the -ipc switch */
         if(ac < 4) {
             printf("\nERROR - Too few arguments to -ipc switch\n");
-            printf("\nUsage - atesse_xspice -ipc <mode> <ipc channel>\n");
+            printf("\nUsage - atesse_xspice -ipc <mode> <ipc channel> [ <protocol> ]\n");
             exit(1);
         }
 
@@ -174,8 +174,25 @@ main(ac, av)
         else
             strcpy(ipc_path, av[3]);
 
+        /* The protocol is optional - V1 unless V2 or V2DELTA is given */
+        if(ac > 4) {
+            if(strcmp(av[4],"V1") == 0)
+                g_ipc.protocol = IPC_PROTOCOL_V1;
+            else if(strcmp(av[4],"V2") == 0)
+                g_ipc.protocol = IPC_PROTOCOL_V2;
+            else if(strcmp(av[4],"V2DELTA") == 0) {
+                g_ipc.protocol = IPC_PROTOCOL_V2;
+                g_ipc.delta = IPC_TRUE;
+            }
+            else {
+                printf("\nERROR - Bad protocol as third argument\n");
+                printf("\nMust be V1, V2, or V2DELTA\n");
+                exit(1);
+            }
+        }
+
         /* Create the IPC transport server */
-        ipc_status = ipc_initialize_server(ipc_path, g_ipc.mode, IPC_PROTOCOL_V1);
+        ipc_status = ipc_initialize_server(ipc_path, g_ipc.mode, g_ipc.protocol);
         if(ipc_status != IPC_STATUS_OK) {
             printf("\nERROR - Problems initializing IPC server\n");
             exit(1);
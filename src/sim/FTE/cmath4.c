@@ -22,6 +22,8 @@
 #include "FTEcmath.h"
 #include "suffix.h"
 
+static char *fftdir();
+
 char *
 cx_and(data1, data2, datatype1, datatype2, length)
     char *data1, *data2;
@@ -237,3 +239,71 @@ cx_interpolate(data, type, length, newlength, newtype, pl, newpl)
     return ((char *) d);
 }
 
+
+/* The discrete Fourier transform and its inverse, of any length.  There
+ * is no windowing or resampling here -- see the fft command for that.
+ */
+
+char *
+cx_fft(data, type, length, newlength, newtype)
+    char *data;
+    short type;
+    int length;
+    int *newlength;
+    short *newtype;
+{
+    return (fftdir(data, type, length, newlength, newtype, -1));
+}
+
+char *
+cx_ifft(data, type, length, newlength, newtype)
+    char *data;
+    short type;
+    int length;
+    int *newlength;
+    short *newtype;
+{
+    return (fftdir(data, type, length, newlength, newtype, 1));
+}
+
+static char *
+fftdir(data, type, length, newlength, newtype, dir)
+    char *data;
+    short type;
+    int length;
+    int *newlength;
+    short *newtype;
+    int dir;
+{
+    complex *c, *cc = (complex *) data;
+    double *dd = (double *) data;
+    double *re, *im;
+    int i;
+
+    if (length < 1) {
+        fprintf(cp_err, "Error: can't transform an empty vector\n");
+        return (NULL);
+    }
+    re = alloc_d(length);
+    im = alloc_d(length);
+    for (i = 0; i < length; i++)
+        if (type == VF_REAL) {
+            re[i] = dd[i];
+            im[i] = 0.0;
+        } else {
+            re[i] = realpart(&cc[i]);
+            im[i] = imagpart(&cc[i]);
+        }
+    (void) ft_fft(re, im, length, dir);
+
+    c = alloc_c(length);
+    for (i = 0; i < length; i++) {
+        realpart(&c[i]) = re[i];
+        imagpart(&c[i]) = im[i];
+    }
+    tfree(re);
+    tfree(im);
+    *newtype = VF_COMPLEX;
+    *newlength = length;
+    return ((char *) c);
+}
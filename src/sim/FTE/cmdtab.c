@@ -14,6 +14,7 @@
 
 /* gtri - begin - wbk - add include files */
 #include "EVTproto.h"
+#include "MIFproto.h"
 /* gtri - end - wbk - add include files */
 
 #include "suffix.h"
@@ -104,6 +105,11 @@ struct comm cp_coms[] = {
       "node node ... : Print event values." } ,
 /* gtri - end - wbk - add event print command */
 
+    { "codemodel", MIFcodemodel, false, false, false,
+      { 1, 1, 1, 1 }, E_DEFHMASK, 0, LOTS,
+      (int (*)()) NULL,
+      "[library ...] : Find code models and node types in libraries." } ,
+
     { "load", com_load, false, false, true,
       { 1, 1, 1, 1 }, E_BEGINNING | E_NOPLOTS, 1, LOTS,
       arg_load,
@@ -156,6 +162,14 @@ struct comm cp_coms[] = {
       { 0, 040000, 040000, 040000 }, E_DEFHMASK, 1, LOTS,
       (int (*)()) NULL,
       "fund_freq vector ... : Do a fourier analysis of some data." } ,
+    { "fft", com_fft, false, false, true,
+      { 040000, 040000, 040000, 040000 }, E_DEFHMASK, 1, LOTS,
+      (int (*)()) NULL,
+      "vector ... : Make a plot of the spectra of some data." } ,
+    { "distortion", com_distortion, false, false, true,
+      { 0, 040000, 040000, 040000 }, E_DEFHMASK, 2, LOTS,
+      (int (*)()) NULL,
+      "fund_freq vector ... : Find the THD, SNR and SFDR of a tone." } ,
     { "show", com_show, false, true, false,
       { 040, 040, 040, 040 }, E_DEFHMASK, 0, LOTS,
       (int (*)()) NULL,
@@ -208,6 +222,14 @@ struct comm cp_coms[] = {
       { 0, 0, 0, 0 }, E_DEFHMASK, 0, 1,
       (int (*)()) NULL,
       "[rawfile] : Run the simulation as specified in the input file." } ,
+    { "mc", com_mc, false, true, true,
+      { 0, 1, 0, 0 }, E_DEFHMASK, 1, 2,
+      (int (*)()) NULL,
+      "nruns [rawfile] : Do Monte Carlo runs of the input file analyses." } ,
+    { "vary", com_vary, false, true, false,
+      { 040, 0, 0, 0 }, E_DEFHMASK, 0, 4,
+      (int (*)()) NULL,
+      "[name parm sigma [uniform]] : Vary a parameter in Monte Carlo runs." } ,
     { "aspice", com_aspice, false, false, false,
       { 1, 1, 1, 1 }, E_DEFHMASK, 1, 2,
       (int (*)()) NULL,
@@ -125,6 +125,9 @@ ft_cpinit()
         cp_addkword(CT_RUSEARGS, "solvetime");
         cp_addkword(CT_RUSEARGS, "transolvetime");
         cp_addkword(CT_RUSEARGS, "loadtime");
+        cp_addkword(CT_RUSEARGS, "lufactors");
+        cp_addkword(CT_RUSEARGS, "lusaved");
+        cp_addkword(CT_RUSEARGS, "autopartial");
         cp_addkword(CT_RUSEARGS, "all");
 
         cp_addkword(CT_VECTOR, "all");
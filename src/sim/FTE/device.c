@@ -108,6 +108,7 @@ com_alter(wl)
 {
     wordlist *devs, *tw;
     struct variable var;
+    struct altvar *av, *last;
     char *parm, *val;
     double *dd;
 
@@ -149,14 +150,66 @@ com_alter(wl)
         var.va_type = VT_STRING;
         var.va_string = val;
     }
+    var.va_name = NULL;
+    var.va_next = NULL;
 
+    /* Remember it, so that it survives the deck being reparsed. */
+    for (last = ft_curckt->ci_alters; last && last->av_next;
+            last = last->av_next)
+        ;
     while (devs) {
         if_setparam(ft_curckt->ci_ckt, devs->wl_word, parm, &var);
+        av = alloc(altvar);
+        av->av_name = copy(devs->wl_word);
+        av->av_parm = copy(parm);
+        av->av_val = var;
+        if (var.va_type == VT_STRING)
+            av->av_val.va_string = copy(var.va_string);
+        if (last)
+            last->av_next = av;
+        else
+            ft_curckt->ci_alters = av;
+        last = av;
         devs = devs->wl_next;
     }
     return;
 }
 
+/* Do the alter commands given since the deck was last parsed again, on
+ * the newly parsed circuit.
+ */
+
+void
+ft_altredo(ci)
+    struct circ *ci;
+{
+    struct altvar *av;
+
+    for (av = ci->ci_alters; av; av = av->av_next)
+        if_setparam(ci->ci_ckt, av->av_name, av->av_parm, &av->av_val);
+    return;
+}
+
+/* Forget them. */
+
+void
+ft_altfree(ci)
+    struct circ *ci;
+{
+    struct altvar *av;
+
+    while (ci->ci_alters) {
+        av = ci->ci_alters->av_next;
+        tfree(ci->ci_alters->av_name);
+        tfree(ci->ci_alters->av_parm);
+        if (ci->ci_alters->av_val.va_type == VT_STRING)
+            tfree(ci->ci_alters->av_val.va_string);
+        tfree(ci->ci_alters);
+        ci->ci_alters = av;
+    }
+    return;
+}
+
 /* Given a device name, possibly with wildcards, return the matches. */
 
 static wordlist *
@@ -218,7 +218,8 @@ ft_cktcoms(terse)
         } else if (ciprefix(".four", command->wl_word)) {
             com_fourier(command->wl_next);
             fprintf(cp_out, "\n\n");
-        } else if (!eq(command->wl_word, ".save"))
+        } else if (!eq(command->wl_word, ".save") &&
+                !ciprefix(".meas", command->wl_word))
             goto bad;
         coms = coms->wl_next;
     }
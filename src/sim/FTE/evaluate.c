@@ -20,6 +20,8 @@
 
 static struct dvec *apply_func();
 static struct dvec *doop();
+static struct dvec *evalfused();
+static void fusefree();
 static char *mkcname();
 static int sig_matherr();
 
@@ -54,6 +56,8 @@ ft_evaluate(node)
         return (NULL);
     else if (node->pn_value)
         d = node->pn_value;
+    else if (d = evalfused(node))
+        ;   /* Pointwise, done in one pass. */
     else if (node->pn_func)
         d = apply_func(node->pn_func, node->pn_left);
     else if (node->pn_op) {
@@ -805,3 +809,572 @@ doop(what, func, arg1, arg2)
     return (res);
 }
 
+
+/* Expressions built only out of the pointwise operators and functions
+ * are compiled into a short postorder program and run FU_CHUNK points at
+ * a time, so that no intermediate vectors get allocated and the partial
+ * results stay in the cache.  Each step computes exactly what the cx_
+ * routine it replaces would, and the result gets the same name, flags,
+ * and scale that doop() and apply_func() would have given it.  Anything
+ * that doesn't fit, or any argument out of range, makes evalfused()
+ * return NULL and the expression is done the old way, which also prints
+ * the error message.
+ */
+
+#define FU_CHUNK    256     /* Points per block -- 4K per complex temp. */
+#define FU_MAXOPS   64
+
+#define FU_LEAF     0
+#define FU_PLUS     1
+#define FU_MINUS    2
+#define FU_TIMES    3
+#define FU_DIVIDE   4
+#define FU_COMMA    5
+#define FU_UMINUS   6
+#define FU_MAG      7
+#define FU_PH       8
+#define FU_J        9
+#define FU_REAL     10
+#define FU_IMAG     11
+#define FU_POS      12
+#define FU_DB       13
+#define FU_LOG      14
+#define FU_LN       15
+#define FU_EXP      16
+#define FU_SIN      17
+#define FU_COS      18
+#define FU_TAN      19
+#define FU_ATAN     20
+
+struct fuseop {
+    int fo_what;            /* FU_ code. */
+    int fo_left;            /* Operands, indices into the program. */
+    int fo_right;
+    bool fo_cplx;           /* Result is complex (interleaved re, im). */
+    int fo_length;
+    struct dvec *fo_vec;    /* The vector for an FU_LEAF. */
+    double *fo_data;        /* This block of the result. */
+    double *fo_buf;         /* FU_CHUNK points of scratch. */
+    char *fo_name;
+    short fo_flags;
+    struct dvec *fo_scale;
+    struct dvec *fo_from;   /* Where color, grid, and type come from. */
+    bool fo_dims;           /* The dims of fo_from carry through too. */
+    bool fo_warn;           /* The scales of the operands differ. */
+} ;
+
+static struct fusefunc {
+    char *(*ff_func)();
+    int ff_what;
+    bool ff_real;           /* Result is always real. */
+} fusefuncs[] = {
+    { cx_mag, FU_MAG, true } ,
+    { cx_ph, FU_PH, true } ,
+    { cx_j, FU_J, false } ,
+    { cx_real, FU_REAL, true } ,
+    { cx_imag, FU_IMAG, true } ,
+    { cx_pos, FU_POS, true } ,
+    { cx_db, FU_DB, true } ,
+    { cx_log, FU_LOG, false } ,
+    { cx_ln, FU_LN, false } ,
+    { cx_exp, FU_EXP, false } ,
+    { cx_sin, FU_SIN, false } ,
+    { cx_cos, FU_COS, false } ,
+    { cx_tan, FU_TAN, false } ,
+    { cx_atan, FU_ATAN, true } ,
+    { NULL, 0, false }
+} ;
+
+#define fure(o, d, i)   ((o)->fo_cplx ? (d)[2 * (i)] : (d)[i])
+#define fuim(o, d, i)   ((o)->fo_cplx ? (d)[2 * (i) + 1] : 0.0)
+
+/* Add node and everything under it to the program, returning the index
+ * of node's step or -1 if it can't be done this way.
+ */
+
+static int
+fusecomp(node, ops, nops)
+    struct pnode *node;
+    struct fuseop *ops;
+    int *nops;
+{
+    struct fuseop *f, *fl, *fr;
+    struct dvec *v = NULL;
+    int what, l = -1, r = -1, i;
+    char opc = '\0';
+    bool real;
+
+    if (!node)
+        return (-1);
+    if (node->pn_value) {
+        v = node->pn_value;
+        if (v->v_link2 || (v->v_length < 1))
+            return (-1);
+        what = FU_LEAF;
+    } else if (node->pn_func) {
+        for (i = 0; fusefuncs[i].ff_func; i++)
+            if (node->pn_func->fu_func == fusefuncs[i].ff_func)
+                break;
+        if (!fusefuncs[i].ff_func)
+            return (-1);
+        what = fusefuncs[i].ff_what;
+        real = fusefuncs[i].ff_real;
+        if ((l = fusecomp(node->pn_left, ops, nops)) < 0)
+            return (-1);
+    } else if (node->pn_op && (node->pn_op->op_arity == 1)) {
+        if (node->pn_op->op_func != op_uminus)
+            return (-1);
+        what = FU_UMINUS;
+        real = false;
+        if ((l = fusecomp(node->pn_left, ops, nops)) < 0)
+            return (-1);
+    } else if (node->pn_op && (node->pn_op->op_arity == 2)) {
+        if (node->pn_op->op_func == op_plus) {
+            what = FU_PLUS;
+            opc = '+';
+        } else if (node->pn_op->op_func == op_minus) {
+            what = FU_MINUS;
+            opc = '-';
+        } else if (node->pn_op->op_func == op_times) {
+            what = FU_TIMES;
+            opc = '*';
+        } else if (node->pn_op->op_func == op_divide) {
+            what = FU_DIVIDE;
+            opc = '/';
+        } else if (node->pn_op->op_func == op_comma) {
+            what = FU_COMMA;
+            opc = ',';
+        } else
+            return (-1);
+        if ((l = fusecomp(node->pn_left, ops, nops)) < 0)
+            return (-1);
+        if ((r = fusecomp(node->pn_right, ops, nops)) < 0)
+            return (-1);
+    } else
+        return (-1);
+
+    if (*nops == FU_MAXOPS)
+        return (-1);
+    f = &ops[*nops];
+    bzero((char *) f, sizeof (struct fuseop));
+    f->fo_what = what;
+    f->fo_left = l;
+    f->fo_right = r;
+
+    if (what == FU_LEAF) {
+        f->fo_vec = v;
+        f->fo_cplx = !isreal(v);
+        f->fo_length = v->v_length;
+        f->fo_name = v->v_name;
+        f->fo_flags = v->v_flags;
+        f->fo_scale = v->v_scale;
+        f->fo_from = v;
+        f->fo_dims = true;
+    } else if (opc) {
+        /* As in doop(). */
+        fl = &ops[l];
+        fr = &ops[r];
+        f->fo_length = (fl->fo_length > fr->fo_length) ? fl->fo_length :
+                fr->fo_length;
+        f->fo_cplx = fl->fo_cplx || fr->fo_cplx || (what == FU_COMMA);
+        if (f->fo_cplx)
+            f->fo_flags = (fl->fo_flags | fr->fo_flags | VF_COMPLEX) &
+                    ~ VF_REAL;
+        else
+            f->fo_flags = (fl->fo_flags | fr->fo_flags | VF_REAL) &
+                    ~ VF_COMPLEX;
+        f->fo_name = mkcname(opc, fl->fo_name, fr->fo_name);
+        if (fl->fo_scale != fr->fo_scale)
+            f->fo_warn = true;
+        else
+            f->fo_scale = fl->fo_scale;
+        f->fo_from = fl->fo_from;
+        f->fo_dims = false;
+    } else {
+        /* As in apply_func(). */
+        fl = &ops[l];
+        f->fo_length = fl->fo_length;
+        if (what == FU_J)
+            f->fo_cplx = true;
+        else
+            f->fo_cplx = real ? false : fl->fo_cplx;
+        f->fo_flags = (fl->fo_flags & ~VF_COMPLEX & ~VF_REAL &
+                ~VF_PERMANENT & ~VF_MINGIVEN & ~VF_MAXGIVEN);
+        f->fo_flags |= f->fo_cplx ? VF_COMPLEX : VF_REAL;
+        if (what == FU_UMINUS)
+            f->fo_name = mkcname('a', func_uminus.fu_name, fl->fo_name);
+        else
+            f->fo_name = mkcname('b', fl->fo_name, (char *) NULL);
+        f->fo_scale = fl->fo_scale;
+        f->fo_from = fl->fo_from;
+        f->fo_dims = fl->fo_dims;
+    }
+    return ((*nops)++);
+}
+
+/* Compute points base through base + n - 1 of step f into f->fo_data.
+ * Returns false if an argument is out of range.
+ */
+
+static bool
+fusestep(ops, f, base, n)
+    struct fuseop *ops, *f;
+    int base, n;
+{
+    struct fuseop *fl, *fr;
+    struct dvec *v;
+    double *a, *b, *out = f->fo_data;
+    double ar, ai, br, bi, tt, u, w;
+    int i, j;
+
+    if (f->fo_what == FU_LEAF) {
+        /* A shorter vector is padded out with its last value. */
+        v = f->fo_vec;
+        a = isreal(v) ? v->v_realdata : (double *) v->v_compdata;
+        if (base + n <= v->v_length) {
+            f->fo_data = f->fo_cplx ? a + 2 * base : a + base;
+            return (true);
+        }
+        for (i = 0; i < n; i++) {
+            j = (base + i < v->v_length) ? base + i : v->v_length - 1;
+            if (f->fo_cplx) {
+                out[2 * i] = a[2 * j];
+                out[2 * i + 1] = a[2 * j + 1];
+            } else
+                out[i] = a[j];
+        }
+        return (true);
+    }
+
+    fl = &ops[f->fo_left];
+    a = fl->fo_data;
+    if (f->fo_right >= 0) {
+        fr = &ops[f->fo_right];
+        b = fr->fo_data;
+    }
+
+    /* The all-real cases are kept as plain loops over the block so that
+     * the compiler can vectorize them.
+     */
+    switch (f->fo_what) {
+        case FU_PLUS:
+            if (!f->fo_cplx)
+                for (i = 0; i < n; i++)
+                    out[i] = a[i] + b[i];
+            else
+                for (i = 0; i < n; i++) {
+                    out[2 * i] = fure(fl, a, i) + fure(fr, b, i);
+                    out[2 * i + 1] = fuim(fl, a, i) + fuim(fr, b, i);
+                }
+            break;
+
+        case FU_MINUS:
+            if (!f->fo_cplx)
+                for (i = 0; i < n; i++)
+                    out[i] = a[i] - b[i];
+            else
+                for (i = 0; i < n; i++) {
+                    out[2 * i] = fure(fl, a, i) - fure(fr, b, i);
+                    out[2 * i + 1] = fuim(fl, a, i) - fuim(fr, b, i);
+                }
+            break;
+
+        case FU_TIMES:
+            if (!f->fo_cplx)
+                for (i = 0; i < n; i++)
+                    out[i] = a[i] * b[i];
+            else
+                for (i = 0; i < n; i++) {
+                    ar = fure(fl, a, i);
+                    ai = fuim(fl, a, i);
+                    br = fure(fr, b, i);
+                    bi = fuim(fr, b, i);
+                    out[2 * i] = ar * br - ai * bi;
+                    out[2 * i + 1] = ai * br + ar * bi;
+                }
+            break;
+
+        case FU_DIVIDE:
+            if (!f->fo_cplx) {
+                for (i = 0; i < n; i++)
+                    if (b[i] == 0)
+                        return (false);
+                for (i = 0; i < n; i++)
+                    out[i] = a[i] / b[i];
+            } else
+                for (i = 0; i < n; i++) {
+                    ar = fure(fl, a, i);
+                    ai = fuim(fl, a, i);
+                    br = fure(fr, b, i);
+                    bi = fuim(fr, b, i);
+                    if ((br == 0) && (bi == 0))
+                        return (false);
+                    cdiv(ar, ai, br, bi, out[2 * i], out[2 * i + 1]);
+                }
+            break;
+
+        case FU_COMMA:
+            for (i = 0; i < n; i++) {
+                out[2 * i] = fure(fl, a, i) + fuim(fr, b, i);
+                out[2 * i + 1] = fuim(fl, a, i) + fure(fr, b, i);
+            }
+            break;
+
+        case FU_UMINUS:
+            if (!f->fo_cplx)
+                for (i = 0; i < n; i++)
+                    out[i] = - a[i];
+            else
+                for (i = 0; i < 2 * n; i++)
+                    out[i] = - a[i];
+            break;
+
+        case FU_MAG:
+            if (!fl->fo_cplx)
+                for (i = 0; i < n; i++)
+                    out[i] = FTEcabs(a[i]);
+            else
+                for (i = 0; i < n; i++)
+                    out[i] = sqrt(a[2 * i] * a[2 * i] +
+                            a[2 * i + 1] * a[2 * i + 1]);
+            break;
+
+        case FU_PH:
+            if (!fl->fo_cplx)
+                for (i = 0; i < n; i++)
+                    out[i] = 0.0;
+            else
+                for (i = 0; i < n; i++)
+                    out[i] = radtodeg(atan2(a[2 * i + 1], a[2 * i]));
+            break;
+
+        case FU_J:
+            for (i = 0; i < n; i++) {
+                out[2 * i] = - fuim(fl, a, i);
+                out[2 * i + 1] = fure(fl, a, i);
+            }
+            break;
+
+        case FU_REAL:
+            for (i = 0; i < n; i++)
+                out[i] = fure(fl, a, i);
+            break;
+
+        case FU_IMAG:
+            /* cx_imag() returns the data itself for a real vector. */
+            for (i = 0; i < n; i++)
+                out[i] = fl->fo_cplx ? a[2 * i + 1] : a[i];
+            break;
+
+        case FU_POS:
+            for (i = 0; i < n; i++)
+                out[i] = (fure(fl, a, i) > 0.0) ? 1.0 : 0.0;
+            break;
+
+        case FU_DB:
+            for (i = 0; i < n; i++) {
+                if (fl->fo_cplx)
+                    tt = sqrt(a[2 * i] * a[2 * i] +
+                            a[2 * i + 1] * a[2 * i + 1]);
+                else
+                    tt = a[i];
+                if (!(tt >= 0))
+                    return (false);
+                if (tt == 0.0)
+                    out[i] = 20.0 * - log(HUGE);
+                else
+                    out[i] = 20.0 * log10(tt);
+            }
+            break;
+
+        case FU_LOG:
+        case FU_LN:
+            for (i = 0; i < n; i++) {
+                if (fl->fo_cplx)
+                    tt = sqrt(a[2 * i] * a[2 * i] +
+                            a[2 * i + 1] * a[2 * i + 1]);
+                else
+                    tt = a[i];
+                if (!(tt >= 0))
+                    return (false);
+                if (tt == 0.0)
+                    u = (f->fo_what == FU_LOG) ? - log10(HUGE) : - log(HUGE);
+                else
+                    u = (f->fo_what == FU_LOG) ? log10(tt) : log(tt);
+                if (fl->fo_cplx) {
+                    out[2 * i] = u;
+                    out[2 * i + 1] = (tt == 0.0) ? 0.0 :
+                            atan2(a[2 * i + 1], a[2 * i]);
+                } else
+                    out[i] = u;
+            }
+            break;
+
+        case FU_EXP:
+            if (!fl->fo_cplx)
+                for (i = 0; i < n; i++)
+                    out[i] = exp(a[i]);
+            else
+                for (i = 0; i < n; i++) {
+                    /* Sic -- this is what cx_exp() does. */
+                    tt = exp(a[2 * i]);
+                    out[2 * i] = tt * cos(a[2 * i]);
+                    out[2 * i + 1] = tt * sin(a[2 * i + 1]);
+                }
+            break;
+
+        case FU_SIN:
+        case FU_COS:
+            if (!fl->fo_cplx) {
+                for (i = 0; i < n; i++)
+                    out[i] = (f->fo_what == FU_SIN) ? sin(degtorad(a[i])) :
+                            cos(degtorad(a[i]));
+            } else
+                for (i = 0; i < n; i++) {
+                    u = degtorad(a[2 * i]);
+                    w = degtorad(a[2 * i + 1]);
+                    if (f->fo_what == FU_SIN) {
+                        out[2 * i] = sin(u) * cosh(w);
+                        out[2 * i + 1] = cos(u) * sinh(w);
+                    } else {
+                        out[2 * i] = cos(u) * cosh(w);
+                        out[2 * i + 1] = - sin(u) * sinh(w);
+                    }
+                }
+            break;
+
+        case FU_TAN:
+            if (!fl->fo_cplx)
+                for (i = 0; i < n; i++) {
+                    if (!(cos(degtorad(a[i])) != 0))
+                        return (false);
+                    out[i] = sin(degtorad(a[i])) / cos(degtorad(a[i]));
+                }
+            else
+                for (i = 0; i < n; i++) {
+                    u = degtorad(a[2 * i]);
+                    w = degtorad(a[2 * i + 1]);
+                    br = cos(u) * cosh(w);
+                    bi = sin(u) * sinh(w);
+                    if ((br == 0) || (bi == 0))
+                        return (false);
+                    ar = sin(u) * cosh(w);
+                    ai = cos(u) * sinh(w);
+                    cdiv(ar, ai, br, bi, out[2 * i], out[2 * i + 1]);
+                }
+            break;
+
+        case FU_ATAN:
+            for (i = 0; i < n; i++)
+                out[i] = radtodeg(atan(fure(fl, a, i)));
+            break;
+    }
+    return (true);
+}
+
+static struct dvec *
+evalfused(node)
+    struct pnode *node;
+{
+    struct fuseop ops[FU_MAXOPS], *f;
+    struct dvec *res, *v;
+    double *buf, *out;
+    int nops = 0, root, base, n, i;
+    bool ok = true;
+
+    if (ft_evdb)
+        return (NULL);
+    root = fusecomp(node, ops, &nops);
+    if ((root < 0) || (ops[root].fo_what == FU_LEAF)) {
+        fusefree(ops, nops);
+        return (NULL);
+    }
+    f = &ops[root];
+    out = (double *) tmalloc(f->fo_length * (f->fo_cplx ? 2 : 1) *
+            sizeof (double));
+    buf = (double *) tmalloc(nops * 2 * FU_CHUNK * sizeof (double));
+    for (i = 0; i < nops; i++)
+        ops[i].fo_buf = buf + 2 * FU_CHUNK * i;
+
+#ifdef BSD
+    if (setjmp(matherrbuf)) {
+        (void) signal(SIGILL, SIG_DFL);
+        tfree(buf);
+        tfree(out);
+        fusefree(ops, nops);
+        return (NULL);
+    }
+    (void) signal(SIGILL, sig_matherr);
+#endif
+
+    for (base = 0; ok && (base < f->fo_length); base += FU_CHUNK) {
+        n = f->fo_length - base;
+        if (n > FU_CHUNK)
+            n = FU_CHUNK;
+        for (i = 0; ok && (i <= root); i++) {
+            if (i == root)
+                ops[i].fo_data = out + (f->fo_cplx ? 2 * base : base);
+            else
+                ops[i].fo_data = ops[i].fo_buf;
+            ok = fusestep(ops, &ops[i], base, n);
+        }
+    }
+
+#ifdef BSD
+    (void) signal(SIGILL, SIG_DFL);
+#endif
+
+    tfree(buf);
+    if (!ok) {
+        tfree(out);
+        fusefree(ops, nops);
+        return (NULL);
+    }
+
+    /* The warnings doop() would have given, in the same order. */
+    for (i = 0; i < nops; i++)
+        if (ops[i].fo_warn)
+            fprintf(cp_err, "Warning: scales of %s and %s are different.\n",
+                    ops[ops[i].fo_left].fo_name,
+                    ops[ops[i].fo_right].fo_name);
+
+    res = alloc(dvec);
+    res->v_flags = f->fo_flags;
+    if (f->fo_cplx)
+        res->v_compdata = (complex *) out;
+    else
+        res->v_realdata = out;
+    res->v_name = f->fo_name;
+    res->v_length = f->fo_length;
+    res->v_scale = f->fo_scale;
+
+    v = f->fo_from;
+    res->v_defcolor = v->v_defcolor;
+    res->v_gridtype = v->v_gridtype;
+    res->v_plottype = v->v_plottype;
+    res->v_type = v->v_type;
+    if (f->fo_dims) {
+        res->v_numdims = v->v_numdims;
+        for (i = 0; i < v->v_numdims; i++)
+            res->v_dims[i] = v->v_dims[i];
+    }
+    vec_new(res);
+
+    fusefree(ops, root);
+    return (res);
+}
+
+/* Free the names made for the first nops steps. */
+
+static void
+fusefree(ops, nops)
+    struct fuseop *ops;
+    int nops;
+{
+    int i;
+
+    for (i = 0; i < nops; i++)
+        if (ops[i].fo_what != FU_LEAF)
+            tfree(ops[i].fo_name);
+    return;
+}
@@ -83,11 +83,13 @@ com_fourier(wl)
                 fprintf(cp_err, 
                     "Error: lengths don't match: %d, %d\n",
                         vec->v_length, time->v_length);
+                vec = vec->v_link2;
                 continue;
             }
             if (!isreal(vec)) {
                 fprintf(cp_err, "Error: %s isn't real!\n", 
                         vec->v_name);
+                vec = vec->v_link2;
                 continue;
             }
 
@@ -169,6 +171,10 @@ com_fourier(wl)
                     fw, pn(nmag[i]),
                     fw, pn(nphase[i]));
             fputs("\n", cp_out);
+            if (polydegree) {
+                tfree(grid);
+                tfree(stuff);
+            }
             vec = vec->v_link2;
         }
     }
@@ -232,144 +238,45 @@ CKTfour(ndata,numFreq,thd,Time,Value,FundFreq,Freq,Mag,Phase,nMag,nPhase)
      */
 
 {
-#define DFT
-#ifdef DFT
-/* we are assuming that the caller has provided exactly one period
- * of the fundamental frequency.
- */
-    int i;
-    int j;
+    /* We are assuming that the caller has provided exactly one period
+     * of the fundamental frequency, evenly spaced, so harmonic j is just
+     * bin j of the transform (taken mod ndata, as the direct sum would).
+     */
+    double *re, *im;
     double tmp;
-    /* clear output/computation arrays */
-    for(i=0;i<numFreq;i++) {
-        Mag[i]=0;
-        Phase[i]=0;
+    int i, j;
+
+    re = (double *) tmalloc(ndata * sizeof (double));
+    im = (double *) tmalloc(ndata * sizeof (double));
+    for (i = 0; i < ndata; i++) {
+        re[i] = Value[i];
+        im[i] = 0.0;
     }
-    for(i=0;i<ndata;i++) {
-        for(j=0;j<numFreq;j++) {
-            Mag[j]   += (Value[i]*sin(j*2*PI*i/((double) ndata)));
-            Phase[j] += (Value[i]*cos(j*2*PI*i/((double) ndata)));
-        }
+    if (!ft_fft(re, im, ndata, -1)) {
+        tfree(re);
+        tfree(im);
+        return (E_BADPARM);
     }
-    Mag[0] = Phase[0]/ndata;
+
+    /* Bin j is sum(v cos) - j sum(v sin). */
+    Mag[0] = re[0]/ndata;
     Phase[0]=nMag[0]=nPhase[0]=Freq[0]=0;
     *thd = 0;
     for(i=1;i<numFreq;i++) {
-        tmp = Mag[i]*2.0 /ndata;
-        Phase[i] *= 2.0/ndata;
+        j = i % ndata;
+        tmp = -im[j]*2.0 /ndata;
+        Phase[i] = re[j]*2.0/ndata;
         Freq[i] = i * FundFreq;
         Mag[i] = sqrt(tmp*tmp+Phase[i]*Phase[i]);
         Phase[i] = atan2(Phase[i],tmp)*180/PI;
+    }
+    for(i=1;i<numFreq;i++) {
         nMag[i] = Mag[i]/Mag[1];
         nPhase[i] = Phase[i]-Phase[1];
         if(i>1) *thd += nMag[i]*nMag[i];
     }
     *thd = 100*sqrt(*thd);
+    tfree(re);
+    tfree(im);
     return(OK);
-#else DFT
-    double initial; /*  starting time */
-    double final;   /* final time */
-    double elapsed; /* elapsed time */
-    double tmp;
-    int start=0;
-    int n;
-    int m;
-    int edge;
-
-    *thd = 0;
-    final = Time[ndata-1];
-    initial = Time[0];
-    elapsed = final - initial;
-    if( (elapsed-1/FundFreq)< -.01/FundFreq ){
-        /* not enough data for a full period */
-        return(E_BADPARM);
-    }
-    elapsed = 1/FundFreq;   /* set to desired elapsed time */
-    initial = final - elapsed;  /* set to desired starting time */
-    while(Time[start]<initial) { start++; } /* to find first time in interval*/
-    start++; /* throw away one more point - come back to it later */
-    for(m=0;m<numFreq;m++) {
-        Mag[m]=0;
-        Phase[m]=0;
-    }
-    /* ok - here's the hard part - compute the dft of Data[start::ndata]
-     * temporarily, put the real/imag. parts of the DFT in Mag[] and Phase[]
-     * later we will convert each term to phase-magnitude 
-     */
-
-    for(n=start;n<ndata-1;n++) {
-        for(m=0;m<numFreq;m++) {
-            Mag[m]   += .5 * (Time[n+1]-Time[n-1]) * Value[n] * 
-                    sin(2*PI*m*((Time[n]-initial)/elapsed));
-            Phase[m] += .5 * (Time[n+1]-Time[n-1]) * Value[n] * 
-                    cos(2*PI*m*((Time[n]-initial)/elapsed));
-            /* know Time[n+-1] exists because stop at = ndata-2, */
-            /* and did a start++ earlier - come back and clean up ends later */
-        }
-    }
-    /* now to deal with the endpoints.  The (ndata-1)th point has a smaller 
-     * interval 
-     */
-    for(m=0;m<numFreq;m++) {
-        Mag[m]   += .5 * (Time[n]-Time[n-1]) * Value[n] * 
-                sin(2*PI*m*((Time[n]-initial)/elapsed));
-        Phase[m] += .5 * (Time[n]-Time[n-1]) * Value[n] * 
-                cos(2*PI*m*((Time[n]-initial)/elapsed));
-    }
-    /* now to deal with the start of the interval.  first, deal with
-     * the start-1'th point - exactly the same regardless of case 
-     * because of the extra start++ earlier.
-     */
-    for(m=0;m<numFreq;m++) {
-        Mag[m]   += .5 * (Time[start]-initial) * Value[start-1] * 
-                sin(2*PI*m*((Time[start-1]-initial)/elapsed));
-        Phase[m] += .5 * (Time[start]-initial) * Value[start-1] * 
-                cos(2*PI*m*((Time[start-1]-initial)/elapsed));
-    }
-    /* now deal with the possibility that the above point, which was
-     * the first one contained within the interval may have been
-     * inside the interval, or ON the boundry - in the latter case,
-     * we don't want to deal with the previous point at all.
-     */
-    if(Time[start-1]> initial) {
-        /* interesting case - need to handle previous point */
-        /* first, make sure that there is a point on the other side of
-         * the beginning of time.
-         */
-        if(start-2 < 0) { 
-            /* point doesn't exist, so we have to fudge
-             * things slightly - by bumping edge up, we re-use the first
-             * point in the interval for the last point before the 
-             * interval - should be only for very small error in
-             * interval boundaries, so shouldn't be significant, and is
-             * better than ignoring the interval
-             */
-            edge = start-1;
-        } else {
-            edge = start-2;
-        }
-        for(m=0;m<numFreq;m++) {
-            Mag[m]   += .5 * (Time[start-1]-initial) * Value[edge] * 
-                    sin(2*PI*m*((Time[edge]-initial)/elapsed));
-            Phase[m] += .5 * (Time[start-1]-initial) * Value[edge] * 
-                    cos(2*PI*m*((Time[edge]-initial)/elapsed));
-        }
-    }
-    
-    Mag[0]=Phase[0]/elapsed;
-    Phase[0]=nMag[0]=nPhase[0]=Freq[0]=0;
-
-    for(m=1;m<numFreq;m++) {
-        tmp = Mag[m] * 2.0 / (elapsed);
-        Phase[m] *= 2.0 / (elapsed);
-        Freq[m] = m * FundFreq;
-        Mag[m] = sqrt(tmp * tmp + Phase[m] * Phase[m]);
-        Phase[m] = atan2(Phase[m],tmp) * 180/PI;
-        nMag[m] = Mag[m] / Mag[1];
-        nPhase[m] = Phase[m] - Phase[1];
-        if(m>1) *thd += nMag[m] * nMag[m];
-    }
-    *thd = 100 * sqrt(*thd);
-    return(OK);
-#endif /*DFT*/
 }
@@ -611,7 +611,7 @@ inp_spsource(fp, comfile, filename)
                 if (eq(s, ".width") || ciprefix(".four", s) ||
                         eq(s, ".plot") || 
                         eq(s, ".print") ||
-                        eq(s, ".save")) {
+                        eq(s, ".save") || ciprefix(".meas", s)) {
                     if (end) {
                         end->wl_next = alloc(wordlist);
                         end->wl_next->wl_prev = end;
@@ -0,0 +1,696 @@
+
+/*
+ * The .measure cards.  These are turned into little state machines when
+ * an analysis starts its output, and each point is fed to them as it is
+ * handed to OUTpData, so the answers are there at the end of the run
+ * whether or not the waveforms they came from were saved.
+ *
+ * The forms understood are
+ *   .measure type name TRIG sig VAL=v [TD=t] [RISE=n|FALL=n|CROSS=n]
+ *                      TARG sig VAL=v [TD=t] [RISE=n|FALL=n|CROSS=n]
+ *   .measure type name WHEN sig=v [TD=t] [RISE=n|FALL=n|CROSS=n]
+ *   .measure type name FIND sig WHEN sig=v [TD=t] [RISE=n|FALL=n|CROSS=n]
+ *   .measure type name FIND sig AT=t
+ *   .measure type name AVG|RMS|MIN|MAX|PP|INTEG sig [FROM=t] [TO=t]
+ * where type is tran, ac, dc or op, and sig is a node, v(node),
+ * v(node,node) or i(vsource).  TRIG and TARG may also be given as AT=t.
+ * AC values are magnitudes.
+ */
+
+#include "prefix.h"
+#include "CPdefs.h"
+#include "FTEdefs.h"
+#include "FTEdata.h"
+#include "IFsim.h"
+#include "util.h"
+#include "suffix.h"
+
+#define MK_TRIGTARG 1
+#define MK_WHEN     2
+#define MK_FINDWHEN 3
+#define MK_FINDAT   4
+#define MK_AVG      5
+#define MK_RMS      6
+#define MK_INTEG    7
+#define MK_MIN      8
+#define MK_MAX      9
+#define MK_PP       10
+
+/* A signal is the difference of two entries in the output vector, either
+ * of which may be -1 for ground.
+ */
+
+struct msig {
+    int ms_pos;
+    int ms_neg;
+};
+
+/* A crossing of a level, or just a fixed point on the scale. */
+
+struct mcross {
+    struct msig mc_sig;
+    double mc_val;      /* The level. */
+    double mc_td;       /* Crossings before this don't count. */
+    double mc_at;       /* The point, if it is fixed. */
+    bool mc_fixed;
+    int mc_dir;         /* 1 for rise, -1 for fall, 0 for either. */
+    int mc_count;       /* Which one we want... */
+    int mc_seen;        /* ... and how many we've had. */
+    double mc_last;     /* The signal at the last point. */
+    bool mc_found;
+    double mc_when;
+};
+
+struct measure {
+    char *me_name;
+    int me_kind;
+    struct msig me_sig;         /* What is found or summed. */
+    struct mcross me_trig;      /* Also the WHEN or AT of a FIND. */
+    struct mcross me_targ;
+    double me_from, me_to;      /* The window for the statistics. */
+    int me_reftype;             /* IF_REAL, IF_COMPLEX, or 0 if none. */
+    bool me_complex;
+    bool me_started;
+    bool me_seen;               /* Anything inside the window yet? */
+    bool me_done;
+    double me_lastref;
+    double me_lastval;
+    double me_sum, me_sum2, me_span;
+    double me_min, me_max;
+    double me_result;
+    struct measure *me_next;
+};
+
+static char *meastok();
+static bool measnum();
+static bool measnode();
+static bool meassig();
+static bool meascross();
+static struct measure *measparse();
+static double measval();
+static bool measstep();
+static void measwindow();
+
+/* Make up the measurements for an analysis that is about to start.
+ * coms are the dot cards of the circuit, and names and type describe
+ * the vector that OUTpData will be given.  Cards for other analyses are
+ * skipped, and cards we can't make sense of are complained about and
+ * then forgotten.
+ */
+
+struct measure *
+ft_measinit(coms, analname, reftype, numnames, names, type)
+    wordlist *coms;
+    char *analname;
+    int reftype;
+    int numnames;
+    char **names;
+    int type;
+{
+    struct measure *list = NULL, *end = NULL, *me;
+    char *abbrev, *s, *t;
+    bool ours;
+
+    if (!(abbrev = ft_plotabbrev(analname)))
+        return (NULL);
+    for (; coms; coms = coms->wl_next) {
+        if (!ciprefix(".meas", coms->wl_word))
+            continue;
+        s = coms->wl_word;
+        t = meastok(&s);
+        tfree(t);
+        if (!(t = meastok(&s)))
+            continue;
+        ours = cieq(t, abbrev);
+        tfree(t);
+        if (!ours)
+            continue;
+        if (!(me = measparse(s, numnames, names))) {
+            fprintf(cp_err, "Warning: bad card ignored: %s\n",
+                    coms->wl_word);
+            continue;
+        }
+        me->me_reftype = reftype;
+        me->me_complex = (type == IF_COMPLEX) ? true : false;
+        if (end)
+            end->me_next = me;
+        else
+            list = me;
+        end = me;
+    }
+    return (list);
+}
+
+/* Give the measurements one more point. */
+
+void
+ft_measpoint(list, refValue, valuePtr, count)
+    struct measure *list;
+    IFvalue *refValue;
+    IFvalue *valuePtr;
+    int count;
+{
+    struct measure *me;
+    double ref, val;
+    bool found;
+
+    for (me = list; me; me = me->me_next) {
+        if (me->me_done)
+            continue;
+        if (me->me_reftype == IF_COMPLEX)
+            ref = refValue->cValue.real;
+        else if (me->me_reftype)
+            ref = refValue->rValue;
+        else
+            ref = count - 1;
+
+        switch (me->me_kind) {
+          case MK_TRIGTARG:
+            if (!me->me_trig.mc_found)
+                (void) measstep(me, &me->me_trig, ref, valuePtr);
+            if (!me->me_targ.mc_found)
+                (void) measstep(me, &me->me_targ, ref, valuePtr);
+            if (me->me_trig.mc_found && me->me_targ.mc_found) {
+                me->me_result = me->me_targ.mc_when -
+                        me->me_trig.mc_when;
+                me->me_done = true;
+            }
+            break;
+
+          case MK_WHEN:
+            if (measstep(me, &me->me_trig, ref, valuePtr)) {
+                me->me_result = me->me_trig.mc_when;
+                me->me_done = true;
+            }
+            break;
+
+          case MK_FINDWHEN:
+          case MK_FINDAT:
+            val = measval(&me->me_sig, me->me_complex, valuePtr);
+            found = measstep(me, &me->me_trig, ref, valuePtr);
+            if (found) {
+                if (!me->me_started || (ref == me->me_lastref))
+                    me->me_result = val;
+                else
+                    me->me_result = me->me_lastval + (val -
+                            me->me_lastval) * (me->me_trig.mc_when -
+                            me->me_lastref) / (ref - me->me_lastref);
+                me->me_done = true;
+            }
+            me->me_lastval = val;
+            break;
+
+          default:
+            val = measval(&me->me_sig, me->me_complex, valuePtr);
+            measwindow(me, ref, val);
+            me->me_lastval = val;
+            if (ref >= me->me_to)
+                me->me_done = true;
+            break;
+        }
+        me->me_lastref = ref;
+        me->me_started = true;
+    }
+    return;
+}
+
+/* The analysis is over.  Print the results, and if there is a plot stick
+ * each of them in it as a vector of length one.  Then throw the lot away.
+ */
+
+void
+ft_measend(list, pl)
+    struct measure *list;
+    struct plot *pl;
+{
+    struct measure *me;
+    struct dvec *v;
+
+    while (me = list) {
+        list = me->me_next;
+        switch (me->me_kind) {
+          case MK_AVG:
+          case MK_RMS:
+          case MK_INTEG:
+            me->me_done = me->me_seen;
+            if (!me->me_seen)
+                break;
+            if (me->me_kind == MK_INTEG)
+                me->me_result = me->me_sum;
+            else if (me->me_span == 0.0)
+                /* Only the one point - it's its own average. */
+                me->me_result = (me->me_kind == MK_AVG) ? me->me_min :
+                        FABS(me->me_min);
+            else if (me->me_kind == MK_AVG)
+                me->me_result = me->me_sum / me->me_span;
+            else
+                me->me_result = sqrt(me->me_sum2 / me->me_span);
+            break;
+          case MK_MIN:
+          case MK_MAX:
+          case MK_PP:
+            me->me_done = me->me_seen;
+            if (!me->me_seen)
+                break;
+            if (me->me_kind == MK_MIN)
+                me->me_result = me->me_min;
+            else if (me->me_kind == MK_MAX)
+                me->me_result = me->me_max;
+            else
+                me->me_result = me->me_max - me->me_min;
+            break;
+        }
+
+        if (me->me_done) {
+            fprintf(cp_out, "%-20s = %s\n", me->me_name,
+                    printnum(me->me_result));
+            if (pl) {
+                v = alloc(dvec);
+                v->v_name = copy(me->me_name);
+                v->v_type = SV_NOTYPE;
+                v->v_flags = VF_REAL | VF_PERMANENT;
+                v->v_realdata = (double *) tmalloc(sizeof (double));
+                v->v_realdata[0] = me->me_result;
+                v->v_length = 1;
+                v->v_plot = pl;
+                vec_new(v);
+            }
+        } else
+            fprintf(cp_err, "Warning: measurement %s failed\n",
+                    me->me_name);
+        tfree(me->me_name);
+        tfree(me);
+    }
+    return;
+}
+
+/* Parse the rest of a card, after the analysis type. */
+
+static struct measure *
+measparse(s, numnames, names)
+    char *s;
+    int numnames;
+    char **names;
+{
+    struct measure *me = alloc(measure);
+    char *kind = NULL, *t = NULL;
+
+    me->me_from = -HUGE;
+    me->me_to = HUGE;
+    if (!(me->me_name = meastok(&s)) || !(kind = meastok(&s)))
+        goto bad;
+
+    if (cieq(kind, "trig")) {
+        me->me_kind = MK_TRIGTARG;
+        if (!meascross(&s, &me->me_trig, numnames, names))
+            goto bad;
+        if (!(t = meastok(&s)) || !cieq(t, "targ"))
+            goto bad;
+        tfree(t);
+        if (!meascross(&s, &me->me_targ, numnames, names))
+            goto bad;
+    } else if (cieq(kind, "when")) {
+        me->me_kind = MK_WHEN;
+        if (!meascross(&s, &me->me_trig, numnames, names))
+            goto bad;
+    } else if (cieq(kind, "find")) {
+        if (!meassig(&s, &me->me_sig, numnames, names))
+            goto bad;
+        if (!(t = meastok(&s)))
+            goto bad;
+        if (cieq(t, "when"))
+            me->me_kind = MK_FINDWHEN;
+        else if (cieq(t, "at")) {
+            me->me_kind = MK_FINDAT;
+            me->me_trig.mc_fixed = true;
+            if (!measnum(&s, &me->me_trig.mc_at))
+                goto bad;
+        } else
+            goto bad;
+        tfree(t);
+        if ((me->me_kind == MK_FINDWHEN) && !meascross(&s, &me->me_trig,
+                numnames, names))
+            goto bad;
+    } else {
+        if (cieq(kind, "avg"))
+            me->me_kind = MK_AVG;
+        else if (cieq(kind, "rms"))
+            me->me_kind = MK_RMS;
+        else if (cieq(kind, "integ") || cieq(kind, "integral"))
+            me->me_kind = MK_INTEG;
+        else if (cieq(kind, "min"))
+            me->me_kind = MK_MIN;
+        else if (cieq(kind, "max"))
+            me->me_kind = MK_MAX;
+        else if (cieq(kind, "pp"))
+            me->me_kind = MK_PP;
+        else
+            goto bad;
+        if (!meassig(&s, &me->me_sig, numnames, names))
+            goto bad;
+        while (t = meastok(&s)) {
+            if (cieq(t, "from")) {
+                if (!measnum(&s, &me->me_from))
+                    goto bad;
+            } else if (cieq(t, "to")) {
+                if (!measnum(&s, &me->me_to))
+                    goto bad;
+            } else
+                goto bad;
+            tfree(t);
+        }
+    }
+    if (t = meastok(&s))
+        goto bad;
+    tfree(kind);
+    return (me);
+
+bad:
+    tfree(t);
+    tfree(kind);
+    tfree(me->me_name);
+    tfree(me);
+    return (NULL);
+}
+
+/* Parse "sig VAL=v ..." for TRIG or TARG, "sig=v ..." for WHEN, or
+ * "AT=t" for either.  We stop at the first word that isn't ours.
+ */
+
+static bool
+meascross(s, mc, numnames, names)
+    char **s;
+    struct mcross *mc;
+    int numnames;
+    char **names;
+{
+    char *t, *save;
+    double d;
+
+    mc->mc_td = -HUGE;
+    mc->mc_count = 1;
+    save = *s;
+    if (!(t = meastok(s)))
+        return (false);
+    if (cieq(t, "at")) {
+        tfree(t);
+        mc->mc_fixed = true;
+        return (measnum(s, &mc->mc_at));
+    }
+    tfree(t);
+    *s = save;
+    if (!meassig(s, &mc->mc_sig, numnames, names))
+        return (false);
+
+    for (;;) {
+        save = *s;
+        if (!(t = meastok(s)))
+            break;
+        if (eq(t, "=") || cieq(t, "val")) {
+            if (eq(t, "="))
+                *s = save;
+            tfree(t);
+            if (!measnum(s, &mc->mc_val))
+                return (false);
+            continue;
+        }
+        if (!cieq(t, "td") && !cieq(t, "rise") && !cieq(t, "fall") &&
+                !cieq(t, "cross")) {
+            tfree(t);
+            *s = save;
+            break;
+        }
+        if (!measnum(s, &d)) {
+            tfree(t);
+            return (false);
+        }
+        if (cieq(t, "td"))
+            mc->mc_td = d;
+        else {
+            mc->mc_count = d;
+            if (cieq(t, "rise"))
+                mc->mc_dir = 1;
+            else if (cieq(t, "fall"))
+                mc->mc_dir = -1;
+            else
+                mc->mc_dir = 0;
+        }
+        tfree(t);
+    }
+    return ((mc->mc_count > 0) ? true : false);
+}
+
+/* Look for the crossing in the step to ref from the last point.  Returns
+ * true once the one we want has turned up, with mc_when set.
+ */
+
+static bool
+measstep(me, mc, ref, valuePtr)
+    struct measure *me;
+    struct mcross *mc;
+    double ref;
+    IFvalue *valuePtr;
+{
+    double v, v0, t;
+
+    if (mc->mc_fixed) {
+        if (!me->me_started) {
+            if (mc->mc_at > ref)
+                return (false);
+            mc->mc_when = ref;
+        } else if ((mc->mc_at > me->me_lastref) && (mc->mc_at <= ref))
+            mc->mc_when = mc->mc_at;
+        else
+            return (false);
+        mc->mc_found = true;
+        return (true);
+    }
+
+    v = measval(&mc->mc_sig, me->me_complex, valuePtr);
+    v0 = mc->mc_last;
+    mc->mc_last = v;
+    if (!me->me_started)
+        return (false);
+    if ((v0 < mc->mc_val) && (v >= mc->mc_val)) {
+        if (mc->mc_dir == -1)
+            return (false);
+    } else if ((v0 > mc->mc_val) && (v <= mc->mc_val)) {
+        if (mc->mc_dir == 1)
+            return (false);
+    } else
+        return (false);
+
+    t = me->me_lastref + (mc->mc_val - v0) * (ref - me->me_lastref) /
+            (v - v0);
+    if (t < mc->mc_td)
+        return (false);
+    if (++mc->mc_seen < mc->mc_count)
+        return (false);
+    mc->mc_when = t;
+    mc->mc_found = true;
+    return (true);
+}
+
+/* Add the part of the step from the last point to (ref, val) that is
+ * inside the window to the statistics.  The integrals are trapezoidal,
+ * with the ends of the step pulled in to the window by interpolation.
+ */
+
+static void
+measwindow(me, ref, val)
+    struct measure *me;
+    double ref, val;
+{
+    double a, b, va, vb, r0, v0;
+
+    if (!me->me_started) {
+        if ((ref < me->me_from) || (ref > me->me_to))
+            return;
+        a = b = ref;
+        va = vb = val;
+    } else {
+        r0 = me->me_lastref;
+        v0 = me->me_lastval;
+        a = MAX(r0, me->me_from);
+        b = MIN(ref, me->me_to);
+        if (b < a)
+            return;
+        if (ref == r0) {
+            va = vb = val;
+        } else {
+            va = v0 + (val - v0) * (a - r0) / (ref - r0);
+            vb = v0 + (val - v0) * (b - r0) / (ref - r0);
+        }
+        me->me_sum += (va + vb) / 2 * (b - a);
+        me->me_sum2 += (va * va + vb * vb) / 2 * (b - a);
+        me->me_span += b - a;
+    }
+    if (!me->me_seen) {
+        me->me_min = me->me_max = va;
+        me->me_seen = true;
+    }
+    if (va < me->me_min)
+        me->me_min = va;
+    if (va > me->me_max)
+        me->me_max = va;
+    if (vb < me->me_min)
+        me->me_min = vb;
+    if (vb > me->me_max)
+        me->me_max = vb;
+    return;
+}
+
+static double
+measval(ms, cplx, valuePtr)
+    struct msig *ms;
+    bool cplx;
+    IFvalue *valuePtr;
+{
+    double re = 0.0, im = 0.0;
+
+    if (!cplx) {
+        if (ms->ms_pos >= 0)
+            re = valuePtr->v.vec.rVec[ms->ms_pos];
+        if (ms->ms_neg >= 0)
+            re -= valuePtr->v.vec.rVec[ms->ms_neg];
+        return (re);
+    }
+    if (ms->ms_pos >= 0) {
+        re = valuePtr->v.vec.cVec[ms->ms_pos].real;
+        im = valuePtr->v.vec.cVec[ms->ms_pos].imag;
+    }
+    if (ms->ms_neg >= 0) {
+        re -= valuePtr->v.vec.cVec[ms->ms_neg].real;
+        im -= valuePtr->v.vec.cVec[ms->ms_neg].imag;
+    }
+    return (sqrt(re * re + im * im));
+}
+
+/* Turn node, v(node), v(node,node) or i(source) into indices in the
+ * output vector.
+ */
+
+static bool
+meassig(s, ms, numnames, names)
+    char **s;
+    struct msig *ms;
+    int numnames;
+    char **names;
+{
+    char *t, *n1, *n2, *p, buf[BSIZE];
+    bool ok;
+
+    if (!(t = meastok(s)))
+        return (false);
+    ms->ms_neg = -1;
+    n2 = NULL;
+    if ((p = index(t, '(')) && (t[strlen(t) - 1] == ')')) {
+        t[strlen(t) - 1] = '\0';
+        for (n1 = p + 1; isspace(*n1); n1++)
+            ;
+        if (n2 = index(n1, ',')) {
+            *n2++ = '\0';
+            while (isspace(*n2))
+                n2++;
+        }
+        for (p = n1 + strlen(n1); (p > n1) && isspace(p[-1]); p--)
+            ;
+        *p = '\0';
+        if ((*t == 'i') || (*t == 'I')) {
+            (void) sprintf(buf, "%s#branch", n1);
+            n1 = buf;
+        }
+    } else
+        n1 = t;
+
+    ok = measnode(n1, numnames, names, &ms->ms_pos);
+    if (ok && n2)
+        ok = measnode(n2, numnames, names, &ms->ms_neg);
+    if (!ok)
+        fprintf(cp_err, "Error: no such vector %s\n", n1);
+    tfree(t);
+    return (ok);
+}
+
+static bool
+measnode(name, numnames, names, ind)
+    char *name;
+    int numnames;
+    char **names;
+    int *ind;
+{
+    int i;
+
+    if (eq(name, "0") || cieq(name, "gnd")) {
+        *ind = -1;
+        return (true);
+    }
+    for (i = 0; i < numnames; i++)
+        if (cieq(name, names[i])) {
+            *ind = i;
+            return (true);
+        }
+    return (false);
+}
+
+/* Read "= number". */
+
+static bool
+measnum(s, d)
+    char **s;
+    double *d;
+{
+    char *t, *p;
+    double *dd;
+
+    if (!(t = meastok(s)))
+        return (false);
+    if (!eq(t, "=")) {
+        tfree(t);
+        return (false);
+    }
+    tfree(t);
+    if (!(t = meastok(s)))
+        return (false);
+    p = t;
+    if (dd = ft_numparse(&p, true))
+        *d = *dd;
+    tfree(t);
+    return (dd ? true : false);
+}
+
+/* The next word.  An = is a word by itself, commas are white space, and
+ * anything inside parentheses sticks together.
+ */
+
+static char *
+meastok(s)
+    char **s;
+{
+    char *t = *s, *start, *w;
+    int depth = 0;
+
+    while (isspace(*t) || (*t == ','))
+        t++;
+    if (!*t) {
+        *s = t;
+        return (NULL);
+    }
+    start = t;
+    if (*t == '=')
+        t++;
+    else
+        while (*t && (depth || (!isspace(*t) && (*t != '=') &&
+                (*t != ',')))) {
+            if (*t == '(')
+                depth++;
+            else if ((*t == ')') && depth)
+                depth--;
+            t++;
+        }
+    *s = t;
+    w = tmalloc(t - start + 1);
+    (void) strncpy(w, start, t - start);
+    w[t - start] = '\0';
+    return (w);
+}
@@ -0,0 +1,240 @@
+
+/*
+ * Parameter variations for Monte Carlo runs.  The "vary" command records
+ * which device or model parameters are to be perturbed, and by how much.
+ * The "mc" command (in runcoms.c) parses and sets up the circuit once
+ * (or, with event-driven instances or when a varied parameter decides
+ * what the setup builds, before every run) and then calls ft_mcperturb
+ * before each run to pick new values.
+ */
+
+#include "prefix.h"
+#include "CPdefs.h"
+#include "FTEdefs.h"
+#include "util.h"
+#include "suffix.h"
+
+static double mcgauss();
+static double mcuniform();
+static void mcfreevar();
+
+/* mcgauss makes its deviates in pairs, and keeps the second here. */
+static bool mcsaved = false;
+static double mcnext;
+
+/* Usage is
+ *   vary name parm sigma [uniform]
+ * where name is a device or a model, and sigma is the relative standard
+ * deviation of parm (or the relative half-width of the range if uniform
+ * is given).  With no arguments, the variations of the current circuit
+ * are listed, and "vary clear" throws them away.
+ */
+
+void
+com_vary(wl)
+    wordlist *wl;
+{
+    struct mcvar *mv, *last;
+    double *dd;
+    char *s;
+
+    if (!ft_curckt) {
+        fprintf(cp_err, "Error: no circuit loaded\n");
+        return;
+    }
+    if (wl == NULL) {
+        if (ft_curckt->ci_vary == NULL) {
+            fprintf(cp_out, "No parameter variations.\n");
+            return;
+        }
+        for (mv = ft_curckt->ci_vary; mv; mv = mv->mv_next)
+            fprintf(cp_out, "\t%-12s %-12s %g %s\n", mv->mv_name,
+                    mv->mv_parm, mv->mv_sigma,
+                    mv->mv_uniform ? "uniform" : "gauss");
+        return;
+    }
+    if (eq(wl->wl_word, "clear") && (wl->wl_next == NULL)) {
+        while (ft_curckt->ci_vary) {
+            mv = ft_curckt->ci_vary->mv_next;
+            tfree(ft_curckt->ci_vary->mv_name);
+            tfree(ft_curckt->ci_vary->mv_parm);
+            tfree(ft_curckt->ci_vary);
+            ft_curckt->ci_vary = mv;
+        }
+        return;
+    }
+    if (!wl->wl_next || !wl->wl_next->wl_next) {
+        fprintf(cp_err, "Usage: vary name parm sigma [uniform]\n");
+        return;
+    }
+    s = wl->wl_next->wl_next->wl_word;
+    if (!(dd = ft_numparse(&s, false)) || (*dd < 0.0)) {
+        fprintf(cp_err, "Error: bad deviation %s\n",
+                wl->wl_next->wl_next->wl_word);
+        return;
+    }
+
+    mv = alloc(mcvar);
+    mv->mv_name = copy(wl->wl_word);
+    inp_casefix(mv->mv_name);
+    mv->mv_parm = copy(wl->wl_next->wl_word);
+    mv->mv_sigma = *dd;
+    wl = wl->wl_next->wl_next->wl_next;
+    if (wl && eq(wl->wl_word, "uniform"))
+        mv->mv_uniform = true;
+    else if (wl && !eq(wl->wl_word, "gauss"))
+        fprintf(cp_err, "Warning: unknown distribution %s, using gauss\n",
+                wl->wl_word);
+
+    /* Keep them in the order given. */
+    if (ft_curckt->ci_vary) {
+        for (last = ft_curckt->ci_vary; last->mv_next; last = last->mv_next)
+            ;
+        last->mv_next = mv;
+    } else
+        ft_curckt->ci_vary = mv;
+    return;
+}
+
+/* Find the nominal values of all the varied parameters in the freshly
+ * parsed circuit.  Returns false if any of them can't be found.
+ */
+
+bool
+ft_mcnominal(ci)
+    struct circ *ci;
+{
+    struct mcvar *mv;
+    struct variable *v;
+    char *name;
+
+    for (mv = ci->ci_vary; mv; mv = mv->mv_next) {
+        /* The symbol table takes the copy, or frees it if the name is
+         * already there.
+         */
+        name = copy(mv->mv_name);
+        v = if_getparam(ci->ci_ckt, &name, mv->mv_parm, 0);
+        if (v == NULL)
+            return (false);
+        if (v->va_type == VT_REAL)
+            mv->mv_nominal = v->va_real;
+        else if (v->va_type == VT_NUM)
+            mv->mv_nominal = v->va_num;
+        else {
+            fprintf(cp_err, "Error: %s of %s is not a number.\n",
+                    mv->mv_parm, mv->mv_name);
+            mcfreevar(v);
+            return (false);
+        }
+        mcfreevar(v);
+    }
+    return (true);
+}
+
+/* Start a new set of runs, before the random numbers are seeded: a
+ * deviate left from the last set would not come from the new seed.
+ */
+
+void
+ft_mcstart()
+{
+    mcsaved = false;
+    return;
+}
+
+/* Pick a new value for each of the varied parameters. */
+
+void
+ft_mcperturb(ci)
+    struct circ *ci;
+{
+    struct mcvar *mv;
+
+    for (mv = ci->ci_vary; mv; mv = mv->mv_next) {
+        if (mv->mv_uniform)
+            mv->mv_value = mv->mv_nominal * (1.0 + mv->mv_sigma *
+                    (2.0 * mcuniform() - 1.0));
+        else
+            mv->mv_value = mv->mv_nominal * (1.0 + mv->mv_sigma *
+                    mcgauss());
+    }
+    ft_mcredo(ci);
+    return;
+}
+
+/* Set the values last picked, again if the deck has been reparsed. */
+
+void
+ft_mcredo(ci)
+    struct circ *ci;
+{
+    struct mcvar *mv;
+    struct variable var;
+
+    var.va_type = VT_REAL;
+    var.va_next = NULL;
+    for (mv = ci->ci_vary; mv; mv = mv->mv_next) {
+        var.va_real = mv->mv_value;
+        if_setparam(ci->ci_ckt, mv->mv_name, mv->mv_parm, &var);
+    }
+    return;
+}
+
+/* Put the nominal values back. */
+
+void
+ft_mcrestore(ci)
+    struct circ *ci;
+{
+    struct mcvar *mv;
+    struct variable var;
+
+    var.va_type = VT_REAL;
+    var.va_next = NULL;
+    for (mv = ci->ci_vary; mv; mv = mv->mv_next) {
+        var.va_real = mv->mv_nominal;
+        if_setparam(ci->ci_ckt, mv->mv_name, mv->mv_parm, &var);
+    }
+    return;
+}
+
+/* Free a value returned by if_getparam. */
+
+static void
+mcfreevar(v)
+    struct variable *v;
+{
+    if (v->va_type == VT_STRING)
+        tfree(v->va_string);
+    tfree(v->va_name);
+    tfree(v);
+    return;
+}
+
+/* A uniform deviate in (0, 1]. */
+
+static double
+mcuniform()
+{
+    return (((double) random() + 1.0) / 2147483648.0);
+}
+
+/* A normal deviate, by the Box-Muller method.  The second value of each
+ * pair is saved for the next call.
+ */
+
+static double
+mcgauss()
+{
+    double r, t;
+
+    if (mcsaved) {
+        mcsaved = false;
+        return (mcnext);
+    }
+    r = sqrt(-2.0 * log(mcuniform()));
+    t = 2.0 * PI * mcuniform();
+    mcnext = r * sin(t);
+    mcsaved = true;
+    return (r * cos(t));
+}
@@ -46,6 +46,7 @@ int OUTattributes() {}
 /* ARGSUSED */ void if_option(ckt, name, type, value) char *name, *ckt, *value;
         int type; { }
 /* ARGSUSED */ void if_cktfree(ckt, tab) char *ckt, *tab; { }
+/* ARGSUSED */ bool if_canrerun(ckt) char *ckt; { return (false); }
 /* ARGSUSED */ void if_setndnames(line) char *line; { }
 /* ARGSUSED */ char * if_errstring(code) { return ("spice error"); }
 /* ARGSUSED */ struct variable * if_getparam(ckt, name, param, ind)
@@ -102,6 +103,7 @@ static IFsimulator SIMinfo = {
     NULL,           /* deleteTask function */
 
     NULL,           /* doAnalyses function */
+    NULL,           /* snapshot function */
 
     0,
     NULL,
@@ -409,6 +409,7 @@ char *ft_setkwords[] = {
     "curplottitle",
     "curplotdate",
     "debug",
+    "deckcache",
     "defad",
     "defas",
     "defl",
@@ -417,6 +418,7 @@ char *ft_setkwords[] = {
     "display",
     "dontplot",
     "editor",
+    "fftsize",
     "filetype",
     "fourgridsize",
     "geometry",
@@ -427,6 +429,7 @@ char *ft_setkwords[] = {
     "height",
     "history",
     "ignoreeof",
+    "incremental",
     "itl1",
     "itl2",
     "itl3",
@@ -452,6 +455,8 @@ char *ft_setkwords[] = {
     "nosort",
     "nosubckt",
     "numdgt",
+    "opsnap",
+    "opsnapaccept",
     "opts",
     "pivrel",
     "pivtol",
@@ -467,8 +472,11 @@ char *ft_setkwords[] = {
     "renumber",
     "rhost",
     "rprogram",
+    "shmout",
+    "shmpoints",
     "slowplot",
     "sourcepath",
+    "specwindow",
     "spicepath",
     "subend",
     "subinvoke",
@@ -593,6 +593,8 @@ struct func ft_funcs[] = {
         { "unitvec",    cx_unitvec } ,
         { "length", cx_length } ,
         { "interpolate",cx_interpolate } ,
+        { "fft",    cx_fft } ,
+        { "ifft",   cx_ifft } ,
         { "v",      NULL } ,
         { NULL,     NULL }
 } ;
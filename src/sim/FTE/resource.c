@@ -26,6 +26,7 @@
 #include "suffix.h"
 
 extern edata;
+extern int MIFauto_stats();
 
 static void printres();
 
@@ -202,6 +203,19 @@ printres(name)
         }
     }
 
+    /* Code models paying for partials by divided differences */
+    if ((!name || eq(name, "autopartial")) && ft_curckt &&
+            ft_curckt->ci_ckt) {
+        if (!name)
+            (void) putc('\n', cp_out);
+        if (MIFauto_stats(ft_curckt->ci_ckt, cp_out) > 0)
+            yy = true;
+        else if (name) {
+            fprintf(cp_out, "No code model partials by divided differences.\n");
+            yy = true;
+        }
+    }
+
     if (!yy) {
         fprintf(cp_err, "Error: no rusage information on %s,\n", name);
         fprintf(cp_err, "\tor no active circuit available\n");
@@ -135,6 +135,7 @@ dosim(what, wl)
     bool dofile = false;
     char buf[BSIZE];
     struct circ *ct;
+    struct altvar *alters;
     bool ascii = true;
 /*  bool oct = false;   */
 
@@ -182,8 +183,24 @@ dosim(what, wl)
         ft_setflag = false;
         return;
     }
-    if (ft_curckt->ci_runonce)
-        com_rset((wordlist *) NULL);
+    /* With incremental set, a circuit that has been run keeps its
+     * setup, and if_run only updates what has been altered since.
+     * Otherwise, and for circuits if_run can't rerun, reparse the deck
+     * - incremental still keeps the alterations then, by doing them
+     * again.
+     */
+    if (ft_curckt->ci_runonce && (eq(what, "sens") ||
+            !cp_getvar("incremental", VT_BOOL, (char *) NULL) ||
+            !if_canrerun(ft_curckt->ci_ckt))) {
+        if (cp_getvar("incremental", VT_BOOL, (char *) NULL)) {
+            alters = ft_curckt->ci_alters;
+            ft_curckt->ci_alters = NULL;
+            com_rset((wordlist *) NULL);
+            ft_curckt->ci_alters = alters;
+            ft_altredo(ft_curckt);
+        } else
+            com_rset((wordlist *) NULL);
+    }
 
     /* From now on until the next prompt, an interrupt will just
      * set a flag and let spice finish up, then control will be
@@ -293,6 +310,116 @@ ft_dorun(file)
     return;
 }
 
+/* Usage is mc nruns [rawfile].  Carry out the analyses in the input file
+ * nruns times, changing the parameters given with the vary command before
+ * each run.  The circuit is parsed and set up only for the first run, the
+ * later ones reuse the matrix and only redo the temperature dependent
+ * setup - unless it has event-driven instances, which need the deck
+ * reparsed for each run.  If a rawfile is given, all the runs go into it,
+ * one plot after another.  The variable mcseed seeds the random number
+ * generator.
+ */
+
+void
+com_mc(wl)
+    wordlist *wl;
+{
+    char buf[BSIZE];
+    char *s;
+    double *dd;
+    int nruns, i, seed;
+    bool ascii = true, rerun;
+
+    if (!ft_curckt) {
+        fprintf(cp_err, "Error: there aren't any circuits loaded.\n");
+        return;
+    } else if (ft_curckt->ci_ckt == NULL) {
+        fprintf(cp_err, "Error: circuit not parsed.\n");
+        return;
+    }
+    s = wl->wl_word;
+    if (!(dd = ft_numparse(&s, false)) || (*dd < 1.0)) {
+        fprintf(cp_err, "Error: bad number of runs %s\n", wl->wl_word);
+        return;
+    }
+    nruns = *dd;
+    if (ft_curckt->ci_vary == NULL)
+        fprintf(cp_err, "Warning: no parameters to vary.\n");
+    ft_mcstart();
+    if (cp_getvar("mcseed", VT_NUM, (char *) &seed))
+        srandom(seed);
+    if (cp_getvar("filetype", VT_STRING, buf)) {
+        if (eq(buf, "binary"))
+            ascii = false;
+        else if (!eq(buf, "ascii"))
+            fprintf(cp_err, "Warning: strange file type %s\n",
+                    buf);
+    }
+
+    /* Start from a freshly parsed circuit, so the nominal values are
+     * the ones in the deck.
+     */
+    if (ft_curckt->ci_inprogress) {
+        fprintf(cp_err, "Warning: losing old state for circuit '%s'\n",
+                ft_curckt->ci_name);
+        ft_curckt->ci_inprogress = false;
+    }
+    if (ft_curckt->ci_runonce)
+        com_rset((wordlist *) NULL);
+    if (!ft_mcnominal(ft_curckt))
+        return;
+
+    ft_setflag = true;
+    ft_intrpt = false;
+    if (wl->wl_next) {
+        if (!(rawfileFp = fopen(wl->wl_next->wl_word, "w"))) {
+            perror(wl->wl_next->wl_word);
+            ft_setflag = false;
+            return;
+        }
+        rawfileBinary = !ascii;
+    } else
+        rawfileFp = NULL;
+
+    for (i = 0; i < nruns; i++) {
+        ft_mcperturb(ft_curckt);
+        rerun = i && if_canrerun(ft_curckt->ci_ckt);
+        if (i && !rerun) {
+            /* Event-driven instances, or a parameter that decides what
+             * the setup builds was varied: parse again and put the
+             * values just picked into the new circuit.
+             */
+            com_rset((wordlist *) NULL);
+            ft_mcredo(ft_curckt);
+        }
+        if (!rawfileFp)
+            plot_num++;
+        ft_curckt->ci_inprogress = true;
+        if (if_run(ft_curckt->ci_ckt, rerun ? "rerun" : "run",
+                (wordlist *) NULL, ft_curckt->ci_symtab) == 1) {
+            fprintf(cp_err, "mc run %d interrupted\n", i + 1);
+
+            g_ipc.run_error = IPC_TRUE;
+            if(g_ipc.enabled)
+                ipc_send_errchk();
+            break;
+        }
+        ft_curckt->ci_inprogress = false;
+        ft_curckt->ci_runonce = true;
+        if (ft_intrpt)
+            break;
+    }
+    ft_mcrestore(ft_curckt);
+
+    if (rawfileFp) {
+        (void) fclose(rawfileFp);
+        rawfileFp = NULL;
+    }
+    ft_curckt->ci_runonce = true;
+    ft_setflag = false;
+    return;
+}
+
 /* Throw out the circuit struct and recreate it from the deck.  This command
  * should be obsolete.
  */
@@ -308,6 +435,7 @@ com_rset(wl)
     }
 
     if_cktfree(ft_curckt->ci_ckt, ft_curckt->ci_symtab);
+    ft_altfree(ft_curckt);
     inp_dodeck(ft_curckt->ci_deck, ft_curckt->ci_name, (wordlist *) NULL,
             true, ft_curckt->ci_options, ft_curckt->ci_filename);
     return;
@@ -0,0 +1,597 @@
+
+/*
+ * Spectra by FFT.  ft_fft does a power-of-two length with the usual
+ * radix-2 butterflies, and any other length by turning it into a
+ * convolution of a power-of-two length (Bluestein's method), so it is
+ * n log n either way.  The "fft" command makes a new plot of the
+ * spectra of some vectors, and the "distortion" command finds the
+ * harmonics of a tone and prints THD, SNR, SINAD, SFDR and ENOB.
+ * Transient data is first resampled onto a uniform grid with
+ * ft_interpolate, then windowed.
+ *
+ * Variables used: fftsize is the number of points (the default is the
+ * number of points in the scale rounded up to a power of two), specwindow
+ * is one of rectangular, hann, hamming, blackman, blackmanharris or
+ * flattop (default hann), polydegree is the interpolation degree, and for
+ * distortion, nfreqs is the number of harmonics, counting the fundamental.
+ */
+
+#include "prefix.h"
+#include "CPdefs.h"
+#include "FTEdefs.h"
+#include "FTEdata.h"
+#include "FTEparse.h"
+#include "util.h"
+#include "suffix.h"
+
+static void fft2();
+static bool bluestein();
+static double *mkwindow();
+static bool specprep();
+static struct dvec *specvecs();
+static double tonepower();
+static void specwindow();
+
+/* The windows, and how many bins either side of a tone its leakage is
+ * counted over.
+ */
+
+static struct window {
+    char *w_name;
+    int w_bins;
+} windows[] = {
+    { "rectangular", 1 } ,
+    { "hann", 2 } ,
+    { "hanning", 2 } ,
+    { "hamming", 2 } ,
+    { "blackman", 3 } ,
+    { "blackmanharris", 4 } ,
+    { "flattop", 5 } ,
+    { NULL, 0 }
+} ;
+
+/* Transform the n points in re and im in place.  dir is -1 for the
+ * forward transform and 1 for the inverse, which is scaled by 1/n.
+ */
+
+bool
+ft_fft(re, im, n, dir)
+    double *re, *im;
+    int n, dir;
+{
+    int i;
+
+    if (n < 1)
+        return (false);
+    if (n & (n - 1)) {
+        if (!bluestein(re, im, n, dir))
+            return (false);
+    } else
+        fft2(re, im, n, dir);
+    if (dir > 0)
+        for (i = 0; i < n; i++) {
+            re[i] /= n;
+            im[i] /= n;
+        }
+    return (true);
+}
+
+/* Radix 2, decimation in time, unscaled. */
+
+static void
+fft2(re, im, n, dir)
+    double *re, *im;
+    int n, dir;
+{
+    double *wr, *wi, tr, ti;
+    int i, j, k, len, half, step;
+
+    /* Put the data in bit reversed order. */
+    for (i = 1, j = 0; i < n; i++) {
+        for (k = n >> 1; j & k; k >>= 1)
+            j ^= k;
+        j |= k;
+        if (i < j) {
+            tr = re[i]; re[i] = re[j]; re[j] = tr;
+            ti = im[i]; im[i] = im[j]; im[j] = ti;
+        }
+    }
+    if (n < 2)
+        return;
+
+    /* The twiddles for the last pass - the others use every step'th. */
+    wr = (double *) tmalloc((n / 2) * sizeof (double));
+    wi = (double *) tmalloc((n / 2) * sizeof (double));
+    for (i = 0; i < n / 2; i++) {
+        wr[i] = cos(2 * PI * i / n);
+        wi[i] = dir * sin(2 * PI * i / n);
+    }
+
+    for (len = 2; len <= n; len <<= 1) {
+        half = len >> 1;
+        step = n / len;
+        for (i = 0; i < n; i += len)
+            for (j = 0, k = 0; j < half; j++, k += step) {
+                tr = wr[k] * re[i + j + half] - wi[k] * im[i + j + half];
+                ti = wr[k] * im[i + j + half] + wi[k] * re[i + j + half];
+                re[i + j + half] = re[i + j] - tr;
+                im[i + j + half] = im[i + j] - ti;
+                re[i + j] += tr;
+                im[i + j] += ti;
+            }
+    }
+    tfree(wr);
+    tfree(wi);
+    return;
+}
+
+/* Any length, as a convolution with a chirp done with two power of two
+ * transforms of at least 2n - 1 points.  Unscaled.
+ */
+
+static bool
+bluestein(re, im, n, dir)
+    double *re, *im;
+    int n, dir;
+{
+    double *cr, *ci, *ar, *ai, *br, *bi, tr, ti;
+    int m, i, kk;
+
+    for (m = 1; m < 2 * n - 1; m <<= 1)
+        ;
+    cr = (double *) tmalloc(n * sizeof (double));
+    ci = (double *) tmalloc(n * sizeof (double));
+    ar = (double *) tmalloc(m * sizeof (double));
+    ai = (double *) tmalloc(m * sizeof (double));
+    br = (double *) tmalloc(m * sizeof (double));
+    bi = (double *) tmalloc(m * sizeof (double));
+
+    /* The chirp, exp(dir j pi k^2 / n), with k^2 taken mod 2n so the
+     * angle doesn't lose its precision.
+     */
+    for (i = 0, kk = 0; i < n; i++) {
+        cr[i] = cos(PI * kk / n);
+        ci[i] = dir * sin(PI * kk / n);
+        kk += 2 * i + 1;
+        if (kk >= 2 * n)
+            kk -= 2 * n;
+    }
+    for (i = 0; i < m; i++)
+        ar[i] = ai[i] = br[i] = bi[i] = 0.0;
+    for (i = 0; i < n; i++) {
+        ar[i] = re[i] * cr[i] - im[i] * ci[i];
+        ai[i] = re[i] * ci[i] + im[i] * cr[i];
+    }
+    br[0] = cr[0];
+    bi[0] = -ci[0];
+    for (i = 1; i < n; i++) {
+        br[i] = br[m - i] = cr[i];
+        bi[i] = bi[m - i] = -ci[i];
+    }
+
+    fft2(ar, ai, m, -1);
+    fft2(br, bi, m, -1);
+    for (i = 0; i < m; i++) {
+        tr = ar[i] * br[i] - ai[i] * bi[i];
+        ti = ar[i] * bi[i] + ai[i] * br[i];
+        ar[i] = tr;
+        ai[i] = ti;
+    }
+    fft2(ar, ai, m, 1);
+
+    for (i = 0; i < n; i++) {
+        tr = ar[i] / m;
+        ti = ai[i] / m;
+        re[i] = tr * cr[i] - ti * ci[i];
+        im[i] = tr * ci[i] + ti * cr[i];
+    }
+    tfree(cr);
+    tfree(ci);
+    tfree(ar);
+    tfree(ai);
+    tfree(br);
+    tfree(bi);
+    return (true);
+}
+
+/* Make the window named by $specwindow, and say how wide the tones
+ * it makes are.
+ */
+
+static double *
+mkwindow(n, name, bins)
+    int n;
+    char *name;
+    int *bins;
+{
+    double *w, x;
+    int i, k;
+
+    for (k = 0; windows[k].w_name; k++)
+        if (cieq(name, windows[k].w_name))
+            break;
+    if (!windows[k].w_name) {
+        fprintf(cp_err, "Error: unknown window %s\n", name);
+        return (NULL);
+    }
+    *bins = windows[k].w_bins;
+
+    w = (double *) tmalloc(n * sizeof (double));
+    for (i = 0; i < n; i++) {
+        x = 2 * PI * i / n;
+        switch (k) {
+          case 0:
+            w[i] = 1.0;
+            break;
+          case 1:
+          case 2:
+            w[i] = 0.5 - 0.5 * cos(x);
+            break;
+          case 3:
+            w[i] = 0.54 - 0.46 * cos(x);
+            break;
+          case 4:
+            w[i] = 0.42 - 0.5 * cos(x) + 0.08 * cos(2 * x);
+            break;
+          case 5:
+            w[i] = 0.35875 - 0.48829 * cos(x) + 0.14128 * cos(2 * x) -
+                    0.01168 * cos(3 * x);
+            break;
+          case 6:
+            w[i] = 0.21557895 - 0.41663158 * cos(x) + 0.277263158 *
+                    cos(2 * x) - 0.083578947 * cos(3 * x) + 0.006947368 *
+                    cos(4 * x);
+            break;
+        }
+    }
+    return (w);
+}
+
+/* Resample v onto n evenly spaced points over the whole of the scale,
+ * window it, and transform it.  The spacing is returned in dt, and
+ * the sums of the window and of its square in wsum and wsqsum.
+ */
+
+static bool
+specprep(v, scale, n, re, im, dt, bins, wsum, wsqsum)
+    struct dvec *v, *scale;
+    int n;
+    double *re, *im, *dt;
+    int *bins;
+    double *wsum, *wsqsum;
+{
+    double *grid, *w, span;
+    char wname[BSIZE];
+    int degree, i;
+
+    specwindow(wname);
+    if ((!cp_getvar("polydegree", VT_NUM, (char *) &degree)) ||
+            (degree < 0))
+        degree = 1;
+    if (!(w = mkwindow(n, wname, bins)))
+        return (false);
+
+    span = scale->v_realdata[scale->v_length - 1] - scale->v_realdata[0];
+    if (degree && (scale->v_length > 1)) {
+        /* The last point is left off, since it is the first point of
+         * the next period.
+         */
+        grid = (double *) tmalloc(n * sizeof (double));
+        for (i = 0; i < n; i++)
+            grid[i] = scale->v_realdata[0] + i * span / n;
+        if (!ft_interpolate(v->v_realdata, re, scale->v_realdata,
+                v->v_length, grid, n, degree)) {
+            fprintf(cp_err, "Error: can't interpolate %s\n", v->v_name);
+            tfree(grid);
+            tfree(w);
+            return (false);
+        }
+        tfree(grid);
+        *dt = span / n;
+    } else {
+        /* Take the points as they are, padded with zeros. */
+        for (i = 0; i < n; i++)
+            re[i] = (i < v->v_length) ? v->v_realdata[i] : 0.0;
+        *dt = (scale->v_length > 1) ? span / (scale->v_length - 1) : 1.0;
+    }
+
+    *wsum = *wsqsum = 0.0;
+    for (i = 0; i < n; i++) {
+        re[i] *= w[i];
+        im[i] = 0.0;
+        *wsum += w[i];
+        *wsqsum += w[i] * w[i];
+    }
+    tfree(w);
+    return (ft_fft(re, im, n, -1));
+}
+
+/* Evaluate the expressions in wl, and check that they are real and
+ * go with the scale.  The results are linked with v_link2.
+ */
+
+static struct dvec *
+specvecs(wl, scale)
+    wordlist *wl;
+    struct dvec *scale;
+{
+    struct pnode *names;
+    struct dvec *vecs = NULL, *end = NULL, *vec, *next;
+
+    names = ft_getpnames(wl, true);
+    for (; names; names = names->pn_next) {
+        for (vec = ft_evaluate(names); vec; vec = next) {
+            next = vec->v_link2;
+            if (vec->v_length != scale->v_length) {
+                fprintf(cp_err, "Error: lengths don't match: %d, %d\n",
+                        vec->v_length, scale->v_length);
+                continue;
+            }
+            if (!isreal(vec)) {
+                fprintf(cp_err, "Error: %s isn't real!\n", vec->v_name);
+                continue;
+            }
+            vec->v_link2 = NULL;
+            if (end)
+                end->v_link2 = vec;
+            else
+                vecs = vec;
+            end = vec;
+        }
+    }
+    return (vecs);
+}
+
+static void
+specwindow(buf)
+    char *buf;
+{
+    if (!cp_getvar("specwindow", VT_STRING, buf))
+        (void) strcpy(buf, "hann");
+    return;
+}
+
+static int
+specsize(scale)
+    struct dvec *scale;
+{
+    int n;
+
+    if ((!cp_getvar("fftsize", VT_NUM, (char *) &n)) || (n < 2))
+        for (n = 2; n < scale->v_length; n <<= 1)
+            ;
+    return (n);
+}
+
+/* Usage is "fft vector ...".  The result is a new plot, with a frequency
+ * scale and the one-sided spectrum of each vector, scaled so that a sine
+ * of amplitude A shows up with magnitude A.
+ */
+
+void
+com_fft(wl)
+    wordlist *wl;
+{
+    struct plot *new, *old;
+    struct dvec *scale, *vecs, *vec, *f, *v;
+    double *re, *im, dt, wsum, wsqsum, d;
+    int n, len, i, bins;
+    char buf[BSIZE];
+
+    if (!plot_cur || !(scale = plot_cur->pl_scale)) {
+        fprintf(cp_err, "Error: no vectors loaded.\n");
+        return;
+    }
+    if (!isreal(scale)) {
+        fprintf(cp_err, "Error: fft needs a real scale\n");
+        return;
+    }
+    if (!(vecs = specvecs(wl, scale)))
+        return;
+
+    old = plot_cur;
+    n = specsize(scale);
+    len = n / 2 + 1;
+    new = plot_alloc("spect");
+    (void) sprintf(buf, "%s (spectrum)", old->pl_name);
+    new->pl_name = copy(buf);
+    new->pl_title = copy(old->pl_title);
+    new->pl_date = copy(old->pl_date);
+
+    re = (double *) tmalloc(n * sizeof (double));
+    im = (double *) tmalloc(n * sizeof (double));
+    f = NULL;
+    for (vec = vecs; vec; vec = vec->v_link2) {
+        if (!specprep(vec, scale, n, re, im, &dt, &bins, &wsum, &wsqsum))
+            continue;
+        if (!f) {
+            f = alloc(dvec);
+            f->v_name = copy("frequency");
+            f->v_type = SV_FREQUENCY;
+            f->v_flags = VF_REAL | VF_PERMANENT;
+            f->v_length = len;
+            f->v_plot = new;
+            f->v_realdata = (double *) tmalloc(len * sizeof (double));
+            for (i = 0; i < len; i++)
+                f->v_realdata[i] = i / (n * dt);
+            new->pl_scale = new->pl_dvecs = f;
+        }
+        v = alloc(dvec);
+        v->v_name = copy(vec->v_name);
+        v->v_type = vec->v_type;
+        v->v_flags = VF_COMPLEX | VF_PERMANENT;
+        v->v_length = len;
+        v->v_plot = new;
+        v->v_compdata = (complex *) tmalloc(len * sizeof (complex));
+        for (i = 0; i < len; i++) {
+            d = ((i == 0) || (2 * i == n)) ? 1 / wsum : 2 / wsum;
+            realpart(&v->v_compdata[i]) = re[i] * d;
+            imagpart(&v->v_compdata[i]) = im[i] * d;
+        }
+        vec_new(v);
+    }
+    tfree(re);
+    tfree(im);
+
+    if (!f) {
+        fprintf(cp_err, "Error: no spectra made\n");
+        return;
+    }
+    plot_new(new);
+    plot_setcur(new->pl_typename);
+    return;
+}
+
+/* Usage is "distortion fund_freq vector ...".  The tone nearest fund_freq
+ * and its harmonics (folded back below the Nyquist frequency, as they
+ * would be by a sampler) are picked out of the spectrum, and everything
+ * else except DC is counted as noise.  This is meant for coherently
+ * sampled tones, e.g. ADC outputs, but with a good window it does well
+ * enough on anything.
+ */
+
+void
+com_distortion(wl)
+    wordlist *wl;
+{
+    struct dvec *scale, *vecs, *vec;
+    double *re, *im, *p, dt, wsum, wsqsum, df, fund, *ff;
+    double ptot, pfund, pharm, pnoise, pdc, spur, ph, amp, sinad;
+    char *used, *s, wname[BSIZE];
+    int n, half, i, h, k, kf, nharm, bins;
+
+    if (!plot_cur || !(scale = plot_cur->pl_scale)) {
+        fprintf(cp_err, "Error: no vectors loaded.\n");
+        return;
+    }
+    if (!isreal(scale)) {
+        fprintf(cp_err, "Error: distortion needs a real scale\n");
+        return;
+    }
+    s = wl->wl_word;
+    if (!(ff = ft_numparse(&s, false)) || (*ff <= 0.0)) {
+        fprintf(cp_err, "Error: bad fund freq %s\n", wl->wl_word);
+        return;
+    }
+    fund = *ff;
+    if ((!cp_getvar("nfreqs", VT_NUM, (char *) &nharm)) || (nharm < 2))
+        nharm = 10;
+    if (!(vecs = specvecs(wl->wl_next, scale)))
+        return;
+
+    n = specsize(scale);
+    half = n / 2;
+    specwindow(wname);
+    re = (double *) tmalloc(n * sizeof (double));
+    im = (double *) tmalloc(n * sizeof (double));
+    p = (double *) tmalloc((half + 1) * sizeof (double));
+    used = tmalloc(half + 1);
+
+    for (vec = vecs; vec; vec = vec->v_link2) {
+        if (!specprep(vec, scale, n, re, im, &dt, &bins, &wsum, &wsqsum))
+            continue;
+        df = 1 / (n * dt);
+        ptot = 0.0;
+        for (i = 0; i <= half; i++) {
+            p[i] = re[i] * re[i] + im[i] * im[i];
+            if ((i != 0) && (i != half))
+                p[i] *= 2;
+            ptot += p[i];
+            used[i] = 0;
+        }
+
+        kf = fund / df + 0.5;
+        if ((kf <= bins) || (kf > half - bins)) {
+            fprintf(cp_err,
+                "Error: %s: fund freq outside the spectrum (0 - %g)\n",
+                    vec->v_name, half * df);
+            continue;
+        }
+        pdc = tonepower(p, used, half, 0, 0, bins);
+        pfund = tonepower(p, used, half, kf, bins, bins);
+        if (pfund <= 0.0) {
+            fprintf(cp_err, "Error: %s: no signal at %g\n", vec->v_name,
+                    fund);
+            continue;
+        }
+        for (k = kf - bins, i = kf; k <= kf + bins; k++)
+            if (p[k] > p[i])
+                i = k;
+        kf = i;
+
+        fprintf(cp_out, "Distortion analysis for %s:\n", vec->v_name);
+        fprintf(cp_out, "  Points: %d, Window: %s, Resolution: %g Hz\n\n",
+                n, wname, df);
+        fprintf(cp_out, "Harmonic %-14s %-14s %s\n", "Frequency",
+                "Amplitude", "dBc");
+        fprintf(cp_out, "-------- %-14s %-14s %s\n", "---------",
+                "---------", "---");
+        amp = 2 * sqrt(pfund / (2 * n * wsqsum));
+        fprintf(cp_out, " %-4d    %-14g %-14g\n", 1, kf * df, amp);
+
+        pharm = 0.0;
+        for (h = 2; h <= nharm; h++) {
+            /* Where the harmonic lands after sampling. */
+            k = (int) (((double) h * kf) - n * floor((double) h * kf / n));
+            if (k > half)
+                k = n - k;
+            ph = tonepower(p, used, half, k, 1, bins);
+            pharm += ph;
+            fprintf(cp_out, " %-4d    %-14g %-14g %.2f\n", h, k * df,
+                    2 * sqrt(ph / (2 * n * wsqsum)),
+                    10 * log10((ph > 0.0 ? ph : 1e-300) / pfund));
+        }
+        pnoise = ptot - pdc - pfund - pharm;
+        if (pnoise <= 0.0)
+            pnoise = 1e-300;
+
+        /* The biggest bin that isn't DC or the fundamental. */
+        spur = 0.0;
+        for (i = 0; i <= half; i++)
+            if ((i > bins) && ((i < kf - bins) || (i > kf + bins)) &&
+                    (p[i] > spur))
+                spur = p[i];
+
+        sinad = 10 * log10(pfund / (pnoise + pharm));
+        fprintf(cp_out, "\n  THD: %g %% (%.2f dB)\n",
+                100 * sqrt(pharm / pfund),
+                10 * log10((pharm > 0.0 ? pharm : 1e-300) / pfund));
+        fprintf(cp_out, "  SNR: %.2f dB, SINAD: %.2f dB, ENOB: %.2f bits\n",
+                10 * log10(pfund / pnoise), sinad, (sinad - 1.76) / 6.02);
+        if (spur > 0.0)
+            fprintf(cp_out, "  SFDR: %.2f dB\n\n",
+                    10 * log10(p[kf] / spur));
+        else
+            fprintf(cp_out, "  SFDR: infinite\n\n");
+    }
+    tfree(re);
+    tfree(im);
+    tfree(p);
+    tfree(used);
+    return;
+}
+
+/* The power of the tone near bin k: look up to search bins either way
+ * for the peak, and add up the bins around it that nobody has taken yet.
+ */
+
+static double
+tonepower(p, used, half, k, search, bins)
+    double *p;
+    char *used;
+    int half, k, search, bins;
+{
+    double sum = 0.0;
+    int i, peak = k;
+
+    for (i = k - search; i <= k + search; i++)
+        if ((i >= 0) && (i <= half) && !used[i] && (used[peak] ||
+                (p[i] > p[peak])))
+            peak = i;
+    for (i = peak - bins; i <= peak + bins; i++)
+        if ((i >= 0) && (i <= half) && !used[i]) {
+            sum += p[i];
+            used[i] = 1;
+        }
+    return (sum);
+}
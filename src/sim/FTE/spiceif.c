@@ -65,6 +65,7 @@ if_inpdeck(deck, tab)
     IFuid taskUid;
     IFuid optUid;
     int which = -1;
+    char cachedir[BSIZE];
 
     for (i = 0, ll = deck; ll; ll = ll->li_next)
         i++;
@@ -109,9 +110,30 @@ if_inpdeck(deck, tab)
     }
     ft_curckt->ci_curTask = ft_curckt->ci_defTask;
 
-    INPpas1((GENERIC *) ckt, (card *) deck->li_next,(INPtables *)*tab);
-    INPpas2((GENERIC *) ckt, (card *) deck->li_next,
-            (INPtables *) *tab,ft_curckt->ci_defTask);
+    /* If there is a deck cache, and this deck is in it, the circuit can
+     * be built straight from there without parsing it at all.
+     */
+    if (cp_getvar("deckcache", VT_STRING, cachedir) && *cachedir) {
+        err = INPcacheLoad(ckt, (card *) deck->li_next, (INPtables *) *tab,
+                ft_curckt->ci_defTask, ft_curckt->ci_defOpt, cachedir);
+        if (err && (err != E_NOTFOUND)) {
+            ft_sperror(err, "deckcache");
+            return (NULL);
+        }
+    } else {
+        *cachedir = '\0';
+        err = E_NOTFOUND;
+    }
+    if (err) {
+        if (*cachedir)
+            INPcacheStart(ckt, (card *) deck->li_next,
+                    ft_curckt->ci_defTask, ft_curckt->ci_defOpt);
+        INPpas1((GENERIC *) ckt, (card *) deck->li_next,(INPtables *)*tab);
+        INPpas2((GENERIC *) ckt, (card *) deck->li_next,
+                (INPtables *) *tab,ft_curckt->ci_defTask);
+        if (*cachedir)
+            INPcacheSave((card *) deck->li_next, cachedir);
+    }
     INPkillMods();
 
 /* gtri - begin - wbk - 6/6/91 - Finish initialization of event driven structures */
@@ -130,7 +152,13 @@ if_inpdeck(deck, tab)
  * return value of this routine is 0 if the exit was ok, and 1 if there was
  * a reason to interrupt the circuit (interrupt typed at the keyboard,
  * error in the simulation, etc). args should be the entire command line,
- * e.g. "tran 1 10 20 uic"
+ * e.g. "tran 1 10 20 uic"  Type "rerun" repeats the task of the last run
+ * without redoing the circuit setup, for use after parameters have been
+ * changed with if_setparam.  The other types don't redo the setup either
+ * if the circuit has been run before (the caller reparses the deck unless
+ * incremental is set), so they too only update the models that were
+ * altered and start from the last operating point.  Only call it that
+ * way if if_canrerun says so.
  */
 
 int
@@ -146,8 +174,11 @@ if_run(t, what, args, tab)
     char buf[BSIZE];
     int j;
     int which = -1;
+    int reset;
     IFuid specUid,optUid;
 
+    reset = (ft_curckt->ci_runonce && if_canrerun(t)) ? RERUN : RESTART;
+
     /* First parse the line... */
     if (eq(what, "tran") || eq(what, "ac") || eq(what, "dc") || 
             eq(what, "op") || eq(what, "pz")) {
@@ -212,6 +243,21 @@ if_run(t, what, args, tab)
         ft_curckt->ci_curOpt = ft_curckt->ci_defOpt;
     }
 
+    /* Keep the operating point in the file named by opsnap, and with
+     * opsnapaccept take the one there without iterating if it fits.
+     */
+    if (!eq(what, "resume") && ft_sim->snapshot) {
+        if (cp_getvar("opsnap", VT_STRING, buf))
+            err = (*(ft_sim->snapshot))(ckt, buf,
+                    cp_getvar("opsnapaccept", VT_BOOL, (char *) NULL));
+        else
+            err = (*(ft_sim->snapshot))(ckt, (char *) NULL, 0);
+        if (err) {
+            ft_sperror(err, "snapshot");
+            return (1);
+        }
+    }
+
     /* Then do the stuff. */
     if (  (eq(what, "tran"))  ||
           (eq(what, "ac"))  ||
@@ -219,11 +265,19 @@ if_run(t, what, args, tab)
           (eq(what, "op")) ||
           (eq(what, "pz")) ||
           (eq(what, "run"))     )  {
-        if ((err = (*(ft_sim->doAnalyses))(ckt, 1, ft_curckt->ci_curTask))!=OK){
+        if ((err = (*(ft_sim->doAnalyses))(ckt, reset, ft_curckt->ci_curTask))
+                != OK) {
             ft_sperror(err, "doAnalyses");
             /* wrd_end(); */
             return (1);
         }
+    } else if (eq(what, "rerun")) {
+        /* Same task as the last run, but don't rebuild the matrix */
+        if ((err = (*(ft_sim->doAnalyses))(ckt, RERUN, ft_curckt->ci_curTask))
+                != OK) {
+            ft_sperror(err, "doAnalyses");
+            return (1);
+        }
     } else if (eq(what, "resume")) {
         if ((err = (*(ft_sim->doAnalyses))(ckt, 0, ft_curckt->ci_curTask))!=OK){
             ft_sperror(err, "doAnalyses");
@@ -237,6 +291,23 @@ if_run(t, what, args, tab)
     return (0);
 }
 
+/* Say whether a circuit that has been run can be run again without
+ * reparsing the deck.  Code models only allocate their event state on
+ * the first call of an instance, and each analysis starts with fresh
+ * event data, so circuits with event-driven or hybrid instances have to
+ * be reparsed.  So do circuits where a parameter that decides which
+ * internal nodes a device gets (a MOSFET's rd, say) has been changed.
+ */
+
+bool
+if_canrerun(t)
+    char *t;
+{
+    CKTcircuit *ckt = (CKTcircuit *) t;
+
+    return (ckt->evt->counts.num_insts == 0 && !ckt->CKTsetupTouched);
+}
+
 /* Set an option in the circuit. Arguments are option name, type, and
  * value (the last a char *), suitable for casting to whatever needed...
  */
@@ -526,7 +597,12 @@ if_getparam(ckt, name, param, ind)
 #endif
 }
 
-/* ARGSUSED */
+/* Set a device or model parameter.  The name is looked up first as an
+ * instance and then as a model, and param must be a settable parameter
+ * of whichever one was found.  The change takes effect the next time the
+ * temperature dependent setup (CKTtemp) is done, i.e. on the next run.
+ */
+
 void
 if_setparam(ckt, name, param, val)
     char *ckt;
@@ -534,6 +610,108 @@ if_setparam(ckt, name, param, val)
     char *param;
     struct variable *val;
 {
+    IFvalue pv;
+    IFparm *opt = NULL;
+    IFdevice *device;
+    int typecode, i, err;
+    GENinstance *dev=(GENinstance *)NULL;
+    GENmodel *mod=(GENmodel *)NULL;
+
+    name = copy(name);  /* INPinsert may free it */
+    INPinsert(&name,(INPtables *)ft_curckt->ci_symtab);
+    typecode = finddev(ckt, name, (GENERIC**)&dev, (GENERIC**)&mod);
+    if (typecode == -1) {
+        fprintf(cp_err, "Error: no such device or model name %s\n", name);
+        return;
+    }
+    device = ft_sim->devices[typecode];
+    if (dev) {
+        for (i = 0; i < device->numInstanceParms; i++)
+            if ((device->instanceParms[i].dataType & IF_SET) &&
+                    eq(device->instanceParms[i].keyword, param)) {
+                opt = &device->instanceParms[i];
+                break;
+            }
+        /* A parameter that the instance doesn't have goes to its model */
+        if (!opt) {
+            mod = dev->GENmodPtr;
+            dev = NULL;
+        }
+    }
+    if (!opt) {
+        for (i = 0; i < device->numModelParms; i++)
+            if ((device->modelParms[i].dataType & IF_SET) &&
+                    eq(device->modelParms[i].keyword, param)) {
+                opt = &device->modelParms[i];
+                break;
+            }
+    }
+    if (!opt) {
+        fprintf(cp_err, "Error: no such parameter %s on %s.\n",
+                param, name);
+        return;
+    }
+
+#ifndef LINT
+    switch (opt->dataType & IF_VARTYPES) {
+#else
+    switch (i) {
+#endif
+        case IF_REAL:
+            if (val->va_type == VT_REAL)
+                pv.rValue = val->va_real;
+            else if (val->va_type == VT_NUM)
+                pv.rValue = val->va_num;
+            else
+                goto badtype;
+            break;
+        case IF_INTEGER:
+            if (val->va_type == VT_NUM)
+                pv.iValue = val->va_num;
+            else if (val->va_type == VT_REAL)
+                pv.iValue = val->va_real;
+            else
+                goto badtype;
+            break;
+        case IF_FLAG:
+            if (val->va_type == VT_BOOL)
+                pv.iValue = val->va_bool ? 1 : 0;
+            else if (val->va_type == VT_NUM)
+                pv.iValue = val->va_num ? 1 : 0;
+            else if (val->va_type == VT_REAL)
+                pv.iValue = (val->va_real != 0.0) ? 1 : 0;
+            else
+                goto badtype;
+            break;
+        case IF_STRING:
+            if (val->va_type == VT_STRING)
+                pv.sValue = copy(val->va_string);
+            else
+                goto badtype;
+            break;
+        default:
+            fprintf(cp_err, "Error: can't alter parameter %s of %s.\n",
+                    param, name);
+            return;
+    }
+
+    if (dev)
+        err = (*(ft_sim->setInstanceParm))((GENERIC *)ckt, (GENERIC *)dev,
+                opt->id, &pv, (IFvalue *)NULL);
+    else
+        err = (*(ft_sim->setModelParm))((GENERIC *)ckt, (GENERIC *)mod,
+                opt->id, &pv, (IFvalue *)NULL);
+    /* The parameter routines keep their own copy of a string */
+    if ((opt->dataType & IF_VARTYPES) == IF_STRING)
+        tfree(pv.sValue);
+    if (err != OK)
+        ft_sperror(err, "if_setparam");
+    return;
+
+badtype:
+    fprintf(cp_err, "Error: bad type given for parameter %s of %s.\n",
+            param, name);
+    return;
 }
 
 static struct variable *
@@ -618,7 +796,7 @@ parmlookup(dev, inptr, param)
      */
     *inptr = NULL;
     for (i = 0; i < dev->numModelParms; i++)
-        if ( (dev->instanceParms[i].dataType & IF_ASK) &&
+        if ( (dev->modelParms[i].dataType & IF_ASK) &&
                 eq(dev->modelParms[i].keyword, param))
             return (&dev->modelParms[i]);
     return (NULL);
@@ -940,6 +1118,7 @@ extern SPICEdev VCCSinfo;
 extern SPICEdev CCCSinfo;
 extern SPICEdev RESinfo;
 extern SPICEdev TRAinfo;
+extern SPICEdev LTRAinfo;
 extern SPICEdev CAPinfo;
 extern SPICEdev INDinfo;
 extern SPICEdev MUTinfo;
@@ -998,6 +1177,7 @@ SPICEdev *dummy_DEVices[] = {
         &CCCSinfo,
         &RESinfo,
         &TRAinfo,
+        &LTRAinfo,
         &CAPinfo,
         &INDinfo,
         &MUTinfo,
@@ -1056,6 +1236,7 @@ IFsimulator dummy_SIMinfo = {
     CKTdelTask,     /* deleteTask function */
 
     CKTdoJob,       /* doAnalyses function */
+    CKTsnapshot,    /* snapshot function */
 
     sizeof(dummy_DEVices)/sizeof(SPICEdev *),
     (IFdevice**) dummy_DEVices,
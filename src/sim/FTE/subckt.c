@@ -18,20 +18,46 @@
 
 #include "suffix.h"
 
+/* A small string hash table, used in place of the linear searches for
+ * subcircuit names, port names and model names.  The keys are copies
+ * owned by the table.
+ */
+struct hent {
+    char *h_key;
+    char *h_val;
+    int h_num;
+    struct hent *h_next;
+};
+
+struct htab {
+    struct hent **h_tab;
+    int h_size;         /* Always a power of 2. */
+    int h_count;
+};
+
 static struct line *doit();
 static void translate();
-static void settrans();
+static bool settrans();
 static void finishLine();
 static char *gettrans();
 static int numnodes(), numdevs();
 static bool modtranslate();
 static void devmodtranslate();
+static struct htab *ht_new();
+static void ht_free();
+static struct hent *ht_find();
+static struct hent *ht_enter();
+static void addch(), addstr(), addname();
+static struct line *mktemplate(), *stamp();
 
 struct subs {
     char *su_name;      /* The name. */
     char *su_args;      /* The arguments, space seperated. */
     int su_numargs;
+    char **su_formals;  /* The arguments, one per entry. */
+    struct htab *su_ports;  /* Formal name to its position in the list. */
     struct line *su_def;    /* The deck that is to be substituted. */
+    struct line *su_tmpl;   /* It translated once for all instances. */
     struct subs *su_next;
 } ;
 
@@ -43,19 +69,37 @@ struct subs {
  * and collect all of the subcircuits. Then, whenever a card that starts
  * with 'x' is found, copy the subcircuit associated with that name and
  * splice it in. A few of the problems: the nodes in the spliced-in
- * stuff must be unique, so when we copy it, append "subcktname:" to
- * each node. If we are in a nested subcircuit, use foo:bar:...:node.
+ * stuff must be unique, so when we copy it, append ":subcktname" to
+ * each node. If we are in a nested subcircuit, use node:...:bar:foo.
  * Then we have to systematically change all references to the renamed
  * nodes. On top of that, we have to know how many args BJT's have,
  * so we have to keep track of model names.
+ * The renaming is the same for every instance of a subcircuit but for
+ * the instance name and the actual nodes, so it is done once for each
+ * subcircuit, with markers in their place (mktemplate), and each
+ * instance is stamped out of that by filling them in (stamp).  The
+ * result is still a flat deck of cards for the parser.
  */
 
-static wordlist *modnames, *submod;
+static struct htab *modnames;   /* All the models, for the BJT hack. */
+static struct htab *submod;     /* Models local to the copy in hand. */
+static struct htab *subtab;     /* The subcircuits, by name. */
 static struct subs *subs = NULL;
 static bool nobjthack = false;
 
 static char start[32], sbend[32], invoke[32], model[32];
 
+/* The card being built. */
+static char *cbuf = NULL;
+static int clen = 0, csize = 0;
+
+/* The actual nodes of the instance being expanded, in the order of the
+ * formals they go with.
+ */
+static char **actuals = NULL;
+static int numactuals = 0, maxactuals = 0;
+static struct htab *ports = NULL;
+
 struct line *
 inp_subcktexpand(deck)
     struct line *deck;
@@ -143,6 +187,7 @@ inp_subcktexpand(deck)
     return (ll);
 }
 
+
 #define MAXNEST 21
 
 static struct line *
@@ -151,18 +196,18 @@ doit(deck)
 {
     struct line *c, *last, *lc, *lcc;
     struct subs *sss = (struct subs *) NULL, *ks;
-    char *s, *t, *scname, *subname;
+    struct hent *h;
+    char *s, *t, *scname;
     int nest, numpasses = MAXNEST, i;
     bool gotone;
-    wordlist *wl;
-    wordlist *tmodnames = modnames;
-    wordlist *tsubmod = submod;
+    struct htab *tmodnames = modnames;
+    struct htab *tsubtab = subtab;
     struct subs *ts = subs;
 
     /* Save all the old stuff... */
-    modnames = NULL;
+    modnames = ht_new();
+    subtab = ht_new();
     subs = NULL;
-    submod = NULL;
 
     /* First extract all the subckts. */
     for (last = deck, lc = NULL; last; ) {
@@ -177,9 +222,6 @@ doit(deck)
                 return (NULL);
             }
             lcc = NULL;
-            wl_free(submod);
-            submod = NULL;
-            gotone = false;
             for (nest = 0, c = last->li_next; c; c = c->li_next) {
                 if (prefix(sbend, c->li_line)) {
                     if (!nest)
@@ -208,6 +250,10 @@ doit(deck)
             (void) gettok(&s);
             sss->su_name = gettok(&s);
             sss->su_args = copy(s);
+
+            /* Number the formals once here, rather than matching them
+             * up by name for every instance.
+             */
             for (sss->su_numargs = 0, i = 0; s[i]; ) {
                 while (isspace(s[i]))
                     i++;
@@ -217,8 +263,21 @@ doit(deck)
                         i++;
                 }
             }
+            sss->su_formals = (char **) tmalloc((sss->su_numargs + 1) *
+                    sizeof (char *));
+            sss->su_ports = ht_new();
+            for (i = 0; i < sss->su_numargs; i++) {
+                sss->su_formals[i] = gettok(&s);
+                if (!ht_find(sss->su_ports, sss->su_formals[i]))
+                    ht_enter(sss->su_ports, sss->su_formals[i])->h_num = i;
+            }
             sss->su_next = subs;
             subs = sss;
+            /* The first definition of a name wins, as it did when the
+             * list was searched.
+             */
+            if (!ht_find(subtab, sss->su_name))
+                ht_enter(subtab, sss->su_name)->h_val = (char *) sss;
             last = c->li_next;
             lcc = subs->su_def;
         } else {
@@ -227,8 +286,14 @@ doit(deck)
         }
     }
 
-    if (!sss)
+    if (!sss) {
+        ht_free(modnames);
+        ht_free(subtab);
+        modnames = tmodnames;
+        subtab = tsubtab;
+        subs = ts;
         return (deck);
+    }
 
     /* Expand sub-subcircuits. */
     for (ks = sss = subs; sss; sss = sss->su_next)
@@ -241,12 +306,9 @@ doit(deck)
         if (prefix(model, c->li_line)) {
             s = c->li_line;
             (void) gettok(&s);
-            wl = alloc(wordlist);
-            wl->wl_next = modnames;
-            if (modnames)
-                modnames->wl_prev = wl;
-            modnames = wl;
-            wl->wl_word = gettok(&s);
+            t = gettok(&s);
+            (void) ht_enter(modnames, t);
+            tfree(t);
         }
 
     /* Now do the replacements. */
@@ -255,52 +317,52 @@ doit(deck)
         for (c = deck, lc = NULL; c; ) {
             if (ciprefix(invoke, c->li_line)) {
                 gotone = true;
-                t = s = copy(c->li_line);
-                scname = gettok(&s);
+                t = c->li_line;
+                scname = gettok(&t);
 /* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* comment out so that whole instance name is used in pathnames   */
-/*
-                scname += strlen(invoke);
-                while ((*scname == ' ') || (*scname == '\t') ||
-                        (*scname == ':'))
-                    scname++;
-*/
+/* the whole instance name is used in pathnames                    */
 /* gtri - end - wbk - 4/10/91 - change way pathnames are built */
-                while(*s)
-                    s++;
-                s--;
-                while ((*s == ' ') || (*s == '\t'))
-                    *s-- = '\0';
-                while ((*s != ' ') && (*s != '\t'))
+
+                /* The subcircuit name is the last thing on the card. */
+                for (s = t + strlen(t); (s > t) && isspace(s[-1]); s--)
+                    ;
+                i = s - t;
+                while ((s > t) && !isspace(s[-1]))
                     s--;
-                s++;
-                for (sss = subs; sss; sss = sss->su_next)
-                    if (eq(sss->su_name, s))
-                        break;
+                i -= s - t;
+                s = strncpy(tmalloc(i + 1), s, i);
+                h = ht_find(subtab, s);
+                tfree(s);
                 /* Don't complain -- this might be an
                  * instance of a subckt that is defined above.
                  */
-                if (!sss) {
+                if (!h) {
+                    tfree(scname);
                     lc = c;
                     c = c->li_next;
                     continue;
                 }
+                sss = (struct subs *) h->h_val;
+
                 /* Now we have to replace this card with the
                  * macro definition.
                  */
-                subname = copy(sss->su_name);
-                lcc = inp_deckcopy(sss->su_def);
-
-                /* Change the names of the models... */
-                if (modtranslate(lcc, scname))
-                    devmodtranslate(lcc, scname);
-
-                s = sss->su_args;
-                (void) gettok(&t); /* Throw out the name. */
-
-                translate(lcc, s, t, scname, subname);
+                if (!sss->su_tmpl)
+                    sss->su_tmpl = mktemplate(sss);
+                (void) settrans(sss, t);
+                lcc = stamp(sss, scname);
+                tfree(scname);
 
                 /* Now splice the decks together. */
+                if (!lcc) {
+                    /* An empty subcircuit. */
+                    if (lc)
+                        lc->li_next = c->li_next;
+                    else
+                        deck = c->li_next;
+                    c = c->li_next;
+                    continue;
+                }
                 if (lc)
                     lc->li_next = lcc;
                 else
@@ -322,9 +384,11 @@ doit(deck)
         return (NULL);
     }
 
+    ht_free(modnames);
+    ht_free(subtab);
     subs = ts;
     modnames = tmodnames;
-    submod = tsubmod;
+    subtab = tsubtab;
 
     return (deck);
 }
@@ -353,20 +417,109 @@ inp_deckcopy(deck)
     return (nd);
 }
 
+
+/* The markers mktemplate leaves for stamp to fill in: the instance
+ * name, and the actual node for formal n, which is written as n between
+ * two PORTMARKs.
+ */
+
+#define NAMEMARK    '\001'
+#define PORTMARK    '\002'
+
+/* Translate the definition of a subcircuit for an instance named by
+ * NAMEMARK, with the formals connected to PORTMARKed numbers.
+ */
+
+static struct line *
+mktemplate(sss)
+    struct subs *sss;
+{
+    struct line *lcc;
+    char *s, name[2], buf[32];
+    int i;
+
+    name[0] = NAMEMARK;
+    name[1] = '\0';
+    clen = 0;
+    for (i = 0; i < sss->su_numargs; i++) {
+        (void) sprintf(buf, "%c%d%c ", PORTMARK, i, PORTMARK);
+        addstr(buf);
+    }
+    addstr(sss->su_name);
+    addch('\0');
+    s = copy(cbuf);
+
+    lcc = inp_deckcopy(sss->su_def);
+
+    /* Change the names of the models... */
+    if (modtranslate(lcc, name))
+        devmodtranslate(lcc, name);
+
+    (void) settrans(sss, s);
+    translate(lcc, name);
+    tfree(s);
+    return (lcc);
+}
+
+/* Make the cards for an instance named scname from the template of its
+ * subcircuit, with the actual nodes that settrans has found.  A formal
+ * that got no actual node is local to the instance, as in gettrans.
+ */
+
+static struct line *
+stamp(sss, scname)
+    struct subs *sss;
+    char *scname;
+{
+    struct line *tl, *d = NULL, *nd = NULL;
+    char *s;
+    int n;
+
+    for (tl = sss->su_tmpl; tl; tl = tl->li_next) {
+        clen = 0;
+        for (s = tl->li_line; *s; s++) {
+            if (*s == NAMEMARK)
+                addstr(scname);
+            else if (*s == PORTMARK) {
+                for (n = 0, s++; *s != PORTMARK; s++)
+                    n = n * 10 + (*s - '0');
+                if (n < numactuals - 1)
+                    addstr(actuals[n]);
+                else {
+                    addstr(sss->su_formals[n]);
+                    addch(':');
+                    addstr(scname);
+                }
+            } else
+                addch(*s);
+        }
+        addch('\0');
+        if (nd) {
+            d->li_next = alloc(line);
+            d = d->li_next;
+        } else
+            nd = d = alloc(line);
+        d->li_linenum = tl->li_linenum;
+        d->li_line = copy(cbuf);
+        if (tl->li_error)
+            d->li_error = copy(tl->li_error);
+        d->li_actual = inp_deckcopy(tl->li_actual);
+    }
+    return (nd);
+}
+
 /* Translate all of the device names and node names in the deck. They are
- * pre-pended with subname:, unless they are in the formal list, in which case
- * they are replaced with the corresponding entry in the actual list.
- * The one special case is node 0 -- this is always ground and we don't
- * touch it.
+ * prefixed with the name of the subcircuit instance, except for the
+ * formal parameters, which get the actual node names instead.
  */
 
 static void
-translate(deck, formal, actual, scname, subname)
+translate(deck, scname)
     struct line *deck;
-    char *formal, *actual, *scname, *subname;
+    char *scname;
 {
     struct line *c;
-    char *buffer, *name, *s, *t, ch;
+    char *name, *s, *t;
     int nnodes;
 
 /* gtri - add - wbk - 10/23/90 - add new local variables */
@@ -375,8 +528,6 @@ translate(deck, formal, actual, scname, subname)
 
 /* gtri - end - wbk - 10/23/90 */
 
-
-    settrans(formal, actual, subname);
     for (c = deck; c; c = c->li_next) {
         /* Rename the device. */
         switch (*c->li_line) {
@@ -394,12 +545,13 @@ translate(deck, formal, actual, scname, subname)
 
             /* translate the instance name according to normal rules */
 
-            buffer = tmalloc(10000);     /* XXXXX */
+            clen = 0;
 
             s = c->li_line;
             name = MIFgettok(&s);
 
-            sprintf(buffer, "%s:%s ", name, scname);
+            addname(name, scname);
+            tfree(name);
 
             /* Now translate the nodes, looking ahead one token to recognize */
             /* when we reach the model name which should not be translated   */
@@ -427,19 +579,22 @@ translate(deck, formal, actual, scname, subname)
                 case '[':
                 case ']':
                 case '~':
-                    sprintf(buffer + strlen(buffer), "%s ", name);
+                    addstr(name);
+                    addch(' ');
                     break;
 
                 case '%':
 
-                    sprintf(buffer + strlen(buffer), "%%");
+                    addch('%');
 
                     /* don't translate the port type identifier */
 
+                    tfree(name);
                     name = next_name;
                     next_name = MIFgettok(&s);
 
-                    sprintf(buffer + strlen(buffer), "%s ", name);
+                    addstr(name);
+                    addch(' ');
                     break;
 
                 default:
@@ -447,27 +602,28 @@ translate(deck, formal, actual, scname, subname)
                     /* must be a node name at this point, so translate it */
 
                     t = gettrans(name);
-                    if (t)
-                        sprintf(buffer + strlen(buffer), "%s ", t);
-                    else
-                        sprintf(buffer + strlen(buffer), "%s:%s ", name, scname);
+                    if (t) {
+                        addstr(t);
+                        addch(' ');
+                    } else
+                        addname(name, scname);
 
                     break;
 
                 } /* switch */
 
+                tfree(name);
+
             } /* while */
 
 
             /* copy in the last token, which is the model name */
 
-            if(name)
-                sprintf(buffer + strlen(buffer), "%s ", name);
-
-            /* Set s to null string for compatibility with code */
-            /* after switch statement                           */
-
-            s = "";
+            if(name) {
+                addstr(name);
+                addch(' ');
+                tfree(name);
+            }
 
             break;
 
@@ -475,100 +631,61 @@ translate(deck, formal, actual, scname, subname)
 
 
         default:
-                s = c->li_line;
+            s = c->li_line;
             name = gettok(&s);
 /* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
 /* reverse order so that innermost name is now first */
-/*
-            ch = *name;
-            buffer = tmalloc(10000);
-            name++;
-            if (*name == ':')
-            name++;
-            if (*name)
-                (void) sprintf(buffer, "%c:%s:%s ", ch, scname,
-                    name);
-            else
-                (void) sprintf(buffer, "%c:%s ", ch, scname);
-*/
-            buffer = tmalloc(10000);    /* XXXXX */
-            (void) sprintf(buffer, "%s:%s ", name, scname);
-
+            clen = 0;
+            addname(name, scname);
+            tfree(name);
 /* gtri - end - wbk - 4/10/91 - change way pathnames are built */
 
             nnodes = numnodes(c->li_line);
             while (nnodes-- > 0) {
-            name = gettok(&s);
-            if (name == NULL) {
-                fprintf(cp_err, "Warning: too few nodes: %s\n",
-                        c->li_line);
-                return;
-            }
-            t = gettrans(name);
-            if (t)
-                (void) sprintf(buffer + strlen(buffer), "%s ",
-                        t);
-            else
-/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* reverse order so that innermost name is now first */
-/*
-                (void) sprintf(buffer + strlen(buffer),
-                        "%s:%s ", scname, name);
-*/
-                (void) sprintf(buffer + strlen(buffer),
-                        "%s:%s ", name, scname);
-
-/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
+                name = gettok(&s);
+                if (name == NULL) {
+                    fprintf(cp_err, "Warning: too few nodes: %s\n",
+                            c->li_line);
+                    return;
+                }
+                t = gettrans(name);
+                if (t) {
+                    addstr(t);
+                    addch(' ');
+                } else
+                    addname(name, scname);
+                tfree(name);
             }    
             nnodes = numdevs(c->li_line);
             while (nnodes-- > 0) {
-            name = gettok(&s);
-            if (name == NULL) {
-                fprintf(cp_err, "Warning: too few devs: %s\n",
-                        c->li_line);
-                return;
-            }
-/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* reverse order so that innermost name is now first */
-/*
-            ch = *name;
-            name++;
-            if (*name == ':')
-                name++;
-            if (*name)
-                (void) sprintf(buffer + strlen(buffer),
-                        "%c:%s:%s ", ch, scname, name);
-            else
-                (void) sprintf(buffer + strlen(buffer),
-                        "%c:%s ", ch, scname);
-*/
-            (void) sprintf(buffer + strlen(buffer),
-                    "%s:%s ", name, scname);
-
-/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
+                name = gettok(&s);
+                if (name == NULL) {
+                    fprintf(cp_err, "Warning: too few devs: %s\n",
+                            c->li_line);
+                    return;
+                }
+                addname(name, scname);
+                tfree(name);
             }
             /* Now scan through the line for v(something) and
              * i(something)...
              */
-            finishLine(buffer + strlen(buffer), s, scname);
-            s = "";
+            finishLine(s, scname);
         }
-            (void) strcat(buffer, s);
+        addch('\0');
         tfree(c->li_line);
-        c->li_line = copy(buffer);
-        tfree(buffer);
+        c->li_line = copy(cbuf);
     }
     return;
 }
 
 static void
-finishLine(dst, src, scname)
-    char *dst;
+finishLine(src, scname)
     char *src;
     char *scname;
 {
-    char buf[BSIZE], which;
-    char *s;
+    char which;
+    char *s, *t;
     int i;
 
     while (*src) {
@@ -578,84 +695,130 @@ finishLine(dst, src, scname)
         if (((*src != 'v') && (*src != 'V') &&
                 (*src != 'i') && (*src != 'I')) ||
                 isalpha(src[-1])) {
-            *dst++ = *src++;
+            addch(*src++);
             continue;
         }
         for (s = src + 1; *s && isspace(*s); s++)
             ;
         if (!*s || (*s != '(')) {
-            *dst++ = *src++;
+            addch(*src++);
             continue;
         }
-        which = *dst++ = *src;
+        which = *src;
+        addch(which);
         src = s;
-        *dst++ = *src++;
+        addch(*src++);
         while (isspace(*src))
             src++;
-        for (i = 0; *src && !isspace(*src) && (*src != ')'); i++)
-            buf[i] = *src++;
-        buf[i] = '\0';
-printf("which = %c, buf = '%s'\n", which, buf);
+        for (i = 0; src[i] && !isspace(src[i]) && (src[i] != ')'); i++)
+            ;
+        t = strncpy(tmalloc(i + 1), src, i);
+        src += i;
         if ((which == 'v') || (which == 'V'))
-            s = gettrans(buf);
+            s = gettrans(t);
         else
             s = NULL;
-        if (s) {
-            while (*s)
-                *dst++ = *s++;
-        } else {
+        if (s)
+            addstr(s);
+        else {
 /* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
 /* reverse order of building pathnames so innermost is always first */
-/*
-            for (s = scname; *s; )
-                *dst++ = *s++;
-            *dst++ = ':';
-            for (s = buf; *s; )
-                *dst++ = *s++;
-*/
-            for (s = buf; *s; )
-                *dst++ = *s++;
-            *dst++ = ':';
-            for (s = scname; *s; )
-                *dst++ = *s++;
-
+            addstr(t);
+            addch(':');
+            addstr(scname);
 /* gtri - end - wbk - 4/10/91 - change way pathnames are built */
         }
+        tfree(t);
+    }
+
+    return;
+}
+
+/* Add to the card being built. */
+
+static void
+addch(ch)
+    char ch;
+{
+    if (clen >= csize) {
+        if (csize) {
+            csize *= 2;
+            cbuf = trealloc(cbuf, csize);
+        } else {
+            csize = BSIZE;
+            cbuf = tmalloc(csize);
+        }
     }
+    cbuf[clen++] = ch;
+    return;
+}
 
+static void
+addstr(s)
+    char *s;
+{
+    while (*s)
+        addch(*s++);
     return;
 }
 
-static struct tab {
-    char *t_old;
-    char *t_new;
-} table[512];   /* That had better be enough. */
+/* A name local to the subcircuit: name:scname, innermost name first. */
 
 static void
-settrans(formal, actual, subname)
-    char *formal, *actual, *subname;
+addname(name, scname)
+    char *name, *scname;
 {
+    addstr(name);
+    addch(':');
+    addstr(scname);
+    addch(' ');
+    return;
+}
+
+/* Pair the actual nodes on the invocation with the formals of the
+ * subcircuit.  The last thing on the card is the subcircuit name.
+ */
+
+static bool
+settrans(sss, actual)
+    struct subs *sss;
+    char *actual;
+{
+    char *t;
     int i;
 
-    for (i = 0; ; i++) {
-        table[i].t_old = gettok(&formal);
-        table[i].t_new = gettok(&actual);
-        if ((table[i].t_old == NULL) && eq(table[i].t_new, subname))
-            break;
-        if ((table[i].t_old == NULL) || (table[i].t_new == NULL)) {
-            fprintf(cp_err, 
-            "settrans: Internal Error: wrong number of params\n");
-            return;
+    for (i = 0; i < numactuals; i++)
+        tfree(actuals[i]);
+    numactuals = 0;
+    while ((t = gettok(&actual)) != NULL) {
+        if (numactuals >= maxactuals) {
+            if (maxactuals) {
+                maxactuals *= 2;
+                actuals = (char **) trealloc((char *) actuals,
+                        maxactuals * sizeof (char *));
+            } else {
+                maxactuals = 32;
+                actuals = (char **) tmalloc(maxactuals *
+                        sizeof (char *));
+            }
         }
+        actuals[numactuals++] = t;
     }
-    return;
+    ports = sss->su_ports;
+    if ((numactuals != sss->su_numargs + 1) ||
+            !eq(actuals[numactuals - 1], sss->su_name)) {
+        fprintf(cp_err, 
+        "settrans: Internal Error: wrong number of params\n");
+        return (false);
+    }
+    return (true);
 }
 
 static char *
 gettrans(name)
     char *name;
 {
-    int i;
+    struct hent *h;
 
     if (eq(name, "0"))
         return (name);
@@ -667,9 +830,9 @@ gettrans(name)
 
 /* gtri - end */
 
-    for (i = 0; table[i].t_old; i++)
-        if (eq(table[i].t_old, name))
-            return (table[i].t_new);
+    /* Only the formals that got an actual node are translated. */
+    if (ports && (h = ht_find(ports, name)) && (h->h_num < numactuals - 1))
+        return (actuals[h->h_num]);
     return (NULL);
 }
 
@@ -678,9 +841,8 @@ numnodes(name)
     char *name;
 {
     char c = (isupper(*name) ? tolower(*name) : *name);
-    struct subs *sss;
+    struct hent *h;
     char *s, *t, buf[BSIZE];
-    wordlist *wl;
     int n, i;
 
     (void) strncpy(buf, name, BSIZE);
@@ -694,20 +856,19 @@ numnodes(name)
         while ((*s != ' ') && (*s != '\t'))
             s--;
         s++;
-        for (sss = subs; sss; sss = sss->su_next)
-            if (eq(sss->su_name, s))
-                break;
-        if (!sss) {
+        if (!subtab || !(h = ht_find(subtab, s))) {
             fprintf(cp_err, "Error: no such subcircuit: %s\n", s);
             return (0);
         }
-        return (sss->su_numargs);
+        return (((struct subs *) h->h_val)->su_numargs);
     }
     n = inp_numnodes(c);
     if (nobjthack || (c != 'q'))
         return (n);
-    for (s = buf, i = 0; *s && (i < 4); i++)
-        (void) gettok(&s);
+    for (s = buf, i = 0; *s && (i < 4); i++) {
+        t = gettok(&s);
+        tfree(t);
+    }
     if (i == 3)
         return (3);
     else if (i < 4) {
@@ -716,10 +877,10 @@ numnodes(name)
     }
     /* Now, is this a model? */
     t = gettok(&s);
-    for (wl = modnames; wl; wl = wl->wl_next)
-        if (eq(t, wl->wl_word))
-            return (3);
-    return (4);
+    i = (t && modnames && ht_find(modnames, t));
+    if (t)
+        tfree(t);
+    return (i ? 3 : 4);
 }
 
 static int 
@@ -742,341 +903,273 @@ numdevs(s)
     }
 }
 
+/* Rename the .model cards in the copy of a subcircuit, and remember the
+ * names in submod so that the devices which use them can be found.
+ * Only the models of this copy go in submod -- a model of the same name
+ * in some other subcircuit has nothing to do with it.
+ */
+
 static bool
 modtranslate(deck, subname)
     struct line *deck;
     char *subname;
 {
     struct line *c;
-    char *buffer, *name, *t, model[BSIZE];
-    wordlist *wl, *wlsub;
+    char *name, *t, model[BSIZE];
     bool gotone;
 
     (void) strcpy(model, ".model");
     gotone = false;
+    if (submod)
+        ht_free(submod);
+    submod = ht_new();
     for (c = deck; c; c = c->li_next) {
         if (prefix(model, c->li_line)) {
             gotone = true;
             t = c->li_line;
             name = gettok(&t);
-            buffer = tmalloc(strlen(name) + strlen(t) +
-                    strlen(subname) + 4);
-            (void) sprintf(buffer, "%s ",name);
+            clen = 0;
+            addstr(name);
+            addch(' ');
+            tfree(name);
             name = gettok(&t);
-            wlsub = alloc(wordlist);
-            wlsub->wl_next = submod;
-            if (submod)
-                submod->wl_prev = wlsub;
-            submod = wlsub;
-            wlsub->wl_word = name;
+            (void) ht_enter(submod, name);
 /* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
 /* reverse order so that innermost name is now first */
-/*
-            (void) sprintf(buffer + strlen(buffer), "%s:%s ",
-                    subname, name);
-*/
-            (void) sprintf(buffer + strlen(buffer), "%s:%s ",
-                    name, subname);
-
+            addname(name, subname);
 /* gtri - end - wbk - 4/10/91 - change way pathnames are built */
-            (void) strcat(buffer, t);
+            tfree(name);
+            addstr(t);
+            addch('\0');
             tfree(c->li_line);
-            c->li_line = buffer;
+            c->li_line = copy(cbuf);
             t = c->li_line;
-            (void) gettok(&t);
-            wl = alloc(wordlist);
-            wl->wl_next = modnames;
-            if (modnames) 
-                modnames->wl_prev = wl;
-            modnames = wl;
-            wl->wl_word = gettok(&t);
+            name = gettok(&t);
+            tfree(name);
+            name = gettok(&t);
+            (void) ht_enter(modnames, name);
+            tfree(name);
         }
     }
     return(gotone);
 }
 
+/* Where the model name is on each kind of card: the number of tokens
+ * before it, and how many tokens after that might be a model (the
+ * resistor and capacitor models are optional, and the BJT model may be
+ * after a substrate node).
+ */
+
 static void
 devmodtranslate(deck, subname)
     struct line *deck;
     char *subname;
 {
     struct line *s;
-    char *buffer, *name, *t, c;
-    wordlist *wlsub;
-    bool found;
+    char *name, *next, *t, c;
+    int skip, nmod, i;
 
     for (s = deck; s; s = s->li_next) {
         t = s->li_line;
         c = isupper(*t) ? tolower(*t) : *t;
-        found = false;
-        buffer = tmalloc(strlen(t) + strlen(subname) + 4);
-            switch (c) {
-        case 'r':
-        case 'c':
-            name = gettok(&t);
-            (void) sprintf(buffer,"%s ",name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            if (*t) {
-                name = gettok(&t);
-            /* Now, is this a subcircuit model? */
-            for (wlsub = submod; wlsub; wlsub = wlsub->wl_next) {
-                    if (eq(name, wlsub->wl_word)) {
-/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* reverse order so that innermost name is now first */
-/*
-                    (void) sprintf(buffer + strlen(buffer),
-                        "%s:%s ", subname, name);
-*/
-                    (void) sprintf(buffer + strlen(buffer),
-                        "%s:%s ", name, subname);
-
-/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
-                    found = true;
-                    break;
-                    }
-                }
-                if (!found)
-                (void) sprintf(buffer + strlen(buffer), "%s ",
-                    name);
-            }
-            found = false;
-            if (*t) {
-                name = gettok(&t);
-                /* Now, is this a subcircuit model? */
-                for (wlsub = submod; wlsub; wlsub = wlsub->wl_next) {
-                if (eq(name, wlsub->wl_word)) {
-/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* reverse order so that innermost name is now first */
-/*
-                (void) sprintf(buffer + strlen(buffer),
-                        "%s:%s ", subname, name);
-*/
-                (void) sprintf(buffer + strlen(buffer),
-                        "%s:%s ", name, subname);
-
-/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
-                    found = true;
-                    break;
-                }
-                }
-                if (!found)
-                (void) sprintf(buffer + strlen(buffer), "%s ", 
-                    name);
-            }
-            (void) strcat(buffer, t);
-            tfree(s->li_line);
-            s->li_line = buffer;
+        switch (c) {
+            case 'r':
+            case 'c':
+            skip = 3;
+            nmod = 2;
             break;
-            case 'd':
-            name = gettok(&t);
-            (void) sprintf(buffer,"%s ",name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            /* Now, is this a subcircuit model? */
-            for (wlsub = submod; wlsub; wlsub = wlsub->wl_next) {
-                if (eq(name, wlsub->wl_word)) {
-/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* reverse order so that innermost name is now first */
-/*
-                (void) sprintf(buffer + strlen(buffer), "%s:%s ", 
-                    subname, name);
-*/
-                (void) sprintf(buffer + strlen(buffer), "%s:%s ",
-                    name, subname);
 
-/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
-                found = true;
-                break;
-                }
-            }
-            if (!found)
-                (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            (void) strcat(buffer, t);
-            tfree(s->li_line);
-            s->li_line = buffer;
+            case 'd':
+            skip = 3;
+            nmod = 1;
             break;
+
             case 'u':
             case 'j':
             case 'z':
-            name = gettok(&t);
-            (void) sprintf(buffer,"%s ",name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            /* Now, is this a subcircuit model? */
-            for (wlsub = submod; wlsub; wlsub = wlsub->wl_next) {
-                if (eq(name, wlsub->wl_word)) {
-/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* reverse order so that innermost name is now first */
-/*
-                (void) sprintf(buffer + strlen(buffer), "%s:%s ", 
-                    subname, name);
-*/
-                (void) sprintf(buffer + strlen(buffer), "%s:%s ",
-                    name, subname);
-
-/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
-                found = true;
-                break;
-                }
-            }
-            if (!found)
-                (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            (void) strcat(buffer, t);
-            tfree(s->li_line);
-            s->li_line = buffer;
+            skip = 4;
+            nmod = 1;
             break;
-            case 'm':
-            name = gettok(&t);
-            (void) sprintf(buffer,"%s ",name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            /* Now, is this a subcircuit model? */
-            for (wlsub = submod; wlsub; wlsub = wlsub->wl_next) {
-                if (eq(name, wlsub->wl_word)) {
-/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* reverse order so that innermost name is now first */
-/*
-                (void) sprintf(buffer + strlen(buffer), "%s:%s ", 
-                    subname, name);
-*/
-                (void) sprintf(buffer + strlen(buffer), "%s:%s ",
-                    name, subname);
 
-/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
-                found = true;
-                break;
-                }
-            }
-            if (!found)
-                (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            (void) strcat(buffer, t);
-            tfree(s->li_line);
-            s->li_line = buffer;
+            case 'm':
+            case 'o':
+            skip = 5;
+            nmod = 1;
             break;
-            case 'q':
-            name = gettok(&t);
-            (void) sprintf(buffer,"%s ",name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            name = gettok(&t);
-            /* Now, is this a subcircuit model? */
-            for (wlsub = submod; wlsub; wlsub = wlsub->wl_next) {
-                if (eq(name, wlsub->wl_word)) {
-/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* reverse order so that innermost name is now first */
-/*
-                (void) sprintf(buffer + strlen(buffer), "%s:%s ", 
-                    subname, name);
-*/
-                (void) sprintf(buffer + strlen(buffer), "%s:%s ",
-                    name, subname);
 
-/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
-                found = true;
-                break;
-                }
-            }
-            if (!found)
-                (void) sprintf(buffer + strlen(buffer), "%s ", name);
-            found = false;
-            if (*t) {
-                name = gettok(&t);
-                /* Now, is this a subcircuit model? */
-                for (wlsub = submod; wlsub; wlsub = wlsub->wl_next) {
-                    if (eq(name, wlsub->wl_word)) {
-/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
-/* reverse order so that innermost name is now first */
-/*
-                    (void) sprintf(buffer + strlen(buffer),
-                            "%s:%s ", subname, name);
-*/
-                    (void) sprintf(buffer + strlen(buffer),
-                            "%s:%s ", name, subname);
-
-/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
-                    found = true;
-                    break;
-                }
-                }
-                if (!found)
-                (void) sprintf(buffer + strlen(buffer), "%s ",
-                    name);
-            }
-            (void) strcat(buffer, t);
-            tfree(s->li_line);
-            s->li_line = buffer;
+            case 'q':
+            skip = 4;
+            nmod = 2;
             break;
 
 /* gtri - modify - wbk - 10/22/90 - add a case for the new 'a' devices */
 
-        case 'a':
+            case 'a':
 
             /* set name to the beginning of the last token on the line */
 
             while(1) {
 
                 name = t;
-                MIFgettok(&t);
+                next = MIFgettok(&t);
+                tfree(next);
 
                 if(*t == '\0')
                     break;
             }
 
             /* copy up to this token into the buffer */
-            strncpy(buffer, s->li_line, name - s->li_line);
-            buffer[name - s->li_line] = '\0';
+            clen = 0;
+            for (t = s->li_line; t < name; t++)
+                addch(*t);
 
             /* eliminate the possibility of trailing white space */
             t = name;
             name = MIFgettok(&t);
 
             /* map name if it matches any .model cards in this subckt */
-            for (wlsub = submod; wlsub; wlsub = wlsub->wl_next) {
-                if (eq(name, wlsub->wl_word)) {
-                sprintf(buffer + strlen(buffer), "%s:%s ", name, subname);
-                    found = true;
-                    break;
-                }
+            if (ht_find(submod, name))
+                addname(name, subname);
+            else {
+                addstr(name);
+                addch(' ');
             }
-            if (!found)
-                sprintf(buffer + strlen(buffer), "%s ", name);
+            tfree(name);
 
+            addch('\0');
             tfree(s->li_line);
-            s->li_line = buffer;
-            break;
+            s->li_line = copy(cbuf);
+            continue;
 
 /* gtri - end - wbk - 10/22/90 */
 
             default:
-            tfree(buffer);
-            break;
+            continue;
+        }
+
+        clen = 0;
+        for (i = 0; i < skip; i++) {
+            name = gettok(&t);
+            if (name == NULL)
+                break;
+            addstr(name);
+            addch(' ');
+            tfree(name);
+        }
+        for (i = 0; (i < nmod) && *t; i++) {
+            name = gettok(&t);
+            /* Now, is this a subcircuit model? */
+/* gtri - modify - wbk - 4/10/91 - change way pathnames are built */
+/* reverse order so that innermost name is now first */
+            if (ht_find(submod, name))
+                addname(name, subname);
+/* gtri - end - wbk - 4/10/91 - change way pathnames are built */
+            else {
+                addstr(name);
+                addch(' ');
+            }
+            tfree(name);
         }
+        addstr(t);
+        addch('\0');
+        tfree(s->li_line);
+        s->li_line = copy(cbuf);
     }
     return;
 }
 
+/* The hash tables. */
+
+static int
+ht_hash(tab, key)
+    struct htab *tab;
+    register char *key;
+{
+    register unsigned int h = 0;
+
+    while (*key)
+        h = h * 31 + (unsigned char) *key++;
+    return (h & (tab->h_size - 1));
+}
+
+static struct htab *
+ht_new()
+{
+    struct htab *tab;
+
+    tab = alloc(htab);
+    tab->h_size = 64;
+    tab->h_tab = (struct hent **) tmalloc(tab->h_size *
+            sizeof (struct hent *));
+    return (tab);
+}
+
+static void
+ht_free(tab)
+    struct htab *tab;
+{
+    struct hent *h, *nh;
+    int i;
+
+    for (i = 0; i < tab->h_size; i++)
+        for (h = tab->h_tab[i]; h; h = nh) {
+            nh = h->h_next;
+            tfree(h->h_key);
+            tfree(h);
+        }
+    tfree(tab->h_tab);
+    tfree(tab);
+    return;
+}
+
+static struct hent *
+ht_find(tab, key)
+    struct htab *tab;
+    char *key;
+{
+    struct hent *h;
+
+    for (h = tab->h_tab[ht_hash(tab, key)]; h; h = h->h_next)
+        if (eq(h->h_key, key))
+            return (h);
+    return (NULL);
+}
+
+/* Add an entry for key, or return the one that is there already. */
+
+static struct hent *
+ht_enter(tab, key)
+    struct htab *tab;
+    char *key;
+{
+    struct hent *h, *nh, **otab;
+    int i, osize;
+
+    if ((h = ht_find(tab, key)) != NULL)
+        return (h);
+    if (tab->h_count >= 2 * tab->h_size) {
+        otab = tab->h_tab;
+        osize = tab->h_size;
+        tab->h_size *= 2;
+        tab->h_tab = (struct hent **) tmalloc(tab->h_size *
+                sizeof (struct hent *));
+        for (i = 0; i < osize; i++)
+            for (h = otab[i]; h; h = nh) {
+                nh = h->h_next;
+                h->h_next = tab->h_tab[ht_hash(tab, h->h_key)];
+                tab->h_tab[ht_hash(tab, h->h_key)] = h;
+            }
+        tfree(otab);
+    }
+    h = alloc(hent);
+    h->h_key = copy(key);
+    i = ht_hash(tab, key);
+    h->h_next = tab->h_tab[i];
+    tab->h_tab[i] = h;
+    tab->h_count++;
+    return (h);
+}
+
 /* This is a spice-dependent thing.  It should probably go somewhere
  * else, but...  Note that we pretend that dependent sources and mutual
  * inductors have more nodes than they really do...
@@ -1117,6 +1210,7 @@ inp_numnodes(c)
         case 'k': return (0);
         case 'l': return (2);
         case 'm': return (4);
+        case 'o': return (4);
         case 'q': return (4);
         case 'r': return (2);
         case 's': return (4);
@@ -54,8 +54,17 @@ Refer to the 2G6 User Guide for an explanation of the coefficients.
 
 This model is patterned after the FORTRAN code used in the 2G6 simulator.
 Function cm_poly() below performs the functions of subroutines NLCSRC and
-EVPOLY.  Function evterm() performs the function of subroutine EVTERM,
-and function nxtpwr() performs the function of subroutine NXTPWR.
+EVPOLY, and function nxtpwr() performs the function of subroutine NXTPWR.
+
+2G6 enumerates the exponents of every term with NXTPWR and raises each
+input to its power with EVTERM for every term, then does it all again for
+each input to get the partials.  Here the exponents are enumerated once
+at initialization into a table of the inputs with non-zero exponents in
+each term (poly_setup()).  Each call then forms the powers of each input
+once, and a single pass over the terms gives the output and all of the
+partials: the partial of a term with respect to one of its inputs is the
+product of its other factors, taken from running products from the left
+and from the right, times n*x**(n-1).
 
 */
 
@@ -65,10 +74,24 @@ and function nxtpwr() performs the function of subroutine NXTPWR.
 void *malloc(int);
 void  free(void *);
 
+/* Table built at initialization - see poly_setup() */
+typedef struct {
+    int     num_factors;  /* Factors with non-zero exponents in all terms */
+    int     *term_start;  /* Index of first factor of each term, and end */
+    int     *factor_in;   /* Input of each factor */
+    int     *factor_exp;  /* Exponent of each factor */
+    int     *factor_pwr;  /* Index in pwr[] of the input to that exponent */
+    int     *pwr_start;   /* Index in pwr[] of each input to the zero power */
+    double  *pwr;         /* Powers of each input, 0 to its highest */
+    double  *left;        /* Running products of a term's factors */
+    double  *partial;     /* Partials being summed */
+} Poly_Table_t;
+
 /* SPICE 2G6 type utility functions */
-static double evterm(double x, int n);
 static void   nxtpwr(int *pwrseq, int pdim);
 
+static void   poly_setup(int num_inputs, int num_coefs);
+
 
 
 
@@ -76,34 +99,37 @@ void icm_poly (ARGS)
 {
     int         num_inputs;   /* Number of inputs to model */
     int         num_coefs;    /* Number of coefficients */
-    int         *exp;         /* List of exponents in products */
-                              /* One for each input */
 
     int         i;            /* Counter */
     int         j;            /* Counter */
     int         k;            /* Counter */
+    int         end;          /* End of the factors of a term or powers */
 
-    double      *in;          /* Values of inputs to model */
-    double      *coef;        /* Values of coefficients    */
-
+    double      x;            /* Value of an input */
+    double      *pwr;         /* Powers of an input */
+    double      coef;         /* Coefficient of a term */
     double      sum;          /* Temporary for accumulating sum of terms */
-    double      product;      /* Temporary for accumulating product */
+    double      right;        /* Product of factors to the right */
 
     double      *acgains;     /* Static variable holding AC gains for AC analysis */
 
+    Poly_Table_t *table;      /* Exponents and storage for the powers */
 
-    /* Get number of input values */
+
+    /* Get number of input values and coefficients */
 
     num_inputs = PORT_SIZE(in);
+    num_coefs = PARAM_SIZE(coef);
 
     /* If this is the first call to the model, allocate the static variable */
-    /* array */
+    /* array and build the table of exponents */
 
     if(INIT) {
         acgains = malloc(num_inputs * sizeof(double));
         for(i = 0; i < num_inputs; i++)
             acgains[i] = 0.0;
         STATIC_VAR(acgains) = acgains;
+        poly_setup(num_inputs, num_coefs);
     }
     else
         acgains = STATIC_VAR(acgains);
@@ -113,116 +139,158 @@ void icm_poly (ARGS)
 
     if(ANALYSIS == MIF_AC) {
         for(i = 0; i < num_inputs; i++) {
-            acgains = STATIC_VAR(acgains);
             AC_GAIN(out,in[i]).real = acgains[i];
             AC_GAIN(out,in[i]).imag = 0.0;
         }
         return;
     }
 
-    /* Get input values and coefficients to local storage for faster access */
+    table = (Poly_Table_t *) cm_static_get_ptr(0);
 
-    in = malloc(num_inputs * sizeof(double));
-    for(i = 0; i < num_inputs; i++)
-        in[i] = INPUT(in[i]);
 
-    num_coefs = PARAM_SIZE(coef);
-
-    coef = malloc(num_coefs * sizeof(double));
-    for(i = 0; i < num_coefs; i++)
-        coef[i] = PARAM(coef[i]);
-
-
-    /* Allocate the array of exponents used in computing the poly terms */
-    exp = malloc(num_inputs * sizeof(int));
+    /* Form the powers of each input up to the highest one used */
+    for(i = 0; i < num_inputs; i++) {
+        x = INPUT(in[i]);
+        pwr = table->pwr + table->pwr_start[i];
+        end = table->pwr_start[i + 1] - table->pwr_start[i];
+        pwr[0] = 1.0;
+        for(j = 1; j < end; j++)
+            pwr[j] = pwr[j - 1] * x;
+        table->partial[i] = 0.0;
+    }
 
-    /* Initialize the exponents to zeros */
-    for(i = 0; i < num_inputs; i++)
-        exp[i] = 0;
 
+    /* Sum the terms and their partials in one pass */
+    sum = PARAM(coef[0]);
 
-    /* Compute the output of the source by summing the required products */
-    for(i = 1, sum = coef[0]; i < num_coefs; i++) {
+    for(i = 1; i < num_coefs; i++) {
 
-        /* Get the list of powers for the product terms in this term of the sum */
-        nxtpwr(exp, num_inputs);
+        coef = PARAM(coef[i]);
+        j = table->term_start[i];
+        end = table->term_start[i + 1];
 
-        /* Form the product of the inputs taken to the required powers */
-        for(j = 0, product = 1.0; j < num_inputs; j++)
-            product *= evterm(in[j], exp[j]);
+        /* Form the product of the inputs taken to the required powers, */
+        /* keeping the product of the factors to the left of each one */
+        table->left[0] = 1.0;
+        for(k = 0; j + k < end; k++)
+            table->left[k + 1] = table->left[k] *
+                                 table->pwr[table->factor_pwr[j + k]];
 
         /* Add the product times the appropriate coefficient into the sum */
-        sum += coef[i] * product;
+        sum += coef * table->left[k];
+
+        /* The partial with respect to each input in the term is the */
+        /* product of the other factors and the derivative n*x**(n-1) */
+        for(right = coef, k--; k >= 0; k--) {
+            table->partial[table->factor_in[j + k]] +=
+                        table->left[k] * right * table->factor_exp[j + k] *
+                        table->pwr[table->factor_pwr[j + k] - 1];
+            right *= table->pwr[table->factor_pwr[j + k]];
+        }
     }
     OUTPUT(out) = sum;
 
 
-    /* Compute and output the partials for each input */
+    /* Output the partials for each input */
     for(i = 0; i < num_inputs; i++) {
 
-        /* Reinitialize the exponent list to zeros */
-        for(j = 0; j < num_inputs; j++)
-            exp[j] = 0;
-
-        /* Compute the partials by summing the required products */
-        for(j = 1, sum = 0.0; j < num_coefs; j++) {
-
-            /* Get the list of powers for the product terms in this term of the sum */
-            nxtpwr(exp, num_inputs);
-
-            /* If power for input for which partial is being evaluated */
-            /* is zero, the term is a constant, so the partial is zero */
-            if(exp[i] == 0)
-                continue;
-
-            /* Form the product of the inputs taken to the required powers */
-            for(k = 0, product = 1.0; k < num_inputs; k++) {
-                /* If input is not the one for which the partial is being taken */
-                /* take the term to the specified exponent */
-                if(k != i)
-                    product *= evterm(in[k], exp[k]);
-                /* else, take the derivative of this term as n*x**(n-1) */
-                else
-                    product *= exp[k] * evterm(in[k], exp[k] - 1);
-            }
-
-            /* Add the product times the appropriate coefficient into the sum */
-            sum += coef[j] * product;
-        }
-
-        PARTIAL(out,in[i]) = sum;
+        PARTIAL(out,in[i]) = table->partial[i];
 
         /* If this is DC analysis, save the partial for use as AC gain */
         /* value in an AC analysis */
 
         if(ANALYSIS == MIF_DC)
-            acgains[i] = sum;
+            acgains[i] = table->partial[i];
     }
 
-    /* Free the allocated items and return */
-    free(in);
-    free(coef);
-    free(exp);
-
     return;
 }
 
 
-/* Function evterm computes the value of x**n */
 
-static double evterm(
-    double x,
-    int n)
+/*
+poly_setup
+
+Enumerate the exponents of the terms in 2G6 order and build the table
+used by each call.  The first term is the constant, so it has no factors.
+*/
+
+static void poly_setup(
+    int num_inputs,        /* Number of inputs to model */
+    int num_coefs)         /* Number of coefficients */
 {
-    double product;       /* Temporary accumlator for forming the product */
+    Poly_Table_t *table;   /* The table being built */
+    int          *exp;     /* Exponents of the current term */
+    int          *max_exp; /* Highest exponent of each input */
+    int          num_pwrs; /* Total size of the power tables */
+    int          *ints;    /* Storage for the integer arrays */
+    double       *doubles; /* Storage for the double arrays */
+    int          i;        /* Counter */
+    int          j;        /* Counter */
+    int          n;        /* Counter */
+
+
+    table = (Poly_Table_t *) cm_static_alloc(0, sizeof(Poly_Table_t));
+
+    exp = malloc(2 * num_inputs * sizeof(int));
+    max_exp = exp + num_inputs;
+
+    /* Count the factors and find the highest power of each input */
+    for(i = 0; i < num_inputs; i++)
+        exp[i] = max_exp[i] = 0;
+    for(i = 1, n = 0; i < num_coefs; i++) {
+        nxtpwr(exp, num_inputs);
+        for(j = 0; j < num_inputs; j++) {
+            if(exp[j] != 0)
+                n++;
+            if(exp[j] > max_exp[j])
+                max_exp[j] = exp[j];
+        }
+    }
+    table->num_factors = n;
+    for(i = 0, num_pwrs = 0; i < num_inputs; i++)
+        num_pwrs += max_exp[i] + 1;
+
+    /* Allocate the arrays */
+    ints = (int *) cm_static_alloc(1, (num_coefs + 1 + 3 * n +
+                                       num_inputs + 1) * sizeof(int));
+    table->term_start = ints;
+    table->factor_in = table->term_start + num_coefs + 1;
+    table->factor_exp = table->factor_in + n;
+    table->factor_pwr = table->factor_exp + n;
+    table->pwr_start = table->factor_pwr + n;
+
+    doubles = (double *) cm_static_alloc(2, (num_pwrs + 2 * num_inputs + 1) *
+                                            sizeof(double));
+    table->pwr = doubles;
+    table->left = table->pwr + num_pwrs;
+    table->partial = table->left + num_inputs + 1;
+
+    for(i = 0, n = 0; i < num_inputs; i++) {
+        table->pwr_start[i] = n;
+        n += max_exp[i] + 1;
+    }
+    table->pwr_start[num_inputs] = n;
 
-    product = 1.0;
-    while(n > 0) {
-        product *= x;
-        n--;
+    /* Enumerate the terms again and record their factors */
+    for(i = 0; i < num_inputs; i++)
+        exp[i] = 0;
+    table->term_start[0] = 0;
+    table->term_start[1] = 0;
+    for(i = 1, n = 0; i < num_coefs; i++) {
+        nxtpwr(exp, num_inputs);
+        for(j = 0; j < num_inputs; j++) {
+            if(exp[j] == 0)
+                continue;
+            table->factor_in[n] = j;
+            table->factor_exp[n] = exp[j];
+            table->factor_pwr[n] = table->pwr_start[j] + exp[j];
+            n++;
+        }
+        table->term_start[i + 1] = n;
     }
 
-    return(product);
+    free(exp);
 }
 
 
@@ -0,0 +1,79 @@
+/*
+ * Lossy (RLGC) transmission line
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "IFsim.h"
+#include "INPdefs.h"
+#include "INPmacs.h"
+#ifndef CMS
+#include "FTEextern.h"
+#else  /* CMS */
+#include "FTEexter.h"
+#endif /* CMS */
+#include "suffix.h"
+
+void
+INP2O(ckt,tab,current)
+    GENERIC *ckt;
+    INPtables *tab;
+    card *current;
+
+{
+
+    /* Oname <node> <node> <node> <node> <model> */
+
+int mytype; /* the type my lookup says LTRA is */
+char *line; /* the part of the current line left to parse */
+char *name; /* the line's name */
+char *nname1;   /* the first node's name */
+char *nname2;   /* the second node's name */
+char *nname3;   /* the third node's name */
+char *nname4;   /* the fourth node's name */
+GENERIC *node1; /* the first node's node pointer */
+GENERIC *node2; /* the second node's node pointer */
+GENERIC *node3; /* the third node's node pointer */
+GENERIC *node4; /* the fourth node's node pointer */
+int error;      /* error code temporary */
+GENERIC *fast;  /* pointer to the actual instance */
+int waslead;    /* flag to indicate that funny unlabeled number was found */
+double leadval; /* actual value of unlabeled number */
+char *model;    /* name of the model */
+INPmodel *thismodel;    /* pointer to our model descriptor */
+
+    mytype = INPtypelook("LTRA");
+    if(mytype < 0 ) {
+        LITERR("Device type LTRA not supported by this binary\n")
+        return;
+    }
+    line = current->line;
+    INPgetTok(&line,&name,1);
+    INPinsert(&name,tab);
+    INPgetTok(&line,&nname1,1);
+    INPtermInsert(ckt,&nname1,tab,&node1);
+    INPgetTok(&line,&nname2,1);
+    INPtermInsert(ckt,&nname2,tab,&node2);
+    INPgetTok(&line,&nname3,1);
+    INPtermInsert(ckt,&nname3,tab,&node3);
+    INPgetTok(&line,&nname4,1);
+    INPtermInsert(ckt,&nname4,tab,&node4);
+    INPgetTok(&line,&model,1);
+    INPinsert(&model,tab);
+    current->error = INPgetMod(ckt,model,&thismodel,tab);
+    if(thismodel == NULL) {
+        /* there is no sensible default for a lossy line */
+        LITERR("lossy line needs a model\n")
+        return;
+    }
+    if(mytype != thismodel->INPmodType) {
+        LITERR("incorrect model type")
+        return;
+    }
+    IFC(newInstance,(ckt,thismodel->INPmodfast,&fast,name))
+    IFC(bindNode,(ckt,fast,1,node1))
+    IFC(bindNode,(ckt,fast,2,node2))
+    IFC(bindNode,(ckt,fast,3,node3))
+    IFC(bindNode,(ckt,fast,4,node4))
+    PARSECALL((&line,ckt,mytype,fast,&leadval,&waslead,tab))
+}
@@ -0,0 +1,1221 @@
+/*
+ * Copyright (c) 1985 Thomas L. Quarles
+ */
+
+    /*
+     * Compiled deck cache.
+     *
+     * Parsing a deck with INPpas1/INPpas2 ends up as a series of calls
+     * through the IFsimulator structure - make a node, make a model, set
+     * a parameter on it, make an instance, bind its terminals, and so on.
+     * While a deck is parsed we stand in for ft_sim and write each of
+     * those calls down, with the objects they refer to numbered in the
+     * order they were made.  If the deck parsed cleanly the list is saved
+     * in a file named after a hash of the deck, and the next time the same
+     * deck comes along the calls are simply made again from the file,
+     * which skips all of the parsing, model lookups and number scanning.
+     *
+     * The deck is the flattened one, with the .include files and the
+     * subcircuits already expanded, so a change to any of the files it
+     * came from changes the key.  The full text of the deck is also kept
+     * in the file and compared, so the hash is only used to find it.
+     */
+
+#include "prefix.h"
+#include <stdio.h>
+#include "INPdefs.h"
+#include "util.h"
+#include "IFsim.h"
+#include "IFerrmsgs.h"
+#include "CPstd.h"
+#ifndef CMS
+#include "FTEextern.h"
+#else  /* CMS */
+#include "FTEexter.h"
+#endif /* CMS */
+#include "suffix.h"
+
+#define CACHEMAGIC "XSPICE compiled deck 1\n"
+
+    /* the calls we keep */
+#define C_NODE 'N'      /* newNode name -> handle */
+#define C_GND 'G'       /* groundNode name -> handle */
+#define C_BIND 'B'      /* bindNode instance terminal node */
+#define C_MODEL 'M'     /* newModel type name -> handle */
+#define C_INST 'I'      /* newInstance model name -> handle */
+#define C_TASK 'T'      /* newTask name -> handle */
+#define C_ANAL 'A'      /* newAnalysis type name task -> handle */
+#define C_MPARM 'm'     /* setModelParm model parm value */
+#define C_IPARM 'i'     /* setInstanceParm instance parm value */
+#define C_APARM 'a'     /* setAnalysisParm analysis parm value */
+#define C_NPARM 'n'     /* setNodeParm node parm value */
+
+    /* the objects made while recording, found by address */
+typedef struct sINPcobj {
+    GENERIC *CObj;
+    int CHandle;
+    int CType;              /* device or analysis type, -1 otherwise */
+    struct sINPcobj *CNext;
+} INPcobj;
+
+#define CHASHSIZE 4096
+
+static IFsimulator *INPrealSim;     /* the one we stand in for */
+static IFsimulator INPcacheSim;
+static INPcobj **INPcobjs;
+static int INPnumHandles;
+static int INPcacheBad;             /* something we can't write down */
+
+    /* the buffer the calls are written into, or read out of */
+static char *INPcbuf;
+static int INPclen;
+static int INPcsize;
+static int INPcpos;
+
+static int INPcnewNode();
+static int INPcgroundNode();
+static int INPcbindNode();
+static int INPcsetNodeParm();
+static int INPcnewInstance();
+static int INPcsetInstanceParm();
+static int INPcnewModel();
+static int INPcsetModelParm();
+static int INPcnewTask();
+static int INPcnewAnalysis();
+static int INPcsetAnalysisParm();
+static int INPcfindNode();
+static int INPcinstToNode();
+static int INPcfindInstance();
+static int INPcfindModel();
+static int INPcfindAnalysis();
+static int INPcfindTask();
+static int INPcdeleteNode();
+static int INPcdeleteInstance();
+static int INPcdeleteModel();
+static int INPcdeleteTask();
+static void INPcput();
+static void INPcint();
+static void INPcstr();
+static int INPcget();
+static int INPcgetInt();
+static char *INPcgetStr();
+static int INPchandle();
+static INPcobj *INPcfind();
+static void INPcadd();
+static void INPcputVal();
+static int INPcgetVal();
+static int INPcparmType();
+static void INPcident();
+static char *INPcname();
+static int INPcreplay();
+
+    /* start writing down what the parser does to the circuit */
+void
+INPcacheStart(ckt,data,task,opt)
+    GENERIC *ckt;
+    card *data;
+    GENERIC *task;
+    GENERIC *opt;
+{
+    card *current;
+    int i;
+
+    INPcacheBad = 0;
+    INPclen = 0;
+    INPnumHandles = 0;
+    INPrealSim = (IFsimulator *)NULL;
+    for(current = data; current != NULL; current = current->nextcard) {
+        if(*(current->line) == 'a' || *(current->line) == 'A') {
+            /* code model instances are built up directly by MIF_INP2A,
+             * not through ft_sim, so there is nothing we could replay */
+            INPcacheBad = 1;
+            return;
+        }
+    }
+    INPcobjs = (INPcobj **)MALLOC(CHASHSIZE * sizeof(INPcobj *));
+    if(INPcobjs == (INPcobj **)NULL) {
+        INPcacheBad = 1;
+        return;
+    }
+
+    /* the default task and options exist before the deck is read, so
+     * they are always handles 0 and 1 */
+    INPcadd(task, -1);
+    for(i=0;i<ft_sim->numAnalyses;i++) {
+        if(strcmp(ft_sim->analyses[i]->name,"options")==0) break;
+    }
+    INPcadd(opt, i < ft_sim->numAnalyses ? i : -1);
+
+    INPrealSim = ft_sim;
+    INPcacheSim = *ft_sim;
+    INPcacheSim.newNode = INPcnewNode;
+    INPcacheSim.groundNode = INPcgroundNode;
+    INPcacheSim.bindNode = INPcbindNode;
+    INPcacheSim.findNode = INPcfindNode;
+    INPcacheSim.instToNode = INPcinstToNode;
+    INPcacheSim.setNodeParm = INPcsetNodeParm;
+    INPcacheSim.deleteNode = INPcdeleteNode;
+    INPcacheSim.newInstance = INPcnewInstance;
+    INPcacheSim.setInstanceParm = INPcsetInstanceParm;
+    INPcacheSim.findInstance = INPcfindInstance;
+    INPcacheSim.deleteInstance = INPcdeleteInstance;
+    INPcacheSim.newModel = INPcnewModel;
+    INPcacheSim.setModelParm = INPcsetModelParm;
+    INPcacheSim.findModel = INPcfindModel;
+    INPcacheSim.deleteModel = INPcdeleteModel;
+    INPcacheSim.newTask = INPcnewTask;
+    INPcacheSim.newAnalysis = INPcnewAnalysis;
+    INPcacheSim.setAnalysisParm = INPcsetAnalysisParm;
+    INPcacheSim.findAnalysis = INPcfindAnalysis;
+    INPcacheSim.findTask = INPcfindTask;
+    INPcacheSim.deleteTask = INPcdeleteTask;
+    ft_sim = &INPcacheSim;
+}
+
+
+    /* stop writing things down, and if the deck went in without any
+     * complaints, save what we have in the cache directory */
+void
+INPcacheSave(data,dir)
+    card *data;
+    char *dir;
+{
+    card *current;
+    INPcobj *o, *next;
+    FILE *fp;
+    char *name;
+    char *temp;
+    int numCards;
+    int i;
+
+    if(INPrealSim) ft_sim = INPrealSim;
+    INPrealSim = (IFsimulator *)NULL;
+    if(INPcobjs) {
+        for(i=0;i<CHASHSIZE;i++) {
+            for(o = INPcobjs[i]; o != NULL; o = next) {
+                next = o->CNext;
+                FREE(o);
+            }
+        }
+        FREE(INPcobjs);
+    }
+    for(current = data; current != NULL; current = current->nextcard) {
+        if(current->error) INPcacheBad = 1;
+    }
+    if(INPcacheBad) return;
+
+    name = INPcname(data,dir);
+    if(name == NULL) return;
+    temp = MALLOC(strlen(name) + 16);
+    if(temp == NULL) {
+        FREE(name);
+        return;
+    }
+    /* write it under another name first, so that another run reading
+     * the same deck never sees half a file */
+    sprintf(temp,"%s.%d",name,getpid());
+    fp = fopen(temp,"w");
+    if(fp == (FILE *)NULL) {
+        FREE(temp);
+        FREE(name);
+        return;
+    }
+
+    /* the records are still in the buffer - write the header after
+     * them and put it out first */
+    i = INPclen;
+    INPcident();
+    for(numCards = 0, current = data; current != NULL;
+            current = current->nextcard) {
+        numCards++;
+    }
+    INPcint(numCards);
+    for(current = data; current != NULL; current = current->nextcard) {
+        INPcstr(current->line);
+    }
+    INPcint(INPnumHandles);
+    INPcint(i);
+    if(fwrite(CACHEMAGIC, 1, sizeof(CACHEMAGIC), fp) != sizeof(CACHEMAGIC) ||
+            fwrite(INPcbuf + i, 1, INPclen - i, fp) != INPclen - i ||
+            fwrite(INPcbuf, 1, i, fp) != i) {
+        (void)fclose(fp);
+        (void)unlink(temp);
+    } else if(fclose(fp) != 0 || rename(temp,name) != 0) {
+        (void)unlink(temp);
+    }
+    INPclen = 0;
+    FREE(temp);
+    FREE(name);
+}
+
+
+    /* build the circuit from the cache if we have this deck in it.
+     * returns OK if so, E_NOTFOUND if the deck has to be parsed after all,
+     * and anything else if the cache went bad part way through
+     */
+int
+INPcacheLoad(ckt,data,tab,task,opt,dir)
+    GENERIC *ckt;
+    card *data;
+    INPtables *tab;
+    GENERIC *task;
+    GENERIC *opt;
+    char *dir;
+{
+    card *current;
+    FILE *fp;
+    char *name;
+    char *s;
+    long size;
+    int identLen;
+    int len;
+    int numCards;
+    int numHandles;
+    int recLen;
+    int error;
+
+    name = INPcname(data,dir);
+    if(name == NULL) return(E_NOTFOUND);
+    fp = fopen(name,"r");
+    FREE(name);
+    if(fp == (FILE *)NULL) return(E_NOTFOUND);
+    if(fseek(fp, 0L, 2) != 0 || (size = ftell(fp)) <= 0 ||
+            fseek(fp, 0L, 0) != 0) {
+        (void)fclose(fp);
+        return(E_NOTFOUND);
+    }
+
+    /* what this simulator would have written goes first in the buffer,
+     * and the file after it */
+    INPclen = 0;
+    INPcident();
+    identLen = INPclen;
+    INPcput((char *)NULL, (int)size);
+    if(INPclen != identLen + size ||
+            fread(INPcbuf + identLen, 1, (int)size, fp) != size) {
+        (void)fclose(fp);
+        return(E_NOTFOUND);
+    }
+    (void)fclose(fp);
+
+    /* is it from this simulator? */
+    INPcpos = identLen;
+    if(INPcget(&s, sizeof(CACHEMAGIC)) ||
+            memcmp(s, CACHEMAGIC, sizeof(CACHEMAGIC)) != 0 ||
+            INPcget(&s, identLen) || memcmp(s, INPcbuf, identLen) != 0) {
+        return(E_NOTFOUND);
+    }
+
+    /* and of this deck? */
+    if(INPcgetInt(&numCards)) return(E_NOTFOUND);
+    for(current = data; current != NULL; current = current->nextcard) {
+        if(numCards-- <= 0) return(E_NOTFOUND);
+        if(INPcgetInt(&len) || len != strlen(current->line) ||
+                INPcget(&s, len) || strncmp(s, current->line, len) != 0) {
+            return(E_NOTFOUND);
+        }
+    }
+    if(numCards != 0) return(E_NOTFOUND);
+    if(INPcgetInt(&numHandles) || INPcgetInt(&recLen) || numHandles < 2 ||
+            recLen != INPclen - INPcpos) {
+        return(E_NOTFOUND);
+    }
+
+    /* go over the records once without doing anything, so that a
+     * damaged file is found before the circuit has been touched */
+    error = INPcreplay((GENERIC *)NULL, (INPtables *)NULL, task, opt,
+            INPcpos, numHandles);
+    if(error) return(E_NOTFOUND);
+    return(INPcreplay(ckt, tab, task, opt, INPclen - recLen, numHandles));
+}
+
+
+    /* make the calls in the buffer from 'start' on again.  With no
+     * circuit, just check that they make sense. */
+static int
+INPcreplay(ckt,tab,task,opt,start,numHandles)
+    GENERIC *ckt;
+    INPtables *tab;
+    GENERIC *task;
+    GENERIC *opt;
+    int start;
+    int numHandles;
+{
+    GENERIC **handles;
+    GENERIC *obj;
+    IFvalue value;
+    char *s;
+    char *name;
+    int next;
+    int op;
+    int a, b, c;
+    int error;
+
+    handles = (GENERIC **)MALLOC(numHandles * sizeof(GENERIC *));
+    if(handles == (GENERIC **)NULL) return(E_NOMEM);
+    handles[0] = task;
+    handles[1] = opt;
+    next = 2;
+    error = OK;
+    INPcpos = start;
+
+#define HANDLE(h) if(INPcgetInt(&h) || h < 0 || h >= next) { \
+        error = E_PANIC; break; }
+#define NEWHANDLE if(next >= numHandles) { error = E_PANIC; break; }
+#define NAME if((name = INPcgetStr()) == NULL) { error = E_PANIC; break; }
+
+    while(error == OK && INPcpos < INPclen) {
+        if(INPcget(&s, 1)) {
+            error = E_PANIC;
+            break;
+        }
+        op = *s;
+        switch(op) {
+
+        case C_NODE:
+        case C_GND:
+            NAME
+            NEWHANDLE
+            if(ckt) {
+                if(op == C_NODE) {
+                    error = INPtermInsert(ckt,&name,tab,&handles[next]);
+                } else {
+                    error = INPgndInsert(ckt,&name,tab,&handles[next]);
+                }
+            } else FREE(name);
+            next++;
+            break;
+
+        case C_BIND:
+            HANDLE(a)
+            if(INPcgetInt(&b)) {
+                error = E_PANIC;
+                break;
+            }
+            HANDLE(c)
+            if(ckt) error = (*(ft_sim->bindNode))(ckt,handles[a],b,
+                    handles[c]);
+            break;
+
+        case C_MODEL:
+            if(INPcgetInt(&a) || a < 0 || a >= ft_sim->numDevices) {
+                error = E_PANIC;
+                break;
+            }
+            NAME
+            NEWHANDLE
+            if(ckt) {
+                (void)INPinsert(&name,tab);
+                error = (*(ft_sim->newModel))(ckt,a,&handles[next],
+                        (IFuid)name);
+            } else FREE(name);
+            next++;
+            break;
+
+        case C_INST:
+            HANDLE(a)
+            NAME
+            NEWHANDLE
+            if(ckt) {
+                (void)INPinsert(&name,tab);
+                error = (*(ft_sim->newInstance))(ckt,handles[a],
+                        &handles[next],(IFuid)name);
+            } else FREE(name);
+            next++;
+            break;
+
+        case C_TASK:
+            NAME
+            NEWHANDLE
+            if(ckt) {
+                (void)INPinsert(&name,tab);
+                error = (*(ft_sim->newTask))(ckt,&handles[next],
+                        (IFuid)name);
+            } else FREE(name);
+            next++;
+            break;
+
+        case C_ANAL:
+            if(INPcgetInt(&a) || a < 0 || a >= ft_sim->numAnalyses) {
+                error = E_PANIC;
+                break;
+            }
+            NAME
+            HANDLE(b)
+            NEWHANDLE
+            if(ckt) {
+                (void)INPinsert(&name,tab);
+                error = (*(ft_sim->newAnalysis))(ckt,a,(IFuid)name,
+                        &handles[next],handles[b]);
+            } else FREE(name);
+            next++;
+            break;
+
+        case C_MPARM:
+        case C_IPARM:
+        case C_APARM:
+        case C_NPARM:
+            HANDLE(a)
+            if(INPcgetInt(&b)) {
+                error = E_PANIC;
+                break;
+            }
+            error = INPcgetVal(&value,tab,handles,next);
+            if(error || ckt == NULL) break;
+            obj = handles[a];
+            switch(op) {
+            case C_MPARM:
+                error = (*(ft_sim->setModelParm))(ckt,obj,b,&value,
+                        (IFvalue *)NULL);
+                break;
+            case C_IPARM:
+                error = (*(ft_sim->setInstanceParm))(ckt,obj,b,&value,
+                        (IFvalue *)NULL);
+                break;
+            case C_APARM:
+                error = (*(ft_sim->setAnalysisParm))(ckt,obj,b,&value,
+                        (IFvalue *)NULL);
+                break;
+            case C_NPARM:
+                error = (*(ft_sim->setNodeParm))(ckt,obj,b,&value,
+                        (IFvalue *)NULL);
+                break;
+            }
+            break;
+
+        default:
+            error = E_PANIC;
+            break;
+        }
+        if(error == E_EXISTS) error = OK;
+    }
+#undef HANDLE
+#undef NEWHANDLE
+#undef NAME
+
+    FREE(handles);
+    return(error);
+}
+
+
+    /* the name of the cache file for this deck, in malloc'd space */
+static char *
+INPcname(data,dir)
+    card *data;
+    char *dir;
+{
+    card *current;
+    register unsigned long h1, h2;
+    register char *s;
+    char *name;
+    int start;
+    int i;
+
+    /* two different hashes of the whole deck and of what we know about
+     * the simulator - 64 bits is plenty to keep the decks apart, and the
+     * text is checked anyway */
+    h1 = 2166136261L;
+    h2 = 0;
+    start = INPclen;
+    INPcident();
+    for(i = start; i < INPclen; i++) {
+        h1 = ((h1 ^ (unsigned char)INPcbuf[i]) * 16777619L) & 0xffffffffL;
+        h2 = (h2 * 31 + (unsigned char)INPcbuf[i]) & 0xffffffffL;
+    }
+    INPclen = start;
+    for(current = data; current != NULL; current = current->nextcard) {
+        for(s = current->line; *s; s++) {
+            h1 = ((h1 ^ (unsigned char)*s) * 16777619L) & 0xffffffffL;
+            h2 = (h2 * 31 + (unsigned char)*s) & 0xffffffffL;
+        }
+        h1 = ((h1 ^ '\n') * 16777619L) & 0xffffffffL;
+        h2 = (h2 * 31 + '\n') & 0xffffffffL;
+    }
+    name = MALLOC(strlen(dir) + 32);
+    if(name == NULL) return(NULL);
+    sprintf(name,"%s/%08lx%08lx.ckc",dir,h1,h2);
+    return(name);
+}
+
+
+    /* append what identifies this simulator to the buffer - the handles
+     * in the file are device and analysis type numbers and parameter
+     * ids, so they are only good for the binary that wrote them */
+static void
+INPcident()
+{
+    IFdevice *dev;
+    int i;
+
+    INPcint((int)sizeof(int));
+    INPcint((int)sizeof(double));
+    INPcint(0x01020304);
+    INPcstr(ft_sim->simulator);
+    INPcstr(ft_sim->version);
+    INPcint(ft_sim->numDevices);
+    for(i=0;i<ft_sim->numDevices;i++) {
+        dev = ft_sim->devices[i];
+        INPcstr(dev->name);
+        INPcint(dev->numInstanceParms);
+        INPcint(dev->numModelParms);
+        INPcint(dev->numNames);
+    }
+    INPcint(ft_sim->numAnalyses);
+    for(i=0;i<ft_sim->numAnalyses;i++) {
+        INPcstr(ft_sim->analyses[i]->name);
+        INPcint(ft_sim->analyses[i]->numParms);
+    }
+    INPcint(ft_sim->numNodeParms);
+}
+
+
+    /* the buffer */
+
+static void
+INPcput(p,n)
+    char *p;
+    int n;
+{
+    char *new;
+
+    if(INPclen + n > INPcsize) {
+        if(INPcsize == 0) INPcsize = 1024;
+        while(INPclen + n > INPcsize) INPcsize *= 2;
+        if(INPcbuf) {
+            new = REALLOC(INPcbuf, INPcsize);
+        } else {
+            new = MALLOC(INPcsize);
+        }
+        if(new == NULL) {
+            INPcacheBad = 1;
+            INPcsize = 0;
+            if(INPcbuf) FREE(INPcbuf);
+            INPclen = 0;
+            return;
+        }
+        INPcbuf = new;
+    }
+    if(p) bcopy(p, INPcbuf + INPclen, n);
+    INPclen += n;
+}
+
+static void
+INPcint(i)
+    int i;
+{
+    INPcput((char *)&i, sizeof(int));
+}
+
+static void
+INPcstr(s)
+    char *s;
+{
+    int len;
+
+    len = s ? strlen(s) : -1;
+    INPcint(len);
+    if(len > 0) INPcput(s, len);
+}
+
+static int
+INPcget(p,n)
+    char **p;
+    int n;
+{
+    if(n < 0 || INPcpos + n > INPclen) return(1);
+    *p = INPcbuf + INPcpos;
+    INPcpos += n;
+    return(0);
+}
+
+static int
+INPcgetInt(i)
+    int *i;
+{
+    char *s;
+
+    if(INPcget(&s, sizeof(int))) return(1);
+    bcopy(s, (char *)i, sizeof(int));
+    return(0);
+}
+
+    /* a string from the buffer, in malloc'd space */
+static char *
+INPcgetStr()
+{
+    char *s;
+    char *str;
+    int len;
+
+    if(INPcgetInt(&len) || len < 0 || INPcget(&s, len)) return(NULL);
+    str = MALLOC(len + 1);
+    if(str == NULL) return(NULL);
+    bcopy(s, str, len);
+    str[len] = '\0';
+    return(str);
+}
+
+
+    /* the objects made while recording */
+
+static INPcobj *
+INPcfind(obj)
+    GENERIC *obj;
+{
+    INPcobj *o;
+
+    for(o = INPcobjs[((unsigned long)obj >> 4) % CHASHSIZE]; o != NULL;
+            o = o->CNext) {
+        if(o->CObj == obj) return(o);
+    }
+    return((INPcobj *)NULL);
+}
+
+static void
+INPcadd(obj,type)
+    GENERIC *obj;
+    int type;
+{
+    INPcobj *o;
+    int key;
+
+    o = (INPcobj *)MALLOC(sizeof(INPcobj));
+    if(o == (INPcobj *)NULL) {
+        INPcacheBad = 1;
+        return;
+    }
+    key = ((unsigned long)obj >> 4) % CHASHSIZE;
+    o->CObj = obj;
+    o->CHandle = INPnumHandles++;
+    o->CType = type;
+    o->CNext = INPcobjs[key];
+    INPcobjs[key] = o;
+}
+
+    /* write down the handle of something made earlier */
+static int
+INPchandle(obj)
+    GENERIC *obj;
+{
+    INPcobj *o;
+
+    o = INPcfind(obj);
+    if(o == (INPcobj *)NULL) {
+        /* made somewhere we didn't see */
+        INPcacheBad = 1;
+        INPcint(-1);
+        return(-1);
+    }
+    INPcint(o->CHandle);
+    return(o->CType);
+}
+
+    /* the data type of a parameter, or 0 if we don't know it */
+static int
+INPcparmType(parms,num,id)
+    IFparm *parms;
+    int num;
+    int id;
+{
+    int i;
+
+    for(i=0;i<num;i++) {
+        if(parms[i].id == id && (parms[i].dataType & IF_SET)) {
+            return(parms[i].dataType & IF_VARTYPES);
+        }
+    }
+    return(0);
+}
+
+
+    /* parameter values */
+
+static void
+INPcputVal(type,val)
+    int type;
+    IFvalue *val;
+{
+    int n;
+    int i;
+
+    INPcint(type);
+    if(type & IF_VECTOR) {
+        n = val->v.numValue;
+        INPcint(n);
+    } else {
+        n = 1;
+    }
+    for(i = 0; i < n; i++) {
+        switch(type & ~IF_VECTOR) {
+        case IF_FLAG:
+        case IF_INTEGER:
+            INPcint((type & IF_VECTOR) ? val->v.vec.iVec[i] : val->iValue);
+            break;
+        case IF_REAL:
+            INPcput((char *)((type & IF_VECTOR) ? &val->v.vec.rVec[i] :
+                    &val->rValue), sizeof(double));
+            break;
+        case IF_COMPLEX:
+            INPcput((char *)((type & IF_VECTOR) ? &val->v.vec.cVec[i] :
+                    &val->cValue), sizeof(IFcomplex));
+            break;
+        case IF_STRING:
+            INPcstr((type & IF_VECTOR) ? val->v.vec.sVec[i] : val->sValue);
+            break;
+        case IF_INSTANCE:
+            INPcstr((char *)((type & IF_VECTOR) ? val->v.vec.uVec[i] :
+                    val->uValue));
+            break;
+        case IF_NODE:
+            (void)INPchandle((GENERIC *)((type & IF_VECTOR) ?
+                    val->v.vec.nVec[i] : val->nValue));
+            break;
+        default:
+            /* parse trees and whatever else */
+            INPcacheBad = 1;
+            return;
+        }
+    }
+}
+
+static int
+INPcgetVal(val,tab,handles,next)
+    IFvalue *val;
+    INPtables *tab;
+    GENERIC **handles;
+    int next;
+{
+    char *s;
+    char *str;
+    int type;
+    int n;
+    int h;
+    int i;
+
+    if(INPcgetInt(&type)) return(E_PANIC);
+    if(type & IF_VECTOR) {
+        if(INPcgetInt(&n) || n < 0) return(E_PANIC);
+        val->v.numValue = n;
+        switch(type & ~IF_VECTOR) {
+        case IF_FLAG:
+        case IF_INTEGER:
+            val->v.vec.iVec = (int *)MALLOC((n+1) * sizeof(int));
+            break;
+        case IF_REAL:
+            val->v.vec.rVec = (double *)MALLOC((n+1) * sizeof(double));
+            break;
+        case IF_COMPLEX:
+            val->v.vec.cVec = (IFcomplex *)MALLOC((n+1) * sizeof(IFcomplex));
+            break;
+        case IF_STRING:
+        case IF_INSTANCE:
+        case IF_NODE:
+            val->v.vec.sVec = (char **)MALLOC((n+1) * sizeof(char *));
+            break;
+        default:
+            return(E_PANIC);
+        }
+        if(val->v.vec.sVec == (char **)NULL) return(E_NOMEM);
+    } else {
+        n = 1;
+    }
+    for(i = 0; i < n; i++) {
+        switch(type & ~IF_VECTOR) {
+        case IF_FLAG:
+        case IF_INTEGER:
+            if(INPcgetInt((type & IF_VECTOR) ? &val->v.vec.iVec[i] :
+                    &val->iValue)) return(E_PANIC);
+            break;
+        case IF_REAL:
+            if(INPcget(&s, sizeof(double))) return(E_PANIC);
+            bcopy(s, (char *)((type & IF_VECTOR) ? &val->v.vec.rVec[i] :
+                    &val->rValue), sizeof(double));
+            break;
+        case IF_COMPLEX:
+            if(INPcget(&s, sizeof(IFcomplex))) return(E_PANIC);
+            bcopy(s, (char *)((type & IF_VECTOR) ? &val->v.vec.cVec[i] :
+                    &val->cValue), sizeof(IFcomplex));
+            break;
+        case IF_STRING:
+        case IF_INSTANCE:
+            str = INPcgetStr();
+            if(str == NULL) return(E_PANIC);
+            if((type & ~IF_VECTOR) == IF_INSTANCE) {
+                if(tab) (void)INPinsert(&str,tab);
+                else FREE(str);
+            } else if(tab == NULL) {
+                FREE(str);
+            }
+            if(type & IF_VECTOR) val->v.vec.sVec[i] = str;
+            else val->sValue = str;
+            break;
+        case IF_NODE:
+            if(INPcgetInt(&h) || h < 0 || h >= next) return(E_PANIC);
+            if(type & IF_VECTOR) val->v.vec.nVec[i] = handles[h];
+            else val->nValue = handles[h];
+            break;
+        default:
+            return(E_PANIC);
+        }
+    }
+    if((type & IF_VECTOR) && tab == NULL) FREE(val->v.vec.sVec);
+    return(OK);
+}
+
+
+    /* the stand-ins for the simulator routines - each one does the
+     * real thing, and if that worked writes it down */
+
+static int
+INPcnewNode(ckt,node,name)
+    GENERIC *ckt;
+    GENERIC **node;
+    IFuid name;
+{
+    int error;
+
+    error = (*(INPrealSim->newNode))(ckt,node,name);
+    if(error) {
+        INPcacheBad = 1;
+        return(error);
+    }
+    INPcput("N", 1);
+    INPcstr((char *)name);
+    INPcadd(*node, -1);
+    return(OK);
+}
+
+static int
+INPcgroundNode(ckt,node,name)
+    GENERIC *ckt;
+    GENERIC **node;
+    IFuid name;
+{
+    int error;
+
+    error = (*(INPrealSim->groundNode))(ckt,node,name);
+    if(error) {
+        INPcacheBad = 1;
+        return(error);
+    }
+    INPcput("G", 1);
+    INPcstr((char *)name);
+    INPcadd(*node, -1);
+    return(OK);
+}
+
+static int
+INPcbindNode(ckt,inst,term,node)
+    GENERIC *ckt;
+    GENERIC *inst;
+    int term;
+    GENERIC *node;
+{
+    int error;
+
+    error = (*(INPrealSim->bindNode))(ckt,inst,term,node);
+    if(error) {
+        INPcacheBad = 1;
+        return(error);
+    }
+    INPcput("B", 1);
+    (void)INPchandle(inst);
+    INPcint(term);
+    (void)INPchandle(node);
+    return(OK);
+}
+
+static int
+INPcsetNodeParm(ckt,node,parm,value,select)
+    GENERIC *ckt;
+    GENERIC *node;
+    int parm;
+    IFvalue *value;
+    IFvalue *select;
+{
+    int type;
+
+    type = INPcparmType(ft_sim->nodeParms, ft_sim->numNodeParms, parm);
+    if(type == 0 || select) INPcacheBad = 1;
+    else {
+        INPcput("n", 1);
+        (void)INPchandle(node);
+        INPcint(parm);
+        INPcputVal(type,value);
+    }
+    return((*(INPrealSim->setNodeParm))(ckt,node,parm,value,select));
+}
+
+static int
+INPcnewInstance(ckt,model,inst,name)
+    GENERIC *ckt;
+    GENERIC *model;
+    GENERIC **inst;
+    IFuid name;
+{
+    int error;
+    int type;
+
+    error = (*(INPrealSim->newInstance))(ckt,model,inst,name);
+    if(error) {
+        INPcacheBad = 1;
+        return(error);
+    }
+    INPcput("I", 1);
+    type = INPchandle(model);
+    INPcstr((char *)name);
+    INPcadd(*inst, type);
+    return(OK);
+}
+
+static int
+INPcsetInstanceParm(ckt,inst,parm,value,select)
+    GENERIC *ckt;
+    GENERIC *inst;
+    int parm;
+    IFvalue *value;
+    IFvalue *select;
+{
+    INPcobj *o;
+    int type = 0;
+
+    o = INPcfind(inst);
+    if(o && o->CType >= 0) {
+        type = INPcparmType(ft_sim->devices[o->CType]->instanceParms,
+                ft_sim->devices[o->CType]->numInstanceParms, parm);
+    }
+    if(type == 0 || select) INPcacheBad = 1;
+    else {
+        INPcput("i", 1);
+        INPcint(o->CHandle);
+        INPcint(parm);
+        INPcputVal(type,value);
+    }
+    return((*(INPrealSim->setInstanceParm))(ckt,inst,parm,value,select));
+}
+
+static int
+INPcnewModel(ckt,type,model,name)
+    GENERIC *ckt;
+    int type;
+    GENERIC **model;
+    IFuid name;
+{
+    int error;
+
+    error = (*(INPrealSim->newModel))(ckt,type,model,name);
+    if(error) {
+        INPcacheBad = 1;
+        return(error);
+    }
+    INPcput("M", 1);
+    INPcint(type);
+    INPcstr((char *)name);
+    INPcadd(*model, type);
+    return(OK);
+}
+
+static int
+INPcsetModelParm(ckt,model,parm,value,select)
+    GENERIC *ckt;
+    GENERIC *model;
+    int parm;
+    IFvalue *value;
+    IFvalue *select;
+{
+    INPcobj *o;
+    int type = 0;
+
+    o = INPcfind(model);
+    if(o && o->CType >= 0) {
+        type = INPcparmType(ft_sim->devices[o->CType]->modelParms,
+                ft_sim->devices[o->CType]->numModelParms, parm);
+    }
+    if(type == 0 || select) INPcacheBad = 1;
+    else {
+        INPcput("m", 1);
+        INPcint(o->CHandle);
+        INPcint(parm);
+        INPcputVal(type,value);
+    }
+    return((*(INPrealSim->setModelParm))(ckt,model,parm,value,select));
+}
+
+static int
+INPcnewTask(ckt,task,name)
+    GENERIC *ckt;
+    GENERIC **task;
+    IFuid name;
+{
+    int error;
+
+    error = (*(INPrealSim->newTask))(ckt,task,name);
+    if(error) {
+        INPcacheBad = 1;
+        return(error);
+    }
+    INPcput("T", 1);
+    INPcstr((char *)name);
+    INPcadd(*task, -1);
+    return(OK);
+}
+
+static int
+INPcnewAnalysis(ckt,type,name,anal,task)
+    GENERIC *ckt;
+    int type;
+    IFuid name;
+    GENERIC **anal;
+    GENERIC *task;
+{
+    int error;
+
+    error = (*(INPrealSim->newAnalysis))(ckt,type,name,anal,task);
+    if(error) {
+        INPcacheBad = 1;
+        return(error);
+    }
+    INPcput("A", 1);
+    INPcint(type);
+    INPcstr((char *)name);
+    (void)INPchandle(task);
+    INPcadd(*anal, type);
+    return(OK);
+}
+
+static int
+INPcsetAnalysisParm(ckt,anal,parm,value,select)
+    GENERIC *ckt;
+    GENERIC *anal;
+    int parm;
+    IFvalue *value;
+    IFvalue *select;
+{
+    INPcobj *o;
+    int type = 0;
+
+    o = INPcfind(anal);
+    if(o && o->CType >= 0) {
+        type = INPcparmType(ft_sim->analyses[o->CType]->analysisParms,
+                ft_sim->analyses[o->CType]->numParms, parm);
+    }
+    if(type == 0 || select) INPcacheBad = 1;
+    else {
+        INPcput("a", 1);
+        INPcint(o->CHandle);
+        INPcint(parm);
+        INPcputVal(type,value);
+    }
+    return((*(INPrealSim->setAnalysisParm))(ckt,anal,parm,value,select));
+}
+
+    /* the parser doesn't look things up, but if it ever does the
+     * answers would have to be written down too - until then just
+     * don't save such a deck */
+
+static int
+INPcfindNode(ckt,node,name)
+    GENERIC *ckt;
+    GENERIC **node;
+    IFuid name;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->findNode))(ckt,node,name));
+}
+
+static int
+INPcinstToNode(ckt,inst,term,node,name)
+    GENERIC *ckt;
+    GENERIC *inst;
+    int term;
+    GENERIC **node;
+    IFuid *name;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->instToNode))(ckt,inst,term,node,name));
+}
+
+static int
+INPcfindInstance(ckt,type,inst,name,model,modname)
+    GENERIC *ckt;
+    int *type;
+    GENERIC **inst;
+    IFuid name;
+    GENERIC *model;
+    IFuid modname;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->findInstance))(ckt,type,inst,name,model,modname));
+}
+
+static int
+INPcfindModel(ckt,type,model,name)
+    GENERIC *ckt;
+    int *type;
+    GENERIC **model;
+    IFuid name;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->findModel))(ckt,type,model,name));
+}
+
+static int
+INPcfindAnalysis(ckt,type,anal,name,task,taskname)
+    GENERIC *ckt;
+    int *type;
+    GENERIC **anal;
+    IFuid name;
+    GENERIC *task;
+    IFuid taskname;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->findAnalysis))(ckt,type,anal,name,task,taskname));
+}
+
+static int
+INPcfindTask(ckt,task,name)
+    GENERIC *ckt;
+    GENERIC **task;
+    IFuid name;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->findTask))(ckt,task,name));
+}
+
+    /* nor delete them */
+
+static int
+INPcdeleteNode(ckt,obj)
+    GENERIC *ckt;
+    GENERIC *obj;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->deleteNode))(ckt,obj));
+}
+
+static int
+INPcdeleteInstance(ckt,obj)
+    GENERIC *ckt;
+    GENERIC *obj;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->deleteInstance))(ckt,obj));
+}
+
+static int
+INPcdeleteModel(ckt,obj)
+    GENERIC *ckt;
+    GENERIC *obj;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->deleteModel))(ckt,obj));
+}
+
+static int
+INPcdeleteTask(ckt,obj)
+    GENERIC *ckt;
+    GENERIC *obj;
+{
+    INPcacheBad = 1;
+    return((*(INPrealSim->deleteTask))(ckt,obj));
+}
@@ -66,6 +66,12 @@ INPdomodel(ckt,image,tab)
             err = INPmkTemp("Device type URC not available in this binary\n");
         }
         INPmakeMod(modname,type,image);
+    } else if(strcmp(typename,"ltra") == 0) {
+        type = INPtypelook("LTRA");
+        if(type < 0) {
+            err = INPmkTemp("Device type LTRA not available in this binary\n");
+        }
+        INPmakeMod(modname,type,image);
     } else if( (strcmp(typename,"nmos")==0) || (strcmp(typename,"pmos")==0) ) {
         err = INPfindLev(line,&lev);
         switch(lev) {
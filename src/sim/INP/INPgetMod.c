@@ -17,8 +17,6 @@
 
 RCSID("INPgetMod.c $Revision: 1.1 $ on $Date: 91/04/02 11:56:47 $")
 
-extern INPmodel *modtab;
-
 char *
 INPgetMod(ckt,name,model,tab)
     GENERIC * ckt;
@@ -35,8 +33,8 @@ INPgetMod(ckt,name,model,tab)
     char *temp;
     int error;
 
-    for (modtmp = modtab;modtmp != (INPmodel *)NULL;modtmp =
-            ((modtmp)->INPnextModel)) {
+    for (modtmp = INPmodBucket(name);modtmp != (INPmodel *)NULL;modtmp =
+            ((modtmp)->INPnextHash)) {
         if (strcmp((modtmp)->INPmodName,name) == 0) {
             /* found the model in question - now instantiate if necessary */
             /* and return an appropriate pointer to it */
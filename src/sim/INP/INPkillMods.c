@@ -11,6 +11,8 @@
 RCSID("INPkillMods.c $Revision: 1.1 $ on $Date: 91/04/02 11:56:53 $")
 
 extern INPmodel *modtab;
+extern INPmodel **INPmodHash;
+extern int INPmodHashSize;
 
 void
 INPkillMods()
@@ -25,5 +27,7 @@ INPkillMods()
     }
     if(prev) FREE(prev);
     modtab = (INPmodel *)NULL;
+    if(INPmodHash) FREE(INPmodHash);
+    INPmodHashSize = 0;
 }
 
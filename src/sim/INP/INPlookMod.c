@@ -11,17 +11,15 @@
 
 RCSID("INPlookMod.c $Revision: 1.1 $ on $Date: 91/04/02 11:56:57 $")
 
-extern INPmodel *modtab;
-
 /*ARGSUSED*/
 int
 INPlookMod(name)
     char *name;
 {
-    register INPmodel **i;
+    register INPmodel *i;
 
-    for (i = &modtab;*i != (INPmodel *)NULL;i = &((*i)->INPnextModel)) {
-        if (strcmp((*i)->INPmodName,name) == 0) {
+    for (i = INPmodBucket(name);i != (INPmodel *)NULL;i = i->INPnextHash) {
+        if (strcmp(i->INPmodName,name) == 0) {
             /* found the model in question - return true */
             return(1);
         }
@@ -18,6 +18,22 @@ RCSID("INPmakeMod.c $Revision: 1.1 $ on $Date: 91/04/02 11:56:59 $")
 
 INPmodel *modtab;
 
+/* the models in modtab are also chained by name off a hash table, which
+ * INPkillMods throws away along with the models */
+INPmodel **INPmodHash;
+int INPmodHashSize;
+
+static INPmodel *lastmod;   /* end of modtab, for appending */
+static int nummods;
+
+#ifdef __STDC__
+static int INPmodKey(char *);
+static int INPmodGrow(void);
+#else /* stdc */
+static int INPmodKey();
+static int INPmodGrow();
+#endif /* stdc */
+
     /* create/lookup a 'model' entry */
 
 int
@@ -26,20 +42,82 @@ INPmakeMod(token,type,line)
     int type;
     card *line;
 {
-    register INPmodel **i;
+    register INPmodel *i;
+    int key;
 
-    for (i = &modtab;*i != (INPmodel *)NULL;i = &((*i)->INPnextModel)) {
-        if (strcmp((*i)->INPmodName,token) == 0) {
+    for (i = INPmodBucket(token);i != (INPmodel *)NULL;i = i->INPnextHash) {
+        if (strcmp(i->INPmodName,token) == 0) {
             return(OK);
         }
     }
-    *i = (INPmodel *)MALLOC(sizeof(INPmodel));
-    if(*i==NULL) return(E_NOMEM);
-    (*i)->INPmodName = token;
-    (*i)->INPmodType = type;
-    (*i)->INPnextModel = (INPmodel *)NULL;
-    (*i)->INPmodUsed = 0;
-    (*i)->INPmodLine = line;
-    (*i)->INPmodfast = NULL;
+    if(modtab == (INPmodel *)NULL) {
+        lastmod = (INPmodel *)NULL;
+        nummods = 0;
+    }
+    if(nummods >= 2 * INPmodHashSize) {
+        if(INPmodGrow()) return(E_NOMEM);
+    }
+    i = (INPmodel *)MALLOC(sizeof(INPmodel));
+    if(i==NULL) return(E_NOMEM);
+    i->INPmodName = token;
+    i->INPmodType = type;
+    i->INPnextModel = (INPmodel *)NULL;
+    i->INPmodUsed = 0;
+    i->INPmodLine = line;
+    i->INPmodfast = NULL;
+    if(lastmod) lastmod->INPnextModel = i;
+    else modtab = i;
+    lastmod = i;
+    key = INPmodKey(token);
+    i->INPnextHash = INPmodHash[key];
+    INPmodHash[key] = i;
+    nummods++;
+    return(OK);
+}
+
+
+/* first model in the hash chain that 'name' would be on - the caller
+ * still has to compare the names along the chain */
+INPmodel *
+INPmodBucket(name)
+    char *name;
+{
+    if(INPmodHashSize == 0) return((INPmodel *)NULL);
+    return(INPmodHash[INPmodKey(name)]);
+}
+
+
+static int
+INPmodKey(name)
+    char *name;
+{
+    register unsigned int h = 0;
+    register char *s;
+
+    for (s = name; *s; s++)
+        h = h * 31 + *s;
+    return((int)(h & (INPmodHashSize - 1)));
+}
+
+
+/* double the table (or start it off) and chain modtab back onto it */
+static int
+INPmodGrow()
+{
+    register INPmodel *i;
+    int key;
+
+    if(INPmodHash) FREE(INPmodHash);
+    INPmodHashSize = INPmodHashSize ? 2 * INPmodHashSize : 64;
+    INPmodHash = (INPmodel **)MALLOC(INPmodHashSize * sizeof(INPmodel *));
+    if(INPmodHash == (INPmodel **)NULL) {
+        INPmodHashSize = 0;
+        return(E_NOMEM);
+    }
+    for (i = modtab; i != (INPmodel *)NULL; i = i->INPnextModel) {
+        key = INPmodKey(i->INPmodName);
+        i->INPnextHash = INPmodHash[key];
+        INPmodHash[key] = i;
+    }
     return(OK);
 }
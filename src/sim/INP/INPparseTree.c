@@ -154,6 +154,13 @@ INPgetTree(line, pt, ckt, tab)
     for (i = 0; i < numvalues; i++)
         (*pt)->derivs[i] = PTdifferentiate(p, i);
 
+    /* If it can be compiled, evaluate it that way (PTexec) instead of
+     * walking the trees with IFeval.
+     */
+    (*pt)->code = NULL;
+    if (PTcompile(*pt) == OK)
+        (*pt)->p.IFeval = PTexec;
+
     return;
 }
 
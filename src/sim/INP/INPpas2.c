@@ -113,6 +113,11 @@ int error;  /* used by the macros defined above */
             INP2M(ckt,tab,current);
             break;
 
+        case 'O':   /* Oname <node> <node> <node> <node> <model> */
+            /* LOSSY TRANSMISSION LINE */
+            INP2O(ckt,tab,current);
+            break;
+
         case 'V':   /* Vname <node> <node> [ [DC] <val>] [AC [<val> [<val> ] ] ]
                      *       [<tran function>] */
             INP2V(ckt,tab,current);
@@ -214,10 +214,12 @@ hash(name, tsize)
         int tsize;
 {
         char *s;
-        register int i = 0;
+        register unsigned int i = 0;
 
+        /* just adding the characters up puts names like n1 ... n99999
+         * into a handful of buckets */
         for (s = name; *s; s++)
-                i += *s;
+                i = i * 31 + *s;
         return (i % tsize);
 }
 
@@ -16,6 +16,7 @@
 #include "FTEexter.h"
 #endif /* CMS */
 #include "IFsim.h"
+#include "MIFproto.h"
 #include "suffix.h"
 
 RCSID("INPtypelook.c $Revision: 1.1 $ on $Date: 91/04/02 11:57:17 $")
@@ -32,6 +33,7 @@ INPtypelook(type)
             return(i);
         }
     }
-    return(-1);
+    /* not linked in - try the code model libraries */
+    return(MIFlib_find_dev(type));
 }
 
@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 1987 Wayne A. Christopher, U. C. Berkeley CAD Group
+ *   faustus@cad.berkeley.edu, ucbvax!faustus
+ *
+ * Compile the parse tree of an arbitrary source and its derivative trees
+ * into one list of instructions, and evaluate that.
+ *
+ * The derivative trees share subtrees with the function and each other,
+ * and build new copies of many more (the u in d sin(u) = cos(u) du, for
+ * instance), so walking them all with IFeval computes the same things
+ * over and over.  Here each distinct operation gets one instruction:
+ * nodes are first looked up by address, then by operation and operands,
+ * so a common subexpression is computed only once however it was built.
+ * Operations on constants are done here rather than at each evaluation,
+ * unless they would give an error.
+ *
+ * Every instruction has its own register, so there is nothing to
+ * allocate, and the order the instructions are made in is an order they
+ * can be run in.
+ */
+
+#include "prefix.h"
+#include <stdio.h>
+#include <math.h>
+#include "util.h"
+#include "IFsim.h"
+#ifndef CMS
+#include "IFerrmsgs.h"
+#else  /* CMS */
+#include "IFerrmsg.h"
+#endif /* CMS */
+#ifndef CMS
+#include "INPparseTree.h"
+#else  /* CMS */
+#include "INPparse.h"
+#endif /* CMS */
+#include "suffix.h"
+
+/* While compiling, an operand is a variable number (>= 0), an instruction
+ * (numVars + its number), or a constant (-1 - its number).  The constants
+ * go in the registers after the variables, so instruction operands are
+ * moved up by the number of constants at the end.
+ */
+
+#define KEY_NODE    0   /* a parse tree node, by address */
+#define KEY_CONST   1   /* a constant, by value */
+#define KEY_INSTR   2   /* an operation, by operation and operands */
+
+typedef struct {
+    int kind;           /* KEY_*, or -1 if the slot is empty */
+    char *ptr;          /* the node, or the function of the operation */
+    double con;         /* the constant */
+    int op;             /* the operation ... */
+    int left;           /* ... and its operands */
+    int right;
+    int operand;        /* what it compiled to */
+} PTkey;
+
+static INPparseTree *tree;
+static PTkey *keys;
+static int numKeys;
+static int keySize;
+static PTinstr *code;
+static int numInstrs;
+static int codeSize;
+static double *consts;
+static int numConsts;
+static int constSize;
+static int failed;      /* set if we run out of memory */
+
+static int compile();
+static int constant();
+static int operand();
+static int fold();
+static PTkey *lookup();
+static void insert();
+
+int
+PTcompile(pt)
+    INPparseTree *pt;
+{
+    int numVars = pt->p.numVars;
+    int *outputs;
+    int i;
+
+    tree = pt;
+    keySize = 256;
+    numKeys = 0;
+    keys = (PTkey *) MALLOC(keySize * sizeof (PTkey));
+    codeSize = 64;
+    numInstrs = 0;
+    code = (PTinstr *) MALLOC(codeSize * sizeof (PTinstr));
+    constSize = 16;
+    numConsts = 0;
+    consts = (double *) MALLOC(constSize * sizeof (double));
+    outputs = (int *) MALLOC((numVars + 1) * sizeof (int));
+    if (!keys || !code || !consts || !outputs)
+        goto fail;
+    for (i = 0; i < keySize; i++)
+        keys[i].kind = -1;
+
+    failed = 0;
+    outputs[0] = compile(pt->tree);
+    for (i = 0; i < numVars; i++)
+        outputs[i + 1] = compile(pt->derivs[i]);
+    if (failed)
+        goto fail;
+
+    /* Put the constants after the variables, and the instruction
+     * results after them.
+     */
+    pt->regs = (double *) MALLOC((numVars + numConsts + numInstrs + 1) *
+            sizeof (double));
+    if (!pt->regs)
+        goto fail;
+    for (i = 0; i < numConsts; i++)
+        pt->regs[numVars + i] = consts[i];
+    for (i = 0; i < numInstrs; i++) {
+        code[i].left = operand(code[i].left);
+        code[i].right = operand(code[i].right);
+    }
+    for (i = 0; i <= numVars; i++)
+        outputs[i] = operand(outputs[i]);
+
+    pt->code = code;
+    pt->numInstrs = numInstrs;
+    pt->numConsts = numConsts;
+    pt->outputs = outputs;
+
+    FREE(keys);
+    FREE(consts);
+    return (OK);
+
+fail:
+    if (keys) FREE(keys);
+    if (code) FREE(code);
+    if (consts) FREE(consts);
+    if (outputs) FREE(outputs);
+    pt->code = NULL;
+    return (E_NOMEM);
+}
+
+/* Map an operand as it was while compiling to its register. */
+
+static int
+operand(r)
+    int r;
+{
+    if (r < 0)
+        return (tree->p.numVars - 1 - r);
+    else if (r >= tree->p.numVars)
+        return (r + numConsts);
+    else
+        return (r);
+}
+
+/* Compile a node and return its operand.  If memory runs out, failed is
+ * set and the operand is meaningless.
+ */
+
+static int
+compile(p)
+    INPparseNode *p;
+{
+    PTkey key, *k;
+    int left, right, r;
+    int op;
+    double (*function)();
+
+    if (failed)
+        return (0);
+
+    key.kind = KEY_NODE;
+    key.ptr = (char *) p;
+    if ((k = lookup(&key))->kind != -1)
+        return (k->operand);
+
+    switch (p->type) {
+        case PT_CONSTANT:
+        r = constant(p->constant);
+        break;
+
+        case PT_VAR:
+        r = p->valueIndex;
+        break;
+
+        case PT_FUNCTION:
+        case PT_PLUS:
+        case PT_MINUS:
+        case PT_TIMES:
+        case PT_DIVIDE:
+        case PT_POWER:
+        left = compile(p->left);
+        if (p->type == PT_FUNCTION) {
+            right = 0;
+            op = (p->function == PTuminus) ? PT_NEGATE : PT_FUNCTION;
+        } else {
+            right = compile(p->right);
+            op = p->type;
+        }
+        if (failed)
+            return (0);
+
+        /* Work it out now if it's all constants. */
+        if (left < 0 && (p->type == PT_FUNCTION || right < 0) &&
+                (r = fold(p, left, right)) < 0)
+            break;
+
+        function = (op == PT_FUNCTION || op == PT_POWER) ? p->function :
+                NULL;
+        key.kind = KEY_INSTR;
+        key.ptr = (char *) function;
+        key.op = op;
+        key.left = left;
+        key.right = right;
+        if ((k = lookup(&key))->kind != -1) {
+            r = k->operand;
+            break;
+        }
+        if (numInstrs == codeSize) {
+            codeSize *= 2;
+            code = (PTinstr *) REALLOC(code, codeSize * sizeof (PTinstr));
+            if (!code) {
+                failed = 1;
+                return (0);
+            }
+        }
+        code[numInstrs].op = op;
+        code[numInstrs].left = left;
+        code[numInstrs].right = right;
+        code[numInstrs].function = function;
+        code[numInstrs].funcname = p->funcname;
+        r = tree->p.numVars + numInstrs++;
+        insert(&key, r);
+        break;
+
+        default:
+        fprintf(stderr, "Internal Error: bad node type %d\n", p->type);
+        failed = 1;
+        return (0);
+    }
+
+    key.kind = KEY_NODE;
+    key.ptr = (char *) p;
+    insert(&key, r);
+    return (r);
+}
+
+/* Return the operand for a constant, adding it if it's new. */
+
+static int
+constant(val)
+    double val;
+{
+    PTkey key, *k;
+    int r;
+
+    key.kind = KEY_CONST;
+    key.con = val;
+    if ((k = lookup(&key))->kind != -1)
+        return (k->operand);
+    if (numConsts == constSize) {
+        constSize *= 2;
+        consts = (double *) REALLOC(consts, constSize * sizeof (double));
+        if (!consts) {
+            failed = 1;
+            return (-1);
+        }
+    }
+    consts[numConsts] = val;
+    r = -1 - numConsts++;
+    insert(&key, r);
+    return (r);
+}
+
+/* Apply p's operation to constant operands and return the operand of
+ * the result.  Returns 0 if it has to be left until the instructions are
+ * run, to report the error then.
+ */
+
+static int
+fold(p, left, right)
+    INPparseNode *p;
+    int left, right;
+{
+    double val;
+
+    if (p->type == PT_FUNCTION)
+        val = (*p->function)(consts[-1 - left]);
+    else
+        val = (*p->function)(consts[-1 - left], consts[-1 - right]);
+    if (val == HUGE)
+        return (0);
+    return (constant(val));
+}
+
+static unsigned long
+hash(k)
+    PTkey *k;
+{
+    unsigned long h;
+    unsigned char *c;
+    int i;
+
+    switch (k->kind) {
+        case KEY_NODE:
+        h = (unsigned long) k->ptr >> 3;
+        break;
+
+        case KEY_CONST:
+        h = 0;
+        for (i = 0, c = (unsigned char *) &k->con; i < sizeof (double); i++)
+            h = h * 31 + c[i];
+        break;
+
+        default:
+        h = (unsigned long) k->ptr >> 3;
+        h = h * 31 + k->op;
+        h = h * 31 + k->left;
+        h = h * 31 + k->right;
+        break;
+    }
+    return (h * 31 + k->kind);
+}
+
+static int
+same(a, b)
+    PTkey *a, *b;
+{
+    int i;
+
+    if (a->kind != b->kind)
+        return (0);
+    switch (a->kind) {
+        case KEY_NODE:
+        return (a->ptr == b->ptr);
+
+        case KEY_CONST:
+        /* by bits, so 0 and -0 stay apart */
+        for (i = 0; i < sizeof (double); i++)
+            if (((char *) &a->con)[i] != ((char *) &b->con)[i])
+                return (0);
+        return (1);
+
+        default:
+        return (a->ptr == b->ptr && a->op == b->op &&
+                a->left == b->left && a->right == b->right);
+    }
+}
+
+/* Return the slot holding key, or the empty slot where it would go. */
+
+static PTkey *
+lookup(key)
+    PTkey *key;
+{
+    int i;
+
+    for (i = hash(key) & (keySize - 1); keys[i].kind != -1;
+            i = (i + 1) & (keySize - 1))
+        if (same(&keys[i], key))
+            break;
+    return (&keys[i]);
+}
+
+static void
+insert(key, r)
+    PTkey *key;
+    int r;
+{
+    PTkey *old, *k;
+    int oldSize, i;
+
+    if (2 * (numKeys + 1) > keySize) {
+        old = keys;
+        oldSize = keySize;
+        keySize *= 2;
+        keys = (PTkey *) MALLOC(keySize * sizeof (PTkey));
+        if (!keys) {
+            keys = old;
+            keySize = oldSize;
+            failed = 1;
+            return;
+        }
+        for (i = 0; i < keySize; i++)
+            keys[i].kind = -1;
+        for (i = 0; i < oldSize; i++)
+            if (old[i].kind != -1)
+                *lookup(&old[i]) = old[i];
+        FREE(old);
+    }
+    k = lookup(key);
+    if (k->kind == -1)
+        numKeys++;
+    *k = *key;
+    k->operand = r;
+}
+
+/* Evaluate a compiled tree - the IFeval of trees that PTcompile took. */
+
+int
+PTexec(ptree, result, vals, derivs)
+    IFparseTree *ptree;
+    double *result;
+    double *vals;
+    double *derivs;
+{
+    INPparseTree *pt = (INPparseTree *) ptree;
+    register double *regs = pt->regs;
+    register double *dest;
+    register PTinstr *ip, *end;
+    register double r;
+    int i;
+
+    for (i = 0; i < pt->p.numVars; i++)
+        regs[i] = vals[i];
+
+    dest = regs + pt->p.numVars + pt->numConsts;
+    ip = pt->code;
+    end = ip + pt->numInstrs;
+    for (; ip < end; ip++) {
+        switch (ip->op) {
+            case PT_PLUS:
+            r = regs[ip->left] + regs[ip->right];
+            break;
+
+            case PT_MINUS:
+            r = regs[ip->left] - regs[ip->right];
+            break;
+
+            case PT_TIMES:
+            r = regs[ip->left] * regs[ip->right];
+            break;
+
+            case PT_DIVIDE:
+            if (regs[ip->right] == 0)
+                r = HUGE;
+            else
+                r = regs[ip->left] / regs[ip->right];
+            break;
+
+            case PT_NEGATE:
+            r = - regs[ip->left];
+            break;
+
+            case PT_POWER:
+            r = (*ip->function)(regs[ip->left], regs[ip->right]);
+            break;
+
+            default:
+            r = (*ip->function)(regs[ip->left]);
+            break;
+        }
+        if (r == HUGE) {
+            if (ip->op == PT_FUNCTION || ip->op == PT_NEGATE)
+                fprintf(stderr, "Error: %lg out of range for %s\n",
+                        regs[ip->left], ip->funcname);
+            else
+                fprintf(stderr, "Error: %lg, %lg out of range for %s\n",
+                        regs[ip->left], regs[ip->right], ip->funcname);
+            return (E_PARMVAL);
+        }
+        *dest++ = r;
+    }
+
+    *result = regs[pt->outputs[0]];
+    for (i = 0; i < pt->p.numVars; i++)
+        derivs[i] = regs[pt->outputs[i + 1]];
+
+    return (OK);
+}
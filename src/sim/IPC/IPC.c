@@ -17,6 +17,7 @@ AUTHORS
 MODIFICATIONS
 
     6/13/92  Bill Kuhn  Added some comments
+             Protocol V2 - name dictionary and packed frames
 
 SUMMARY
 
@@ -41,6 +42,9 @@ SUMMARY
         ipc_send_evtdict_suffix
         ipc_send_evtdata_prefix
         ipc_send_evtdata_suffix
+        ipc_send_vecdict_prefix
+        ipc_send_vecdict_entry
+        ipc_send_vecdict_suffix
         ipc_send_errchk
         ipc_send_end
         ipc_send_boolean
@@ -50,6 +54,12 @@ SUMMARY
         ipc_send_event
         ipc_flush
     
+    Under protocol V1 every value goes out as its own record tagged with
+    the upper-cased name of the variable.  Under protocol V2 the names go
+    out once per plot in a >VECDICT block, and the values of each analysis
+    point are collected into a single binary frame that is sent by the
+    matching suffix function (see frame_send below).
+
     These functions communicate with a set of transport-level functions
     that implement the interprocess communications under one of
     the following protocol types determined by a compile-time option:
@@ -75,6 +85,7 @@ SUMMARY
 #include <assert.h>
 #include <ctype.h>
 #include <string.h>
+#include <stdlib.h>
 #include <memory.h>     /* NOTE: I think this is a Sys5ism (there is not man
                          * page for it under Bsd, but it's in /usr/include
                          * and it has a BSD copyright header. Go figure.
@@ -117,6 +128,31 @@ static int              batch_fd;
 #define FMT_BUFFER_SIZE 80
 static char fmt_buffer [FMT_BUFFER_SIZE];
 
+/*
+ * Protocol V2 frames.  A frame is one record:
+ *
+ *    '@' <kind> <u32 length> <f64 reference> <u32 n> <body>
+ *
+ * where <length> counts the bytes after itself, <kind> is 'O' for an
+ * operating point, 'F' for a full frame and 'D' for a delta frame, and all
+ * numbers are big-endian IEEE.  <n> is the number of doubles in the frame
+ * (a complex value takes two) in >VECDICT order.  A full body is the n
+ * doubles.  A delta body is an n bit map, most significant bit first, of
+ * the doubles that differ from the previous frame, followed by just those
+ * doubles.  Deltas are only sent if g_ipc.delta is set and they come out
+ * smaller; the first frame after a dictionary is always full.
+ */
+
+static double           *frame_val = NULL;    /* The frame being built */
+static double           *frame_last = NULL;   /* The frame last sent */
+static int              frame_alloc = 0;
+static int              frame_count;
+static int              frame_last_count = -1;
+static double           frame_ref;
+static char             frame_kind;
+static char             *frame_buf = NULL;
+static int              frame_buf_alloc = 0;
+
 /*---------------------------------------------------------------------------*/
 static Ipc_Boolean_t kw_match (keyword, str)
      char *keyword;
@@ -175,6 +211,8 @@ Ipc_Status_t ipc_initialize_server (server_name, m, p)
 
    num_records = 0;
    fill_count = 0;
+   frame_count = 0;
+   frame_last_count = -1;
    
    status = ipc_transport_initialize_server (server_name, m, p,
                                              batch_filename);
@@ -385,6 +423,10 @@ Ipc_Status_t ipc_flush ()
    int bytes;
    int i;
 
+   /* nothing to do if a frame went out on its own */
+   if (num_records == 0)
+      return IPC_STATUS_OK;
+
    /* if batch mode */
    if (mode == IPC_MODE_BATCH) {
 
@@ -548,6 +590,9 @@ Ipc_Status_t ipc_send_data_prefix (time)
 {
    char buffer[40];
 
+   if (protocol == IPC_PROTOCOL_V2)
+      return frame_begin ('F', time);
+
    sprintf (buffer, ">DATAB %.5E", time);
    return ipc_send_line (buffer);
 }
@@ -567,7 +612,10 @@ Ipc_Status_t ipc_send_data_suffix ()
 {
    Ipc_Status_t  status;
 
-   status = ipc_send_line (">ENDDATA");
+   if (protocol == IPC_PROTOCOL_V2)
+      status = frame_send ();
+   else
+      status = ipc_send_line (">ENDDATA");
 
    if(status != IPC_STATUS_OK)
        return(status);
@@ -587,6 +635,9 @@ results dump from a DC operating point analysis.
 
 Ipc_Status_t ipc_send_dcop_prefix ()
 {
+   if (protocol == IPC_PROTOCOL_V2)
+      return frame_begin ('O', 0.0);
+
    return ipc_send_line (">DCOPB");
 }
 
@@ -605,7 +656,10 @@ Ipc_Status_t ipc_send_dcop_suffix ()
 {
    Ipc_Status_t  status;
 
-   status = ipc_send_line (">ENDDCOP");
+   if (protocol == IPC_PROTOCOL_V2)
+      status = frame_send ();
+   else
+      status = ipc_send_line (">ENDDCOP");
 
    if(status != IPC_STATUS_OK)
        return(status);
@@ -813,6 +867,259 @@ static int stuff_binary_v1 (d1, d2, n, buf, pos)
    return i;
 }
 
+/*---------------------------------------------------------------------------*/
+static int stuff_u32_v2 (u, buf, pos)
+     unsigned long u;   /* value to be stuffed                  */
+     char       *buf;   /* buffer to stuff to                   */
+     int        pos;    /* index at which to stuff              */
+{
+   buf[pos]     = (u >> 24) & 0xff;
+   buf[pos + 1] = (u >> 16) & 0xff;
+   buf[pos + 2] = (u >> 8) & 0xff;
+   buf[pos + 3] = u & 0xff;
+   return pos + 4;
+}
+
+/*---------------------------------------------------------------------------*/
+static int stuff_double_v2 (d, buf, pos)
+     double     d;      /* value to be stuffed                  */
+     char       *buf;   /* buffer to stuff to                   */
+     int        pos;    /* index at which to stuff              */
+{
+   union {
+      double double_val;
+      char ch[8];
+   } trick;
+   static int one = 1;
+   int i;
+
+   assert (sizeof(double) == 8);
+
+   trick.double_val = d;
+   if (*(char *) &one) {
+      /* little-endian host */
+      for (i = 0; i < 8; i++)
+         buf[pos + i] = trick.ch[7 - i];
+   } else {
+      for (i = 0; i < 8; i++)
+         buf[pos + i] = trick.ch[i];
+   }
+   return pos + 8;
+}
+
+/*---------------------------------------------------------------------------*/
+static Ipc_Status_t ipc_send_record (str, len)
+     char *str;
+     int  len;
+     /*
+      * Same as `ipc_send_line_binary' except that records too big for the
+      * output buffer are sent on their own after whatever is queued.  `str'
+      * must have room for the newline after the last character.
+      */
+{
+   Ipc_Status_t status;
+
+   if ((len + 1) < OUT_BUFFER_SIZE)
+      return ipc_send_line_binary (str, len);
+
+   status = ipc_flush ();
+   if (IPC_STATUS_OK != status) {
+      return status;
+   }
+   str[len] = '\n';
+
+   if (mode == IPC_MODE_BATCH) {
+      if ((len + 1) != write (batch_fd, str, len + 1)) {
+         fprintf (stderr,
+                  "ERROR: IPC: Error writing to batch output file\n");
+         perror ("IPC");
+         return IPC_STATUS_ERROR;
+      }
+      return IPC_STATUS_OK;
+   }
+   return ipc_transport_send_line (str, len + 1);
+}
+
+/*---------------------------------------------------------------------------*/
+static Ipc_Status_t frame_begin (kind, ref)
+     char       kind;   /* 'O' for an operating point, else 'F' */
+     double     ref;    /* The analysis point */
+{
+   assert (protocol == IPC_PROTOCOL_V2);
+
+   frame_kind = kind;
+   frame_ref = ref;
+   frame_count = 0;
+   return IPC_STATUS_OK;
+}
+
+/*---------------------------------------------------------------------------*/
+static Ipc_Status_t frame_add (d)
+     double     d;
+{
+   double *p;
+   int size;
+
+   if (frame_count >= frame_alloc) {
+      /* grow both frames together so that they can be swapped */
+      size = frame_alloc ? 2 * frame_alloc : 256;
+      p = (double *) realloc ((char *) frame_val, size * sizeof(double));
+      if (p) {
+         frame_val = p;
+         p = (double *) realloc ((char *) frame_last, size * sizeof(double));
+      }
+      if (! p) {
+         fprintf (stderr, "ERROR: IPC: Out of memory for frame\n");
+         return IPC_STATUS_ERROR;
+      }
+      frame_last = p;
+      frame_alloc = size;
+   }
+   frame_val [frame_count++] = d;
+   return IPC_STATUS_OK;
+}
+
+/*---------------------------------------------------------------------------*/
+static Ipc_Status_t frame_send ()
+     /*
+      * Send the frame built since the last prefix and remember it as the
+      * base for the next delta.
+      */
+{
+   int n = frame_count;
+   int nmap = (n + 7) / 8;
+   int nchanged = 0;
+   int len, pos, map, i;
+   Ipc_Boolean_t delta = IPC_FALSE;
+   double *p;
+
+   if (g_ipc.delta && (frame_kind == 'F') && (frame_last_count == n)) {
+      for (i = 0; i < n; i++)
+         if (memcmp ((char *) &frame_val[i], (char *) &frame_last[i],
+                     sizeof(double)))
+            nchanged++;
+      if ((nmap + 8 * nchanged) < (8 * n))
+         delta = IPC_TRUE;
+   }
+
+   len = 6 + 12 + (delta ? (nmap + 8 * nchanged) : (8 * n));
+   if ((len + 1) > frame_buf_alloc) {
+      if (frame_buf)
+         free (frame_buf);
+      frame_buf_alloc = 2 * (len + 1);
+      frame_buf = (char *) malloc (frame_buf_alloc);
+      if (! frame_buf) {
+         fprintf (stderr, "ERROR: IPC: Out of memory for frame\n");
+         frame_buf_alloc = 0;
+         return IPC_STATUS_ERROR;
+      }
+   }
+
+   frame_buf[0] = '@';
+   frame_buf[1] = delta ? 'D' : frame_kind;
+   pos = stuff_u32_v2 ((unsigned long) (len - 6), frame_buf, 2);
+   pos = stuff_double_v2 (frame_ref, frame_buf, pos);
+   pos = stuff_u32_v2 ((unsigned long) n, frame_buf, pos);
+   if (delta) {
+      map = pos;
+      memset (&frame_buf[map], 0, nmap);
+      pos += nmap;
+      for (i = 0; i < n; i++) {
+         if (memcmp ((char *) &frame_val[i], (char *) &frame_last[i],
+                     sizeof(double))) {
+            frame_buf[map + i / 8] |= 0x80 >> (i % 8);
+            pos = stuff_double_v2 (frame_val[i], frame_buf, pos);
+         }
+      }
+   } else {
+      for (i = 0; i < n; i++)
+         pos = stuff_double_v2 (frame_val[i], frame_buf, pos);
+   }
+   assert (pos == len);
+
+   p = frame_last;
+   frame_last = frame_val;
+   frame_val = p;
+   frame_last_count = n;
+   frame_count = 0;
+
+   return ipc_send_record (frame_buf, len);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ipc_send_vecdict_prefix
+
+This function sends a ``>VECDICT'' line giving the number of entries in
+the name dictionary of a new plot.  The dictionary is sent only under
+protocol V2.
+*/
+
+Ipc_Status_t ipc_send_vecdict_prefix (num)
+     int                num;    /* The number of entries to follow */
+{
+   char buffer[40];
+
+   if (protocol != IPC_PROTOCOL_V2)
+      return IPC_STATUS_OK;
+
+   /* new names, so the next frame can't be a delta */
+   frame_last_count = -1;
+
+   sprintf (buffer, ">VECDICT %d", num);
+   return ipc_send_line (buffer);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ipc_send_vecdict_entry
+
+This function sends one ``<index> <R|C> <name>'' line of the name
+dictionary.  Entries must be sent in the order in which the values are
+later passed to ipc_send_double and ipc_send_complex.
+*/
+
+Ipc_Status_t ipc_send_vecdict_entry (index, tag, is_complex)
+     int                index;       /* Position of the value in each frame */
+     char               *tag;        /* The node or instance */
+     Ipc_Boolean_t      is_complex;  /* Sent with ipc_send_complex */
+{
+   char buffer[OUT_BUFFER_SIZE];
+
+   if (protocol != IPC_PROTOCOL_V2)
+      return IPC_STATUS_OK;
+
+   sprintf (buffer, "%d %c ", index, is_complex ? 'C' : 'R');
+   strncat (buffer, tag, OUT_BUFFER_SIZE - strlen(buffer) - 2);
+   return ipc_send_line_binary (buffer, strlen(buffer));
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ipc_send_vecdict_suffix
+
+This function sends a ``>ENDVDICT'' line to signal the end of the name
+dictionary.
+*/
+
+Ipc_Status_t ipc_send_vecdict_suffix ()
+{
+   Ipc_Status_t  status;
+
+   if (protocol != IPC_PROTOCOL_V2)
+      return IPC_STATUS_OK;
+
+   status = ipc_send_line (">ENDVDICT");
+
+   if(status != IPC_STATUS_OK)
+       return(status);
+
+   return(ipc_flush());
+}
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -848,7 +1155,8 @@ Ipc_Status_t ipc_send_double (tag, value)
       len = stuff_binary_v1 (value, 0.0, 1, fmt_buffer, strlen(fmt_buffer));
       break;
    case IPC_PROTOCOL_V2:
-      break;
+      /* the tag went out in the dictionary */
+      return frame_add (value);
    }
    return ipc_send_line_binary (fmt_buffer, len);
 }
@@ -889,7 +1197,9 @@ Ipc_Status_t ipc_send_complex (tag, value)
                              strlen(fmt_buffer));
       break;
    case IPC_PROTOCOL_V2:
-      break;
+      if (IPC_STATUS_OK != frame_add (value.real))
+         return IPC_STATUS_ERROR;
+      return frame_add (value.imag);
    }
    return ipc_send_line_binary (fmt_buffer, len);
 }
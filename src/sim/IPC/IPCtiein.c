@@ -95,6 +95,8 @@ Ipc_Tiein_t  g_ipc = {
         NULL,                       /* device_name array */
     },
     IPC_FALSE,                  /* stop analysis */
+    IPC_PROTOCOL_V1,            /* protocol */
+    IPC_FALSE,                  /* delta frames */
 };
 
 
@@ -52,7 +52,7 @@ Mif_Info_t  g_mif_info = {
   NULL,
   NULL,
   { 0.0, 0.0,},
-  { MIF_FALSE, MIF_FALSE,},
+  { MIF_FALSE, MIF_FALSE, MIF_FALSE,},
 };
 
 
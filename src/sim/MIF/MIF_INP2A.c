@@ -565,6 +565,8 @@ static void  MIFinit_inst(
     fast->analog = MIF_FALSE;
     fast->event_driven = MIF_FALSE;
     fast->inst_index = 0;
+    fast->static_data = NULL;
+    fast->jacobian = NULL;
 }
 
 
@@ -81,6 +81,8 @@ MIFdelete(
     int         num_port;
     int         num_inst_var;
 
+    Mif_Static_t   *static_data;
+
 
     /* Convert generic pointers in arg list to MIF specific pointers */
     model = (MIFmodel *) inModel;
@@ -190,6 +192,19 @@ MIFdelete(
         FREE(here->intgr);
     if(here->num_conv && here->conv)
         FREE(here->conv);
+    while(here->static_data) {
+        static_data = here->static_data;
+        here->static_data = static_data->next;
+        if(static_data->cleanup)
+            (*(static_data->cleanup))(static_data->block);
+        FREE(static_data->block);
+        FREE(static_data);
+    }
+    if(here->jacobian) {
+        FREE(here->jacobian->input);
+        FREE(here->jacobian->partial);
+        FREE(here->jacobian);
+    }
 
 
     /* Finally, free the instance struct itself */
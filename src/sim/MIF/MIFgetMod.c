@@ -61,7 +61,6 @@ NON-STANDARD FEATURES
 #include "suffix.h"
 
 
-extern INPmodel *modtab;
 
 extern SPICEdev *DEVices[];        /* info about all device types */
 
@@ -109,9 +108,10 @@ MIFgetMod(ckt,name,model,tab)
     MIFmodel          *mdfast;
     Mif_Param_Info_t  *param_info;
 
-    /* locate the named model in the modtab list */
+    /* locate the named model through the modtab hash chains */
 
-    for (modtmp = modtab; modtmp != NULL; modtmp = ((modtmp)->INPnextModel)) {
+    for (modtmp = INPmodBucket(name); modtmp != NULL;
+            modtmp = ((modtmp)->INPnextHash)) {
 
         if (strcmp((modtmp)->INPmodName,name) == 0) {
 
@@ -202,7 +202,7 @@ MIFgetMod(ckt,name,model,tab)
 
         } /* end if name matches */
 
-    } /* end for all models in modtab linked list */
+    } /* end for all models in hash chain */
 
 
     /* didn't find model - ERROR  - return NULL model */
@@ -0,0 +1,267 @@
+/*============================================================================
+FILE    MIFlib.c
+
+MEMBER OF process XSPICE
+
+Copyright 1991
+Georgia Tech Research Corporation
+Atlanta, Georgia 30332
+All Rights Reserved
+
+PROJECT A-8503
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    This file contains the functions that load code models and
+    user-defined node types from shared libraries at run time, as an
+    alternative to linking them into the simulator with modpath.lst and
+    udnpath.lst.
+
+    A library is built from the same objects as a linked-in code model
+    (see the cmlib target in simdir/makefile) and exports two NULL
+    terminated tables made from CMinfo.h and UDNinfo.h:
+
+        SPICEdev        *cm_lib_devices[]
+        Evt_Udn_Info_t  *cm_lib_udns[]
+
+    The 'codemodel' command only records the library names.  A library
+    is opened the first time the parser meets a model or node type that
+    is not already known, and only the entries a deck actually uses are
+    added to the simulator's tables, so a large library costs nothing
+    until one of its models is needed.  Libraries are never closed, since
+    the circuits keep pointers into them.
+
+INTERFACES
+
+    void MIFcodemodel(wordlist *wl)
+    int  MIFlib_find_dev(char *name)
+    int  MIFlib_find_udn(char *name)
+
+REFERENCED FILES
+
+    The shared libraries named in 'codemodel' commands.
+
+NON-STANDARD FEATURES
+
+    dlopen() and dlsym(), when HAS_DLOPEN is defined in prefix.h.
+
+============================================================================*/
+
+#include "prefix.h"
+#include <stdio.h>
+#include <strings.h>
+#ifdef HAS_DLOPEN
+#include <dlfcn.h>
+#endif
+
+#include "CKTdefs.h"
+#include "DEVdefs.h"
+#include "util.h"
+
+#include "MIF.h"
+#include "EVTudn.h"
+
+#include "MIFproto.h"
+#include "suffix.h"
+
+
+extern SPICEdev         *DEVices[];
+extern int              DEVmaxnum;
+extern Evt_Udn_Info_t   *g_evt_udn_info[];
+extern int              g_evt_num_udn_types;
+
+extern int SPIaddDevice(SPICEdev *dev);
+extern int SPIaddUdn(Evt_Udn_Info_t *udn);
+
+
+typedef struct Mif_Lib_s {
+    char                *path;      /* File name given to 'codemodel' */
+    Mif_Boolean_t       tried;      /* Set once it has been opened, or failed to */
+    SPICEdev            **devices;  /* Its code model table, NULL if none */
+    Evt_Udn_Info_t      **udns;     /* Its node type table, NULL if none */
+    struct Mif_Lib_s    *next;
+} Mif_Lib_t;
+
+
+static Mif_Lib_t  *lib_list = NULL;     /* In the order they were given */
+
+
+static Mif_Boolean_t MIFlib_open(Mif_Lib_t *lib);
+
+
+/*
+MIFcodemodel
+
+This function implements the 'codemodel' command.  With arguments
+it adds each named library to the end of the list searched for
+unknown models and node types.  Without, it lists the libraries and
+the entries already taken from them.
+*/
+
+void MIFcodemodel(
+    wordlist *wl)     /* The command arguments */
+{
+    Mif_Lib_t   *lib;
+    Mif_Lib_t   **lib_ptr;
+    int         i;
+    int         j;
+
+    if(wl == NULL) {
+        if(lib_list == NULL) {
+            printf("No code model libraries\n");
+            return;
+        }
+        for(lib = lib_list; lib; lib = lib->next) {
+            printf("%s", lib->path);
+            if(! lib->tried) {
+                printf("  (not yet opened)\n");
+                continue;
+            }
+            if((lib->devices == NULL) && (lib->udns == NULL)) {
+                printf("  (could not be opened)\n");
+                continue;
+            }
+            printf("\n");
+            for(i = 0; lib->devices && lib->devices[i]; i++) {
+                for(j = 0; j < DEVmaxnum; j++)
+                    if(DEVices[j] == lib->devices[i])
+                        break;
+                printf("    %-20s %s\n", lib->devices[i]->DEVpublic.name,
+                       (j < DEVmaxnum) ? "loaded" : "");
+            }
+            for(i = 0; lib->udns && lib->udns[i]; i++) {
+                for(j = 0; j < g_evt_num_udn_types; j++)
+                    if(g_evt_udn_info[j] == lib->udns[i])
+                        break;
+                printf("    %-20s %s\n", lib->udns[i]->name,
+                       (j < g_evt_num_udn_types) ? "loaded (node type)"
+                                                 : "(node type)");
+            }
+        }
+        return;
+    }
+
+    for(; wl; wl = wl->wl_next) {
+
+        /* Skip it if it is already on the list */
+        for(lib_ptr = &lib_list; *lib_ptr; lib_ptr = &((*lib_ptr)->next))
+            if(strcmp((*lib_ptr)->path, wl->wl_word) == 0)
+                break;
+        if(*lib_ptr)
+            continue;
+
+        lib = (Mif_Lib_t *) MALLOC(sizeof(Mif_Lib_t));
+        lib->path = MIFcopy(wl->wl_word);
+        lib->tried = MIF_FALSE;
+        lib->devices = NULL;
+        lib->udns = NULL;
+        lib->next = NULL;
+        *lib_ptr = lib;
+    }
+}
+
+
+/*
+MIFlib_find_dev
+
+This function is called when a model type is not among the devices
+already known.  It searches the code model libraries in order, opening
+them as needed, and adds the first code model of that name to the
+device table.  It returns the new device type, or -1 if there is none.
+*/
+
+int MIFlib_find_dev(
+    char *name)       /* The model type, e.g. "gain" */
+{
+    Mif_Lib_t   *lib;
+    int         i;
+
+    for(lib = lib_list; lib; lib = lib->next) {
+        if(! MIFlib_open(lib) || (lib->devices == NULL))
+            continue;
+        for(i = 0; lib->devices[i]; i++) {
+            if(strcmp(name, lib->devices[i]->DEVpublic.name) == 0)
+                return(SPIaddDevice(lib->devices[i]));
+        }
+    }
+    return(-1);
+}
+
+
+/*
+MIFlib_find_udn
+
+This function is the same as MIFlib_find_dev, but for user-defined
+node types.  It returns the new index into g_evt_udn_info, or -1.
+*/
+
+int MIFlib_find_udn(
+    char *name)       /* The node type, e.g. "real" */
+{
+    Mif_Lib_t   *lib;
+    int         i;
+
+    for(lib = lib_list; lib; lib = lib->next) {
+        if(! MIFlib_open(lib) || (lib->udns == NULL))
+            continue;
+        for(i = 0; lib->udns[i]; i++) {
+            if(strcmp(name, lib->udns[i]->name) == 0)
+                return(SPIaddUdn(lib->udns[i]));
+        }
+    }
+    return(-1);
+}
+
+
+/*
+MIFlib_open
+
+Open a library if it has not been tried before and find its tables.
+Returns false if it could not be opened.  A library that cannot be
+opened is reported once and then skipped.
+*/
+
+static Mif_Boolean_t MIFlib_open(
+    Mif_Lib_t *lib)   /* The library */
+{
+#ifdef HAS_DLOPEN
+    GENERIC     *handle;
+#endif
+
+    if(lib->tried)
+        return((lib->devices != NULL) || (lib->udns != NULL));
+    lib->tried = MIF_TRUE;
+
+#ifdef HAS_DLOPEN
+    /* RTLD_NOW, so that a model that won't link fails here and not */
+    /* in the middle of a simulation */
+    handle = dlopen(lib->path, RTLD_NOW);
+    if(handle == NULL) {
+        fprintf(stderr, "Error: can't load code model library %s: %s\n",
+                lib->path, dlerror());
+        return(MIF_FALSE);
+    }
+    lib->devices = (SPICEdev **) dlsym(handle, "cm_lib_devices");
+    lib->udns = (Evt_Udn_Info_t **) dlsym(handle, "cm_lib_udns");
+    if((lib->devices == NULL) && (lib->udns == NULL)) {
+        fprintf(stderr, "Error: %s is not a code model library\n",
+                lib->path);
+        dlclose(handle);
+        return(MIF_FALSE);
+    }
+    return(MIF_TRUE);
+#else
+    fprintf(stderr,
+            "Error: can't load %s - code model libraries not supported\n",
+            lib->path);
+    return(MIF_FALSE);
+#endif
+}
@@ -30,6 +30,8 @@ SUMMARY
 INTERFACES
 
     MIFload()
+    MIFauto_stats()
+    MIFauto_clear()
 
 REFERENCED FILES
 
@@ -50,6 +52,7 @@ NON-STANDARD FEATURES
 #include "CKTdefs.h"
 #include "DEVdefs.h"
 #include "SPerror.h"
+#include "util.h"
 
 #include "MIFproto.h"
 #include "MIFparse.h"
@@ -71,7 +74,18 @@ extern SPICEdev *DEVices[];        /* info about all device types */
 static void MIFauto_partial(
     MIFinstance     *here,
     void            (*cm_func)(),
-    Mif_Private_t   *cm_data
+    Mif_Private_t   *cm_data,
+    CKTcircuit      *ckt
+);
+
+static Mif_Jacobian_t *MIFauto_jacobian(
+    MIFinstance     *here
+);
+
+static Mif_Boolean_t MIFauto_reuse(
+    MIFinstance     *here,
+    Mif_Jacobian_t  *jac,
+    CKTcircuit      *ckt
 );
 
 
@@ -449,7 +463,8 @@ MIFload(
             /* or by model through call to cm_analog_auto_partial() in DC or TRAN analysis */
             if((anal_type != MIF_AC) && 
                (g_mif_info.auto_partial.global || g_mif_info.auto_partial.local))
-                    MIFauto_partial(here, DEVices[mod_type]->DEVpublic.cm_func, &cm_data);
+                    MIFauto_partial(here, DEVices[mod_type]->DEVpublic.cm_func, &cm_data,
+                                    ckt);
 
             /* ***************************************************************** */
             /* Loop through all connections on this instance and */
@@ -684,13 +699,24 @@ the code model additional times with an individual input to the
 model varied by a small amount at each call.  Partial
 derivatives of each output with respect to the varied input
 are then computed by divided differences.
+
+The partials are also kept with the instance, along with the inputs
+they were computed at.  If option autopartialreuse is set and every
+analog input is still within the convergence tolerances of those
+values, the kept partials are used and the model is not called again.
+That is only done in the same mode and with the same timestep and
+integration coefficient, since models that integrate or differentiate
+have partials that depend on them.
+Newton iteration converges to the same point with them, since the
+outputs themselves are always computed at the current inputs.
 */
 
 
 static void MIFauto_partial(
     MIFinstance     *here,         /* The instance structure */
     void            (*cm_func)(),  /* The code model function to be called */
-    Mif_Private_t   *cm_data)      /* The data to be passed to the code model */
+    Mif_Private_t   *cm_data,      /* The data to be passed to the code model */
+    CKTcircuit      *ckt)          /* The circuit structure */
 {
 
     Mif_Port_Data_t *fast;
@@ -699,6 +725,8 @@ static void MIFauto_partial(
     Mif_Port_Type_t type;
     Mif_Port_Type_t out_type;
 
+    Mif_Jacobian_t  *jac;
+
     int         num_conn;
     int         num_port;
     int         num_port_k;
@@ -708,9 +736,25 @@ static void MIFauto_partial(
     int         k;
     int         l;
 
+    int         in_index;
+    int         out_index;
+
     double      epsilon;
     double      nominal_input;
+    double      partial;
+
 
+    /* Count the load against the model for MIFauto_stats */
+    (here->MIFmodPtr->auto_loads)++;
+
+    jac = MIFauto_jacobian(here);
+
+    /* Use the last partials if the inputs have not moved */
+    if(g_mif_info.auto_partial.reuse && jac && jac->valid &&
+       MIFauto_reuse(here, jac, ckt)) {
+        (here->MIFmodPtr->auto_reused)++;
+        return;
+    }
 
     /* Reset init and anal_init flags before making additional calls */
     /* to the model */
@@ -765,6 +809,7 @@ static void MIFauto_partial(
     /* ***************************************************************** */
 
     /* loop through all connections */
+    in_index = 0;
     num_conn = here->num_conn;
     for(i = 0; i < num_conn; i++) {
 
@@ -825,10 +870,13 @@ static void MIFauto_partial(
             /* record and perturb input value */
             nominal_input = fast->input.rvalue;
             fast->input.rvalue += epsilon;
+            if(jac)
+                jac->input[in_index] = nominal_input;
 
 
             /* call model to compute new outputs */
             (*cm_func)(cm_data);
+            (here->MIFmodPtr->auto_calls)++;
 
 
             /* ******************************************************* */
@@ -837,6 +885,7 @@ static void MIFauto_partial(
             /* ******************************************************* */
 
             /* loop through all analog output connections */
+            out_index = 0;
             for(k = 0; k < num_conn; k++) {
 
                 /* if the connection is null or is not an output */
@@ -863,8 +912,12 @@ static void MIFauto_partial(
                         continue;
 
                     /* compute partial by divided differences */
-                    out_fast->partial[i].port[j] =
-                        (out_fast->output.rvalue - out_fast->nominal_output) / epsilon;
+                    partial = (out_fast->output.rvalue - out_fast->nominal_output) /
+                              epsilon;
+                    out_fast->partial[i].port[j] = partial;
+                    if(jac)
+                        jac->partial[out_index * jac->num_in + in_index] = partial;
+                    out_index++;
 
                     /* zero the output in preparation for next call */
                     out_fast->output.rvalue = 0.0;
@@ -874,10 +927,18 @@ static void MIFauto_partial(
 
             /* restore nominal input value */
             fast->input.rvalue = nominal_input;
+            in_index++;
 
         } /* end for number of input ports */
     } /* end for number of input connections */
 
+    if(jac) {
+        jac->valid = MIF_TRUE;
+        jac->mode = ckt->CKTmode;
+        jac->delta = ckt->CKTdelta;
+        jac->ag0 = ckt->CKTag[0];
+    }
+
 
     /* *************************************************** */
     /* Call model one last time to recompute nominal case. */
@@ -888,8 +949,255 @@ static void MIFauto_partial(
     /* to the nominal condition from here */
 
     (*cm_func)(cm_data);
+    (here->MIFmodPtr->auto_calls)++;
+
+}
+
+
+
+/*
+MIFauto_jacobian
+
+This function returns the structure that keeps the automatically
+computed partials of an instance, allocating it the first time.  The
+analog inputs and outputs are numbered in the order MIFauto_partial
+visits them.  Returns NULL if there is no memory, in which case the
+partials are simply computed every time.
+*/
+
+
+static Mif_Jacobian_t *MIFauto_jacobian(
+    MIFinstance     *here)         /* The instance structure */
+{
+    Mif_Jacobian_t  *jac;
+    Mif_Port_Data_t *fast;
+    int             num_in;
+    int             num_out;
+    int             i;
+    int             j;
+
+    if(here->jacobian)
+        return(here->jacobian);
+
+    num_in = 0;
+    num_out = 0;
+    for(i = 0; i < here->num_conn; i++) {
+        if(here->conn[i]->is_null)
+            continue;
+        for(j = 0; j < here->conn[i]->size; j++) {
+            fast = here->conn[i]->port[j];
+            if(fast->is_null || (fast->type == MIF_DIGITAL) ||
+               (fast->type == MIF_USER_DEFINED))
+                continue;
+            if(here->conn[i]->is_input)
+                num_in++;
+            if(here->conn[i]->is_output)
+                num_out++;
+        }
+    }
+
+    jac = (void *) MALLOC(sizeof(Mif_Jacobian_t));
+    if(jac == NULL)
+        return(NULL);
+    jac->num_in = num_in;
+    jac->num_out = num_out;
+    jac->valid = MIF_FALSE;
+    jac->input = (void *) MALLOC((num_in + 1) * sizeof(double));
+    jac->partial = (void *) MALLOC((num_in * num_out + 1) * sizeof(double));
+    if((jac->input == NULL) || (jac->partial == NULL)) {
+        if(jac->input)
+            FREE(jac->input);
+        if(jac->partial)
+            FREE(jac->partial);
+        FREE(jac);
+        return(NULL);
+    }
 
+    here->jacobian = jac;
+    return(jac);
 }
 
 
 
+/*
+MIFauto_reuse
+
+This function checks whether every analog input of an instance is
+within the convergence tolerances (reltol, and vntol or abstol) of the
+value the kept partials were computed at, in the same mode and at the
+same timestep.  If so, it copies the kept partials to the output ports
+and returns true.
+*/
+
+
+static Mif_Boolean_t MIFauto_reuse(
+    MIFinstance     *here,         /* The instance structure */
+    Mif_Jacobian_t  *jac,          /* The kept partials */
+    CKTcircuit      *ckt)          /* The circuit structure */
+{
+    Mif_Port_Data_t *fast;
+    Mif_Port_Data_t *out_fast;
+
+    int         num_conn;
+    int         i;
+    int         j;
+    int         k;
+    int         l;
+
+    int         in_index;
+    int         out_index;
+
+    double      input;
+    double      last;
+    double      tol;
+
+
+    /* Check the mode and integration coefficients */
+    if((ckt->CKTmode != jac->mode) || (ckt->CKTdelta != jac->delta) ||
+       (ckt->CKTag[0] != jac->ag0))
+        return(MIF_FALSE);
+
+    /* Check the inputs */
+    in_index = 0;
+    num_conn = here->num_conn;
+    for(i = 0; i < num_conn; i++) {
+        if(here->conn[i]->is_null || (! here->conn[i]->is_input))
+            continue;
+        for(j = 0; j < here->conn[i]->size; j++) {
+            fast = here->conn[i]->port[j];
+            if(fast->is_null || (fast->type == MIF_DIGITAL) ||
+               (fast->type == MIF_USER_DEFINED))
+                continue;
+
+            input = fast->input.rvalue;
+            last = jac->input[in_index++];
+            tol = ckt->CKTreltol * ((fabs(input) > fabs(last)) ?
+                                    fabs(input) : fabs(last));
+            switch(fast->type) {
+                case MIF_VOLTAGE:
+                case MIF_DIFF_VOLTAGE:
+                case MIF_CONDUCTANCE:
+                case MIF_DIFF_CONDUCTANCE:
+                    tol += ckt->CKTvoltTol;
+                    break;
+                default:
+                    tol += ckt->CKTabstol;
+                    break;
+            }
+            if(fabs(input - last) > tol)
+                return(MIF_FALSE);
+        }
+    }
+
+    /* Inputs are close enough, so load the kept partials */
+    in_index = 0;
+    for(i = 0; i < num_conn; i++) {
+        if(here->conn[i]->is_null || (! here->conn[i]->is_input))
+            continue;
+        for(j = 0; j < here->conn[i]->size; j++) {
+            fast = here->conn[i]->port[j];
+            if(fast->is_null || (fast->type == MIF_DIGITAL) ||
+               (fast->type == MIF_USER_DEFINED))
+                continue;
+
+            out_index = 0;
+            for(k = 0; k < num_conn; k++) {
+                if(here->conn[k]->is_null || (! here->conn[k]->is_output))
+                    continue;
+                for(l = 0; l < here->conn[k]->size; l++) {
+                    out_fast = here->conn[k]->port[l];
+                    if(out_fast->is_null || (out_fast->type == MIF_DIGITAL) ||
+                       (out_fast->type == MIF_USER_DEFINED))
+                        continue;
+                    out_fast->partial[i].port[j] =
+                        jac->partial[out_index * jac->num_in + in_index];
+                    out_index++;
+                }
+            }
+            in_index++;
+        }
+    }
+
+    return(MIF_TRUE);
+}
+
+
+
+/*
+MIFauto_stats
+
+This function prints a line for each code model in the circuit whose
+partials have been computed automatically: the number of instance
+loads that needed them, the extra calls to the model that were made
+for them, and the number of loads that reused the last partials
+instead (see option autopartialreuse).  It is called by the rusage
+command.  Returns the number of models printed.
+*/
+
+
+int MIFauto_stats(
+    CKTcircuit  *ckt,        /* The circuit structure */
+    FILE        *fp)         /* Where to print */
+{
+    MIFmodel    *model;
+    int         type;
+    int         num_models;
+
+    num_models = 0;
+    for(type = 0; type < DEVmaxnum; type++) {
+        if((ckt->CKThead[type] == NULL) ||
+           (DEVices[type]->DEVpublic.cm_func == NULL))
+            continue;
+        for(model = (MIFmodel *) ckt->CKThead[type]; model;
+            model = model->MIFnextModel) {
+            if(model->auto_loads == 0)
+                continue;
+            if(num_models == 0) {
+                fprintf(fp, "Code model partials by divided differences:\n");
+                fprintf(fp, "    %-16s %-16s %10s %10s %10s\n",
+                        "model", "type", "loads", "calls", "reused");
+            }
+            fprintf(fp, "    %-16s %-16s %10d %10d %10d\n",
+                    (char *) model->MIFmodName,
+                    DEVices[type]->DEVpublic.name,
+                    model->auto_loads, model->auto_calls,
+                    model->auto_reused);
+            num_models++;
+        }
+    }
+    return(num_models);
+}
+
+
+
+/*
+MIFauto_clear
+
+This function marks the partials kept by MIFauto_partial invalid for
+every code model instance in the circuit.  It is called by CKTdoJob
+before a new set of analyses, since parameters may have been altered
+since the partials were computed.
+*/
+
+
+void MIFauto_clear(
+    CKTcircuit  *ckt)        /* The circuit structure */
+{
+    MIFmodel    *model;
+    MIFinstance *here;
+    int         type;
+
+    for(type = 0; type < DEVmaxnum; type++) {
+        if((ckt->CKThead[type] == NULL) ||
+           (DEVices[type]->DEVpublic.cm_func == NULL))
+            continue;
+        for(model = (MIFmodel *) ckt->CKThead[type]; model;
+            model = model->MIFnextModel) {
+            for(here = model->MIFinstances; here;
+                here = here->MIFnextInstance) {
+                if(here->jacobian)
+                    here->jacobian->valid = MIF_FALSE;
+            }
+        }
+    }
+}
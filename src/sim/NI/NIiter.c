@@ -38,11 +38,18 @@ NIiter(ckt,maxIter)
     char *message;  /* temporary message buffer */
     double *temp;
     double startTime;
+    int reuse;      /* solving with the last L-U factors this time */
+    int refactor;   /* the last factors aren't doing well enough */
+    double step;    /* largest change in the solution this iteration */
+    double lastStep;
+    int size;
     static char *msg = "Too many iterations without convergence";
 
 
     iterno=0;
     ipass=0;
+    refactor=0;
+    lastStep=0;
 
 
 
@@ -113,7 +120,34 @@ NIiter(ckt,maxIter)
                 ckt->CKTniState |= NISHOULDREORDER;
             }
 
-            if(ckt->CKTniState & NISHOULDREORDER) {
+            /* modified Newton:  past the first point of a transient run
+             * the jacobian only depends on the step and order through
+             * CKTag[0], so while those stay put it usually hasn't moved
+             * much, and the last L-U factors will do for solving for the
+             * next correction.  The residual has to come from the matrix
+             * just loaded for the answer to still be right.
+             */
+            reuse = ckt->CKTluReuse && !refactor &&
+                    (ckt->CKTmode & MODETRAN) &&
+                    !(ckt->CKTmode & MODEINITTRAN) &&
+                    !(ckt->CKTniState & NISHOULDREORDER) &&
+                    ckt->CKTmatrix->SMPhaveLU &&
+                    (ckt->CKTag[0] == ckt->CKTluAg0) &&
+                    (ckt->CKTorder == ckt->CKTluOrder);
+
+            if(reuse) {
+                startTime = (*(SPfrontEnd->IFseconds))();
+                SMPresidual(ckt->CKTmatrix,ckt->CKTrhs,ckt->CKTrhsOld,
+                        ckt->CKTdiagGmin);
+                SMPluSolve(ckt->CKTmatrix,ckt->CKTrhs,ckt->CKTrhsSpare);
+                size = SMPmatSize(ckt->CKTmatrix);
+                for(i=1;i<=size;i++) {
+                    *(ckt->CKTrhs+i) += *(ckt->CKTrhsOld+i);
+                }
+                ckt->CKTstat->STATsolveTime += (*(SPfrontEnd->IFseconds))()-
+                        startTime;
+                ckt->CKTstat->STATsavedLUfac++;
+            } else if(ckt->CKTniState & NISHOULDREORDER) {
                 startTime = (*(SPfrontEnd->IFseconds))();
                 error = SMPreorder(ckt->CKTmatrix,ckt->CKTpivotAbsTol,
                         ckt->CKTpivotRelTol,ckt->CKTdiagGmin);
@@ -160,14 +194,41 @@ NIiter(ckt,maxIter)
                 }
             } 
 
-            startTime = (*(SPfrontEnd->IFseconds))();
-            SMPsolve(ckt->CKTmatrix,ckt->CKTrhs,ckt->CKTrhsSpare);
-            ckt->CKTstat->STATsolveTime += (*(SPfrontEnd->IFseconds))()-
-                    startTime;
+            if(!reuse) {
+                ckt->CKTstat->STATnumLUfac++;
+                if(ckt->CKTluReuse) {
+                    SMPluSave(ckt->CKTmatrix);
+                    ckt->CKTluAg0 = ckt->CKTag[0];
+                    ckt->CKTluOrder = ckt->CKTorder;
+                    refactor = 0;
+                }
+                startTime = (*(SPfrontEnd->IFseconds))();
+                SMPsolve(ckt->CKTmatrix,ckt->CKTrhs,ckt->CKTrhsSpare);
+                ckt->CKTstat->STATsolveTime += (*(SPfrontEnd->IFseconds))()-
+                        startTime;
+            }
             *ckt->CKTrhs = 0;
             *ckt->CKTrhsSpare = 0;
             *ckt->CKTrhsOld = 0;
 
+            if(ckt->CKTluReuse) {
+                /* if the old factors aren't pulling the corrections down
+                 * at least twice as fast as they were, or it is taking
+                 * too long anyway, factor again next time around */
+                step = 0;
+                size = SMPmatSize(ckt->CKTmatrix);
+                for(i=1;i<=size;i++) {
+                    step = MAX(step,
+                            FABS(*(ckt->CKTrhs+i) - *(ckt->CKTrhsOld+i)));
+                }
+                if(reuse && ((lastStep > 0 && step > 0.5 * lastStep) ||
+                        (2 * iterno >= maxIter))) {
+                    refactor = 1;
+                    ckt->CKTnoncon = 1; /* and don't trust this one */
+                }
+                lastStep = step;
+            }
+
             if(iterno > maxIter) {
                 /*printf("too many iterations without convergence: %d iter's\n",
                         iterno);*/
@@ -42,6 +42,8 @@ int b;
      * and other per-col stuff in the matrix descriptor
      */
 
+    matrix->SMPhaveLU = 0; /* any saved factors are in the old order */
+
     a = *(matrix->SMPcolMapOut + col1) ;
     b = *(matrix->SMPcolMapOut + col2) ;
     *(matrix->SMPcolMapOut + col1) = b;
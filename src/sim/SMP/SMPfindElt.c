@@ -60,10 +60,12 @@ register SMPelement *new;
     if(new == (SMPelement *)NULL) return((SMPelement *)NULL); /* no memory! */
     new->SMPvalue = 0;
     new->SMPiValue = 0;
+    new->SMPluValue = 0;
     new->SMProwNext = *prev;
     new->SMProwNumber = row;
     new->SMPcolNumber = col;
     matrix->SMPnonZero++;
+    matrix->SMPhaveLU = 0;     /* saved factors don't cover it */
     *prev = new;
     if (row!=col && row != 0 && col != 0) {
         /* remember, counts are OFF-DIAGONAL, so skip if on diagonal */
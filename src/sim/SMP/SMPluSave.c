@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 1985 Thomas L. Quarles
+ */
+
+    /*
+     * SMPluSave(matrix)
+     *      - keep a copy of the L-U factors just computed by
+     *      SMPluFac or SMPreorder, so that SMPluSolve can use
+     *      them again after the matrix has been reloaded.
+     */
+
+#include "prefix.h"
+#include "util.h"
+#include "SMPdefs.h"
+#include <stdio.h>
+#include "suffix.h"
+
+void
+SMPluSave(matrix)
+    register SMPmatrix *matrix;
+{
+    register SMPelement *here;
+    register int row;
+
+    for(row=1;row<=matrix->SMPsize;row++) {
+        for(here = *(matrix->SMProwHead + row); here != NULL;
+                here = here->SMProwNext) {
+            here->SMPluValue = here->SMPvalue;
+        }
+    }
+    matrix->SMPhaveLU = 1;
+}
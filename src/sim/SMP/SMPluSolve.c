@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 1985 Thomas L. Quarles
+ */
+
+    /*
+     * SMPluSolve(matrix,rhs,spare) 
+     *      - solve (perform forward/back substitution on) the
+     *      matrix given, using the supplied Right Hand Side
+     *      and the L-U factors last kept by SMPluSave rather
+     *      than the present matrix values.
+     */
+
+#include "prefix.h"
+#include "util.h"
+#include "SMPdefs.h"
+#include <stdio.h>
+#include "suffix.h"
+
+void
+SMPluSolve(matrix,rhs,spare)
+    register SMPmatrix *matrix;
+    register double rhs[];
+    register double spare[];
+
+{
+    register SMPelement * here;
+    register SMPelement * diag;
+    register int row;
+
+    /*  first, permute the rhs correctly */
+
+    for(row=1;row<=matrix->SMPsize;row++) {
+        spare[SMPextToIntMapRow(row,matrix)] = rhs[row];
+    }
+
+    /*  forward substitution */
+
+    for(row=1;row<=matrix->SMPsize;row++) {
+        here = *(matrix->SMProwHead + row);
+        while (here != NULL && here->SMPcolNumber<row) {
+            if(here->SMPcolNumber!=0) {
+                spare[row] -= spare[here->SMPcolNumber] * here->SMPluValue;
+            }
+            here = here->SMProwNext;
+        }
+    }
+
+    /*  backward substitution */
+
+    for (row=matrix->SMPsize;row>=1;row--) {
+        diag = *(matrix->SMProwHead + row);
+        while (diag != NULL && diag->SMPcolNumber<row) {
+            diag = diag->SMProwNext;
+        }
+        for(here = diag->SMProwNext; here != NULL; here = here->SMProwNext) {
+            spare[row] -= here->SMPluValue * spare[here->SMPcolNumber];
+        }
+        spare[row] /= diag->SMPluValue;
+    }
+
+    for(row=1;row<=matrix->SMPsize;row++) {
+        rhs[SMPintToExtMapCol(row,matrix)] = spare[row];
+    }
+}
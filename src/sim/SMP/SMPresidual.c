@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 1985 Thomas L. Quarles
+ */
+
+    /*
+     * SMPresidual(matrix,rhs,x,gmin)
+     *      - subtract the product of the (loaded, not yet factored)
+     *      matrix and the vector x from rhs, leaving the residual
+     *      of the equations at x.  gmin is the value SMPluFac would
+     *      add to each diagonal.  rhs and x are in external order.
+     */
+
+#include "prefix.h"
+#include "util.h"
+#include "SMPdefs.h"
+#include <stdio.h>
+#include "suffix.h"
+
+void
+SMPresidual(matrix,rhs,x,gmin)
+    register SMPmatrix *matrix;
+    register double rhs[];
+    register double x[];
+    double gmin;
+{
+    register SMPelement *here;
+    register int row;
+    register double sum;
+    int col;
+
+    for(row=1;row<=matrix->SMPsize;row++) {
+        sum = 0;
+        for(here = *(matrix->SMProwHead + row); here != NULL;
+                here = here->SMProwNext) {
+            col = here->SMPcolNumber;
+            if(col == 0) continue;
+            if(col == row) {
+                sum += (here->SMPvalue + gmin) *
+                        x[SMPintToExtMapCol(col,matrix)];
+            } else {
+                sum += here->SMPvalue * x[SMPintToExtMapCol(col,matrix)];
+            }
+        }
+        rhs[SMPintToExtMapRow(row,matrix)] -= sum;
+    }
+}
@@ -42,6 +42,8 @@ SMProwSwap(matrix,row1,row2)
      * and other per-row stuff in the matrix descriptor
      */
 
+    matrix->SMPhaveLU = 0; /* any saved factors are in the old order */
+
     a = *(matrix->SMProwMapOut + row1) ;
     b = *(matrix->SMProwMapOut + row2) ;
     *(matrix->SMProwMapOut + row1) = b;
@@ -67,5 +67,39 @@ typedef struct {
 } Digital_t;
 
 
+/* A bus of up to BUS_MAX_WIDTH digital bits carried on one node of */
+/* the 'bus' type (see udnl/bus).  Each bit has the twelve states of */
+/* Digital_t, kept in bit planes so that whole words of bits can be  */
+/* compared, copied and resolved at once.  Bit n is in word          */
+/* BUS_WORD(n) of each plane, under BUS_BIT(n).  Bits at or above    */
+/* width are always zero in every plane.                             */
+
+#define BUS_MAX_WIDTH   64
+#define BUS_WORD_BITS   (8 * sizeof(unsigned long))
+#define BUS_WORDS       ((BUS_MAX_WIDTH + BUS_WORD_BITS - 1) / BUS_WORD_BITS)
+
+#define BUS_WORD(n)     ((n) / BUS_WORD_BITS)
+#define BUS_BIT(n)      (1UL << ((n) % BUS_WORD_BITS))
+
+typedef struct {
+    int            width;                   /* Bits in use */
+    unsigned long  value[BUS_WORDS];        /* Set where a known bit is ONE */
+    unsigned long  unknown[BUS_WORDS];      /* Set where a bit is UNKNOWN */
+    unsigned long  strength[2][BUS_WORDS];  /* Low and high bits of the */
+                                            /* Digital_Strength_t code */
+} Bus_t;
+
+
+typedef struct {
+    double  *x;          /* First breakpoint */
+    int     stride;      /* Doubles from one breakpoint to the next */
+    int     size;        /* Number of breakpoints */
+    int     cursor;      /* Segment found by the last search */
+    int     num_cells;   /* Cells in the uniform grid, or 0 if none */
+    double  cell_scale;  /* Cells per unit of x */
+    int     *cell;       /* Last breakpoint at or below each cell start */
+} Cm_Table_t;
+
+
 
 #endif /* CMTYPES_DEFINED */
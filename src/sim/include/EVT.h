@@ -244,6 +244,16 @@ typedef struct Evt_State_Desc_s {
 } Evt_State_Desc_t;
 
 
+typedef struct Evt_Journal_s {
+    struct Evt_Journal_s *next;        /* Next older entry */
+    double               step;         /* Time at which the bytes were changed */
+    char                 *addr;        /* Location of the bytes */
+    int                  bytes;        /* Number of bytes */
+    int                  size;         /* Space allocated for old */
+    char                 *old;         /* Their contents before the change */
+} Evt_Journal_t;
+
+
 typedef struct {
     Evt_State_t    **head;              /* Beginning of linked lists */
     Evt_State_t    ***tail;             /* Location of last item added to list */
@@ -254,6 +264,9 @@ typedef struct {
     Mif_Boolean_t  *modified;           /* Flags used to prevent multiple entries */
     int            *total_size;         /* Total bytes for all states allocated */
     Evt_State_Desc_t **desc;            /* Lists of description structures */
+    Evt_Journal_t  *journal;            /* cm_event_journal() entries since last */
+                                        /* accepted timepoint, newest first */
+    Evt_Journal_t  *journal_free;       /* Entries for reuse */
 } Evt_State_Data_t;
 
 
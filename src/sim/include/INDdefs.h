@@ -192,6 +192,7 @@ extern int MUTpzLoad(GENmodel*,CKTcircuit*,SPcomplex*);
 extern void MUTsPrint(GENmodel*,CKTcircuit*);
 extern int MUTsSetup(SENstruct*,GENmodel*);
 extern int MUTsetup(SMPmatrix*,GENmodel*,CKTcircuit*,int*);
+extern int MUTtemp(GENmodel*,CKTcircuit*);
 #else /* stdc */
 extern int MUTacLoad();
 extern int MUTask();
@@ -203,6 +204,7 @@ extern int MUTpzLoad();
 extern void MUTsPrint();
 extern int MUTsSetup();
 extern int MUTsetup();
+extern int MUTtemp();
 #endif /* stdc */
 
 
@@ -28,6 +28,13 @@ typedef struct INPparseTree {
     IFparseTree p;
     struct INPparseNode *tree;  /* The real stuff. */
     struct INPparseNode **derivs;   /* The derivative parse trees. */
+    struct PTinstr *code;   /* Both of them compiled by PTcompile(), */
+    int numInstrs;          /* ... the number of instructions, */
+    int numConsts;          /* ... and of constants, */
+    int *outputs;           /* ... the registers holding the value and
+                             * then each derivative, */
+    double *regs;           /* ... and the registers: the variables, the
+                             * constants, then one per instruction. */
 } INPparseTree;
 
 /* This is what is passed as the actual parameter value.  The fields will all
@@ -65,6 +72,23 @@ typedef struct INPparseNode {
 #define PT_CONSTANT 7
 #define PT_VAR      8
 
+/* One more operation that only appears in compiled code. */
+
+#define PT_NEGATE   9
+
+/* An instruction of the compiled form.  It computes op (a PT_* above) of
+ * the registers left and right, and puts the result in its own register,
+ * the one after that of the previous instruction.
+ */
+
+typedef struct PTinstr {
+    int op;
+    int left;
+    int right;
+    double (*function)();   /* For PT_FUNCTION and PT_POWER. */
+    char *funcname;         /* For the error message. */
+} PTinstr;
+
 /* These are the functions that we support. */
 
 #define PTF_ACOS    0
@@ -151,6 +175,16 @@ extern double PTtan();
 extern double PTtanh();
 extern double PTuminus();
 
+/* And in PTcompile.c */
+
+#ifdef __STDC__
+extern int PTcompile(INPparseTree *);
+extern int PTexec(IFparseTree *, double*, double*, double*);
+#else /* stdc */
+extern int PTcompile();
+extern int PTexec();
+#endif /* stdc */
+
 /* And in IFeval.c */
 
 #ifdef __STDC__
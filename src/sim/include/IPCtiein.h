@@ -84,6 +84,8 @@ typedef struct {
     char            *log_file;    /* Path to write log file */
     Ipc_Vtrans_t    vtrans;       /* Used by OUTinterface to translate v sources */
     Ipc_Boolean_t   stop_analysis; /* True if analysis should be terminated */
+    Ipc_Protocol_t  protocol;     /* V1 named records or V2 packed frames */
+    Ipc_Boolean_t   delta;        /* True if V2 frames may be sent as deltas */
 
 } Ipc_Tiein_t;
 
@@ -64,6 +64,7 @@ typedef struct {
 typedef struct {
     Mif_Boolean_t   global;     /* Set by .option to force all models to use auto */
     Mif_Boolean_t   local;      /* Set by individual model to request auto partials */
+    Mif_Boolean_t   reuse;      /* Set by .option to reuse them while inputs hold */
 } Mif_Auto_Partial_t;
 
 
@@ -205,6 +205,14 @@ typedef struct sMOS2instance {
     double MOS2vdsat;
     double MOS2sourceVcrit; /* Vcrit for pos. vds */
     double MOS2drainVcrit;  /* Vcrit for pos. vds */
+    double MOS2tEffLength;   /* effective channel length */
+    double MOS2tDrainSatCur; /* drain junction saturation current */
+    double MOS2tSourceSatCur;    /* source junction saturation current */
+    double MOS2tGsOverlapCap;    /* gate-source overlap capacitance */
+    double MOS2tGdOverlapCap;    /* gate-drain overlap capacitance */
+    double MOS2tGbOverlapCap;    /* gate-bulk overlap capacitance */
+    double MOS2tBeta;        /* transconductance scaled by W/Leff */
+    double MOS2tOxideCap;    /* total gate oxide capacitance */
     double MOS2cd;
     double MOS2cbs;
     double MOS2cbd;
@@ -25,6 +25,10 @@ typedef struct {
     double STATtranDecompTime;  /* time spent in transient LU decomposition */
     double STATtranSolveTime;   /* time spent in transient F-B Subst. */
 
+    int STATnumLUfac;   /* number of L-U factorizations (and reorders) */
+    int STATsavedLUfac; /* iterations that reused the last L-U factors */
+                        /* instead of factoring again (lureuse option) */
+
 } STATistics;
 
 #define OPT_GMIN 1
@@ -70,6 +74,10 @@ typedef struct {
 #define OPT_EQNS 40
 #define OPT_REORDTIME 41
 #define OPT_METHOD 42
+#define OPT_LUREUSE 43
+#define OPT_LUFACTORS 44
+#define OPT_LUSAVED 45
+#define OPT_MIF_AUTO_REUSE 46
 
 /* gtri - begin - wbk - add new options */
 #define OPT_ENH_NOOPALTER           100
@@ -16,6 +16,7 @@
             /* that order due to the definition of 'complex' used */
         double SMPvalue;    /* matrix entry for this point */
         double SMPiValue;   /* imaginary matrix entry for this point */
+        double SMPluValue;  /* saved L-U factor entry, for reuse */
         struct sSMPelement *SMProwNext;  /* pointer to next in row */
         struct sSMPelement *SMPcolNext;  /* pointer to next in column */
         int SMProwNumber; /* internal row number */
@@ -49,6 +50,7 @@
                              * matrix before reordering */
         int SMPbadi;        /* row of last troublesome entry */
         int SMPbadj;        /* column of last troublesome entry*/
+        int SMPhaveLU;      /* saved L-U factors are valid */
     }SMPmatrix;
 
     typedef struct {
@@ -84,6 +86,8 @@ int SMPfillup( SMPmatrix * );
 SMPelement * SMPfindElt( SMPmatrix *, int , int , int );
 void SMPgetError( SMPmatrix *, int *, int *);
 int SMPluFac( SMPmatrix *, double , double );
+void SMPluSave( SMPmatrix *);
+void SMPluSolve( SMPmatrix *, double [], double []);
 double * SMPmakeElt( SMPmatrix * , int , int );
 int SMPmatSize( SMPmatrix *);
 int SMPnewMatrix( SMPmatrix ** );
@@ -91,6 +95,7 @@ int SMPnewNode( int , SMPmatrix *);
 int SMPpreOrder( SMPmatrix *);
 void SMPprint( SMPmatrix * , FILE *);
 int SMPreorder( SMPmatrix * , double , double , double );
+void SMPresidual( SMPmatrix *, double [], double [], double );
 void SMProwSwap( SMPmatrix * , int , int );
 void SMPsolve( SMPmatrix *, double [], double []);
 #else /* stdc */
@@ -107,6 +112,8 @@ int SMPfillup();
 SMPelement * SMPfindElt();
 void SMPgetError();
 int SMPluFac();
+void SMPluSave();
+void SMPluSolve();
 double * SMPmakeElt();
 int SMPmatSize();
 int SMPnewMatrix();
@@ -114,6 +121,7 @@ int SMPnewNode();
 int SMPpreOrder();
 void SMPprint();
 int SMPreorder();
+void SMPresidual();
 void SMProwSwap();
 void SMPsolve();
 #endif /* stdc */
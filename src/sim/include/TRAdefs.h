@@ -39,9 +39,11 @@ typedef struct sTRAinstance {
     double TRAinitCur2;     /* initial condition:  current at port 2 */
     double TRAreltol;       /* relative deriv. tol. for breakpoint setting */
     double TRAabstol;       /* absolute deriv. tol. for breakpoint setting */
-    double *TRAdelays;     /* delayed values of excitation */
+    double *TRAdelays;     /* delayed values of excitation (ring buffer) */
     int TRAsizeDelay;       /* size of active delayed table */
-    int TRAallocDelay;      /* allocated size of delayed table */
+    int TRAallocDelay;      /* allocated size of delayed table (power of 2) */
+    int TRAfirstDelay;      /* slot holding entry 0 of the active table */
+    int TRAcursorDelay;     /* entry last used to interpolate the delay */
     int TRAbrEq1;       /* number of branch equation for end 1 of t. line */
     int TRAbrEq2;       /* number of branch equation for end 2 of t. line */
     double *TRAibr1Ibr2Ptr;     /* pointer to sparse matrix */
@@ -78,6 +80,14 @@ typedef struct sTRAinstance {
     unsigned TRAabstolGiven:1;  /* flag to ind. absolute deriv. tol. given */
 } TRAinstance ;
 
+/* The delay table is kept as a ring of (time, input1, input2) triples so
+ * that old entries can be dropped by just moving TRAfirstDelay.  TRADELAY
+ * gives a pointer to the triple for entry i of the active table, where
+ * entries run from 0 to TRAsizeDelay inclusive.
+ */
+#define TRADELAY(inst,i) ((inst)->TRAdelays + 3 * (((inst)->TRAfirstDelay + \
+        (i)) & ((inst)->TRAallocDelay - 1)))
+
 
 /* per model data */
 
@@ -49,6 +49,7 @@ typedef struct {
     double TSKdefaultMosAS;
     unsigned int TSKfixLimit:1;
     unsigned int TSKnoOpIter:1; /* no OP iterating, go straight to gmin step */
+    unsigned int TSKluReuse:1;  /* modified Newton in transient */
 }TSKtask;
 
 #endif /*TSK*/
@@ -7,6 +7,7 @@
 #include "IFsim.h"
 #include "CKTdefs.h"
 #include "GENdefs.h"
+#include "CMtypes.h"
 #include "complex.h"
 
         /*
@@ -30,6 +31,7 @@ typedef struct sVSRCinstance {
     int VSRCfunctionType;   /* code number of function type for source */
     int VSRCfunctionOrder;  /* order of the function for the source */
     double *VSRCcoeffs; /* pointer to array of coefficients */
+    Cm_Table_t VSRCtable; /* lookup of the PWL timepoints */
 
     double VSRCdcValue; /* DC and TRANSIENT value of source */
 
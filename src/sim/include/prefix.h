@@ -61,6 +61,7 @@
 #define HAS_BSTRING
 #define HAS_INDEX
 #define HAS_TIOCSTI
+#define HAS_DLOPEN  /* dlopen(), for code model libraries (MIFlib.c) */
 
 /* gtri - modify - wbk - 10/8/90 - uncomment, we have VSPRINTF */
 #define HAS_VSPRINTF
@@ -0,0 +1,333 @@
+/*============================================================================
+FILE    bus/udnfunc.c
+
+MEMBER OF process XSPICE
+
+Copyright 1991
+Georgia Tech Research Corporation
+Atlanta, Georgia 30332
+All Rights Reserved
+
+PROJECT A-8503
+
+AUTHORS
+
+    <date> <person name>
+
+MODIFICATIONS
+
+    <date> <person name> <nature of modifications>
+
+SUMMARY
+
+    This file contains the definition of the 'bus' node type used by
+    event-driven models that pass up to BUS_MAX_WIDTH digital bits on
+    a single node.  The data is a Bus_t (see CMtypes.h), with the
+    twelve digital states of each bit held in bit planes, so that a
+    change to any number of bits of a bus is one event, and resolving
+    and comparing bus values works on whole words of bits.  These
+    functions are called exclusively through function pointers in an
+    Evt_Udn_Info_t data structure.
+
+INTERFACES
+
+    Evt_Udn_Info_t udn_bus_info
+
+REFERENCED FILES
+
+    None.
+
+NON-STANDARD FEATURES
+
+    None.
+
+============================================================================*/
+
+#include <stdio.h>
+#include "CM.h"
+
+#include "EVTudn.h"
+
+void *malloc(unsigned);
+
+
+
+/* ************************************************************************ */
+
+void udn_bus_create(CREATE_ARGS)
+{
+    /* Malloc space for a bus struct */
+    MALLOCED_PTR = malloc(sizeof(Bus_t));
+}
+
+
+/* ************************************************************************ */
+
+void udn_bus_dismantle(DISMANTLE_ARGS)
+{
+    /* Do nothing.  There are no internally malloc'ed things to dismantle */
+}
+
+
+/* ************************************************************************ */
+
+void udn_bus_initialize(INITIALIZE_ARGS)
+{
+    Bus_t  *bus_struct = STRUCT_PTR;
+
+    int    i;
+
+
+    /* Initialize to an empty bus.  The first output sets the width. */
+    bus_struct->width = 0;
+    for(i = 0; i < BUS_WORDS; i++) {
+        bus_struct->value[i] = 0;
+        bus_struct->unknown[i] = 0;
+        bus_struct->strength[0][i] = 0;
+        bus_struct->strength[1][i] = 0;
+    }
+}
+
+
+/* ************************************************************************ */
+
+void udn_bus_invert(INVERT_ARGS)
+{
+    Bus_t  *bus_struct = STRUCT_PTR;
+
+    int    i;
+
+
+    /* Invert the state of the known bits */
+    for(i = 0; i < BUS_WORDS; i++)
+        bus_struct->value[i] ^= cm_bus_mask(bus_struct->width, i) &
+                                ~bus_struct->unknown[i];
+}
+
+
+/* ************************************************************************ */
+
+void udn_bus_copy(COPY_ARGS)
+{
+    Bus_t  *bus_from_struct = INPUT_STRUCT_PTR;
+    Bus_t  *bus_to_struct   = OUTPUT_STRUCT_PTR;
+
+    /* Copy the structure */
+    *bus_to_struct = *bus_from_struct;
+}
+
+
+/* ************************************************************************ */
+
+/*
+The resolution is that of the 'digital' node type, applied to every bit
+of a word at once.  Taking the outputs one at a time, a strong bit beats
+anything but another strong bit or one of undetermined strength,
+resistive beats high impedance, and undetermined strength beats both of
+those.  The states of the bits that survive are merged, with any
+disagreement or UNKNOWN giving UNKNOWN.  The result is as wide as the
+widest output.  This is the 'digital' resolution table, except that the
+result does not depend on the order of the outputs, where three entries
+of that table do.
+*/
+
+void udn_bus_resolve(RESOLVE_ARGS)
+{
+    Bus_t   **array    = (Bus_t **) INPUT_STRUCT_PTR_ARRAY;
+    Bus_t   *out       = OUTPUT_STRUCT_PTR;
+    int     num_struct = INPUT_STRUCT_PTR_ARRAY_SIZE;
+
+    Bus_t           *in;
+    unsigned long   s_a, r_a, u_a;       /* Strong, resistive and undetermined */
+    unsigned long   s_b, r_b, u_b;       /* bits of the result and the output */
+    unsigned long   s, r, u, z;          /* Strengths of the new result */
+    unsigned long   p_a, p_b;            /* Bits whose states survive */
+    unsigned long   x;                   /* New unknown bits */
+    int             width;               /* Width of the result so far */
+    int             i;
+    int             w;
+
+    /* Copy the first member of the array directly to the output */
+    *out = *(array[0]);
+
+    /* For the remaining members, perform the resolution algorithm */
+    for(i = 1; i < num_struct; i++) {
+
+        in = array[i];
+        width = out->width;
+        if(in->width > out->width)
+            out->width = in->width;
+
+        for(w = 0; w < BUS_WORDS; w++) {
+
+            s_a = ~out->strength[0][w] & ~out->strength[1][w];
+            r_a = out->strength[0][w] & ~out->strength[1][w];
+            u_a = out->strength[0][w] & out->strength[1][w];
+            s_b = ~in->strength[0][w] & ~in->strength[1][w];
+            r_b = in->strength[0][w] & ~in->strength[1][w];
+            u_b = in->strength[0][w] & in->strength[1][w];
+
+            /* Bits above the width of one side are high impedance */
+            s_a &= cm_bus_mask(width, w);
+            s_b &= cm_bus_mask(in->width, w);
+
+            s = s_a | s_b;
+            u = ~s & (u_a | u_b);
+            r = ~s & ~u & (r_a | r_b);
+            z = ~s & ~u & ~r;
+
+            p_a = (s & (s_a | u_a)) | u | (r & r_a) | z;
+            p_b = (s & (s_b | u_b)) | u | (r & r_b) | z;
+
+            x = (p_a & out->unknown[w]) | (p_b & in->unknown[w]) |
+                (p_a & p_b & (out->value[w] ^ in->value[w]));
+
+            out->value[w] = ((p_a & out->value[w]) | (~p_a & in->value[w])) &
+                            ~x;
+            out->unknown[w] = x;
+            out->strength[0][w] = r | u;
+            out->strength[1][w] = z | u;
+        }
+    }
+
+    /* Clear the bits above the width */
+    for(w = 0; w < BUS_WORDS; w++) {
+        out->value[w] &= cm_bus_mask(out->width, w);
+        out->unknown[w] &= cm_bus_mask(out->width, w);
+        out->strength[0][w] &= cm_bus_mask(out->width, w);
+        out->strength[1][w] &= cm_bus_mask(out->width, w);
+    }
+}
+
+
+/* ************************************************************************ */
+
+void udn_bus_compare(COMPARE_ARGS)
+{
+    Bus_t  *bus_struct1 = STRUCT_PTR_1;
+    Bus_t  *bus_struct2 = STRUCT_PTR_2;
+
+    /* Compare the structures a word of bits at a time */
+    EQUAL = cm_bus_equal(bus_struct1, bus_struct2);
+}
+
+
+/* ************************************************************************ */
+
+void udn_bus_plot_val(PLOT_VAL_ARGS)
+{
+    Bus_t   *bus_struct = STRUCT_PTR;
+
+    double  scale;
+    int     i;
+    int     n;
+
+
+    /* Output the number of unknown bits, or else the value as an */
+    /* unsigned number */
+    if(strcmp(STRUCT_MEMBER_ID, "unknown") == 0) {
+        for(i = 0, n = 0; i < bus_struct->width; i++)
+            if(bus_struct->unknown[BUS_WORD(i)] & BUS_BIT(i))
+                n++;
+        PLOT_VAL = n;
+    }
+    else {
+        PLOT_VAL = 0.0;
+        for(i = 0, scale = 1.0; i < bus_struct->width; i++, scale *= 2.0)
+            if(bus_struct->value[BUS_WORD(i)] & BUS_BIT(i))
+                PLOT_VAL += scale;
+    }
+}
+
+
+/* ************************************************************************ */
+
+void udn_bus_print_val(PRINT_VAL_ARGS)
+{
+    Bus_t   *bus_struct = STRUCT_PTR;
+
+    static char *state_map = "01U";
+    static char *strength_map = "srzu";
+
+    char    *s;
+    int     i;
+    int     n;
+    int     digit;
+    int     strength;
+
+
+    /* Allocate space for the printed value */
+    PRINT_VAL = malloc(BUS_MAX_WIDTH + 1);
+    s = PRINT_VAL;
+
+    /* Print the state or strength of each bit, most significant */
+    /* first, or by default the value in hex with X for any digit */
+    /* that has an unknown bit */
+    if(strcmp(STRUCT_MEMBER_ID, "state") == 0) {
+        for(i = bus_struct->width - 1; i >= 0; i--) {
+            if(bus_struct->unknown[BUS_WORD(i)] & BUS_BIT(i))
+                *s++ = state_map[UNKNOWN];
+            else if(bus_struct->value[BUS_WORD(i)] & BUS_BIT(i))
+                *s++ = state_map[ONE];
+            else
+                *s++ = state_map[ZERO];
+        }
+    }
+    else if(strcmp(STRUCT_MEMBER_ID, "strength") == 0) {
+        for(i = bus_struct->width - 1; i >= 0; i--) {
+            strength = 0;
+            if(bus_struct->strength[0][BUS_WORD(i)] & BUS_BIT(i))
+                strength |= 1;
+            if(bus_struct->strength[1][BUS_WORD(i)] & BUS_BIT(i))
+                strength |= 2;
+            *s++ = strength_map[strength];
+        }
+    }
+    else {
+        for(n = (bus_struct->width + 3) / 4 - 1; n >= 0; n--) {
+            for(i = 4 * n, digit = 0; (i < 4 * n + 4) &&
+                                      (i < bus_struct->width); i++) {
+                if(bus_struct->unknown[BUS_WORD(i)] & BUS_BIT(i))
+                    break;
+                if(bus_struct->value[BUS_WORD(i)] & BUS_BIT(i))
+                    digit |= 1 << (i - 4 * n);
+            }
+            if((i < 4 * n + 4) && (i < bus_struct->width))
+                *s++ = 'X';
+            else
+                *s++ = "0123456789ABCDEF"[digit];
+        }
+    }
+    *s = '\0';
+}
+
+
+
+/* ************************************************************************ */
+
+void udn_bus_ipc_val(IPC_VAL_ARGS)
+{
+    /* Simply return the structure and its size */
+    IPC_VAL = STRUCT_PTR;
+    IPC_VAL_SIZE = sizeof(Bus_t);
+}
+
+
+
+Evt_Udn_Info_t udn_bus_info = {
+
+    "bus",
+    "packed digital bus data",
+
+    udn_bus_create,
+    udn_bus_dismantle,
+    udn_bus_initialize,
+    udn_bus_invert,
+    udn_bus_copy,
+    udn_bus_resolve,
+    udn_bus_compare,
+    udn_bus_plot_val,
+    udn_bus_print_val,
+    udn_bus_ipc_val
+
+};